@@ -0,0 +1,10 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_xbuild
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("source/tnn/device/x86")
+subdirs("source/tnn/device/cpu")
+subdirs("third_party/gflags")
+subdirs("test")
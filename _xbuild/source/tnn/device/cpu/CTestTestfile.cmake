@@ -0,0 +1,6 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/source/tnn/device/cpu
+# Build directory: /root/repo/_xbuild/source/tnn/device/cpu
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
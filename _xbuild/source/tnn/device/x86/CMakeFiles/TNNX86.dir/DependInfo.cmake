@@ -0,0 +1,144 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/source/tnn/device/x86/acc/compute/jit/cblas_driver.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/cblas_driver.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/cblas_driver.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/compute/jit/conv_data_packing.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/conv_data_packing.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/conv_data_packing.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/compute/jit/conv_gemm_config.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/conv_gemm_config.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/conv_gemm_config.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/compute/jit/conv_sgemm_driver.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/conv_sgemm_driver.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/conv_sgemm_driver.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/compute/jit/data_packing.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/data_packing.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/data_packing.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/compute/jit/gemm_config.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/gemm_config.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/gemm_config.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/compute/jit/sgemm_driver.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/sgemm_driver.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/sgemm_driver.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/compute/jit/utils/cpu_isa.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/utils/cpu_isa.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/utils/cpu_isa.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/compute/x86_compute.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/x86_compute.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/x86_compute.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/compute/x86_compute_binary.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/x86_compute_binary.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/x86_compute_binary.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/compute/x86_compute_copy.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/x86_compute_copy.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/x86_compute_copy.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/compute/x86_compute_dynamic_quant.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/x86_compute_dynamic_quant.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/x86_compute_dynamic_quant.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/compute/x86_compute_int8.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/x86_compute_int8.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/x86_compute_int8.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/compute/x86_compute_norm.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/x86_compute_norm.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/x86_compute_norm.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/compute/x86_compute_sparse.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/x86_compute_sparse.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/x86_compute_sparse.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/compute/x86_compute_weight_quant.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/x86_compute_weight_quant.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/x86_compute_weight_quant.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/convolution/x86_conv_int8_layer_common.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/convolution/x86_conv_int8_layer_common.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/convolution/x86_conv_int8_layer_common.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/convolution/x86_conv_int8_layer_depthwise.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/convolution/x86_conv_int8_layer_depthwise.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/convolution/x86_conv_int8_layer_depthwise.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/convolution/x86_conv_layer_1x1.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/convolution/x86_conv_layer_1x1.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/convolution/x86_conv_layer_1x1.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/convolution/x86_conv_layer_3x3.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/convolution/x86_conv_layer_3x3.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/convolution/x86_conv_layer_3x3.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/convolution/x86_conv_layer_acc_factory.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/convolution/x86_conv_layer_acc_factory.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/convolution/x86_conv_layer_acc_factory.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/convolution/x86_conv_layer_common.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/convolution/x86_conv_layer_common.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/convolution/x86_conv_layer_common.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/convolution/x86_conv_layer_depthwise.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/convolution/x86_conv_layer_depthwise.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/convolution/x86_conv_layer_depthwise.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/deconvolution/x86_deconv_layer_common.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/deconvolution/x86_deconv_layer_common.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/deconvolution/x86_deconv_layer_common.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_abs_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_abs_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_abs_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_acos_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_acos_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_acos_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_add_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_add_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_add_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_arg_max_or_min_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_arg_max_or_min_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_arg_max_or_min_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_asin_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_asin_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_asin_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_atan_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_atan_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_atan_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_batch_norm_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_batch_norm_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_batch_norm_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_binary_op_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_binary_op_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_binary_op_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_cast_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_cast_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_cast_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_ceil_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_ceil_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_ceil_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_clip_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_clip_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_clip_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_concat_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_concat_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_concat_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_conv1d_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_conv1d_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_conv1d_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_conv_dw_pw_fused_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_conv_dw_pw_fused_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_conv_dw_pw_fused_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_conv_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_conv_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_conv_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_cos_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_cos_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_cos_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_deconv_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_deconv_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_deconv_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_detection_output_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_detection_output_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_detection_output_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_div_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_div_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_div_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_elu_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_elu_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_elu_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_erf_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_erf_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_erf_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_exp_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_exp_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_exp_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_expand_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_expand_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_expand_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_flatten_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_flatten_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_flatten_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_floor_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_floor_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_floor_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_gather_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_gather_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_gather_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_gathernd_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_gathernd_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_gathernd_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_gelu_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_gelu_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_gelu_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_group_norm_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_group_norm_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_group_norm_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_gru_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_gru_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_gru_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_hard_sigmoid_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_hard_sigmoid_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_hard_sigmoid_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_hard_swish_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_hard_swish_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_hard_swish_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_inner_product_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_inner_product_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_inner_product_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_inst_norm_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_inst_norm_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_inst_norm_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_layer_norm_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_layer_norm_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_layer_norm_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_log_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_log_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_log_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_log_sigmoid_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_log_sigmoid_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_log_sigmoid_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_lrn_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_lrn_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_lrn_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_lstm_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_lstm_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_lstm_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_mat_mul_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_mat_mul_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_mat_mul_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_max_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_max_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_max_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_min_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_min_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_min_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_mul_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_mul_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_mul_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_neg_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_neg_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_neg_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_normalize_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_normalize_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_normalize_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_onehot_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_onehot_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_onehot_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_pad_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_pad_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_pad_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_permute_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_permute_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_permute_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_pixel_shuffle_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_pixel_shuffle_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_pixel_shuffle_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_pool_1d_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_pool_1d_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_pool_1d_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_pool_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_pool_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_pool_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_pow_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_pow_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_pow_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_prelu_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_prelu_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_prelu_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_prior_box_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_prior_box_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_prior_box_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_reciprocal_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_reciprocal_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_reciprocal_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_reduce_l1_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_reduce_l1_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_reduce_l1_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_reduce_l2_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_reduce_l2_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_reduce_l2_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_reduce_log_sum_exp_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_reduce_log_sum_exp_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_reduce_log_sum_exp_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_reduce_log_sum_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_reduce_log_sum_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_reduce_log_sum_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_reduce_max_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_reduce_max_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_reduce_max_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_reduce_mean_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_reduce_mean_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_reduce_mean_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_reduce_min_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_reduce_min_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_reduce_min_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_reduce_op_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_reduce_op_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_reduce_op_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_reduce_prod_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_reduce_prod_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_reduce_prod_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_reduce_sum_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_reduce_sum_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_reduce_sum_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_reduce_sum_square_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_reduce_sum_square_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_reduce_sum_square_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_reformat_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_reformat_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_reformat_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_relu6_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_relu6_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_relu6_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_relu_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_relu_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_relu_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_reorg_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_reorg_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_reorg_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_reshape_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_reshape_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_reshape_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_scale_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_scale_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_scale_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_scatter_nd_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_scatter_nd_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_scatter_nd_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_selu_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_selu_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_selu_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_shuffle_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_shuffle_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_shuffle_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_sigmoid_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_sigmoid_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_sigmoid_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_sign_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_sign_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_sign_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_signed_mul_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_signed_mul_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_signed_mul_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_sin_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_sin_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_sin_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_softmax_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_softmax_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_softmax_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_softplus_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_softplus_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_softplus_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_softsign_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_softsign_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_softsign_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_splitv_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_splitv_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_splitv_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_sqrt_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_sqrt_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_sqrt_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_squeeze_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_squeeze_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_squeeze_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_stride_slice_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_stride_slice_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_stride_slice_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_stride_slice_v2_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_stride_slice_v2_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_stride_slice_v2_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_sub_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_sub_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_sub_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_tan_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_tan_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_tan_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_tanh_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_tanh_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_tanh_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_unary2_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_unary2_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_unary2_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_unary_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_unary_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_unary_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_unsqueeze_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_unsqueeze_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_unsqueeze_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_upsample_layer_acc.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_upsample_layer_acc.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_upsample_layer_acc.cc.o.d"
+  "/root/repo/source/tnn/device/x86/x86_blob_converter.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/x86_blob_converter.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/x86_blob_converter.cc.o.d"
+  "/root/repo/source/tnn/device/x86/x86_blob_preprocess.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/x86_blob_preprocess.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/x86_blob_preprocess.cc.o.d"
+  "/root/repo/source/tnn/device/x86/x86_context.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/x86_context.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/x86_context.cc.o.d"
+  "/root/repo/source/tnn/device/x86/x86_device.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/x86_device.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/x86_device.cc.o.d"
+  "/root/repo/source/tnn/device/x86/x86_mat_converter.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/x86_mat_converter.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/x86_mat_converter.cc.o.d"
+  "/root/repo/source/tnn/device/x86/x86_mat_util.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/x86_mat_util.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/x86_mat_util.cc.o.d"
+  "/root/repo/source/tnn/device/x86/x86_util.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/x86_util.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/x86_util.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,9 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/unit_test
+# Build directory: /root/repo/_xbuild/test/unit_test
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(unit_test "/root/repo/_xbuild/test/unit_test/unit_test")
+set_tests_properties(unit_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/unit_test/CMakeLists.txt;36;add_test;/root/repo/test/unit_test/CMakeLists.txt;0;")
+subdirs("third_party/googletest")
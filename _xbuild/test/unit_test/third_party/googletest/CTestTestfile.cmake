@@ -0,0 +1,7 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/unit_test/third_party/googletest
+# Build directory: /root/repo/_xbuild/test/unit_test/third_party/googletest
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("googlemock")
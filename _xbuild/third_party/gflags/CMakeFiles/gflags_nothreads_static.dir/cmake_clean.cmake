@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/gflags_nothreads_static.dir/src/gflags.cc.o"
+  "CMakeFiles/gflags_nothreads_static.dir/src/gflags.cc.o.d"
+  "CMakeFiles/gflags_nothreads_static.dir/src/gflags_completions.cc.o"
+  "CMakeFiles/gflags_nothreads_static.dir/src/gflags_completions.cc.o.d"
+  "CMakeFiles/gflags_nothreads_static.dir/src/gflags_reporting.cc.o"
+  "CMakeFiles/gflags_nothreads_static.dir/src/gflags_reporting.cc.o.d"
+  "libgflags_nothreads.a"
+  "libgflags_nothreads.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/gflags_nothreads_static.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -121,7 +121,10 @@ typedef enum {
     SHARE_MEMORY_MODE_SHARE_ONE_THREAD = 1,
     // set blob memory from external, different thread share blob memory need
     // synchronize
-    SHARE_MEMORY_MODE_SET_FROM_EXTERNAL = 2
+    SHARE_MEMORY_MODE_SET_FROM_EXTERNAL = 2,
+    // tnn instances of all threads lease blob memory from a pool of the device
+    // during forward, input and output blobs are not shared
+    SHARE_MEMORY_MODE_SHARE_POOL = 3
 } ShareMemoryMode;
 
 typedef enum {
@@ -167,6 +170,24 @@ struct PUBLIC NetworkConfig {
     // network init or reshape may cost more time to select opt kernel implement if enable tune kernel
     // cache_path can set to store tune kernel info.
     bool enable_tune_kernel = false;
+
+    // numa node to run x86 instance on, -1 for no binding. threads of the instance run on the cpus
+    // of the node, blob memory and packed weights are allocated on the node, and packed weights are
+    // shared by the instances of the same model on the node.
+    int numa_node = -1;
+
+    // back large blob memory, workspaces and packed weights of the instance with huge pages,
+    // only works on linux with transparent huge pages.
+    bool enable_huge_page = false;
+
+    // keep the hidden and cell states of recurrent layers across Forward calls to run a stream in chunks,
+    // the states are reset, saved and restored with the recurrent state api of Instance. x86 only.
+    bool enable_recurrent_state = false;
+
+    // run chains of conv, pooling and activation layers on large inputs row tile by row tile, so that the
+    // working set of a tile stays in cache and the activations inside the chain are never allocated.
+    // x86 and naive with float precision only.
+    bool enable_tiled_execution = false;
 };
 
 struct PUBLIC ModelConfig {
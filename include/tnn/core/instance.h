@@ -54,7 +54,15 @@ public:
     // deinit, release network
     Status DeInit();
 
+    // create an instance of the same model and config from this initialized instance. the clone shares the
+    // optimized model and the weights packed for the device, only the blobs, workspace and context are created
+    // for it. instances with folded constants or other network types are initialized from the model again
+    std::shared_ptr<Instance> Clone(Status& status);
+
     //  return memory bytes required for forward
+    Status GetForwardMemorySize(int64_t& memory_size);
+
+    //  return memory bytes required for forward, fails if the size exceeds INT_MAX
     Status GetForwardMemorySize(int& memory_size);
 
     //  set memory to tnn instance. if success, return status code zero.
@@ -100,6 +108,23 @@ public:
     // set threads run on cpu
     Status SetCpuNumThreads(int num_threads);
 
+    // recurrent layers keep their states across Forward calls with NetworkConfig.enable_recurrent_state.
+    // reset the states to zero to start a new stream
+    Status ResetRecurrentState();
+
+    // copy the recurrent states out to switch streams, mats are named by layer_name/state_name
+    Status GetRecurrentState(MatMap& states);
+
+    // restore recurrent states copied by GetRecurrentState
+    Status SetRecurrentState(const MatMap& states);
+
+    // replace the weights with the ones of a retrained .tnnmodel without re-initialization. the model must
+    // have the same structure and resource layout as the one the instance is created from. forward keeps running
+    // on the old weights while the new ones are packed, and only waits while they are switched at once. reshape
+    // must not run meanwhile. the instance keeps the old weights on failure. networks with folded constants or
+    // int8 quantization are not supported
+    Status UpdateModel(std::string model_content);
+
 #if TNN_PROFILE
 public:
     /**start to profile each layer, dont call this func if you only want to profile the whole mode*/
@@ -110,10 +135,14 @@ public:
 
 private:
     std::shared_ptr<AbstractModelInterpreter> interpreter_ = nullptr;
+    // unoptimized interpreter the instance is created from, the model updates are checked against it
+    std::shared_ptr<AbstractModelInterpreter> source_interpreter_ = nullptr;
     std::shared_ptr<AbstractNetwork> network_ = nullptr;
     std::shared_ptr<AbstractNetwork> const_folder_ = nullptr;
     NetworkConfig net_config_;
     ModelConfig model_config_;
+    InputShapesMap min_inputs_shape_;
+    InputShapesMap max_inputs_shape_;
     
     AbstractNetwork *GetNetwork();
     
@@ -123,6 +152,13 @@ public:
     Status SetInputMat(std::shared_ptr<Mat> mat,
                        MatConvertParam param,
                        std::string input_name = "");
+
+    // set input Mat with crop and resize or warp affine and color conversion fused into the conversion,
+    // the mat size can differ from the input size. if input_name is not set, take the first input as default
+    Status SetInputMatWithPreprocess(std::shared_ptr<Mat> mat,
+                                     MatPreprocessParam preprocess,
+                                     MatConvertParam param,
+                                     std::string input_name = "");
     
     // get output Mat, if output_name is not set, take the first output as default
     Status GetOutputMat(std::shared_ptr<Mat>& mat,
@@ -131,6 +167,8 @@ public:
                         DeviceType device = DEVICE_ARM, MatType mat_type = NCHW_FLOAT);
     
 private:
+    Status GetInputConverter(std::string& input_name, std::shared_ptr<BlobConverter>& blob_converter);
+
     // input converter
     std::map<std::string, std::shared_ptr<BlobConverter>> input_converters_ = {};
 
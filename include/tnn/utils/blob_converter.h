@@ -23,6 +23,7 @@
 #include "tnn/core/mat.h"
 #include "tnn/core/macro.h"
 #include "tnn/core/status.h"
+#include "tnn/utils/mat_utils.h"
 
 #pragma warning(push)
 #pragma warning(disable : 4251)
@@ -36,6 +37,18 @@ struct PUBLIC MatConvertParam {
     bool reverse_channel     = false;
 };
 
+// geometry of the image sampled into the blob, applied before scale and bias
+struct PUBLIC MatPreprocessParam {
+    // region of the image resized to the blob height and width. width or height 0 for the rest of the image
+    // from top_left_x or top_left_y
+    CropParam crop;
+    InterpType interp_type = INTERP_TYPE_LINEAR;
+    // sample the image through the affine transform instead of crop and resize.
+    // BORDER_TYPE_CONSTANT and BORDER_TYPE_EDGE are supported.
+    bool warp_affine = false;
+    WarpAffineParam warp_affine_param;
+};
+
 class BlobConverterAcc;
 class PUBLIC BlobConverter {
 public:
@@ -46,6 +59,12 @@ public:
     Status ConvertToMatAsync(Mat& image, MatConvertParam param, void* command_queue);
     Status ConvertFromMatAsync(Mat& image, MatConvertParam param, void* command_queue);
 
+    // @brief crop and resize or warp affine, color conversion, scale and bias into the blob in one pass,
+    // without intermediate mats on devices with a fused implementation. nv12 and nv21 images are converted
+    // to bgr, color images are converted to gray for blobs with one channel.
+    Status ConvertFromMatWithPreprocess(Mat& image, MatPreprocessParam preprocess, MatConvertParam param,
+                                        void* command_queue);
+
 private:
     Blob* blob_ = nullptr;
     std::shared_ptr<BlobConverterAcc> impl_ = nullptr;
@@ -59,6 +59,14 @@ Status AbstractLayerAcc::ReloadConstantBlobs(const std::vector<Blob *> &inputs,
     return TNN_OK;
 }
 
+Status AbstractLayerAcc::GetRecurrentStates(std::map<std::string, RawBuffer *> &states) {
+    return TNN_OK;
+}
+
+int AbstractLayerAcc::GetInplaceInputIndex(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return -1;
+}
+
 Status AbstractLayerAcc::AllocateRuntimeOutputBlob(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     //runtime blob allocate
     for (auto iter : outputs) {
@@ -93,6 +93,13 @@ public:
 
     // @brief decide Blob Data Format based on support data format list
     virtual Status ResolveBlobDataFormat(Blob *blob, BlobType blob_type);
+
+    // @brief states kept by recurrent layers across forward calls, by state name. empty for other layers
+    virtual Status GetRecurrentStates(std::map<std::string, RawBuffer *> &states);
+
+    // @brief index of the input blob whose memory the output may take over if the layer is the last reader of it,
+    // -1 if the acc can not run in place
+    virtual int GetInplaceInputIndex(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
     
     // @brief set runtime bolob pool
     void SetRuntimeBlobMemoryPool(BlobMemoryPool *runtime_blob_pool);
@@ -123,6 +130,8 @@ protected:
     ConstantResourceFlag *const_resource_flag_ = nullptr;
     
     std::map<std::string, std::shared_ptr<Blob> > const_blob_map_ = {};
+    // constants the blobs of const_blob_map_ read in place, kept alive while the blobs point to them
+    ConstantResource const_buffer_map_ = {};
     RuntimeMode runtime_model_ = RUNTIME_MODE_NORMAL;
 };
 
@@ -33,6 +33,18 @@ Status AbstractNetwork::SetCpuNumThreads(int num_threads) {
     return TNN_OK;
 }
 
+Status AbstractNetwork::ResetRecurrentState() {
+    return Status(TNNERR_COMMON_ERROR, "recurrent state is not supported by the network");
+}
+
+Status AbstractNetwork::GetRecurrentState(MatMap &states) {
+    return Status(TNNERR_COMMON_ERROR, "recurrent state is not supported by the network");
+}
+
+Status AbstractNetwork::SetRecurrentState(const MatMap &states) {
+    return Status(TNNERR_COMMON_ERROR, "recurrent state is not supported by the network");
+}
+
 #if TNN_PROFILE
 void AbstractNetwork::StartProfile() {
     LOGI("subclass should implement the func: StartProfile\n");
@@ -48,7 +48,7 @@ public:
     //  forward
     //  @return error code: If successful, returns zero. Otherwise, returns
     //  an error code.
-    virtual Status GetForwardMemorySize(int &memory_size) = 0;
+    virtual Status GetForwardMemorySize(int64_t &memory_size) = 0;
 
     //  @brief: set memory used by the tnn instance without forward
     //  memory, the memory size must be at least that returned by
@@ -93,6 +93,15 @@ public:
     // @brief set threads run on device
     virtual Status SetCpuNumThreads(int num_threads);
 
+    // @brief zero the states kept by recurrent layers to start a new stream
+    virtual Status ResetRecurrentState();
+
+    // @brief copy of the states kept by recurrent layers, by layer name and state name
+    virtual Status GetRecurrentState(MatMap &states);
+
+    // @brief restore the states kept by recurrent layers from a copy
+    virtual Status SetRecurrentState(const MatMap &states);
+
 #if TNN_PROFILE
 public:
     virtual void StartProfile();
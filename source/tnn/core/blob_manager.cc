@@ -24,6 +24,7 @@
 #include "tnn/memory_manager/memory_seperate_assign_strategy.h"
 #include "tnn/memory_manager/memory_unify_assign_strategy.h"
 #include "tnn/utils/dims_utils.h"
+#include "tnn/utils/huge_page_utils.h"
 #include "tnn/utils/data_flag_utils.h"
 
 namespace TNN_NS {
@@ -38,6 +39,10 @@ BlobManager::BlobManager(AbstractDevice *device) {
     }
     net_structure_     = nullptr;
     memory_mode_state_ = nullptr;
+    io_blob_memory_pool_   = nullptr;
+    leased_forward_memory_ = nullptr;
+    bound_forward_memory_  = nullptr;
+    pool_instance_added_   = false;
 }
 
 BlobManager::~BlobManager() {
@@ -49,6 +54,10 @@ BlobManager::~BlobManager() {
             blob_memory_pool_iter.second = nullptr;
         }
     }
+    if (io_blob_memory_pool_ != nullptr) {
+        delete io_blob_memory_pool_;
+        io_blob_memory_pool_ = nullptr;
+    }
 }
 
 static void UpdateDeviceInputDataFormat(NetworkConfig &config, Blob *input, const DeviceType &type,
@@ -156,6 +165,16 @@ Status BlobManager::Init(NetworkConfig &config, NetStructure *net_structure, Inp
 Status BlobManager::AllocateBlobMemory(int flag) {
     const auto &input_shapes_map = net_structure_->inputs_shape_map;
 
+    // in share pool mode, the memory of input and output blobs is owned by the instance,
+    // users set inputs before forward and get outputs after forward when the pool memory is returned.
+    const bool share_pool = config_.share_memory_mode == SHARE_MEMORY_MODE_SHARE_POOL;
+    if (share_pool && io_blob_memory_pool_ == nullptr) {
+        if (blob_memory_pool_map_.size() > 1) {
+            return Status(TNNERR_SHARE_MEMORY_MODE_NOT_SUPPORT, "share pool mode only supports 1d blob memory");
+        }
+        io_blob_memory_pool_ = BlobMemoryPoolFactory::CreateBlobMemoryPool(device_);
+    }
+
     for (auto iter : input_shapes_map) {
         std::string current_blob_name = iter.first;
         Blob *current_blob            = blobs_[current_blob_name];
@@ -165,12 +184,17 @@ Status BlobManager::AllocateBlobMemory(int flag) {
         }
         // todo. need refactor
         BlobMemorySizeInfo info = device_->Calculate(current_blob->GetBlobDesc());
+        if (GetBlobMemoryBytesSize(info) < 0) {
+            LOGE("blob memory size is out of range, name:%s\n", current_blob_name.c_str());
+            return Status(TNNERR_PARAM_ERR, "blob memory size is out of range");
+        }
         if (info.dims.size() > 1 && config_.share_memory_mode != SHARE_MEMORY_MODE_DEFAULT) {
             return Status(TNNERR_SHARE_MEMORY_MODE_NOT_SUPPORT, "share_memory_mode option is unsupported");
         }
         int use_count           = 1;
         BlobMemory *blob_memory = NULL;
-        blob_memory             = blob_memory_pool_map_[info.dims.size()]->BorrowBlobMemory(use_count, info, true);
+        auto memory_pool        = share_pool ? io_blob_memory_pool_ : blob_memory_pool_map_[info.dims.size()];
+        blob_memory             = memory_pool->BorrowBlobMemory(use_count, info, true);
         blob_memory_mapping_.insert(std::make_pair(current_blob, blob_memory));
     }
 
@@ -183,7 +207,7 @@ Status BlobManager::AllocateBlobMemory(int flag) {
         // allocating blob memory for every out nodes of this layer
         for (auto current_blob_name : layer_info->outputs) {
             Blob *current_blob = blobs_[current_blob_name];
-            if (current_blob->NeedAllocateInForward() ||
+            if (current_blob->NeedAllocateInForward() || tiled_blobs_.count(current_blob_name) > 0 ||
                 DataFlagUtils::ChangeStatus(current_blob->GetFlag()) != DataFlagUtils::ChangeStatus(flag)) {
                 continue;
             }
@@ -199,8 +223,23 @@ Status BlobManager::AllocateBlobMemory(int flag) {
                 int use_count = GetBlobUseCount(layer_index, current_blob_name);
 
                 BlobMemorySizeInfo info = device_->Calculate(current_blob->GetBlobDesc());
-                // find an available BlobMemory
-                BlobMemory *blob_memory = blob_memory_pool_map_[info.dims.size()]->BorrowBlobMemory(use_count, info, false);
+                if (GetBlobMemoryBytesSize(info) < 0) {
+                    LOGE("blob memory size is out of range, name:%s\n", current_blob_name.c_str());
+                    return Status(TNNERR_PARAM_ERR, "blob memory size is out of range");
+                }
+                // the memory of the input is refunded below when this layer is its last reader
+                BlobMemory *inplace_memory = GetInplaceBlobMemory(current_blob_name, info, flag);
+                if (inplace_memory) {
+                    inplace_memory->SetUseCount(inplace_memory->GetUseCount() + use_count);
+                    blob_memory_mapping_.insert(std::make_pair(current_blob, inplace_memory));
+                    continue;
+                }
+
+                // find an available BlobMemory, output blobs are never refunded
+                auto memory_pool = (share_pool && net_structure_->outputs.count(current_blob_name) > 0)
+                                       ? io_blob_memory_pool_
+                                       : blob_memory_pool_map_[info.dims.size()];
+                BlobMemory *blob_memory = memory_pool->BorrowBlobMemory(use_count, info, false);
                 blob_memory_mapping_.insert(std::make_pair(current_blob, blob_memory));
             }
         }
@@ -208,7 +247,7 @@ Status BlobManager::AllocateBlobMemory(int flag) {
         // refund the input blob memory
         for (auto current_blob_name : layer_info->inputs) {
             Blob *current_blob = blobs_[current_blob_name];
-            if (current_blob->NeedAllocateInForward() ||
+            if (current_blob->NeedAllocateInForward() || tiled_blobs_.count(current_blob_name) > 0 ||
                 DataFlagUtils::ChangeStatus(current_blob->GetFlag()) != DataFlagUtils::ChangeStatus(flag)) {
                 continue;
             }
@@ -242,7 +281,7 @@ Status BlobManager::AllocateBlobMemory(int flag) {
             // The share_on_thread strategy may share memory of different models-
             // within the same thread.
             for (auto blob_memory_pool_iter : blob_memory_pool_map_) {
-                int forward_memory_size   = blob_memory_pool_iter.second->GetAllBlobMemorySize();
+                int64_t forward_memory_size = blob_memory_pool_iter.second->GetAllBlobMemorySize();
                 SharedMemory share_memory = SharedMemoryManager::GetSharedMemory(
                         forward_memory_size, init_thread_id_, device_,
                         config_.device_id, this, status);
@@ -254,12 +293,59 @@ Status BlobManager::AllocateBlobMemory(int flag) {
             }
             BREAK_IF(status != TNN_OK);
             BindBlobMemory();
+        } else if (share_pool) {
+            // The share_pool strategy leases the memory of the other blobs in forward.
+            MemorySeperateAssignStrategy strategy;
+            status = io_blob_memory_pool_->AssignAllBlobMemory(strategy);
+            BREAK_IF(status != TNN_OK);
+            if (!pool_instance_added_) {
+                SharedMemoryManager::AddPoolInstance(device_, config_.device_id);
+                pool_instance_added_ = true;
+            }
+            BindBlobMemory();
         }
     } while (0);
 
     return status;
 }
 
+void BlobManager::SetInplaceBlobs(const std::map<std::string, std::string> &inplace_blobs) {
+    inplace_blobs_ = inplace_blobs;
+}
+
+void BlobManager::SetTiledBlobs(const std::set<std::string> &tiled_blobs) {
+    tiled_blobs_ = tiled_blobs;
+}
+
+BlobMemory *BlobManager::GetInplaceBlobMemory(const std::string &output_name, BlobMemorySizeInfo &info, int flag) {
+    auto iter = inplace_blobs_.find(output_name);
+    if (iter == inplace_blobs_.end()) {
+        return nullptr;
+    }
+    const std::string &input_name = iter->second;
+    // memory of the network inputs and outputs is kept for the user
+    if (net_structure_->outputs.count(output_name) > 0 || net_structure_->outputs.count(input_name) > 0 ||
+        net_structure_->inputs_shape_map.count(input_name) > 0 || blobs_.count(input_name) == 0) {
+        return nullptr;
+    }
+
+    Blob *input_blob = blobs_[input_name];
+    if (input_blob->NeedAllocateInForward() ||
+        DataFlagUtils::ChangeStatus(input_blob->GetFlag()) != DataFlagUtils::ChangeStatus(flag)) {
+        return nullptr;
+    }
+    auto memory_iter = blob_memory_mapping_.find(input_blob);
+    if (memory_iter == blob_memory_mapping_.end() || memory_iter->second->GetUseCount() != 1) {
+        return nullptr;
+    }
+
+    BlobMemorySizeInfo input_info = device_->Calculate(input_blob->GetBlobDesc());
+    if (input_info.data_type != info.data_type || input_info.dims != info.dims) {
+        return nullptr;
+    }
+    return memory_iter->second;
+}
+
 /*
  * This function calculate the use count of the given blob.
  * output layer is regarded as an additional reference.
@@ -287,6 +373,11 @@ Status BlobManager::DeInit() {
     if(shared_memory_allocated_) {
     	SharedMemoryManager::ReleaseSharedMemory(init_thread_id_, device_, config_.device_id, this);
     }
+    if (pool_instance_added_) {
+        ReturnForwardMemory();
+        SharedMemoryManager::RemovePoolInstance(device_, config_.device_id);
+        pool_instance_added_ = false;
+    }
 
     for (auto blob : blobs_) {
         delete blob.second;
@@ -307,6 +398,42 @@ void BlobManager::OnSharedForwardMemoryChanged(void *memory) {
     BindBlobMemory();
 }
 
+Status BlobManager::LeaseForwardMemory() {
+    if (config_.share_memory_mode != SHARE_MEMORY_MODE_SHARE_POOL || leased_forward_memory_ != nullptr) {
+        return TNN_OK;
+    }
+    int64_t forward_memory_size = blob_memory_pool_map_[1]->GetAllBlobMemorySize();
+    if (forward_memory_size <= 0) {
+        return TNN_OK;
+    }
+
+    HugePageScope huge_page_scope(config_.enable_huge_page);
+    void *memory  = nullptr;
+    Status status = SharedMemoryManager::LeaseForwardMemory(forward_memory_size, device_, config_.device_id, &memory);
+    RETURN_ON_NEQ(status, TNN_OK);
+    leased_forward_memory_ = memory;
+
+    // blobs are bound again only if another memory of the pool is leased
+    if (memory != bound_forward_memory_) {
+        MemoryUnifyAssignStrategy strategy(memory);
+        status = blob_memory_pool_map_[1]->AssignAllBlobMemory(strategy);
+        if (status != TNN_OK) {
+            ReturnForwardMemory();
+            return status;
+        }
+        BindBlobMemory();
+        bound_forward_memory_ = memory;
+    }
+    return TNN_OK;
+}
+
+void BlobManager::ReturnForwardMemory() {
+    if (leased_forward_memory_ != nullptr) {
+        SharedMemoryManager::ReturnForwardMemory(leased_forward_memory_, device_, config_.device_id);
+        leased_forward_memory_ = nullptr;
+    }
+}
+
 /*
  * Blob memory may be allocated by the user.
  * The total size required is given by GetAllBlobMemorySize().
@@ -341,8 +468,8 @@ void BlobManager::BindBlobMemory() {
     }
 }
 
-int BlobManager::GetAllBlobMemorySize() {
-    int mem_size_all_blob = 0;
+int64_t BlobManager::GetAllBlobMemorySize() {
+    int64_t mem_size_all_blob = 0;
     for (auto blob_memory_pool_iter : blob_memory_pool_map_) {
         mem_size_all_blob += blob_memory_pool_iter.second->GetAllBlobMemorySize();
     }
@@ -17,12 +17,14 @@
 
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <thread>
 
 #include "tnn/core/abstract_device.h"
 #include "tnn/core/blob.h"
 #include "tnn/core/common.h"
+#include "tnn/core/context.h"
 #include "tnn/core/status.h"
 #include "tnn/interpreter/net_structure.h"
 #include "tnn/memory_manager/blob_memory.h"
@@ -59,6 +61,17 @@ public:
     // @brief set blob forward memory
     virtual Status SetForwardMemory(void *memory);
 
+    // @brief lease forward memory from the shared pool, only for SHARE_MEMORY_MODE_SHARE_POOL
+    Status LeaseForwardMemory();
+
+    // @brief return the leased forward memory to the shared pool
+    void ReturnForwardMemory();
+
+    // @brief whether forward memory is leased from the shared pool
+    bool IsForwardMemoryLeased() {
+        return leased_forward_memory_ != nullptr;
+    }
+
     // @brief get all input blobs
     // @param blobs blob map
     virtual Status GetAllInputBlobs(BlobMap &blobs);
@@ -70,11 +83,19 @@ public:
     // @brief AllocateBlobMemory for blob with flag
     virtual Status AllocateBlobMemory(int flag = DATA_FLAG_CHANGE_ALWAYS);
 
+    // @brief output blobs which may take over the memory of an input blob, by name. the memory is shared only
+    // if the layer is the last reader of the input and both blobs need the same memory size
+    void SetInplaceBlobs(const std::map<std::string, std::string> &inplace_blobs);
+
+    // @brief blobs inside the chains run by the tiled executor, they only live in the tile buffers and get no
+    // memory from the blob manager
+    void SetTiledBlobs(const std::set<std::string> &tiled_blobs);
+
     // @brief OnSharedForwardMemoryChanged for share memory change observer
     virtual void OnSharedForwardMemoryChanged(void *memory);
 
     // @brief get all blob memory size
-    int GetAllBlobMemorySize();
+    int64_t GetAllBlobMemorySize();
 
     // @brief replace blob with new_blob, and delete the original blob if exist
     void ReplaceBlob(std::string name, Blob *new_blob);
@@ -82,6 +103,7 @@ public:
 protected:
     void BindBlobMemory();
     int GetBlobUseCount(int layer_index, std::string current_blob_name);
+    BlobMemory *GetInplaceBlobMemory(const std::string &output_name, BlobMemorySizeInfo &info, int flag);
 
     NetworkConfig config_;
     NetStructure *net_structure_;
@@ -93,12 +115,45 @@ protected:
     std::shared_ptr<MemoryAssignStrategy> strategy_;
     std::map<std::string, Blob *> blobs_;
     std::map<Blob *, BlobMemory *> blob_memory_mapping_;
+    std::map<std::string, std::string> inplace_blobs_;
+    std::set<std::string> tiled_blobs_;
     bool shared_memory_allocated_;
 
+    // memory of input and output blobs in share pool mode
+    BlobMemoryPool *io_blob_memory_pool_;
+    void *leased_forward_memory_;
+    void *bound_forward_memory_;
+    bool pool_instance_added_;
+
     std::thread::id init_thread_id_;
     MemoryModeState *memory_mode_state_;
 };
 
+// @brief lease the forward memory of blob_manager in the scope, the memory is returned
+// after the context is synchronized. it does nothing if not in SHARE_MEMORY_MODE_SHARE_POOL.
+class ForwardMemoryLease {
+public:
+    ForwardMemoryLease(BlobManager *blob_manager, Context *context) : blob_manager_(blob_manager), context_(context) {
+        status_ = blob_manager_->LeaseForwardMemory();
+    }
+
+    ~ForwardMemoryLease() {
+        if (blob_manager_->IsForwardMemoryLeased()) {
+            context_->Synchronize();
+            blob_manager_->ReturnForwardMemory();
+        }
+    }
+
+    Status GetStatus() {
+        return status_;
+    }
+
+private:
+    BlobManager *blob_manager_;
+    Context *context_;
+    Status status_;
+};
+
 }  // namespace TNN_NS
 
 #endif  // TNN_SOURCE_TNN_CORE_BLOB_MANAGER_H_
@@ -15,6 +15,8 @@
 #include "tnn/core/const_folder.h"
 
 #include <string.h>
+#include <map>
+#include <mutex>
 #include <sstream>
 
 #include "tnn/core/blob_int8.h"
@@ -32,6 +34,60 @@
 
 namespace TNN_NS {
 
+struct SharedConstantKey {
+    DataType data_type;
+    DimsVector dims;
+    int64_t bytes;
+    uint64_t digest;
+
+    bool operator<(const SharedConstantKey &other) const {
+        if (data_type != other.data_type) {
+            return data_type < other.data_type;
+        }
+        if (bytes != other.bytes) {
+            return bytes < other.bytes;
+        }
+        if (digest != other.digest) {
+            return digest < other.digest;
+        }
+        return dims < other.dims;
+    }
+};
+
+static std::mutex g_shared_constant_mutex;
+static std::map<SharedConstantKey, std::weak_ptr<RawBuffer>> g_shared_constants;
+
+// every instance folds the constants of the model again, equal results are kept in one immutable buffer
+// shared by the instances
+static std::shared_ptr<RawBuffer> ShareConstant(std::shared_ptr<RawBuffer> buffer) {
+    const int64_t bytes = buffer->GetBytesSize64();
+    const auto data     = buffer->force_to<unsigned char *>();
+    if (bytes <= 0 || data == nullptr) {
+        return buffer;
+    }
+
+    // fnv-1a
+    uint64_t digest = 14695981039346656037ULL;
+    for (int64_t i = 0; i < bytes; i++) {
+        digest = (digest ^ data[i]) * 1099511628211ULL;
+    }
+    SharedConstantKey key = {buffer->GetDataType(), buffer->GetBufferDims(), bytes, digest};
+
+    std::lock_guard<std::mutex> guard(g_shared_constant_mutex);
+    auto iter = g_shared_constants.find(key);
+    if (iter != g_shared_constants.end()) {
+        auto shared = iter->second.lock();
+        if (shared) {
+            return memcmp(shared->force_to<void *>(), data, bytes) == 0 ? shared : buffer;
+        }
+    }
+    for (auto it = g_shared_constants.begin(); it != g_shared_constants.end();) {
+        it = it->second.expired() ? g_shared_constants.erase(it) : std::next(it);
+    }
+    g_shared_constants[key] = buffer;
+    return buffer;
+}
+
 ConstFolder::ConstFolder() {
     runtime_model_ = RUNTIME_MODE_CONST_FOLD;
 }
@@ -79,9 +135,67 @@ Status ConstFolder::Reshape(const InputShapesMap& inputs_shape) {
     if(!shape_changed) {
         return ret;
     }
+    if (shape_program_) {
+        ret = shape_program_->Run(GetInputShapes(), net_resource_->constant_map);
+        if (ret == TNN_OK) {
+            return ret;
+        }
+        LOGD("ConstFolder shape program failed: %s, forward the layers instead\n", ret.description().c_str());
+    }
     return Forward();
 }
 
+Status ConstFolder::EnableShapeProgram() {
+    shape_program_ = nullptr;
+
+    // blobs of flag DATA_FLAG_CHANGE_IF_SHAPE_DIFFER are the only constants changed by Reshape
+    std::set<std::string> targets;
+    for (auto iter : net_resource_->constant_blob_flags) {
+        if (DataFlagUtils::ChangeStatus(iter.second) == DATA_FLAG_CHANGE_IF_SHAPE_DIFFER) {
+            targets.insert(iter.first);
+        }
+    }
+
+    auto program = std::make_shared<ShapeProgram>();
+    auto status  = program->Compile(net_structure_, net_resource_, blob_manager_, targets);
+    if (status != TNN_OK) {
+        LOGD("ConstFolder shape program is disabled: %s\n", status.description().c_str());
+        return TNN_OK;
+    }
+
+    // the program must reproduce the constants forwarded for the current shapes
+    ConstantResource constant_map;
+    status = program->Run(GetInputShapes(), constant_map);
+    if (status != TNN_OK) {
+        LOGD("ConstFolder shape program is disabled: %s\n", status.description().c_str());
+        return TNN_OK;
+    }
+    for (auto iter : constant_map) {
+        auto expected_iter = net_resource_->constant_map.find(iter.first);
+        auto expected = expected_iter == net_resource_->constant_map.end() ? nullptr : expected_iter->second;
+        if (!expected || expected->GetDataType() != DATA_TYPE_INT32 ||
+            !DimsVectorUtils::Equal(expected->GetBufferDims(), iter.second->GetBufferDims()) ||
+            expected->GetBytesSize() != iter.second->GetBytesSize() ||
+            memcmp(expected->force_to<void *>(), iter.second->force_to<void *>(), expected->GetBytesSize()) != 0) {
+            LOGD("ConstFolder shape program is disabled, blob %s mismatch\n", iter.first.c_str());
+            return TNN_OK;
+        }
+    }
+
+    shape_program_ = program;
+    return TNN_OK;
+}
+
+BlobShapesMap ConstFolder::GetInputShapes() {
+    BlobShapesMap input_shapes;
+    BlobMap input_blobs;
+    blob_manager_->GetAllInputBlobs(input_blobs);
+    for (auto iter : input_blobs) {
+        input_shapes[iter.first] = iter.second->GetBlobDesc().dims;
+    }
+    return input_shapes;
+}
+
 Status ConstFolder::Forward() {  
     auto status = DefaultNetwork::Forward();
     RETURN_ON_NEQ(status, TNN_OK);
@@ -130,6 +244,7 @@ Status ConstFolder::Forward() {
                 std::shared_ptr<RawBuffer> buffer = nullptr;
                 status= Blob2RawBuffer(blob, buffer);
                 RETURN_ON_NEQ(status, TNN_OK);
+                buffer = ShareConstant(buffer);
                 
 #ifdef DEBUG
                 {
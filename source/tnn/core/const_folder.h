@@ -26,6 +26,7 @@
 #include "tnn/core/default_network.h"
 #include "tnn/core/macro.h"
 #include "tnn/core/profile.h"
+#include "tnn/core/shape_program.h"
 #include "tnn/core/status.h"
 #include "tnn/interpreter/abstract_model_interpreter.h"
 #include "tnn/interpreter/layer_resource.h"
@@ -61,11 +62,19 @@ public:
     // fold for new inputs shape
     Status Reshape(const InputShapesMap& inputs_shape);
 
+    // @brief evaluate the shape subgraph with ShapeProgram in Reshape instead of forwarding all layers. it is
+    // ignored if the program does not support some layers, it must be called after Forward
+    Status EnableShapeProgram();
+
 protected:
     virtual Status AllocateBlobMemory();
 
 private:
     virtual Status Forward();
+
+    BlobShapesMap GetInputShapes();
+
+    std::shared_ptr<ShapeProgram> shape_program_ = nullptr;
 };
 
 }  // namespace TNN_NS
@@ -78,6 +78,30 @@ std::string Context::GetCacheFilePath() {
     return cache_file_path_;
 }
 
+void Context::SetNumaNode(int numa_node) {
+    numa_node_ = numa_node;
+}
+
+int Context::GetNumaNode() {
+    return numa_node_;
+}
+
+void Context::SetEnableHugePage(bool enable_huge_page) {
+    enable_huge_page_ = enable_huge_page;
+}
+
+bool Context::GetEnableHugePage() {
+    return enable_huge_page_;
+}
+
+void Context::SetEnableRecurrentState(bool enable_recurrent_state) {
+    enable_recurrent_state_ = enable_recurrent_state;
+}
+
+bool Context::GetEnableRecurrentState() {
+    return enable_recurrent_state_;
+}
+
 #if TNN_PROFILE
 void Context::StartProfile() {
     profile_layer     = true;
@@ -75,6 +75,18 @@ public:
 
     std::string GetCacheFilePath();
 
+    void SetNumaNode(int numa_node);
+
+    int GetNumaNode();
+
+    void SetEnableHugePage(bool enable_huge_page);
+
+    bool GetEnableHugePage();
+
+    void SetEnableRecurrentState(bool enable_recurrent_state);
+
+    bool GetEnableRecurrentState();
+
 #if TNN_PROFILE
 public:
     virtual void StartProfile();
@@ -92,6 +104,9 @@ protected:
     bool enable_tune_kernel_ = true;
     std::string cache_path_ = ""; // dir to save cache files
     std::string cache_file_path_ = "";
+    int numa_node_ = -1;
+    bool enable_huge_page_ = false;
+    bool enable_recurrent_state_ = false;
 };
 
 }  // namespace TNN_NS
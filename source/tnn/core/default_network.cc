@@ -28,7 +28,10 @@
 #include "tnn/utils/cpu_utils.h"
 #include "tnn/utils/data_flag_utils.h"
 #include "tnn/utils/dims_utils.h"
+#include "tnn/utils/huge_page_utils.h"
 #include "tnn/utils/md5.h"
+#include "tnn/utils/numa_utils.h"
+#include "tnn/utils/string_format.h"
 #include "tnn/utils/string_utils_inner.h"
 
 namespace TNN_NS {
@@ -89,6 +92,17 @@ Status DefaultNetwork::Init(NetworkConfig &net_config, ModelConfig &model_config
     context_->SetPrecision(net_config.precision);
     context_->SetEnableTuneKernel(net_config.enable_tune_kernel);
 
+    if (net_config.numa_node >= NumaNodeCount()) {
+        LOGE("ERROR: numa node %d is out of range [0, %d)\n", net_config.numa_node, NumaNodeCount());
+        return Status(TNNERR_PARAM_ERR, "numa node is out of range");
+    }
+    context_->SetNumaNode(net_config.numa_node);
+    // packed weights and blob memory allocated in init are placed on the numa node
+    NumaMemoryScope numa_memory_scope(net_config.numa_node);
+    context_->SetEnableHugePage(net_config.enable_huge_page);
+    context_->SetEnableRecurrentState(net_config.enable_recurrent_state);
+    HugePageScope huge_page_scope(net_config.enable_huge_page);
+
     if(!net_config.cache_path.empty()) {
         auto params_md5 = default_interpreter->GetParamsMd5();
         if (params_md5.size() < 1) {
@@ -106,7 +120,7 @@ Status DefaultNetwork::Init(NetworkConfig &net_config, ModelConfig &model_config
      * The optimization process may change the network structure accoundingly.
      * eg. fuse conv+bn, conv+relu.
      */
-    if (runtime_model_ == RUNTIME_MODE_NORMAL) {
+    if (runtime_model_ == RUNTIME_MODE_NORMAL && !skip_optimize_) {
         // use mutex to protect net_resource and net_structure in multi-thread
         std::unique_lock<std::mutex> lck(optimize_mtx_);
         ret = optimizer::NetOptimizerManager::Optimize(net_structure, net_resource, net_config);
@@ -121,6 +135,13 @@ Status DefaultNetwork::Init(NetworkConfig &net_config, ModelConfig &model_config
     ret = InitLayers(net_structure, net_resource);
     RETURN_ON_NEQ(ret, TNN_OK);
 
+    if (net_config.enable_tiled_execution && runtime_model_ == RUNTIME_MODE_NORMAL) {
+        tiled_executor_ = new TiledExecutor();
+        ret = tiled_executor_->Init(context_, device_, net_structure, net_resource, layers_);
+        RETURN_ON_NEQ(ret, TNN_OK);
+        blob_manager_->SetTiledBlobs(tiled_executor_->GetTiledBlobs());
+    }
+
     ret = AllocateBlobMemory();
     RETURN_ON_NEQ(ret, TNN_OK);
 
@@ -137,6 +158,15 @@ Status DefaultNetwork::Init(NetworkConfig &net_config, ModelConfig &model_config
     return ret;
 }
 
+Status DefaultNetwork::InitOptimized(NetworkConfig &net_config, ModelConfig &model_config,
+                                     AbstractModelInterpreter *interpreter, InputShapesMap min_inputs_shape,
+                                     InputShapesMap max_inputs_shape) {
+    skip_optimize_ = true;
+    auto ret       = DefaultNetwork::Init(net_config, model_config, interpreter, min_inputs_shape, max_inputs_shape);
+    skip_optimize_ = false;
+    return ret;
+}
+
 static inline bool IsLayoutReformatLayer(std::shared_ptr<LayerInfo> layer) {
     if (layer->type == LAYER_REFORMAT) {
         auto param = dynamic_cast<ReformatLayerParam *>(layer->param.get());
@@ -331,6 +361,17 @@ Status DefaultNetwork::InitLayers(NetStructure *net_structure, NetResource *net_
 }
 
 Status DefaultNetwork::AllocateBlobMemory() {
+    // outputs of layers which can run in place take over the memory of an input read by no later layer
+    std::map<std::string, std::string> inplace_blobs;
+    for (auto layer : layers_) {
+        int index = layer->GetInplaceInputIndex();
+        if (index >= 0) {
+            auto inputs  = layer->GetInputBlobs();
+            auto outputs = layer->GetOutputBlobs();
+            inplace_blobs[outputs[0]->GetBlobDesc().name] = inputs[index]->GetBlobDesc().name;
+        }
+    }
+    blob_manager_->SetInplaceBlobs(inplace_blobs);
     return blob_manager_->AllocateBlobMemory(DATA_FLAG_CHANGE_ALWAYS);
 }
 
@@ -426,7 +467,7 @@ Status DefaultNetwork::UpdateBlobPrecision(std::shared_ptr<LayerInfo> layer_info
     return TNN_OK;
 }
 
-Status DefaultNetwork::GetForwardMemorySize(int &memory_size) {
+Status DefaultNetwork::GetForwardMemorySize(int64_t &memory_size) {
     memory_size = blob_manager_->GetAllBlobMemorySize();
     return TNN_OK;
 }
@@ -449,6 +490,165 @@ Status DefaultNetwork::GetAllOutputBlobs(BlobMap &blobs) {
     return TNN_OK;
 }
 
+// states of all layers, named layer_name/state_name
+Status DefaultNetwork::GetLayerRecurrentStates(std::map<std::string, RawBuffer *> &states) {
+    if (!config_.enable_recurrent_state) {
+        return Status(TNNERR_PARAM_ERR, "recurrent state needs NetworkConfig.enable_recurrent_state");
+    }
+    for (auto layer : layers_) {
+        std::map<std::string, RawBuffer *> layer_states;
+        RETURN_ON_NEQ(layer->GetRecurrentStates(layer_states), TNN_OK);
+        for (auto iter : layer_states) {
+            states[layer->GetLayerName() + "/" + iter.first] = iter.second;
+        }
+    }
+    return TNN_OK;
+}
+
+Status DefaultNetwork::ResetRecurrentState() {
+    std::map<std::string, RawBuffer *> states;
+    RETURN_ON_NEQ(GetLayerRecurrentStates(states), TNN_OK);
+    for (auto iter : states) {
+        auto buffer = iter.second;
+        if (buffer->GetBytesSize64() > 0) {
+            memset(buffer->force_to<void *>(), 0, buffer->GetBytesSize64());
+        }
+    }
+    return TNN_OK;
+}
+
+Status DefaultNetwork::GetRecurrentState(MatMap &states) {
+    std::map<std::string, RawBuffer *> layer_states;
+    RETURN_ON_NEQ(GetLayerRecurrentStates(layer_states), TNN_OK);
+    states.clear();
+    for (auto iter : layer_states) {
+        auto buffer = iter.second;
+        // states the layer has not allocated have no size
+        if (buffer->GetBytesSize64() <= 0) {
+            continue;
+        }
+        auto dims = buffer->GetBufferDims();
+        if (dims.empty()) {
+            dims = {buffer->GetDataCount()};
+        }
+        auto mat = std::make_shared<Mat>(DEVICE_NAIVE, NCHW_FLOAT, dims);
+        memcpy(mat->GetData(), buffer->force_to<void *>(), buffer->GetBytesSize64());
+        states[iter.first] = mat;
+    }
+    return TNN_OK;
+}
+
+Status DefaultNetwork::SetRecurrentState(const MatMap &states) {
+    std::map<std::string, RawBuffer *> layer_states;
+    RETURN_ON_NEQ(GetLayerRecurrentStates(layer_states), TNN_OK);
+    // check all the states before copying any, a refused set leaves the states as they are
+    for (auto iter : states) {
+        auto state = layer_states.find(iter.first);
+        if (state == layer_states.end()) {
+            LOGE("network has no recurrent state named %s\n", iter.first.c_str());
+            return Status(TNNERR_PARAM_ERR, "network has no recurrent state with the name");
+        }
+        auto mat = iter.second;
+        if (!mat || mat->GetDeviceType() != DEVICE_NAIVE || mat->GetMatType() != NCHW_FLOAT) {
+            return Status(TNNERR_PARAM_ERR, "recurrent state must be a naive NCHW_FLOAT mat");
+        }
+        // the state must match the batch the layer is reshaped to
+        auto dims       = mat->GetDims();
+        auto state_dims = state->second->GetBufferDims();
+        if (state->second->GetBytesSize64() <= 0 || !DimsVectorUtils::Equal(dims, state_dims)) {
+            LOGE("recurrent state %s has dims %s, expected %s\n", iter.first.c_str(), DimsToString(dims).c_str(),
+                 DimsToString(state_dims).c_str());
+            return Status(TNNERR_PARAM_ERR, "recurrent state dims do not match the layer");
+        }
+    }
+    for (auto iter : states) {
+        auto buffer = layer_states[iter.first];
+        memcpy(buffer->force_to<void *>(), iter.second->GetData(), buffer->GetBytesSize64());
+    }
+    return TNN_OK;
+}
+
+Status DefaultNetwork::UpdateModelResource(NetStructure *net_structure, NetResource *net_resource) {
+    if (runtime_model_ != RUNTIME_MODE_NORMAL || net_structure_ == nullptr || net_resource_ == nullptr) {
+        return Status(TNNERR_NET_ERR, "network is not initialized");
+    }
+    // BlobInt8 holds the blob scales of quantized networks by pointer
+    if (GetQuantizedInfoFromNetStructure(net_structure_)) {
+        return Status(TNNERR_NET_ERR, "updating the weights of quantized networks is not supported");
+    }
+    std::lock_guard<std::mutex> update_guard(update_mtx_);
+
+    {
+        std::unique_lock<std::mutex> lck(optimize_mtx_);
+        auto ret = optimizer::NetOptimizerManager::Optimize(net_structure, net_resource, config_);
+        RETURN_ON_NEQ(ret, TNN_OK);
+    }
+    // the optimizers only depend on the structure, so the layers must match the ones of the network
+    bool same_layers = net_structure->layers.size() == net_structure_->layers.size();
+    for (size_t i = 0; same_layers && i < net_structure->layers.size(); i++) {
+        auto layer     = net_structure->layers[i];
+        auto reference = net_structure_->layers[i];
+        same_layers    = layer->name == reference->name && layer->type == reference->type &&
+                      layer->inputs == reference->inputs && layer->outputs == reference->outputs;
+    }
+    if (!same_layers) {
+        return Status(TNNERR_NET_ERR, "the optimized model does not match the layers of the network");
+    }
+
+    // the new accs pack their weights while forward keeps running on the old ones, the network keeps the old
+    // weights if any layer fails
+    auto discard = [&]() {
+        for (auto layer : layers_) {
+            layer->DiscardResource();
+        }
+    };
+    for (auto layer : layers_) {
+        LayerResource *resource = nullptr;
+        auto iter               = net_resource->resource_map.find(layer->GetLayerName());
+        if (iter != net_resource->resource_map.end()) {
+            resource = iter->second.get();
+        }
+        auto status = layer->PrepareResource(context_, resource, &net_resource->constant_map, device_);
+        if (status != TNN_OK) {
+            discard();
+            return status;
+        }
+    }
+
+    // forward only waits for the switch, the old resources are released after it
+    auto old_resource_map = net_resource_->resource_map;
+    auto old_constant_map = net_resource_->constant_map;
+    Status status         = TNN_OK;
+    {
+        std::lock_guard<std::mutex> guard(resource_mtx_);
+        net_resource_->resource_map = net_resource->resource_map;
+        net_resource_->constant_map = net_resource->constant_map;
+
+        // a layer failing in commit has switched already and is reverted as well
+        size_t committed = 0;
+        for (; committed < layers_.size() && status == TNN_OK; committed++) {
+            status = layers_[committed]->CommitResource();
+        }
+        if (status == TNN_OK && tiled_executor_) {
+            status = tiled_executor_->Reshape();
+        }
+        if (status != TNN_OK) {
+            net_resource_->resource_map = old_resource_map;
+            net_resource_->constant_map = old_constant_map;
+            for (size_t i = 0; i < committed; i++) {
+                if (layers_[i]->RevertResource() != TNN_OK) {
+                    LOGE("Error revert resource of layer %s\n", layers_[i]->GetLayerName().c_str());
+                }
+            }
+            if (tiled_executor_) {
+                tiled_executor_->Reshape();
+            }
+        }
+    }
+    discard();
+    return status;
+}
+
 /*
  * Reshape function is called when the input shape changes.
  * Memory allocation may be involved in Reshape function.
@@ -507,6 +707,11 @@ Status DefaultNetwork::DeInit() {
     }
     layers_.clear();
 
+    if (tiled_executor_ != nullptr) {
+        delete tiled_executor_;
+        tiled_executor_ = nullptr;
+    }
+
     if (blob_manager_ != NULL) {
         delete blob_manager_;
         blob_manager_ = NULL;
@@ -558,6 +763,11 @@ Context* DefaultNetwork::GetContext() {
 Status DefaultNetwork::Forward() {
     auto status = blob_manager_->CheckBlobMemoryState();
     RETURN_ON_NEQ(status, TNN_OK);
+
+    std::lock_guard<std::mutex> resource_guard(resource_mtx_);
+
+    ForwardMemoryLease memory_lease(blob_manager_, context_);
+    RETURN_ON_NEQ(memory_lease.GetStatus(), TNN_OK);
     
     if (runtime_blob_pool_) {
         //now we allocate blob eachtime when running acc, so clear blob pool to avoid memory leak
@@ -568,7 +778,18 @@ Status DefaultNetwork::Forward() {
     RETURN_ON_NEQ(status, TNN_OK);
     
     int cnt = 0;
-    for (auto layer : layers_) {
+    for (size_t index = 0; index < layers_.size(); index++) {
+        auto layer = layers_[index];
+        // the layers of a tiled chain run together tile by tile
+        int chain_length = tiled_executor_ ? tiled_executor_->GetChainLength((int)index) : 0;
+        if (chain_length > 0) {
+            status = tiled_executor_->Forward((int)index);
+            RETURN_ON_NEQ(status, TNN_OK);
+            index += chain_length - 1;
+            cnt += chain_length;
+            continue;
+        }
+
         std::vector<Blob *> inputs  = layer->GetInputBlobs();
         std::vector<Blob *> outputs = layer->GetOutputBlobs();
 
@@ -642,17 +863,33 @@ Status DefaultNetwork::ForwardWithCallback(BlobStatisticCallback before, BlobSta
         return result;
     }
 
+    ForwardMemoryLease memory_lease(blob_manager_, context_);
+    RETURN_ON_NEQ(memory_lease.GetStatus(), TNN_OK);
+
+    std::lock_guard<std::mutex> resource_guard(resource_mtx_);
     context_->OnInstanceForwardBegin();
     int cnt = 0;
-    for (auto layer : layers_) {
+    for (size_t index = 0; index < layers_.size(); index++) {
+        auto layer       = layers_[index];
+        int chain_length = tiled_executor_ ? tiled_executor_->GetChainLength((int)index) : 0;
         std::vector<Blob *> inputs  = layer->GetInputBlobs();
         std::vector<Blob *> outputs = layer->GetOutputBlobs();
+        // the blobs inside a tiled chain have no memory, the callbacks see the chain as its last layer
+        if (chain_length > 0) {
+            layer   = layers_[index + chain_length - 1];
+            outputs = layer->GetOutputBlobs();
+        }
 
         auto layer_info = GetLayerInfoFromName(net_structure_, layer->GetLayerName());
         if (before != nullptr)
             before(inputs, layer_info.get());
 
-        result = layer->Forward();
+        if (chain_length > 0) {
+            result = tiled_executor_->Forward((int)index);
+            index += chain_length - 1;
+        } else {
+            result = layer->Forward();
+        }
         if (result != TNN_OK) {
             LOGE("Forward error %s, exit\n", result.description().c_str());
             return result;
@@ -671,6 +908,7 @@ Status DefaultNetwork::ForwardWithCallback(BlobStatisticCallback before, BlobSta
 
 // @brief tnn instance network infer, it will not wait
 // blob dump is not implement in this funciton.
+// in share pool mode it waits until the forward memory can be returned.
 Status DefaultNetwork::ForwardAsync(Callback call_back) {
     Status result = TNN_OK;
     result        = blob_manager_->CheckBlobMemoryState();
@@ -678,9 +916,19 @@ Status DefaultNetwork::ForwardAsync(Callback call_back) {
         return result;
     }
 
+    ForwardMemoryLease memory_lease(blob_manager_, context_);
+    RETURN_ON_NEQ(memory_lease.GetStatus(), TNN_OK);
+
+    std::lock_guard<std::mutex> resource_guard(resource_mtx_);
     context_->OnInstanceForwardBegin();
-    for (auto layer : layers_) {
-        result = layer->Forward();
+    for (size_t index = 0; index < layers_.size(); index++) {
+        int chain_length = tiled_executor_ ? tiled_executor_->GetChainLength((int)index) : 0;
+        if (chain_length > 0) {
+            result = tiled_executor_->Forward((int)index);
+            index += chain_length - 1;
+        } else {
+            result = layers_[index]->Forward();
+        }
         RETURN_ON_NEQ(result, TNN_OK);
     }
     context_->OnInstanceForwardEnd();
@@ -710,6 +958,9 @@ Status DefaultNetwork::ReshapeLayers() {
         //Note output shape may not change after reshape for const folder, but will do change after forward because shape may be determined at rumtime
         LOGD("ReshapeLayers Output Shape: [%s]\n", cur_layer->GetOutputBlobs()[0]->GetBlobDesc().description().c_str());
     }
+    if (tiled_executor_) {
+        return tiled_executor_->Reshape();
+    }
     return TNN_OK;
 }
 
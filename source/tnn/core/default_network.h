@@ -15,6 +15,7 @@
 #ifndef TNN_SOURCE_TNN_CORE_DEFAULT_NETWORK_H_
 #define TNN_SOURCE_TNN_CORE_DEFAULT_NETWORK_H_
 
+#include <mutex>
 #include <vector>
 
 #include "tnn/core/abstract_device.h"
@@ -26,6 +27,7 @@
 #include "tnn/core/macro.h"
 #include "tnn/core/profile.h"
 #include "tnn/core/status.h"
+#include "tnn/core/tiled_executor.h"
 #include "tnn/interpreter/abstract_model_interpreter.h"
 #include "tnn/interpreter/layer_resource.h"
 #include "tnn/interpreter/net_resource.h"
@@ -52,6 +54,12 @@ public:
     virtual Status Init(NetworkConfig &net_config, ModelConfig &model_config, AbstractModelInterpreter *interpreter,
         InputShapesMap min_inputs_shape, InputShapesMap max_inputs_shape, bool enable_const_folder=true);
 
+    // @brief init with the optimized structure and resource of an initialized network of the same model, the
+    // optimizer passes are skipped. the layers, blobs and context are created for this network
+    virtual Status InitOptimized(NetworkConfig &net_config, ModelConfig &model_config,
+                                 AbstractModelInterpreter *interpreter, InputShapesMap min_inputs_shape,
+                                 InputShapesMap max_inputs_shape);
+
     // @brief reshape with input shape info
     // @inputs input shape info
     virtual Status Reshape(const InputShapesMap &inputs);
@@ -78,7 +86,7 @@ public:
     virtual Status DeInit();
 
     // @brief get network forward for all blob memory size
-    virtual Status GetForwardMemorySize(int &memory_size);
+    virtual Status GetForwardMemorySize(int64_t &memory_size);
 
     // @brief set forward memory when share memory mode is set from external
     virtual Status SetForwardMemory(void *memory);
@@ -92,6 +100,23 @@ public:
     // @brief set threads run on device
     virtual Status SetCpuNumThreads(int num_threads);
 
+    // @brief zero the states kept by recurrent layers to start a new stream
+    virtual Status ResetRecurrentState();
+
+    // @brief copy of the states kept by recurrent layers, by layer name and state name
+    virtual Status GetRecurrentState(MatMap &states);
+
+    // @brief restore the states kept by recurrent layers from a copy
+    virtual Status SetRecurrentState(const MatMap &states);
+
+    // @brief switch the layers to the weights of another model with the same structure, without rebuilding
+    // the network. the resources are optimized like the ones of the network, and must end up in the same
+    // layers. the network shares the new resources
+    // @param net_structure structure of the model the resources belong to, before optimization
+    // @param net_resource resources to switch to
+    // all layers are prepared before any of them switches, the network keeps the old weights on failure
+    virtual Status UpdateModelResource(NetStructure *net_structure, NetResource *net_resource);
+
 #if TNN_PROFILE
 public:
     virtual void StartProfile();
@@ -120,18 +145,26 @@ protected:
 
     BlobManager *blob_manager_ = nullptr;
     BlobMemoryPool *runtime_blob_pool_ = nullptr;
+    TiledExecutor *tiled_executor_     = nullptr;
 
     NetStructure *net_structure_ = nullptr;
     NetResource *net_resource_ = nullptr;
 
     NetworkConfig config_;
+    bool skip_optimize_ = false;
 
     static std::mutex optimize_mtx_;
+    // held by forward, the weights are switched between two forward calls
+    std::mutex resource_mtx_;
+    // held by UpdateModelResource, the layers keep the accs of one update until it is committed
+    std::mutex update_mtx_;
 
 private:
 
    Status ReshapeLayers();
 
+   Status GetLayerRecurrentStates(std::map<std::string, RawBuffer *> &states);
+
 };
 
 }  // namespace TNN_NS
@@ -14,11 +14,15 @@
 
 #include "tnn/core/instance.h"
 
+#include <limits.h>
+
 #include <memory>
+#include <typeinfo>
 
 #include "tnn/core/abstract_network.h"
 #include "tnn/core/common.h"
 #include "tnn/core/const_folder.h"
+#include "tnn/core/default_network.h"
 #include "tnn/core/macro.h"
 #include "tnn/core/profile.h"
 #include "tnn/core/status.h"
@@ -46,7 +50,9 @@ Status Instance::Init(std::shared_ptr<AbstractModelInterpreter> interpreter, Inp
 }
 
 Status Instance::Init(std::shared_ptr<AbstractModelInterpreter> interpreter, InputShapesMap min_inputs_shape, InputShapesMap max_inputs_shape) {
-    
+    min_inputs_shape_ = min_inputs_shape;
+    max_inputs_shape_ = max_inputs_shape;
+
     auto type = net_config_.device_type;
     if(type == DEVICE_APPLE_NPU) {
         //use DEVICE_ARM OR DEVICE_X86 according to hardware
@@ -62,6 +68,7 @@ Status Instance::Init(std::shared_ptr<AbstractModelInterpreter> interpreter, Inp
     RETURN_VALUE_ON_NEQ(device != NULL, true, TNNERR_DEVICE_NOT_SUPPORT);
     
     if (interpreter) {
+        source_interpreter_ = interpreter;
         interpreter_ = interpreter->Copy();
         if (nullptr == interpreter_) {
             // The ModelInterpreter not implement Copy API, just use interpreter
@@ -116,6 +123,12 @@ Status Instance::Init(std::shared_ptr<AbstractModelInterpreter> interpreter, Inp
             auto max_constant_map = default_interpreter->GetNetResource()->blob_shapes_map;
             default_interpreter->GetNetResource()->min_blob_shapes_map = max_constant_map;
         }
+
+        // CUDA and APPLE_NPU read the blob shapes saved by the const folder network, keep forwarding it for them
+        if (net_config_.device_type != DEVICE_CUDA && net_config_.device_type != DEVICE_APPLE_NPU) {
+            status = const_folder->EnableShapeProgram();
+            RETURN_ON_NEQ(status, TNN_OK);
+        }
      
         const_folder_ = const_folder;
     }
@@ -127,15 +140,58 @@ Status Instance::Init(std::shared_ptr<AbstractModelInterpreter> interpreter, Inp
     return TNN_OK;
 }
 
+std::shared_ptr<Instance> Instance::Clone(Status &status) {
+    if (!network_ || !interpreter_) {
+        status = Status(TNNERR_INST_ERR, "instance is not initialized");
+        return nullptr;
+    }
+
+    auto instance = std::make_shared<Instance>(net_config_, model_config_);
+    // the const folder computes the constants into the resource on reshape, the resource can not be shared
+    std::shared_ptr<AbstractModelInterpreter> interpreter = nullptr;
+    if (!const_folder_ && typeid(*network_) == typeid(DefaultNetwork) && source_interpreter_ != interpreter_) {
+        interpreter = interpreter_->Copy();
+    }
+    if (!interpreter) {
+        status = instance->Init(source_interpreter_, min_inputs_shape_, max_inputs_shape_);
+        return status == TNN_OK ? instance : nullptr;
+    }
+
+    // the copy holds the optimized structure and shares the resources, the device packs the weights once
+    auto network = std::make_shared<DefaultNetwork>();
+    status = network->InitOptimized(instance->net_config_, instance->model_config_, interpreter.get(),
+                                    min_inputs_shape_, max_inputs_shape_);
+    if (status != TNN_OK) {
+        return nullptr;
+    }
+    instance->source_interpreter_ = source_interpreter_;
+    instance->interpreter_        = interpreter;
+    instance->network_            = network;
+    instance->min_inputs_shape_   = min_inputs_shape_;
+    instance->max_inputs_shape_   = max_inputs_shape_;
+    return instance;
+}
+
 Status Instance::DeInit() {
     network_ = nullptr;
     return TNN_OK;
 }
 
-Status Instance::GetForwardMemorySize(int &memory_size) {
+Status Instance::GetForwardMemorySize(int64_t &memory_size) {
     return network_->GetForwardMemorySize(memory_size);
 }
 
+Status Instance::GetForwardMemorySize(int &memory_size) {
+    int64_t memory_size_64 = 0;
+    RETURN_ON_NEQ(network_->GetForwardMemorySize(memory_size_64), TNN_OK);
+    if (memory_size_64 > INT_MAX) {
+        LOGE("forward memory size %lld overflows int, use GetForwardMemorySize(int64_t&)\n", (long long)memory_size_64);
+        return Status(TNNERR_PARAM_ERR, "forward memory size overflows int, use GetForwardMemorySize(int64_t&)");
+    }
+    memory_size = static_cast<int>(memory_size_64);
+    return TNN_OK;
+}
+
 Status Instance::SetForwardMemory(void *memory) {
     return network_->SetForwardMemory(memory);
 }
@@ -199,13 +255,44 @@ Status Instance::SetCpuNumThreads(int num_threads) {
     return network_->SetCpuNumThreads(num_threads);
 }
 
-// set input Mat
-Status Instance::SetInputMat(std::shared_ptr<Mat> mat, MatConvertParam param, std::string input_name) {
-    if (!mat) {
-        LOGE("input mat is empty ,please check!\n");
-        return Status(TNNERR_PARAM_ERR, "input mat is empty ,please check!");
+Status Instance::ResetRecurrentState() {
+    return network_->ResetRecurrentState();
+}
+
+Status Instance::GetRecurrentState(MatMap &states) {
+    return network_->GetRecurrentState(states);
+}
+
+Status Instance::SetRecurrentState(const MatMap &states) {
+    return network_->SetRecurrentState(states);
+}
+
+Status Instance::UpdateModel(std::string model_content) {
+    // folded constants may be computed from the weights
+    if (const_folder_) {
+        return Status(TNNERR_NET_ERR, "UpdateModel does not support networks with folded constants");
+    }
+    if (!network_ || typeid(*network_) != typeid(DefaultNetwork)) {
+        return Status(TNNERR_NET_ERR, "UpdateModel only supports the default network");
+    }
+    if (!source_interpreter_ || source_interpreter_ == interpreter_) {
+        return Status(TNNERR_NET_ERR, "UpdateModel needs an interpreter supporting Copy");
     }
 
+    auto interpreter = source_interpreter_->Copy();
+    auto default_interpreter = dynamic_cast<DefaultModelInterpreter *>(interpreter.get());
+    if (!default_interpreter) {
+        return Status(TNNERR_NET_ERR, "UpdateModel only supports the default model interpreter");
+    }
+    auto status = default_interpreter->ReplaceModel(model_content);
+    RETURN_ON_NEQ(status, TNN_OK);
+
+    auto network = dynamic_cast<DefaultNetwork *>(network_.get());
+    return network->UpdateModelResource(default_interpreter->GetNetStructure(), default_interpreter->GetNetResource());
+}
+
+// get the converter of the input, take the first input name for default
+Status Instance::GetInputConverter(std::string &input_name, std::shared_ptr<BlobConverter> &blob_converter) {
     // get input blobs
     BlobMap input_blobs;
     auto status = network_->GetAllInputBlobs(input_blobs);
@@ -225,7 +312,6 @@ Status Instance::SetInputMat(std::shared_ptr<Mat> mat, MatConvertParam param, st
     }
 
     // check blob convert
-    std::shared_ptr<BlobConverter> blob_converter = nullptr;
     if (input_converters_.size() > 0 && input_converters_.find(input_name) != input_converters_.end()) {
         blob_converter = input_converters_[input_name];
     } else {
@@ -233,6 +319,19 @@ Status Instance::SetInputMat(std::shared_ptr<Mat> mat, MatConvertParam param, st
         blob_converter                = std::make_shared<BlobConverter>(input_blob);
         input_converters_[input_name] = blob_converter;
     }
+    return TNN_OK;
+}
+
+// set input Mat
+Status Instance::SetInputMat(std::shared_ptr<Mat> mat, MatConvertParam param, std::string input_name) {
+    if (!mat) {
+        LOGE("input mat is empty ,please check!\n");
+        return Status(TNNERR_PARAM_ERR, "input mat is empty ,please check!");
+    }
+
+    std::shared_ptr<BlobConverter> blob_converter = nullptr;
+    auto status                                   = GetInputConverter(input_name, blob_converter);
+    RETURN_ON_NEQ(status, TNN_OK);
 
     // get command queue
     void *command_queue = nullptr;
@@ -247,6 +346,29 @@ Status Instance::SetInputMat(std::shared_ptr<Mat> mat, MatConvertParam param, st
     return TNN_OK;
 }
 
+Status Instance::SetInputMatWithPreprocess(std::shared_ptr<Mat> mat, MatPreprocessParam preprocess,
+                                           MatConvertParam param, std::string input_name) {
+    if (!mat) {
+        LOGE("input mat is empty ,please check!\n");
+        return Status(TNNERR_PARAM_ERR, "input mat is empty ,please check!");
+    }
+
+    std::shared_ptr<BlobConverter> blob_converter = nullptr;
+    auto status                                   = GetInputConverter(input_name, blob_converter);
+    RETURN_ON_NEQ(status, TNN_OK);
+
+    void *command_queue = nullptr;
+    network_->GetCommandQueue(&command_queue);
+
+    status = blob_converter->ConvertFromMatWithPreprocess(*(mat.get()), preprocess, param, command_queue);
+    if (status != TNN_NS::TNN_OK) {
+        LOGE("input_blob_convert.ConvertFromMatWithPreprocess Error: %s\n", status.description().c_str());
+        return status;
+    }
+
+    return TNN_OK;
+}
+
 // get output Mat
 Status Instance::GetOutputMat(std::shared_ptr<Mat> &mat, MatConvertParam param, std::string output_name,
                               DeviceType device, MatType mat_type) {
@@ -238,6 +238,7 @@ static std::map<std::string, LayerType> global_layer_type_map = {
     {"ConstantOfShape", LAYER_CONSTANT_OF_SHAPE},
     {"NonZero", LAYER_NONZERO},
     {"LSTMONNX", LAYER_LSTMONNX},
+    {"GRUONNX", LAYER_GRUONNX},
     {"QuantizedSigmoid", LAYER_SIGMOID},
     {"StridedSliceV2", LAYER_STRIDED_SLICE_V2},
     {"Erf", LAYER_ERF},
@@ -250,6 +251,7 @@ static std::map<std::string, LayerType> global_layer_type_map = {
     {"OneHot", LAYER_ONEHOT},
     {"CbamFusedReduce", LAYER_CBAM_FUSED_REDUCE},
     {"CbamFusedPooling", LAYER_CBAM_FUSED_POOLING},
+    {"ConvDwPwFused", LAYER_CONV_DW_PW_FUSED},
     {"Softsign", LAYER_SOFTSIGN},
     {"LogSoftmax", LAYER_LOGSOFTMAX},
     {"QuantizedReshape", LAYER_RESHAPE},
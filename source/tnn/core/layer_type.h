@@ -225,6 +225,7 @@ enum LayerType {
     LAYER_LESS                                              = 334,
     LAYER_NON_MAX_SUPPRESSION                               = 335,
     LAYER_SCATTER                                           = 336,
+    LAYER_GRUONNX                                           = 337,
 
     LAYER_BLOB_SCALE                                        = 600,
 
@@ -232,7 +233,8 @@ enum LayerType {
     LAYER_TRT_ENGINE                                        = 701,
 
     LAYER_CBAM_FUSED_REDUCE                                 = 800,
-    LAYER_CBAM_FUSED_POOLING                                = 801
+    LAYER_CBAM_FUSED_POOLING                                = 801,
+    LAYER_CONV_DW_PW_FUSED                                  = 802
 };
 
 LayerType GlobalConvertLayerType(std::string layer_type_str);
@@ -0,0 +1,504 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/core/shape_program.h"
+
+#include <string.h>
+
+#include "tnn/utils/data_flag_utils.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+static Status UnsupportedLayer(std::shared_ptr<LayerInfo> layer) {
+    LOGD("ShapeProgram does not support layer %s (%s)\n", layer->name.c_str(), layer->type_str.c_str());
+    return Status(TNNERR_UNSUPPORT_NET, "ShapeProgram does not support the layer");
+}
+
+static bool IsInt32Buffer(RawBuffer &buffer) {
+    return buffer.GetDataType() == DATA_TYPE_INT32;
+}
+
+Status ShapeProgram::LoadBuffer(RawBuffer &buffer, Value &value) {
+    if (!IsInt32Buffer(buffer)) {
+        return Status(TNNERR_UNSUPPORT_NET, "ShapeProgram only evaluates int32 data");
+    }
+    const int count = buffer.GetDataCount();
+    auto ptr        = buffer.force_to<int *>();
+    value.dims      = buffer.GetBufferDims();
+    if (count < 0 || (!value.dims.empty() && DimsVectorUtils::Count(value.dims) != count)) {
+        return Status(TNNERR_PARAM_ERR, "ShapeProgram got invalid int32 data");
+    }
+    value.data.assign(ptr, ptr + count);
+    return TNN_OK;
+}
+
+int ShapeProgram::AddValue(const Value &value) {
+    values_.push_back(value);
+    return (int)values_.size() - 1;
+}
+
+Status ShapeProgram::Compile(NetStructure *net_structure, NetResource *net_resource, BlobManager *blob_manager,
+                             const std::set<std::string> &targets) {
+    values_.clear();
+    instructions_.clear();
+    targets_.clear();
+
+    net_structure_ = net_structure;
+    net_resource_  = net_resource;
+    blob_manager_  = blob_manager;
+    for (auto layer : net_structure->layers) {
+        for (const auto &name : layer->outputs) {
+            producers_[name] = layer;
+        }
+    }
+
+    Status status = TNN_OK;
+    for (const auto &name : targets) {
+        int index = -1;
+        status    = CompileBlob(name, index);
+        if (status != TNN_OK) {
+            break;
+        }
+        targets_.push_back(std::make_pair(name, index));
+    }
+
+    value_index_.clear();
+    producers_.clear();
+    net_structure_ = nullptr;
+    net_resource_  = nullptr;
+    blob_manager_  = nullptr;
+    if (status != TNN_OK) {
+        values_.clear();
+        instructions_.clear();
+        targets_.clear();
+    }
+    return status;
+}
+
+Status ShapeProgram::CompileBlob(const std::string &name, int &index) {
+    auto iter = value_index_.find(name);
+    if (iter != value_index_.end()) {
+        index = iter->second;
+        return TNN_OK;
+    }
+
+    auto producer     = producers_.find(name);
+    bool has_producer = producer != producers_.end();
+
+    // constants of the model and the blobs folded with flag DATA_FLAG_CHANGE_NEVER keep their values
+    auto &constant_map = net_resource_->constant_map;
+    auto &const_flags  = net_resource_->constant_blob_flags;
+    auto const_iter    = constant_map.find(name);
+    if (const_iter != constant_map.end()) {
+        auto flag_iter = const_flags.find(name);
+        bool never_change =
+            flag_iter == const_flags.end()
+                ? !has_producer
+                : DataFlagUtils::ChangeStatus(flag_iter->second) == DATA_FLAG_CHANGE_NEVER;
+        if (never_change) {
+            Value value;
+            RETURN_ON_NEQ(LoadBuffer(*const_iter->second, value), TNN_OK);
+            index              = AddValue(value);
+            value_index_[name] = index;
+            return TNN_OK;
+        }
+    }
+
+    auto blob = blob_manager_->GetBlob(name);
+    if (!has_producer || !blob) {
+        return Status(TNNERR_UNSUPPORT_NET, "ShapeProgram can not find the layer of blob");
+    }
+    if (blob->GetBlobDesc().data_type != DATA_TYPE_INT32) {
+        return Status(TNNERR_UNSUPPORT_NET, "ShapeProgram only evaluates int32 blobs");
+    }
+    RETURN_ON_NEQ(CompileLayer(producer->second, index), TNN_OK);
+    value_index_[name] = index;
+    return TNN_OK;
+}
+
+Status ShapeProgram::CompileLayer(std::shared_ptr<LayerInfo> layer, int &index) {
+    if (layer->outputs.size() != 1 || layer->inputs.empty() || !layer->param) {
+        return UnsupportedLayer(layer);
+    }
+
+    Instruction inst;
+    inst.type  = layer->type;
+    inst.param = layer->param;
+    auto res_iter = net_resource_->resource_map.find(layer->name);
+    if (res_iter != net_resource_->resource_map.end()) {
+        inst.resource = res_iter->second;
+    }
+
+    std::vector<std::string> value_inputs;
+    switch (layer->type) {
+        case LAYER_SHAPE: {
+            const auto &input = layer->inputs[0];
+            if (net_structure_->inputs_shape_map.find(input) != net_structure_->inputs_shape_map.end()) {
+                inst.input_name = input;
+                break;
+            }
+            // shape of a constant is a constant, shape of other blobs needs the layers to run
+            auto const_iter = net_resource_->constant_map.find(input);
+            if (const_iter == net_resource_->constant_map.end() || producers_.find(input) != producers_.end()) {
+                return UnsupportedLayer(layer);
+            }
+            Value value;
+            value.data = const_iter->second->GetBufferDims();
+            value.dims = {(int)value.data.size()};
+            index      = AddValue(value);
+            return TNN_OK;
+        }
+        case LAYER_GATHER: {
+            auto param    = dynamic_cast<GatherLayerParam *>(layer->param.get());
+            auto resource = dynamic_cast<GatherLayerResource *>(inst.resource.get());
+            if (!param || ((param->data_in_resource || param->indices_in_resource) && !resource)) {
+                return UnsupportedLayer(layer);
+            }
+            if (param->data_in_resource) {
+                if (!IsInt32Buffer(resource->data)) {
+                    return UnsupportedLayer(layer);
+                }
+            } else {
+                value_inputs.push_back(layer->inputs.front());
+            }
+            if (!param->indices_in_resource) {
+                value_inputs.push_back(layer->inputs.back());
+            }
+            break;
+        }
+        case LAYER_CONCAT:
+            value_inputs = layer->inputs;
+            break;
+        case LAYER_ADD:
+        case LAYER_SUB:
+        case LAYER_MUL:
+        case LAYER_DIV: {
+            if (layer->inputs.size() == 1) {
+                auto param    = dynamic_cast<MultidirBroadcastLayerParam *>(layer->param.get());
+                auto resource = dynamic_cast<EltwiseLayerResource *>(inst.resource.get());
+                if (!param || !resource || !IsInt32Buffer(resource->element_handle)) {
+                    return UnsupportedLayer(layer);
+                }
+            }
+            value_inputs = layer->inputs;
+            break;
+        }
+        case LAYER_SQUEEZE:
+        case LAYER_UNSQUEEZE: {
+            auto param = dynamic_cast<SqueezeLayerParam *>(layer->param.get());
+            if (!param || param->data_in_resource || layer->inputs.size() != 1) {
+                return UnsupportedLayer(layer);
+            }
+            value_inputs = layer->inputs;
+            break;
+        }
+        case LAYER_CAST: {
+            auto param = dynamic_cast<CastLayerParam *>(layer->param.get());
+            if (!param || param->to != DATA_TYPE_INT32 || layer->inputs.size() != 1) {
+                return UnsupportedLayer(layer);
+            }
+            value_inputs = layer->inputs;
+            break;
+        }
+        case LAYER_STRIDED_SLICE_V2: {
+            // slices of 1d shape tensors
+            auto param = dynamic_cast<StrideSliceV2LayerParam *>(layer->param.get());
+            if (!param || param->axes.size() != 1 || param->strides.size() != 1 || layer->inputs.size() > 3) {
+                return UnsupportedLayer(layer);
+            }
+            value_inputs = layer->inputs;
+            break;
+        }
+        case LAYER_RANGE: {
+            auto param = dynamic_cast<RangeLayerParam *>(layer->param.get());
+            if (!param) {
+                return UnsupportedLayer(layer);
+            }
+            if (layer->inputs.size() == 3) {
+                value_inputs = layer->inputs;
+            } else if (param->data_type != DATA_TYPE_INT32) {
+                return UnsupportedLayer(layer);
+            }
+            break;
+        }
+        default:
+            return UnsupportedLayer(layer);
+    }
+
+    for (const auto &name : value_inputs) {
+        int input_index = -1;
+        RETURN_ON_NEQ(CompileBlob(name, input_index), TNN_OK);
+        inst.inputs.push_back(input_index);
+    }
+    inst.output = AddValue(Value());
+    instructions_.push_back(inst);
+    index = inst.output;
+    return TNN_OK;
+}
+
+Status ShapeProgram::Run(const BlobShapesMap &input_shapes, ConstantResource &constant_map) {
+    for (const auto &inst : instructions_) {
+        RETURN_ON_NEQ(Execute(inst, input_shapes), TNN_OK);
+    }
+
+    // empty blobs are left to the const folder, see Blob2RawBuffer
+    for (const auto &target : targets_) {
+        if (values_[target.second].data.empty()) {
+            return Status(TNNERR_UNSUPPORT_NET, "ShapeProgram got empty blob");
+        }
+    }
+    for (const auto &target : targets_) {
+        const auto &value = values_[target.second];
+        auto buffer = std::make_shared<RawBuffer>(value.data.size() * sizeof(int), value.dims);
+        memcpy(buffer->force_to<void *>(), value.data.data(), value.data.size() * sizeof(int));
+        buffer->SetDataType(DATA_TYPE_INT32);
+        constant_map[target.first] = buffer;
+    }
+    return TNN_OK;
+}
+
+Status ShapeProgram::BinaryOp(LayerType type, const Value &a, const Value &b, Value &out) {
+    Status status = TNN_OK;
+    out.dims      = DimsFunctionUtils::Broadcast(a.dims, b.dims, &status);
+    RETURN_ON_NEQ(status, TNN_OK);
+
+    const int rank = (int)out.dims.size();
+    DimsVector dims_a(rank - a.dims.size(), 1);
+    DimsVector dims_b(rank - b.dims.size(), 1);
+    dims_a.insert(dims_a.end(), a.dims.begin(), a.dims.end());
+    dims_b.insert(dims_b.end(), b.dims.begin(), b.dims.end());
+
+    const int count = DimsVectorUtils::Count(out.dims);
+    out.data.resize(count);
+    for (int i = 0; i < count; i++) {
+        int offset = i, index_a = 0, index_b = 0, stride_a = 1, stride_b = 1;
+        for (int d = rank - 1; d >= 0; d--) {
+            const int idx = offset % out.dims[d];
+            offset /= out.dims[d];
+            index_a += dims_a[d] == 1 ? 0 : idx * stride_a;
+            index_b += dims_b[d] == 1 ? 0 : idx * stride_b;
+            stride_a *= dims_a[d];
+            stride_b *= dims_b[d];
+        }
+        const int x = a.data[index_a];
+        const int y = b.data[index_b];
+        if (type == LAYER_ADD) {
+            out.data[i] = x + y;
+        } else if (type == LAYER_SUB) {
+            out.data[i] = x - y;
+        } else if (type == LAYER_MUL) {
+            out.data[i] = x * y;
+        } else {
+            if (y == 0) {
+                return Status(TNNERR_PARAM_ERR, "ShapeProgram got division by zero");
+            }
+            out.data[i] = x / y;
+        }
+    }
+    return TNN_OK;
+}
+
+Status ShapeProgram::Execute(const Instruction &inst, const BlobShapesMap &input_shapes) {
+    Value out;
+    switch (inst.type) {
+        case LAYER_SHAPE: {
+            auto iter = input_shapes.find(inst.input_name);
+            if (iter == input_shapes.end()) {
+                return Status(TNNERR_PARAM_ERR, "ShapeProgram misses the shape of an input");
+            }
+            out.data = iter->second;
+            out.dims = {(int)out.data.size()};
+            break;
+        }
+        case LAYER_GATHER: {
+            auto param    = dynamic_cast<GatherLayerParam *>(inst.param.get());
+            auto resource = dynamic_cast<GatherLayerResource *>(inst.resource.get());
+            Value res_data, res_indices;
+            int next = 0;
+            if (param->data_in_resource) {
+                RETURN_ON_NEQ(LoadBuffer(resource->data, res_data), TNN_OK);
+            }
+            if (param->indices_in_resource) {
+                RETURN_ON_NEQ(LoadBuffer(resource->indices, res_indices), TNN_OK);
+            }
+            const Value &data    = param->data_in_resource ? res_data : values_[inst.inputs[next++]];
+            const Value &indices = param->indices_in_resource ? res_indices : values_[inst.inputs[next]];
+
+            const int rank = (int)data.dims.size();
+            int axis       = param->axis < 0 ? param->axis + rank : param->axis;
+            if (axis < 0 || axis >= rank) {
+                return Status(TNNERR_INVALID_AXIS, "ShapeProgram got invalid gather axis");
+            }
+            out.dims.assign(data.dims.begin(), data.dims.begin() + axis);
+            out.dims.insert(out.dims.end(), indices.dims.begin(), indices.dims.end());
+            out.dims.insert(out.dims.end(), data.dims.begin() + axis + 1, data.dims.end());
+
+            const int outer       = DimsVectorUtils::Count(data.dims, 0, axis);
+            const int axis_size   = data.dims[axis];
+            const int inner       = DimsVectorUtils::Count(data.dims, axis + 1);
+            const int index_count = (int)indices.data.size();
+            out.data.resize(outer * index_count * inner);
+            for (int o = 0; o < outer; o++) {
+                for (int i = 0; i < index_count; i++) {
+                    int index = indices.data[i];
+                    index     = index < 0 ? index + axis_size : index;
+                    if (index < 0 || index >= axis_size) {
+                        return Status(TNNERR_PARAM_ERR, "ShapeProgram got invalid gather index");
+                    }
+                    memcpy(out.data.data() + (o * index_count + i) * inner,
+                           data.data.data() + (o * axis_size + index) * inner, inner * sizeof(int));
+                }
+            }
+            break;
+        }
+        case LAYER_CONCAT: {
+            auto param        = dynamic_cast<ConcatLayerParam *>(inst.param.get());
+            const auto &first = values_[inst.inputs[0]];
+            const int rank    = (int)first.dims.size();
+            int axis          = param->axis < 0 ? param->axis + rank : param->axis;
+            if (axis < 0 || axis >= rank) {
+                return Status(TNNERR_INVALID_AXIS, "ShapeProgram got invalid concat axis");
+            }
+            out.dims       = first.dims;
+            out.dims[axis] = 0;
+            for (auto input : inst.inputs) {
+                const auto &dims = values_[input].dims;
+                if ((int)dims.size() != rank ||
+                    DimsVectorUtils::Count(dims, 0, axis) != DimsVectorUtils::Count(first.dims, 0, axis) ||
+                    DimsVectorUtils::Count(dims, axis + 1) != DimsVectorUtils::Count(first.dims, axis + 1)) {
+                    return Status(TNNERR_PARAM_ERR, "ShapeProgram got invalid concat inputs");
+                }
+                out.dims[axis] += dims[axis];
+            }
+            const int outer = DimsVectorUtils::Count(first.dims, 0, axis);
+            for (int o = 0; o < outer; o++) {
+                for (auto input : inst.inputs) {
+                    const auto &value = values_[input];
+                    const int slice   = DimsVectorUtils::Count(value.dims, axis);
+                    out.data.insert(out.data.end(), value.data.begin() + o * slice,
+                                    value.data.begin() + (o + 1) * slice);
+                }
+            }
+            break;
+        }
+        case LAYER_ADD:
+        case LAYER_SUB:
+        case LAYER_MUL:
+        case LAYER_DIV: {
+            if (inst.inputs.size() == 1) {
+                auto param    = dynamic_cast<MultidirBroadcastLayerParam *>(inst.param.get());
+                auto resource = dynamic_cast<EltwiseLayerResource *>(inst.resource.get());
+                Value weight;
+                RETURN_ON_NEQ(LoadBuffer(resource->element_handle, weight), TNN_OK);
+                weight.dims = resource->element_shape;
+                if (weight.data.size() != DimsVectorUtils::Count(weight.dims)) {
+                    return Status(TNNERR_PARAM_ERR, "ShapeProgram got invalid binary weight");
+                }
+                const auto &input = values_[inst.inputs[0]];
+                if (param->weight_input_index == 0) {
+                    RETURN_ON_NEQ(BinaryOp(inst.type, weight, input, out), TNN_OK);
+                } else {
+                    RETURN_ON_NEQ(BinaryOp(inst.type, input, weight, out), TNN_OK);
+                }
+            } else {
+                out = values_[inst.inputs[0]];
+                for (int i = 1; i < inst.inputs.size(); i++) {
+                    Value result;
+                    RETURN_ON_NEQ(BinaryOp(inst.type, out, values_[inst.inputs[i]], result), TNN_OK);
+                    out = result;
+                }
+            }
+            break;
+        }
+        case LAYER_SQUEEZE: {
+            auto param = dynamic_cast<SqueezeLayerParam *>(inst.param.get());
+            out        = values_[inst.inputs[0]];
+            for (auto iter = param->axes.rbegin(); iter != param->axes.rend(); iter++) {
+                int axis = *iter < 0 ? *iter + (int)out.dims.size() : *iter;
+                if (axis < 0 || axis >= out.dims.size() || out.dims[axis] != 1) {
+                    return Status(TNNERR_PARAM_ERR, "ShapeProgram got invalid squeeze axes");
+                }
+                out.dims.erase(out.dims.begin() + axis);
+            }
+            break;
+        }
+        case LAYER_UNSQUEEZE: {
+            auto param = dynamic_cast<SqueezeLayerParam *>(inst.param.get());
+            out        = values_[inst.inputs[0]];
+            for (auto axis : param->axes) {
+                axis = axis < 0 ? axis + (int)out.dims.size() + 1 : axis;
+                if (axis < 0 || axis > out.dims.size()) {
+                    return Status(TNNERR_PARAM_ERR, "ShapeProgram got invalid unsqueeze axes");
+                }
+                out.dims.insert(out.dims.begin() + axis, 1);
+            }
+            break;
+        }
+        case LAYER_CAST:
+            out = values_[inst.inputs[0]];
+            break;
+        case LAYER_STRIDED_SLICE_V2: {
+            auto param        = dynamic_cast<StrideSliceV2LayerParam *>(inst.param.get());
+            const auto &input = values_[inst.inputs[0]];
+            DimsVector begins = inst.inputs.size() >= 2 ? values_[inst.inputs[1]].data : param->begins;
+            DimsVector ends   = inst.inputs.size() >= 3 ? values_[inst.inputs[2]].data : param->ends;
+            DimsVector axes   = param->axes;
+            if (input.dims.size() != 1 || begins.size() != 1 || ends.size() != 1 || (axes[0] != 0 && axes[0] != -1)) {
+                return Status(TNNERR_PARAM_ERR, "ShapeProgram only slices 1d blobs");
+            }
+            Status status = TNN_OK;
+            out.dims = DimsFunctionUtils::StrideSlice(input.dims, begins, ends, param->strides, axes, &status);
+            RETURN_ON_NEQ(status, TNN_OK);
+            for (int i = 0; i < out.dims[0]; i++) {
+                const int index = begins[0] + i * param->strides[0];
+                if (index < 0 || index >= input.dims[0]) {
+                    return Status(TNNERR_PARAM_ERR, "ShapeProgram got invalid slice");
+                }
+                out.data.push_back(input.data[index]);
+            }
+            break;
+        }
+        case LAYER_RANGE: {
+            auto param      = dynamic_cast<RangeLayerParam *>(inst.param.get());
+            RangeData start = param->start, limit = param->limit, delta = param->delta;
+            if (inst.inputs.size() == 3) {
+                for (auto input : inst.inputs) {
+                    if (values_[input].data.empty()) {
+                        return Status(TNNERR_PARAM_ERR, "ShapeProgram got invalid range inputs");
+                    }
+                }
+                start.i = values_[inst.inputs[0]].data[0];
+                limit.i = values_[inst.inputs[1]].data[0];
+                delta.i = values_[inst.inputs[2]].data[0];
+            }
+            if (delta.i == 0) {
+                return Status(TNNERR_PARAM_ERR, "ShapeProgram got invalid range delta");
+            }
+            Status status = TNN_OK;
+            out.dims      = DimsFunctionUtils::Range(start, limit, delta, DATA_TYPE_INT32, &status);
+            RETURN_ON_NEQ(status, TNN_OK);
+            for (int i = 0; i < out.dims[0]; i++) {
+                out.data.push_back(start.i + i * delta.i);
+            }
+            break;
+        }
+        default:
+            return Status(TNNERR_UNSUPPORT_NET, "ShapeProgram got unsupported instruction");
+    }
+    values_[inst.output] = out;
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,85 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_CORE_SHAPE_PROGRAM_H_
+#define TNN_SOURCE_TNN_CORE_SHAPE_PROGRAM_H_
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "tnn/core/blob_manager.h"
+#include "tnn/core/layer_type.h"
+#include "tnn/core/status.h"
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/interpreter/layer_resource.h"
+#include "tnn/interpreter/net_resource.h"
+#include "tnn/interpreter/net_structure.h"
+
+namespace TNN_NS {
+
+// @brief ShapeProgram evaluates the int32 shape subgraph of a network (Shape, Gather, Concat, Range ...)
+// directly from the dims of the network inputs, without running the layers of the const folder.
+class ShapeProgram {
+public:
+    // @brief compile the layers producing the target blobs. it fails if any layer on the way is not
+    // supported, the const folder network must be used in that case.
+    // @param targets names of the blobs to evaluate
+    Status Compile(NetStructure *net_structure, NetResource *net_resource, BlobManager *blob_manager,
+                   const std::set<std::string> &targets);
+
+    // @brief evaluate the program for the dims of the network inputs and save the targets to constant_map
+    Status Run(const BlobShapesMap &input_shapes, ConstantResource &constant_map);
+
+private:
+    struct Value {
+        DimsVector dims;
+        std::vector<int> data;
+    };
+
+    struct Instruction {
+        LayerType type;
+        std::shared_ptr<LayerParam> param;
+        std::shared_ptr<LayerResource> resource;
+        std::vector<int> inputs;
+        int output;
+        // network input of LAYER_SHAPE
+        std::string input_name;
+    };
+
+    Status CompileBlob(const std::string &name, int &index);
+    Status CompileLayer(std::shared_ptr<LayerInfo> layer, int &index);
+    int AddValue(const Value &value);
+    static Status LoadBuffer(RawBuffer &buffer, Value &value);
+
+    Status Execute(const Instruction &inst, const BlobShapesMap &input_shapes);
+    Status BinaryOp(LayerType type, const Value &a, const Value &b, Value &out);
+
+    std::vector<Value> values_;
+    std::vector<Instruction> instructions_;
+    std::vector<std::pair<std::string, int>> targets_;
+
+    // used during Compile only
+    std::map<std::string, int> value_index_;
+    std::map<std::string, std::shared_ptr<LayerInfo>> producers_;
+    NetStructure *net_structure_ = nullptr;
+    NetResource *net_resource_   = nullptr;
+    BlobManager *blob_manager_   = nullptr;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_CORE_SHAPE_PROGRAM_H_
@@ -0,0 +1,418 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/core/tiled_executor.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/utils/dims_utils.h"
+#include "tnn/utils/omp_utils.h"
+#include "tnn/utils/string_format.h"
+
+#if defined(__ANDROID__) || defined(__linux__)
+#include "tnn/utils/cpu_info.h"
+#endif
+
+namespace TNN_NS {
+
+// used when the os does not report the L2 cache size
+static const size_t kDefaultCacheBudget = 1024 * 1024;
+// thinner tiles spend more time on the halo than they save in memory traffic
+static const int kMinTileRows = 4;
+
+static size_t GetCacheBudget() {
+    size_t cache_size = 0;
+#if defined(__ANDROID__) || defined(__linux__)
+    cache_size = cpuinfo_linux_get_cache_size(2);
+#endif
+    return cache_size > 0 ? cache_size : kDefaultCacheBudget;
+}
+
+static size_t GetRowBytes(Blob *blob) {
+    auto dims = blob->GetBlobDesc().dims;
+    return (size_t)dims[0] * dims[1] * dims[3] * sizeof(float);
+}
+
+static size_t GetBlobBytes(Blob *blob) {
+    return GetRowBytes(blob) * blob->GetBlobDesc().dims[2];
+}
+
+// copy rows [src_row, src_row + rows) of every plane of src to rows [dst_row, dst_row + rows) of dst
+static void CopyRows(float *dst, int dst_height, int dst_row, const float *src, int src_height, int src_row,
+                     int rows, int planes, int width) {
+    OMP_PARALLEL_FOR_
+    for (int p = 0; p < planes; p++) {
+        memcpy(dst + ((size_t)p * dst_height + dst_row) * width, src + ((size_t)p * src_height + src_row) * width,
+               (size_t)rows * width * sizeof(float));
+    }
+}
+
+static float *GetBlobData(Blob *blob) {
+    auto handle = blob->GetHandle();
+    return reinterpret_cast<float *>(static_cast<char *>(handle.base) + handle.bytes_offset);
+}
+
+TiledExecutor::~TiledExecutor() {
+    for (auto &chain : chains_) {
+        ReleaseChain(chain);
+    }
+}
+
+bool TiledExecutor::IsTileableLayer(std::shared_ptr<LayerInfo> layer_info, BaseLayer *layer) {
+    if (!layer_info || !layer_info->param || layer_info->param->quantized) {
+        return false;
+    }
+    auto inputs  = layer->GetInputBlobs();
+    auto outputs = layer->GetOutputBlobs();
+    if (inputs.size() != 1 || outputs.size() != 1) {
+        return false;
+    }
+    for (auto blob : {inputs[0], outputs[0]}) {
+        auto &desc = blob->GetBlobDesc();
+        if (desc.dims.size() != 4 || desc.data_type != DATA_TYPE_FLOAT || desc.data_format != DATA_FORMAT_NCHW ||
+            blob->NeedAllocateInForward()) {
+            return false;
+        }
+    }
+
+    switch (layer_info->type) {
+        case LAYER_CONVOLUTION: {
+            auto param = dynamic_cast<ConvLayerParam *>(layer_info->param.get());
+            return param && (param->pad_type == -1 || param->pad_type == 0) && param->fusion_type == FusionType_None &&
+                   param->kernels.size() >= 2 && param->strides.size() >= 2 && param->dialations.size() >= 2 &&
+                   param->pads.size() >= 4;
+        }
+        case LAYER_POOLING: {
+            auto param = dynamic_cast<PoolingLayerParam *>(layer_info->param.get());
+            if (!param || param->is_adaptive_pool || param->is_global_pool || param->kernels_params.size() < 2 ||
+                param->kernels_params[0] <= 0 || param->kernels_params[1] <= 0 || param->pads.size() < 4) {
+                return false;
+            }
+            for (auto index : param->kernel_indexs) {
+                if (index != -1) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case LAYER_RELU:
+        case LAYER_RELU6:
+        case LAYER_PRELU:
+        case LAYER_SIGMOID:
+        case LAYER_TANH:
+        case LAYER_ELU:
+        case LAYER_SELU:
+        case LAYER_GELU:
+        case LAYER_CLIP:
+        case LAYER_HARDSIGMOID:
+        case LAYER_HARDSWISH:
+        case LAYER_BATCH_NORM:
+        case LAYER_SCALE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+Status TiledExecutor::Init(Context *context, AbstractDevice *device, NetStructure *net_structure,
+                           NetResource *net_resource, const std::vector<BaseLayer *> &layers) {
+    context_      = context;
+    device_       = device;
+    net_resource_ = net_resource;
+    if (device->GetDeviceType() != DEVICE_X86 && device->GetDeviceType() != DEVICE_NAIVE) {
+        return TNN_OK;
+    }
+    cache_budget_ = GetCacheBudget();
+
+    std::map<std::string, std::shared_ptr<LayerInfo>> layer_infos;
+    for (auto layer_info : net_structure->layers) {
+        layer_infos[layer_info->name] = layer_info;
+    }
+    std::map<Blob *, int> consumers;
+    for (auto layer : layers) {
+        for (auto blob : layer->GetInputBlobs()) {
+            consumers[blob]++;
+        }
+    }
+
+    // a chain starts at a layer reading a blob larger than the cache and goes on while the blob between
+    // two layers is large, read by the next layer only and not an output of the network
+    int index = 0;
+    while (index < (int)layers.size()) {
+        auto layer = layers[index];
+        if (!IsTileableLayer(layer_infos[layer->GetLayerName()], layer) ||
+            GetBlobBytes(layer->GetInputBlobs()[0]) <= cache_budget_) {
+            index++;
+            continue;
+        }
+
+        Chain chain;
+        chain.begin = index;
+        chain.blobs.push_back(layer->GetInputBlobs()[0]);
+        while (true) {
+            auto layer_info = layer_infos[layers[index]->GetLayerName()];
+            auto output     = layers[index]->GetOutputBlobs()[0];
+            chain.layer_infos.push_back(layer_info);
+            chain.blobs.push_back(output);
+            if (index + 1 >= (int)layers.size()) {
+                break;
+            }
+            auto next = layers[index + 1];
+            if (consumers[output] != 1 || net_structure->outputs.count(output->GetBlobDesc().name) > 0 ||
+                next->GetInputBlobs()[0] != output || !IsTileableLayer(layer_infos[next->GetLayerName()], next) ||
+                GetBlobBytes(output) <= cache_budget_) {
+                break;
+            }
+            index++;
+        }
+        chain.end = ++index;
+
+        if (chain.end - chain.begin >= 2) {
+            LOGD("TiledExecutor: chain of %d layers from %s\n", chain.end - chain.begin,
+                 chain.layer_infos[0]->name.c_str());
+            chain_index_[chain.begin] = (int)chains_.size();
+            chains_.push_back(chain);
+        }
+    }
+    return TNN_OK;
+}
+
+std::set<std::string> TiledExecutor::GetTiledBlobs() {
+    std::set<std::string> tiled_blobs;
+    for (const auto &chain : chains_) {
+        for (int i = 1; i + 1 < (int)chain.blobs.size(); i++) {
+            tiled_blobs.insert(chain.blobs[i]->GetBlobDesc().name);
+        }
+    }
+    return tiled_blobs;
+}
+
+Status TiledExecutor::GetRowGeometry(std::shared_ptr<LayerInfo> layer_info, RowGeometry &geometry) {
+    geometry = RowGeometry();
+    if (layer_info->type == LAYER_CONVOLUTION) {
+        auto param = dynamic_cast<ConvLayerParam *>(layer_info->param.get());
+        CHECK_PARAM_NULL(param);
+        geometry.extent  = param->dialations[1] * (param->kernels[1] - 1) + 1;
+        geometry.stride  = param->strides[1];
+        geometry.pad_top = param->pads[2];
+    } else if (layer_info->type == LAYER_POOLING) {
+        auto param = dynamic_cast<PoolingLayerParam *>(layer_info->param.get());
+        CHECK_PARAM_NULL(param);
+        geometry.extent  = param->kernels[1];
+        geometry.stride  = param->strides[1];
+        geometry.pad_top = param->pads[2];
+    }
+    if (geometry.extent <= 0 || geometry.stride <= 0) {
+        return Status(TNNERR_PARAM_ERR, "TiledExecutor: invalid kernel or stride");
+    }
+    return TNN_OK;
+}
+
+void TiledExecutor::ReleaseChain(Chain &chain) {
+    for (auto &config : chain.configs) {
+        for (auto layer : config.layers) {
+            delete layer;
+        }
+        for (auto blob : config.blobs) {
+            delete blob;
+        }
+    }
+    chain.configs.clear();
+    chain.tiles.clear();
+}
+
+Status TiledExecutor::CreateTileConfig(Chain &chain, const std::vector<int> &rows, const std::vector<int> &pads,
+                                       TileConfig &config) {
+    for (int i = 0; i < (int)chain.blobs.size(); i++) {
+        BlobDesc desc = chain.blobs[i]->GetBlobDesc();
+        desc.dims[2]  = rows[i];
+        auto blob     = new Blob(desc, true);
+        config.blobs.push_back(blob);
+        if (blob->GetHandle().base == nullptr) {
+            return Status(TNNERR_OUTOFMEMORY, "TiledExecutor: allocate tile blob failed");
+        }
+    }
+
+    for (int i = 0; i < (int)chain.layer_infos.size(); i++) {
+        auto layer_info = chain.layer_infos[i];
+        auto param      = layer_info->param->Copy();
+        CHECK_PARAM_NULL(param.get());
+        // the pads of the full layer are resolved by its reshape, the tile keeps the horizontal ones and pads
+        // the rows it reads beyond the borders of the blob
+        if (layer_info->type == LAYER_CONVOLUTION) {
+            auto conv_param      = dynamic_cast<ConvLayerParam *>(param.get());
+            conv_param->pad_type = -1;
+            conv_param->pads[2]  = pads[2 * i];
+            conv_param->pads[3]  = pads[2 * i + 1];
+        } else if (layer_info->type == LAYER_POOLING) {
+            auto pool_param       = dynamic_cast<PoolingLayerParam *>(param.get());
+            pool_param->pad_type  = -1;
+            pool_param->ceil_mode = 0;
+            pool_param->pads[2]   = pads[2 * i];
+            pool_param->pads[3]   = pads[2 * i + 1];
+        }
+        config.params.push_back(param);
+
+        BaseLayer *layer = CreateLayer(layer_info->type);
+        if (layer == nullptr) {
+            return Status(TNNERR_PARAM_ERR, "TiledExecutor: CreateLayer failed");
+        }
+        config.layers.push_back(layer);
+        layer->SetLayerName(layer_info->name);
+        layer->SetConstantResource(&net_resource_->constant_map);
+        layer->SetConstantResourceFlag(&net_resource_->constant_blob_flags);
+
+        LayerResource *resource = nullptr;
+        if (net_resource_->resource_map.count(layer_info->name) != 0) {
+            resource = net_resource_->resource_map[layer_info->name].get();
+        }
+        std::vector<Blob *> inputs  = {config.blobs[i]};
+        std::vector<Blob *> outputs = {config.blobs[i + 1]};
+        auto expected_dims          = outputs[0]->GetBlobDesc().dims;
+        RETURN_ON_NEQ(layer->Init(context_, param.get(), resource, inputs, outputs, device_), TNN_OK);
+        RETURN_ON_NEQ(layer->Reshape(), TNN_OK);
+        if (!DimsVectorUtils::Equal(outputs[0]->GetBlobDesc().dims, expected_dims)) {
+            LOGE("TiledExecutor: tile of layer %s has dims %s, expected %s\n", layer_info->name.c_str(),
+                 DimsToString(outputs[0]->GetBlobDesc().dims).c_str(), DimsToString(expected_dims).c_str());
+            return Status(TNNERR_LAYER_ERR, "TiledExecutor: unexpected tile dims");
+        }
+    }
+    return TNN_OK;
+}
+
+Status TiledExecutor::PlanChain(Chain &chain) {
+    ReleaseChain(chain);
+
+    const int layer_count = (int)chain.layer_infos.size();
+    std::vector<RowGeometry> geometries(layer_count);
+    for (int i = 0; i < layer_count; i++) {
+        RETURN_ON_NEQ(GetRowGeometry(chain.layer_infos[i], geometries[i]), TNN_OK);
+    }
+    std::vector<int> heights;
+    std::vector<size_t> row_bytes;
+    for (auto blob : chain.blobs) {
+        heights.push_back(blob->GetBlobDesc().dims[2]);
+        row_bytes.push_back(GetRowBytes(blob));
+    }
+    const int output_height = heights[layer_count];
+
+    // the working set of a tile is the tile of every blob in the chain, pick the highest tile that fits
+    auto working_set = [&](int tile_rows) {
+        int rows     = tile_rows;
+        size_t bytes = rows * row_bytes[layer_count];
+        for (int i = layer_count - 1; i >= 0; i--) {
+            rows = std::min(heights[i], (rows - 1) * geometries[i].stride + geometries[i].extent);
+            bytes += rows * row_bytes[i];
+        }
+        return bytes;
+    };
+    int tile_rows = output_height;
+    while (tile_rows > kMinTileRows && working_set(tile_rows) > cache_budget_) {
+        tile_rows--;
+    }
+
+    std::map<std::vector<int>, int> config_index;
+    for (int begin = 0; begin < output_height; begin += tile_rows) {
+        int end = std::min(begin + tile_rows, output_height);
+
+        // rows of every blob read by the tile, and the rows padded above and below by every layer
+        std::vector<int> rows(layer_count + 1);
+        std::vector<int> pads(2 * layer_count);
+        int row_begin     = begin;
+        int row_end       = end;
+        rows[layer_count] = end - begin;
+        for (int i = layer_count - 1; i >= 0; i--) {
+            const auto &geometry = geometries[i];
+            int read_begin       = row_begin * geometry.stride - geometry.pad_top;
+            int read_end         = (row_end - 1) * geometry.stride - geometry.pad_top + geometry.extent;
+            row_begin            = std::max(read_begin, 0);
+            row_end              = std::min(read_end, heights[i]);
+            pads[2 * i]          = row_begin - read_begin;
+            pads[2 * i + 1]      = read_end - row_end;
+            rows[i]              = row_end - row_begin;
+        }
+
+        std::vector<int> signature = rows;
+        signature.insert(signature.end(), pads.begin(), pads.end());
+        if (config_index.count(signature) == 0) {
+            config_index[signature] = (int)chain.configs.size();
+            chain.configs.push_back(TileConfig());
+            RETURN_ON_NEQ(CreateTileConfig(chain, rows, pads, chain.configs.back()), TNN_OK);
+        }
+
+        Tile tile;
+        tile.config       = config_index[signature];
+        tile.input_begin  = row_begin;
+        tile.input_end    = row_end;
+        tile.output_begin = begin;
+        tile.output_end   = end;
+        chain.tiles.push_back(tile);
+    }
+    LOGD("TiledExecutor: chain from %s runs %d tiles of %d rows in %d configs\n",
+         chain.layer_infos[0]->name.c_str(), (int)chain.tiles.size(), tile_rows, (int)chain.configs.size());
+    return TNN_OK;
+}
+
+Status TiledExecutor::Reshape() {
+    for (auto &chain : chains_) {
+        RETURN_ON_NEQ(PlanChain(chain), TNN_OK);
+    }
+    return TNN_OK;
+}
+
+int TiledExecutor::GetChainLength(int layer_index) {
+    auto iter = chain_index_.find(layer_index);
+    if (iter == chain_index_.end()) {
+        return 0;
+    }
+    const auto &chain = chains_[iter->second];
+    return chain.end - chain.begin;
+}
+
+Status TiledExecutor::Forward(int layer_index) {
+    auto iter = chain_index_.find(layer_index);
+    if (iter == chain_index_.end()) {
+        return Status(TNNERR_PARAM_ERR, "TiledExecutor: no chain starts at the layer");
+    }
+    auto &chain        = chains_[iter->second];
+    auto input         = chain.blobs.front();
+    auto output        = chain.blobs.back();
+    auto input_dims    = input->GetBlobDesc().dims;
+    auto output_dims   = output->GetBlobDesc().dims;
+    float *input_data  = GetBlobData(input);
+    float *output_data = GetBlobData(output);
+
+    for (const auto &tile : chain.tiles) {
+        auto &config    = chain.configs[tile.config];
+        auto tile_input = config.blobs.front();
+        auto tile_rows  = tile.input_end - tile.input_begin;
+        CopyRows(GetBlobData(tile_input), tile_rows, 0, input_data, input_dims[2], tile.input_begin, tile_rows,
+                 input_dims[0] * input_dims[1], input_dims[3]);
+
+        for (auto layer : config.layers) {
+            RETURN_ON_NEQ(layer->Forward(), TNN_OK);
+        }
+
+        auto tile_output = config.blobs.back();
+        tile_rows        = tile.output_end - tile.output_begin;
+        CopyRows(output_data, output_dims[2], tile.output_begin, GetBlobData(tile_output), tile_rows, 0, tile_rows,
+                 output_dims[0] * output_dims[1], output_dims[3]);
+    }
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
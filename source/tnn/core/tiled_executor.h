@@ -0,0 +1,111 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_CORE_TILED_EXECUTOR_H_
+#define TNN_SOURCE_TNN_CORE_TILED_EXECUTOR_H_
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "tnn/core/abstract_device.h"
+#include "tnn/core/blob.h"
+#include "tnn/core/context.h"
+#include "tnn/core/status.h"
+#include "tnn/interpreter/net_resource.h"
+#include "tnn/interpreter/net_structure.h"
+#include "tnn/layer/base_layer.h"
+
+namespace TNN_NS {
+
+// @brief TiledExecutor runs chains of spatially local layers (conv, pooling, activation) on large inputs
+// depth first. The output of a chain is split into bands of rows, and for each band the rows of the chain
+// input it depends on, halo included, run through the whole chain in small tile blobs. The blobs inside a
+// chain are never allocated, and the working set of a tile is chosen to fit in the L2 cache.
+class TiledExecutor {
+public:
+    ~TiledExecutor();
+
+    // @brief find the chains among the layers of the network, the blob shapes must be inferred
+    Status Init(Context *context, AbstractDevice *device, NetStructure *net_structure, NetResource *net_resource,
+                const std::vector<BaseLayer *> &layers);
+
+    // @brief blobs inside the chains, they get no memory from the blob manager
+    std::set<std::string> GetTiledBlobs();
+
+    // @brief plan the tiles for the current blob shapes, call it after the layers are reshaped
+    Status Reshape();
+
+    // @brief number of layers run by the chain starting at the layer, 0 if no chain starts there
+    int GetChainLength(int layer_index);
+
+    // @brief run the chain starting at the layer
+    Status Forward(int layer_index);
+
+private:
+    // vertical geometry of a layer, output row r reads input rows [r * stride - pad_top, + extent)
+    struct RowGeometry {
+        int extent  = 1;
+        int stride  = 1;
+        int pad_top = 0;
+    };
+
+    // layers and blobs of a tile shape, shared by the tiles with the same rows and pads
+    struct TileConfig {
+        std::vector<std::shared_ptr<LayerParam>> params;
+        std::vector<BaseLayer *> layers;
+        std::vector<Blob *> blobs;
+    };
+
+    struct Tile {
+        int config;
+        // rows of the chain input read by the tile
+        int input_begin;
+        int input_end;
+        // rows of the chain output written by the tile
+        int output_begin;
+        int output_end;
+    };
+
+    struct Chain {
+        int begin;
+        int end;
+        std::vector<std::shared_ptr<LayerInfo>> layer_infos;
+        // chain input, the blobs inside the chain and the chain output
+        std::vector<Blob *> blobs;
+        std::vector<TileConfig> configs;
+        std::vector<Tile> tiles;
+    };
+
+    bool IsTileableLayer(std::shared_ptr<LayerInfo> layer_info, BaseLayer *layer);
+    Status GetRowGeometry(std::shared_ptr<LayerInfo> layer_info, RowGeometry &geometry);
+    Status PlanChain(Chain &chain);
+    Status CreateTileConfig(Chain &chain, const std::vector<int> &rows, const std::vector<int> &pads,
+                            TileConfig &config);
+    void ReleaseChain(Chain &chain);
+
+    Context *context_          = nullptr;
+    AbstractDevice *device_    = nullptr;
+    NetResource *net_resource_ = nullptr;
+    std::vector<Chain> chains_;
+    // chain by the index of its first layer
+    std::map<int, int> chain_index_;
+    size_t cache_budget_ = 0;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_CORE_TILED_EXECUTOR_H_
@@ -42,22 +42,18 @@ ArmDevice::ArmDevice(DeviceType device_type) : AbstractDevice(device_type) {}
 ArmDevice::~ArmDevice() {}
 
 BlobMemorySizeInfo ArmDevice::Calculate1DMemorySize(BlobDesc &desc) {
-    BlobMemorySizeInfo info;
-    info.data_type = desc.data_type;
-    int count      = 1;
+    int64_t count = 1;
     if (desc.data_format == DATA_FORMAT_NCHW || desc.data_format == DATA_FORMAT_AUTO) {
         for (auto d : desc.dims)
             count *= d;
     } else {
         // packed format
-        if (desc.data_type == DATA_TYPE_HALF) {
-            count = DimsFunctionUtils::GetDim(desc.dims, 0) * ROUND_UP(DimsFunctionUtils::GetDim(desc.dims, 1), 8) * DimsVectorUtils::Count(desc.dims, 2);
-        } else {
-            count = DimsFunctionUtils::GetDim(desc.dims, 0) * ROUND_UP(DimsFunctionUtils::GetDim(desc.dims, 1), 4) * DimsVectorUtils::Count(desc.dims, 2);
-        }
+        const int pack = desc.data_type == DATA_TYPE_HALF ? 8 : 4;
+        count = (int64_t)DimsFunctionUtils::GetDim(desc.dims, 0) * ROUND_UP(DimsFunctionUtils::GetDim(desc.dims, 1), pack);
+        for (int i = 2; i < desc.dims.size(); ++i)
+            count *= desc.dims[i];
     }
-    info.dims.push_back(count);
-    return info;
+    return Get1DBlobMemorySizeInfo(desc.data_type, count);
 }
 
 BlobMemorySizeInfo ArmDevice::Calculate(BlobDesc &desc) {
@@ -89,8 +85,11 @@ Status ArmDevice::Allocate(void **handle, MatType mat_type, DimsVector dims) {
 
 Status ArmDevice::Allocate(void **handle, BlobMemorySizeInfo &size_info) {
     if (handle) {
-        int bytes_size = GetBlobMemoryBytesSize(size_info);
-        *handle        = armMalloc(bytes_size + NEON_KERNEL_EXTRA_LOAD);
+        auto bytes_size = GetBlobMemoryBytesSize(size_info);
+        if (bytes_size < 0) {
+            return Status(TNNERR_PARAM_ERR, "ArmDevice::Allocate malloc bytes size < 0");
+        }
+        *handle = armMalloc(bytes_size + NEON_KERNEL_EXTRA_LOAD);
     }
     return TNN_OK;
 }
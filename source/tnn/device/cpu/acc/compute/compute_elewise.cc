@@ -134,4 +134,23 @@ void CPU_SQUARED_DIFFERENCE(const std::vector<void *> &input_ptrs, const std::ve
     CPU_ELEWISE(input_ptrs, input_shapes, output, shape_output, squared_difference_op);
 }
 
+/*
+ * data[i] = activation(data[i]), for the activation fused into a layer param
+ */
+void CPU_ACTIVATION(float *data, int count, int activation_type) {
+    for (int i = 0; i < count; i++) {
+        float v = data[i];
+        if (activation_type == ActivationType_ReLU) {
+            v = v > 0.0f ? v : 0.0f;
+        } else if (activation_type == ActivationType_ReLU6) {
+            v = v > 0.0f ? (v < 6.0f ? v : 6.0f) : 0.0f;
+        } else if (activation_type == ActivationType_SIGMOID_MUL) {
+            v = v / (1.0f + expf(-v));
+        } else if (activation_type == ActivationType_GELU) {
+            v = 0.5f * v * (erff(v * 0.707106793288165f) + 1.0f);
+        }
+        data[i] = v;
+    }
+}
+
 }  // namespace TNN_NS
@@ -145,5 +145,8 @@ void CPU_SUB(const std::vector<void *> &input_ptrs, const std::vector<DimsVector
 
 void CPU_SQUARED_DIFFERENCE(const std::vector<void *> &input_ptrs, const std::vector<DimsVector> &input_shapes,
                             void *output, DimsVector shape_output);
+
+// apply the activation fused into a layer param on data in place
+void CPU_ACTIVATION(float *data, int count, int activation_type);
 }  // namespace TNN_NS
 #endif  // TNN_CPU_COMPUTE_ELEWISE_H_
@@ -14,6 +14,7 @@
 
 #include <cmath>
 #include "tnn/device/cpu/acc/cpu_layer_acc.h"
+#include "tnn/device/cpu/acc/compute/compute_elewise.h"
 #include "tnn/utils/data_type_utils.h"
 #include "tnn/utils/dims_utils.h"
 
@@ -54,6 +55,26 @@ Status CpuGroupNormLayerAcc::Forward(const std::vector<Blob *> &inputs, const st
     if (output_blob->GetBlobDesc().data_type == DATA_TYPE_FLOAT) {
         float *input_data  = (float *)((char *)input_blob->GetHandle().base+ input_blob->GetHandle().bytes_offset);
         float *output_data = (float *)((char *)output_blob->GetHandle().base + output_blob->GetHandle().bytes_offset);
+        const auto dims_output = output_blob->GetBlobDesc().dims;
+        const int count        = DimsVectorUtils::Count(dims_output);
+
+        // the residual fused by net_optimizer_fuse_norm, outputs[1] keeps the sum if present
+        std::vector<float> sum_buffer;
+        if (inputs.size() > 3) {
+            Blob *residual_blob = inputs[3];
+            float *sum_data     = nullptr;
+            if (outputs.size() > 1) {
+                sum_data = (float *)((char *)outputs[1]->GetHandle().base + outputs[1]->GetHandle().bytes_offset);
+            } else {
+                sum_buffer.resize(count);
+                sum_data = sum_buffer.data();
+            }
+            void *residual_data = (char *)residual_blob->GetHandle().base + residual_blob->GetHandle().bytes_offset;
+            CPU_ADD({input_data, residual_data},
+                    {input_blob->GetBlobDesc().dims, residual_blob->GetBlobDesc().dims}, sum_data, dims_output);
+            input_data = sum_data;
+        }
+        float *output_begin = output_data;
         //浮点运算在累加时存在大数吃小数情况，造成误差大，instancenorm累加次数大，更容易出现
         //可考虑用Kahan公式或者用double运算，最后转换成float
         // https://blog.csdn.net/weixin_34268753/article/details/85917630
@@ -90,6 +111,9 @@ Status CpuGroupNormLayerAcc::Forward(const std::vector<Blob *> &inputs, const st
                 }
             }
         }
+        if (layer_param->activation_type != ActivationType_None) {
+            CPU_ACTIVATION(output_begin, count, layer_param->activation_type);
+        }
     } else {
         LOGE("Error: CpuGroupNormLayerAcc layer acc dont support datatype: %d\n", output_blob->GetBlobDesc().data_type);
         return Status(TNNERR_MODEL_ERR, "Error: CpuGroupNormLayerAcc layer acc dont support datatype");
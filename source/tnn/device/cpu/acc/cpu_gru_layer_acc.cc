@@ -0,0 +1,174 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <cmath>
+
+#include "cpu_layer_acc.h"
+#include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+DECLARE_CPU_ACC(GRUONNX, LAYER_GRUONNX);
+
+static Status GRU_Single(const float *x, float *y, const float *w, const float *r, const float *b, float *h_t,
+                         const int T, const int batch_size, const int input_size, const int hidden_size, int reverse,
+                         int linear_before_reset) {
+    // W[zrh], weight tensor for the gates, shape [3*hidden_size, input_size]
+    auto w_z = w;
+    auto w_r = w_z + hidden_size * input_size;
+    auto w_h = w_r + hidden_size * input_size;
+    // R[zrh], recurrence weight tensor, shape [3*hidden_size, hidden_size]
+    auto r_z = r;
+    auto r_r = r_z + hidden_size * hidden_size;
+    auto r_h = r_r + hidden_size * hidden_size;
+    // B[zrh] Concatenation of [Wb[zrh], Rb[zrh]], [6*hidden_size], zero if not specified
+    std::vector<float> zero_bias(6 * hidden_size, 0.f);
+    if (!b) {
+        b = zero_bias.data();
+    }
+    auto wb_z = b, wb_r = b + hidden_size, wb_h = b + 2 * hidden_size;
+    auto rb_z = b + 3 * hidden_size, rb_r = b + 4 * hidden_size, rb_h = b + 5 * hidden_size;
+
+    std::vector<float> z(hidden_size), rg(hidden_size), rh(hidden_size), h_new(hidden_size);
+    for (int t = 0; t < T; t++) {
+        int ti = reverse ? T - 1 - t : t;
+        for (int n = 0; n < batch_size; n++) {
+            const float *x_n = x + (ti * batch_size + n) * input_size;
+            float *h_n       = h_t + n * hidden_size;
+            float *y_n       = y + (ti * batch_size + n) * hidden_size;
+
+            for (int j = 0; j < hidden_size; j++) {
+                float sum_z = wb_z[j] + rb_z[j], sum_r = wb_r[j] + rb_r[j];
+                for (int k = 0; k < input_size; k++) {
+                    sum_z += w_z[j * input_size + k] * x_n[k];
+                    sum_r += w_r[j * input_size + k] * x_n[k];
+                }
+                for (int k = 0; k < hidden_size; k++) {
+                    sum_z += r_z[j * hidden_size + k] * h_n[k];
+                    sum_r += r_r[j * hidden_size + k] * h_n[k];
+                }
+                z[j]  = 1.f / (1.f + std::exp(-sum_z));
+                rg[j] = 1.f / (1.f + std::exp(-sum_r));
+                rh[j] = rg[j] * h_n[j];
+            }
+
+            for (int j = 0; j < hidden_size; j++) {
+                float sum_x = wb_h[j];
+                for (int k = 0; k < input_size; k++) {
+                    sum_x += w_h[j * input_size + k] * x_n[k];
+                }
+                float sum_h = rb_h[j];
+                const float *h_src = linear_before_reset ? h_n : rh.data();
+                for (int k = 0; k < hidden_size; k++) {
+                    sum_h += r_h[j * hidden_size + k] * h_src[k];
+                }
+                float cand = linear_before_reset ? std::tanh(sum_x + rg[j] * sum_h) : std::tanh(sum_x + sum_h);
+                h_new[j]   = (1.f - z[j]) * cand + z[j] * h_n[j];
+            }
+
+            memcpy(h_n, h_new.data(), hidden_size * sizeof(float));
+            memcpy(y_n, h_new.data(), hidden_size * sizeof(float));
+        }
+    }
+    return TNN_OK;
+}
+
+Status CpuGRUONNXLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return TNN_OK;
+}
+
+Status CpuGRUONNXLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto layer_param = dynamic_cast<GRUONNXLayerParam *>(param_);
+    CHECK_PARAM_NULL(layer_param);
+    int num_directions = layer_param->direction >= 2 ? 2 : 1;
+    if (inputs.size() < 3) {
+        return Status(TNNERR_LAYER_ERR, "GRU has invalid inputs");
+    }
+
+    const auto input_dims  = inputs[0]->GetBlobDesc().dims;
+    const auto T           = input_dims[0];                          // length of sequence
+    const auto batch       = input_dims[1];                          // batch_size
+    const auto input_size  = DimsVectorUtils::Count(input_dims, 2);  // input dimension
+    const auto hidden_size = layer_param->hidden_size;               // output dimension
+
+    // convert half weights to float
+    std::vector<std::vector<float>> weights;
+    auto get_blob_data = [&](Blob *blob) -> float * {
+        auto data = (char *)(blob->GetHandle().base) + blob->GetHandle().bytes_offset;
+        if (blob->GetBlobDesc().data_type != DATA_TYPE_HALF) {
+            return (float *)data;
+        }
+        const int count = DimsVectorUtils::Count(blob->GetBlobDesc().dims);
+        weights.emplace_back(count);
+        ConvertFromHalfToFloat((void *)data, weights.back().data(), count);
+        return weights.back().data();
+    };
+    weights.reserve(3);
+
+    float *x = (float *)((char *)(inputs[0]->GetHandle().base) + inputs[0]->GetHandle().bytes_offset);
+    float *y = (float *)((char *)(outputs[0]->GetHandle().base) + outputs[0]->GetHandle().bytes_offset);
+    float *w = get_blob_data(inputs[1]);
+    float *r = get_blob_data(inputs[2]);
+    float *b = inputs.size() >= 4 ? get_blob_data(inputs[3]) : nullptr;
+
+    // Y_h, shape [num_directions, batch_size, hidden_size]
+    std::vector<float> h_temp;
+    float *h_t = nullptr;
+    if (outputs.size() >= 2) {
+        h_t = (float *)((char *)(outputs[1]->GetHandle().base) + outputs[1]->GetHandle().bytes_offset);
+    } else {
+        h_temp.resize(num_directions * batch * hidden_size);
+        h_t = h_temp.data();
+    }
+    if (inputs.size() >= 5) {
+        auto h_0 = (float *)((char *)(inputs[4]->GetHandle().base) + inputs[4]->GetHandle().bytes_offset);
+        memcpy((void *)h_t, h_0, num_directions * batch * hidden_size * sizeof(float));
+    } else {
+        memset(h_t, 0, num_directions * batch * hidden_size * sizeof(float));
+    }
+
+    const int lbr = layer_param->linear_before_reset;
+    if (layer_param->direction == 0 || layer_param->direction == 1) {
+        return GRU_Single(x, y, w, r, b, h_t, T, batch, input_size, hidden_size, layer_param->direction, lbr);
+    } else if (layer_param->direction == 2) {
+        // Y shape [num_directions sequence batch_size hidden_size]
+        std::vector<float> y_temp(num_directions * T * batch * hidden_size);
+        auto y0 = y_temp.data();
+        auto y1 = y0 + T * batch * hidden_size;
+        GRU_Single(x, y0, w, r, b, h_t, T, batch, input_size, hidden_size, 0, lbr);
+
+        auto w1   = w + 3 * hidden_size * input_size;
+        auto r1   = r + 3 * hidden_size * hidden_size;
+        auto b1   = b ? b + 6 * hidden_size : nullptr;
+        auto h_t1 = h_t + batch * hidden_size;
+        GRU_Single(x, y1, w1, r1, b1, h_t1, T, batch, input_size, hidden_size, 1, lbr);
+
+        // transpose [num_directions sequence batch_size hidden_size] to [sequence batch_size
+        // num_directions*hidden_size]
+        for (int i = 0; i < T * batch; i++) {
+            memcpy(y + i * num_directions * hidden_size, y0 + i * hidden_size, hidden_size * sizeof(float));
+            memcpy(y + i * num_directions * hidden_size + hidden_size, y1 + i * hidden_size,
+                   hidden_size * sizeof(float));
+        }
+    } else {
+        return Status(TNNERR_PARAM_ERR, "GRUONNX has invalid direction param");
+    }
+
+    return TNN_OK;
+}
+
+REGISTER_CPU_ACC(GRUONNX, LAYER_GRUONNX);
+
+}  // namespace TNN_NS
@@ -17,7 +17,9 @@
 #include "tnn/interpreter/layer_resource_generator.h"
 #include "tnn/utils/bfp16.h"
 #include "tnn/utils/bfp16_utils.h"
+#include "tnn/utils/dims_utils.h"
 #include "tnn/utils/naive_compute.h"
+#include "tnn/utils/weight_quant_utils.h"
 
 namespace TNN_NS {
 
@@ -47,6 +49,16 @@ Status CpuInnerProductLayerAcc::Init(Context *context, LayerParam *param, LayerR
     CHECK_PARAM_NULL(layer_param);
     auto layer_res = dynamic_cast<InnerProductLayerResource *>(resource_);
     CHECK_PARAM_NULL(layer_res);
+    if (!layer_param->quantized && layer_param->weight_quant_bits > 0 &&
+        layer_res->weight_handle.GetDataType() == DATA_TYPE_INT8) {
+        // weight-only quantization, fp32_resource_ is owned by this acc
+        int oc = layer_param->num_output;
+        int ic = DimsVectorUtils::Count(inputs[0]->GetBlobDesc().dims, 1);
+        RETURN_ON_NEQ(DequantizeWeightOnly(layer_res->weight_handle, layer_res->scale_handle, oc, ic,
+                                           layer_param->weight_quant_bits, layer_param->weight_quant_group,
+                                           layer_res->weight_handle),
+                      TNN_OK);
+    }
     if (outputs[0]->GetBlobDesc().data_type == DATA_TYPE_INT8) {
         if (!buffer_scale_.GetBytesSize()) {
             auto dims_output    = outputs[0]->GetBlobDesc().dims;
@@ -39,6 +39,7 @@ Status CpuLayerAcc::ReloadConstantBlobs(const std::vector<Blob *> &inputs, bool
     auto const_resource = const_resource_;
     auto const_resource_flag = const_resource_flag_;
     auto const_blob_map = const_blob_map_;
+    auto const_buffer_map = const_buffer_map_;
     for (auto iter : inputs) {
         auto name = iter->GetBlobDesc().name;
         if (const_resource == nullptr || const_resource->find(name) == const_resource->end()) {
@@ -50,20 +51,20 @@ Status CpuLayerAcc::ReloadConstantBlobs(const std::vector<Blob *> &inputs, bool
             continue;
         }
         
+        // the constants are immutable and shared by the instances of the model, the blob reads them in place
         auto buffer = (*const_resource)[name];
         std::shared_ptr<Blob> blob = nullptr;
-        if (const_blob_map.find(name) != const_blob_map.end()) {
-            blob = const_blob_map[name];
-        }
-        auto status = RawBuffer2Blob(buffer.get(), blob);
+        auto status = RawBuffer2SharedBlob(buffer.get(), blob);
         RETURN_ON_NEQ(status, TNN_OK);
 
         blob->SetFlag(DATA_FLAG_CHANGE_NEVER);
         const_blob_map[name] = blob;
+        const_buffer_map[name] = buffer;
         iter->SetHandle(blob->GetHandle());
         LOGD("Reload constant blob: %s %p\n", name.c_str(), &blob);
     }
     const_blob_map_ = const_blob_map;
+    const_buffer_map_ = const_buffer_map;
     return TNN_OK;
 }
 
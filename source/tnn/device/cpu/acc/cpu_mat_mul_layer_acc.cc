@@ -95,6 +95,11 @@ Status CpuMatMulLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::
         int batch_a   = count_a / (M * N);
         int batch_b   = count_b / (N * K);
         int batch_c   = count_c / (M * K);
+        // element strides of the operands, swapped if the blob holds the transposed matrix
+        int a_stride_m = param->transpose_a ? 1 : N;
+        int a_stride_n = param->transpose_a ? M : 1;
+        int b_stride_n = param->transpose_b ? 1 : K;
+        int b_stride_k = param->transpose_b ? N : 1;
         for (int bc = 0; bc < batch_c; ++bc) {
             int ba = bc % batch_a;
             int bb = bc % batch_b;
@@ -105,7 +110,8 @@ Status CpuMatMulLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::
                     //or for align with bert model, use COSINE distance ??? not checked
                     double sum = 0;
                     for (int n = 0; n < N; ++n) {
-                        sum += double(matrix_a[ba * M * N + m * N + n]) * double(matrix_b[bb * N * K + n * K + k]);
+                        sum += double(matrix_a[ba * M * N + m * a_stride_m + n * a_stride_n]) *
+                               double(matrix_b[bb * N * K + n * b_stride_n + k * b_stride_k]);
                     }
                     matrix_c[bc * M * K + m * K + k] = float(sum);
                 }
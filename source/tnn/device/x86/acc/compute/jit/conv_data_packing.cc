@@ -204,4 +204,26 @@ void pack_col_a_t(
 template void pack_col_a_t<float>(const float * a, dim_t lda, float * b, dim_t ldb, 
                    dim_t m, dim_t n, conv_gemm_config<float, float, float> &conv_gemm_conf);
 
+//  pack block_size on leading dimension, t denotes transpose.
+//  eg. input:   A MxN matrix in row major, so the storage-format is (M, N)
+//      output:  B MxN matrix in col major(N-packed), the same format as pack_col_b_n
+template<typename T>
+void pack_col_b_t(const T * a, dim_t lda, T * b, dim_t ldb, dim_t m, dim_t n, conv_gemm_config<T, T, T> &conv_gemm_conf)
+{
+    dim_t block_size = conv_gemm_conf.n_block_;
+    for (dim_t i = 0; i < n; i += block_size) {
+        dim_t cur_n = std::min(n - i, block_size);
+        const T * cur_a = a + i;
+        T * cur_b = b + i * ldb;
+        for (dim_t k = 0; k < m; k++) {
+            for (dim_t j = 0; j < cur_n; j++) {
+                cur_b[k * block_size + j] = cur_a[k * lda + j];
+            }
+        }
+    }
+}
+
+template void pack_col_b_t<float>(const float * a, dim_t lda, float * b, dim_t ldb,
+                   dim_t m, dim_t n, conv_gemm_config<float, float, float> &conv_gemm_conf);
+
 } // namespace tnn
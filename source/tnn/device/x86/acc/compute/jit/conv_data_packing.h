@@ -31,6 +31,9 @@ void pack_col_b_n(const T * a, dim_t lda, T * b, dim_t ldb, dim_t m, dim_t n, co
 template<typename T>
 void pack_col_a_t(const T * a, dim_t lda, T * b, dim_t ldb, dim_t m, dim_t n, conv_gemm_config<T, T, T> &conv_gemm_conf);
 
+template<typename T>
+void pack_col_b_t(const T * a, dim_t lda, T * b, dim_t ldb, dim_t m, dim_t n, conv_gemm_config<T, T, T> &conv_gemm_conf);
+
 } // namespace tnn
 
 #endif //TNN_JIT_DATA_PACKING_H_
\ No newline at end of file
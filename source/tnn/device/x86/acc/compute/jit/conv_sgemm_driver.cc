@@ -22,6 +22,7 @@
 #include "tnn/device/x86/acc/compute/jit/conv_gemm_config.h"
 #include "tnn/device/x86/acc/compute/jit/utils/timer.hpp"
 #include "tnn/device/x86/acc/compute/jit/conv_sgemm_driver.h"
+#include "tnn/device/x86/acc/compute/x86_compute.h"
 #include "tnn/utils/omp_utils.h"
 #include <xbyak/xbyak.h>
 
@@ -39,6 +40,14 @@ void conv_sgemm_block_n(
     dim_t K_c = conv_gemm_conf.K_c_;
     dim_t m_block = conv_gemm_conf.m_block_;
 
+    // the jit kernels fuse relu and relu6, other activations are applied
+    // on the output tile right after the kernel stores it, while it is still in L1
+    dim_t kernel_act_type = act_type;
+    if (act_type != ActivationType_ReLU && act_type != ActivationType_ReLU6) {
+        kernel_act_type = ActivationType_None;
+    }
+    auto post_func = m_block >= 8 ? X86ActivationPost<Float8, 8> : X86ActivationPost<Float4, 4>;
+
     for(dim_t i=0;i<M;)  {
         dim_t cur_m = MIN(M - i, conv_gemm_conf.kernel_m_r_);
 
@@ -46,47 +55,32 @@ void conv_sgemm_block_n(
         const float * cur_b = src_b;
         float * cur_c = dst + i;
 
-        switch(cur_m) {
-            case 1:
-                conv_gemm_conf.kernels_[1][N](K, cur_a, lda, cur_b, ldb, cur_c, ldc, bias, first, act_type);
-                i+=1;
-                break;
-            case 2:
-            case 3:
-                conv_gemm_conf.kernels_[2][N](K, cur_a, lda, cur_b, ldb, cur_c, ldc, bias, first, act_type);
-                i+=2;
-                break;
-            case 4:
-            case 5:
-            case 6:
-            case 7:
-                conv_gemm_conf.kernels_[4][N](K, cur_a, lda, cur_b, ldb, cur_c, ldc, bias, first, act_type);
-                i+=4;
-                break;
-            case 8:
-            case 9:
-            case 10:
-            case 11:
-            case 12:
-            case 13:
-            case 14:
-            case 15:
-                conv_gemm_conf.kernels_[8][N](K, cur_a, lda, cur_b, ldb, cur_c, ldc, bias, first, act_type);
-                i+=8;
-                break;
-            default:
-                conv_gemm_conf.kernels_[16][N](K, cur_a, lda, cur_b, ldb, cur_c, ldc, bias, first, act_type);
-                i+=16;
-                break;
+        dim_t m_r;
+        if (cur_m >= 16) {
+            m_r = 16;
+        } else if (cur_m >= 8) {
+            m_r = 8;
+        } else if (cur_m >= 4) {
+            m_r = 4;
+        } else if (cur_m >= 2) {
+            m_r = 2;
+        } else {
+            m_r = 1;
+        }
+        conv_gemm_conf.kernels_[m_r][N](K, cur_a, lda, cur_b, ldb, cur_c, ldc, bias, first, kernel_act_type);
+        if (kernel_act_type != act_type) {
+            post_func(cur_c, m_r, N, ldc, act_type);
         }
+        i += m_r;
     }
 }
 
-// sgemm col_major a no_trans, b no_trans
-// src_a: M * K, lda = M
-// src_b: K * N, ldb = K
+// sgemm col_major, a and b transposed by the packing if trans_a or trans_b
+// src_a: M * K, lda = M, or K * M, lda = K if trans_a
+// src_b: K * N, ldb = K, or N * K, ldb = N if trans_b
 // dst  : M * N, ldc = M
-void conv_sgemm_nn_col_major(
+void conv_sgemm_col_major(
+        bool trans_a, bool trans_b,
         dim_t M, dim_t N, dim_t K,
         const float * src_a, dim_t lda,
         const float * src_b, dim_t ldb,
@@ -125,12 +119,20 @@ void conv_sgemm_nn_col_major(
 
         // pack b -> K_c * N;
         // const float *pack_b_k = src_b + k * divUp(N, n_block);
-        pack_col_b_n(src_b + k, ldb, pack_b_buf, K_c, cur_k, N, conv_gemm_conf);
+        if (trans_b) {
+            pack_col_b_t(src_b + k * ldb, ldb, pack_b_buf, K_c, cur_k, N, conv_gemm_conf);
+        } else {
+            pack_col_b_n(src_b + k, ldb, pack_b_buf, K_c, cur_k, N, conv_gemm_conf);
+        }
 
         for (i = 0; i < M; i += M_c)  {
             dim_t cur_m = MIN(M - i, M_c);
             // pack a -> M_c * K_c;
-            pack_col_a_n(src_a + i + k * lda, lda, pack_a_buf, K_c, cur_k, cur_m, conv_gemm_conf);
+            if (trans_a) {
+                pack_col_a_t(src_a + k + i * lda, lda, pack_a_buf, K_c, cur_k, cur_m, conv_gemm_conf);
+            } else {
+                pack_col_a_n(src_a + i + k * lda, lda, pack_a_buf, K_c, cur_k, cur_m, conv_gemm_conf);
+            }
 
             for (j = 0; j < N;)  {
                 dim_t cur_n = MIN(N - j, conv_gemm_conf.kernel_n_r_);
@@ -147,6 +149,23 @@ void conv_sgemm_nn_col_major(
     }
 }
 
+// sgemm col_major a no_trans, b no_trans
+// src_a: M * K, lda = M
+// src_b: K * N, ldb = K
+// dst  : M * N, ldc = M
+void conv_sgemm_nn_col_major(
+        dim_t M, dim_t N, dim_t K,
+        const float * src_a, dim_t lda,
+        const float * src_b, dim_t ldb,
+        float * dst, dim_t ldc,
+        const float * bias, dim_t act_type,
+        float *pack_buf,
+        conv_gemm_config<float, float, float> &conv_gemm_conf)
+{
+    conv_sgemm_col_major(false, false, M, N, K, src_a, lda, src_b, ldb, dst, ldc, bias, act_type, pack_buf,
+                         conv_gemm_conf);
+}
+
 // sgemm col_major a no_trans, b no_trans
 // src_a: M * K, lda = M
 // src_b: K * N, ldb = K, prepacked
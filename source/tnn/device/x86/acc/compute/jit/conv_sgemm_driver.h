@@ -21,6 +21,15 @@
 
 namespace TNN_NS {
 
+// sgemm of packed a [M * K_c] and packed b [K_c * N], N <= kernel_n_r_
+void conv_sgemm_block_n(
+        dim_t M, dim_t N, dim_t K,
+        const float * src_a, dim_t lda,
+        const float * src_b, dim_t ldb,
+        float * dst, dim_t ldc,
+        const float * bias, dim_t first, dim_t act_type,
+        conv_gemm_config<float, float, float> &conv_gemm_conf);
+
 // sgemm col_major a no_trans, b no_trans
 void conv_sgemm_nn_col_major(
         dim_t M, dim_t N, dim_t K,
@@ -31,6 +40,19 @@ void conv_sgemm_nn_col_major(
         float *pack_buf,
         conv_gemm_config<float, float, float> &conv_gemm_conf);
 
+// sgemm col_major, a and b are read through the packing, so transposed operands need no copy
+// src_a: M * K, lda = M, or K * M, lda = K if trans_a
+// src_b: K * N, ldb = K, or N * K, ldb = N if trans_b
+void conv_sgemm_col_major(
+        bool trans_a, bool trans_b,
+        dim_t M, dim_t N, dim_t K,
+        const float * src_a, dim_t lda,
+        const float * src_b, dim_t ldb,
+        float * dst, dim_t ldc,
+        const float * bias, dim_t act_type,
+        float *pack_buf,
+        conv_gemm_config<float, float, float> &conv_gemm_conf);
+
 // sgemm col_major a no_trans, b no_trans prepacked
 void conv_sgemm_nn_col_major_prepack_b(
         dim_t M, dim_t N, dim_t K,
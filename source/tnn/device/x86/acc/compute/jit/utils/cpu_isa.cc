@@ -15,6 +15,7 @@
 #include "tnn/device/x86/acc/compute/jit/utils/cpu_isa.h"
 
 #include <stdio.h>
+#include <string.h>
 
 #include <xbyak/xbyak.h>
 #include <xbyak/xbyak_util.h>
@@ -46,4 +47,22 @@ bool cpu_with_isa(x86_isa_t arch) {
     return false;
 }
 
+std::string cpu_model_name() {
+    unsigned int data[4] = {0};
+    Cpu::getCpuid(0x80000000, data);
+    if (data[0] < 0x80000004) {
+        return "unknown";
+    }
+    char brand[49] = {0};
+    for (unsigned int i = 0; i < 3; i++) {
+        Cpu::getCpuid(0x80000002 + i, data);
+        memcpy(brand + i * 16, data, 16);
+    }
+    // trim the padding spaces of the brand string
+    std::string name(brand);
+    auto begin = name.find_first_not_of(' ');
+    auto end   = name.find_last_not_of(' ');
+    return begin == std::string::npos ? "unknown" : name.substr(begin, end - begin + 1);
+}
+
 }
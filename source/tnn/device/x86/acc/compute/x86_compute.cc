@@ -13,8 +13,11 @@
 // specific language governing permissions and limitations under the License.
 
 #include "tnn/device/x86/acc/compute/x86_compute.h"
+#include "tnn/device/x86/acc/compute/x86_compute_copy.h"
 #include "tnn/device/x86/acc/Float8.h"
 #include "tnn/device/x86/acc/Float4.h"
+#include "tnn/device/x86/acc/compute/jit/conv_sgemm_driver.h"
+#include "tnn/interpreter/raw_buffer.h"
 #include "tnn/utils/naive_compute.h"
 #include "tnn/utils/omp_utils.h"
 
@@ -126,17 +129,23 @@ Status X86_matrixMul(int m, int n, int k, const float *A, const float *B, float
         cblas_sgemm(CblasColMajor, CblasNoTrans, CblasNoTrans, 
                     n, m, k, alpha, B, n, A, k, beta, C, n);
     } else {
-        for (int mm = 0; mm < m; mm++) {
-            for (int nn = 0; nn < n; nn++) {
-                float tmp = 0.f;
-                for (int kk = 0; kk < k; kk++) {
-                    tmp += A[mm * k + kk] * B[kk * n + nn];
-                }
-                if (has_bias) tmp += bias[mm];
-                if (activation_type == ActivationType_ReLU) tmp = std::max(0.f, tmp);
-                C[mm * n + nn] = tmp;
-            }
+        if (!X86ActivationSupported(activation_type)) {
+            return Status(TNNERR_LAYER_ERR, "X86_matrixMul: unsupported activation type");
+        }
+        // col major B(n, k) x A(k, m), the bias of each column and the activation
+        // are applied by the gemm kernels on the output tile
+        conv_gemm_config<float, float, float> conv_gemm_conf;
+        size_t pack_a_size = ROUND_UP(conv_gemm_conf.M_c_ * conv_gemm_conf.K_c_ * sizeof(float), 32);
+        size_t pack_b_size = conv_gemm_conf.K_c_ * ROUND_UP(m, conv_gemm_conf.n_block_) * sizeof(float);
+        RawBuffer workspace(pack_a_size + pack_b_size, 32);
+
+        RawBuffer zero_bias;
+        if (!has_bias) {
+            zero_bias = RawBuffer(m * sizeof(float));
+            bias      = zero_bias.force_to<float *>();
         }
+        conv_sgemm_nn_col_major(n, m, k, B, n, A, k, C, n, bias, activation_type, workspace.force_to<float *>(),
+                                conv_gemm_conf);
     }
     return TNN_OK;
 }
@@ -830,44 +839,72 @@ void X86_Post_Exec(float *dst, const float *bias, long channel, long area) {
     for (long c = 0; c < channel; c++) {
         auto dst_c = dst + c * area;
         VEC bias_v = VEC(bias + c);
-        VEC zero_v = VEC(0.f);
-        VEC six_v = VEC(6.f);
         long i = 0;
         for (; i + pack - 1 < area; i += pack) {
             VEC src_v = VEC::loadu(dst_c + i);
             VEC dst_v = VEC::add(src_v, bias_v);
 
-            if (activation_type == ActivationType_ReLU || 
-                activation_type == ActivationType_ReLU6) {
-                dst_v = VEC::max(dst_v, zero_v);
-            }
-            if (activation_type == ActivationType_ReLU6) {
-                dst_v = VEC::min(dst_v, six_v);
-            }
+            dst_v = X86ActivationVec<activation_type, VEC>(dst_v);
             VEC::saveu(dst_c + i, dst_v);
         }
 
         for (; i < area; i++) {
-            float dst_value = dst_c[i] + bias[c];
-            if (activation_type == ActivationType_ReLU || 
-                activation_type == ActivationType_ReLU6) {
-                dst_value = std::max(dst_value, 0.f);
-            }
-            if (activation_type == ActivationType_ReLU6) {
-                dst_value = std::min(dst_value, 6.f);
-            }
-            dst_c[i] = dst_value;
+            dst_c[i] = X86Activation<activation_type>(dst_c[i] + bias[c]);
         }
     }
 }
 template void X86_Post_Exec<ActivationType_None, Float4, 4>(float *dst, const float *bias, long channel, long area);
 template void X86_Post_Exec<ActivationType_ReLU, Float4, 4>(float *dst, const float *bias, long channel, long area);
 template void X86_Post_Exec<ActivationType_ReLU6, Float4, 4>(float *dst, const float *bias, long channel, long area);
+template void X86_Post_Exec<ActivationType_SIGMOID_MUL, Float4, 4>(float *dst, const float *bias, long channel, long area);
+template void X86_Post_Exec<ActivationType_GELU, Float4, 4>(float *dst, const float *bias, long channel, long area);
 template void X86_Post_Exec<ActivationType_None, Float8, 8>(float *dst, const float *bias, long channel, long area);
 template void X86_Post_Exec<ActivationType_ReLU, Float8, 8>(float *dst, const float *bias, long channel, long area);
 template void X86_Post_Exec<ActivationType_ReLU6, Float8, 8>(float *dst, const float *bias, long channel, long area);
+template void X86_Post_Exec<ActivationType_SIGMOID_MUL, Float8, 8>(float *dst, const float *bias, long channel, long area);
+template void X86_Post_Exec<ActivationType_GELU, Float8, 8>(float *dst, const float *bias, long channel, long area);
+
+bool X86ActivationSupported(int activation_type) {
+    return activation_type == ActivationType_None || activation_type == ActivationType_ReLU ||
+           activation_type == ActivationType_ReLU6 || activation_type == ActivationType_SIGMOID_MUL ||
+           activation_type == ActivationType_GELU;
+}
 
-//ActivationType_SIGMOID_MUL TBD
+template <int activation_type, typename VEC, int pack>
+static void X86ActivationTile(float *dst, long m, long n, long ld) {
+    for (long j = 0; j < n; j++) {
+        auto dst_j = dst + j * ld;
+        long i     = 0;
+        for (; i + pack - 1 < m; i += pack) {
+            VEC::saveu(dst_j + i, X86ActivationVec<activation_type, VEC>(VEC::loadu(dst_j + i)));
+        }
+        for (; i < m; i++) {
+            dst_j[i] = X86Activation<activation_type>(dst_j[i]);
+        }
+    }
+}
+
+template <typename VEC, int pack>
+void X86ActivationPost(float *dst, long m, long n, long ld, long activation_type) {
+    switch (activation_type) {
+        case ActivationType_ReLU:
+            X86ActivationTile<ActivationType_ReLU, VEC, pack>(dst, m, n, ld);
+            break;
+        case ActivationType_ReLU6:
+            X86ActivationTile<ActivationType_ReLU6, VEC, pack>(dst, m, n, ld);
+            break;
+        case ActivationType_SIGMOID_MUL:
+            X86ActivationTile<ActivationType_SIGMOID_MUL, VEC, pack>(dst, m, n, ld);
+            break;
+        case ActivationType_GELU:
+            X86ActivationTile<ActivationType_GELU, VEC, pack>(dst, m, n, ld);
+            break;
+        default:
+            break;
+    }
+}
+template void X86ActivationPost<Float4, 4>(float *dst, long m, long n, long ld, long activation_type);
+template void X86ActivationPost<Float8, 8>(float *dst, long m, long n, long ld, long activation_type);
 
 template <typename VEC, int pack>
 void X86_VectorAdd(float *dst, const float *src_a, const float *src_b, long len) {
@@ -904,67 +941,18 @@ template void X86_VectorAdd<Float8, 8>(float *dst, const float *src, long len);
 void X86StrideSliceImpl(DimsVector begins, DimsVector strides, DimsVector dims_output,
                         DimsVector input_strides, DimsVector output_strides,
                         const float* input_data, float* output_data) {
-    if (dims_output.size() == 5) {
-        for (int n = 0, n_idx = begins[0]; n < dims_output[0]; n++, n_idx += strides[0]) {
-            auto input_n = input_data + n_idx * input_strides[0];
-            auto output_n = output_data + n * output_strides[0];
-            for (int c = 0, c_idx = begins[1]; c < dims_output[1]; c++, c_idx += strides[1]) {
-                auto input_c = input_n + c_idx * input_strides[1];
-                auto output_c = output_n + c * output_strides[1];
-                for (int h = 0, h_idx = begins[2]; h < dims_output[2]; h++, h_idx += strides[2]) {
-                    auto input_h = input_c + h_idx * input_strides[2];
-                    auto output_h = output_c + h * output_strides[2];
-                    for (int w = 0, w_idx = begins[3]; w < dims_output[3]; w++, w_idx += strides[3]) {
-                        auto input_w = input_h + w_idx * input_strides[3];
-                        auto output_w = output_h + w * output_strides[3];
-                        for (int x = 0, x_idx = begins[4]; x < dims_output[4]; x++, x_idx += strides[4]) {
-                            output_w[x] = input_w[x_idx];
-                        }
-                    }
-                }
-            }
-        }
-    } else if (dims_output.size() == 4) {
-        for (int n = 0, n_idx = begins[0]; n < dims_output[0]; n++, n_idx += strides[0]) {
-            auto input_n = input_data + n_idx * input_strides[0];
-            auto output_n = output_data + n * output_strides[0];
-            for (int c = 0, c_idx = begins[1]; c < dims_output[1]; c++, c_idx += strides[1]) {
-                auto input_c = input_n + c_idx * input_strides[1];
-                auto output_c = output_n + c * output_strides[1];
-                for (int h = 0, h_idx = begins[2]; h < dims_output[2]; h++, h_idx += strides[2]) {
-                    auto input_h = input_c + h_idx * input_strides[2];
-                    auto output_h = output_c + h * output_strides[2];
-                    for (int w = 0, w_idx = begins[3]; w < dims_output[3]; w++, w_idx += strides[3]) {
-                        output_h[w] = input_h[w_idx];
-                    }
-                }
-            }
-        }
-    } else if (dims_output.size() == 3) {
-        for (int n = 0, n_idx = begins[0]; n < dims_output[0]; n++, n_idx += strides[0]) {
-            auto input_n = input_data + n_idx * input_strides[0];
-            auto output_n = output_data + n * output_strides[0];
-            for (int c = 0, c_idx = begins[1]; c < dims_output[1]; c++, c_idx += strides[1]) {
-                auto input_c = input_n + c_idx * input_strides[1];
-                auto output_c = output_n + c * output_strides[1];
-                for (int h = 0, h_idx = begins[2]; h < dims_output[2]; h++, h_idx += strides[2]) {
-                    output_c[h] = input_c[h_idx];
-                }
-            }
-        }
-    } else if (dims_output.size() == 2) {
-        for (int n = 0, n_idx = begins[0]; n < dims_output[0]; n++, n_idx += strides[0]) {
-            auto input_n = input_data + n_idx * input_strides[0];
-            auto output_n = output_data + n * output_strides[0];
-            for (int c = 0, c_idx = begins[1]; c < dims_output[1]; c++, c_idx += strides[1]) {
-                output_n[c] = input_n[c_idx];
-            }
-        }
-    } else if (dims_output.size() == 1) {
-        for (int n = 0, n_idx = begins[0]; n < dims_output[0]; n++, n_idx += strides[0]) {
-            output_data[n] = input_data[n_idx];
-        }
-    }
+    // input_strides and output_strides leave out the innermost stride 1
+    const int rank = (int)dims_output.size();
+    std::vector<long> src_strides(rank, 1);
+    std::vector<long> dst_strides(rank, 1);
+    long src_offset = 0;
+    for (int i = 0; i < rank; i++) {
+        const long input_stride = i < input_strides.size() ? input_strides[i] : 1;
+        src_strides[i]          = input_stride * strides[i];
+        dst_strides[i]          = i < output_strides.size() ? output_strides[i] : 1;
+        src_offset += begins[i] * input_stride;
+    }
+    X86StridedCopy(output_data, dst_strides, input_data + src_offset, src_strides, dims_output, sizeof(float));
 }
 
 }
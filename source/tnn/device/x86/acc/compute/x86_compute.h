@@ -24,6 +24,9 @@
 #include "tnn/device/x86/acc/Float4.h"
 #include "tnn/device/x86/acc/Float8.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace TNN_NS {
 
 // @brief store by row
@@ -33,7 +36,7 @@ Status X86_IM2COL(float *src, int channel, int height, int width, int kernelh, i
 Status X86_COL2IM(float *src, int channel, int height, int width, int kernelh, int kernelw, int padh, int padw,
                   int strideh, int stridew, int dilationh, int dilationw, int output_height, int output_width,
                   float *dst);
-// @brief C = A * B with B tranposed, (m * k) * (k * n), NAIVE
+// @brief row major C = A * B, (m * k) * (k * n), bias of length m and activation are fused into the gemm epilogue
 Status X86_matrixMul(int m, int n, int k, const float *A, const float *B, float *C, 
                      int has_bias = 0, const float *bias = nullptr, int activation_type = ActivationType_None);
 
@@ -69,6 +72,72 @@ void X86Sgemv(float* dst, const float* src, const float* weight, float *bias, Di
 template <int activation_type, typename VEC, int pack>
 void X86_Post_Exec(float *dst, const float *bias, long channel, long area);
 
+// @brief erf approximation with max error 1.2e-7, shared by gelu layer and fused gelu
+template <typename VEC>
+static inline VEC X86FastErf(VEC x) {
+    auto t   = VEC::div(VEC(1.f), VEC(1.f) + VEC(0.5f) * VEC::abs(x));
+    auto t_2 = t * t;
+    auto t_3 = t_2 * t;
+    auto t_4 = t_3 * t;
+    auto t_5 = t_4 * t;
+    auto t_6 = t_5 * t;
+    auto t_7 = t_6 * t;
+    auto t_8 = t_7 * t;
+    auto t_9 = t_8 * t;
+
+    auto v = t * VEC::exp(VEC::neg(x) * x - VEC(1.26551223) +
+                             VEC(1.00002368) * t +
+                             VEC(0.37409196) * t_2 +
+                             VEC(0.09678418) * t_3 -
+                             VEC(0.18628806) * t_4 +
+                             VEC(0.27886807) * t_5 -
+                             VEC(1.13520398) * t_6 +
+                             VEC(1.48851587) * t_7 -
+                             VEC(0.82215223) * t_8 +
+                             VEC(0.17087277) * t_9);
+    auto v_pos = VEC(1.f) - v;
+    auto v_neg = v - VEC(1.f);
+
+    return VEC::bsl_cge(x, VEC(0.f), v_pos, v_neg);
+}
+
+// @brief fused activation on values still in registers
+template <int activation_type, typename VEC>
+static inline VEC X86ActivationVec(const VEC &v) {
+    if (activation_type == ActivationType_ReLU) {
+        return VEC::max(v, VEC(0.f));
+    } else if (activation_type == ActivationType_ReLU6) {
+        return VEC::min(VEC::max(v, VEC(0.f)), VEC(6.f));
+    } else if (activation_type == ActivationType_SIGMOID_MUL) {
+        return v * VEC::sigmoid(v);
+    } else if (activation_type == ActivationType_GELU) {
+        return VEC(0.5f) * v * (X86FastErf<VEC>(v * VEC(0.707106793288165f)) + VEC(1.f));
+    }
+    return v;
+}
+
+template <int activation_type>
+static inline float X86Activation(float v) {
+    if (activation_type == ActivationType_ReLU) {
+        return std::max(v, 0.f);
+    } else if (activation_type == ActivationType_ReLU6) {
+        return std::min(std::max(v, 0.f), 6.f);
+    } else if (activation_type == ActivationType_SIGMOID_MUL) {
+        return v / (1.f + std::exp(-v));
+    } else if (activation_type == ActivationType_GELU) {
+        return 0.5f * v * (std::erf(v * 0.707106793288165f) + 1.0f);
+    }
+    return v;
+}
+
+// @brief whether activation_type can be fused by the x86 kernels
+bool X86ActivationSupported(int activation_type);
+
+// @brief apply activation on a col major tile dst[m * n] with leading dimension ld in place,
+//        called on the output tile of gemm kernels right after it is stored
+template <typename VEC, int pack>
+void X86ActivationPost(float *dst, long m, long n, long ld, long activation_type);
+
 template <typename VEC, int pack>
 void X86_VectorAdd(float *dst, const float *src_a, const float *src_b, long len);
 
@@ -0,0 +1,336 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/device/x86/acc/compute/x86_compute_binary.h"
+
+#include <algorithm>
+
+#include "tnn/core/macro.h"
+#include "tnn/device/x86/acc/Float4.h"
+#include "tnn/device/x86/acc/Float8.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+// elements computed by one omp task at least, smaller ops run on the calling thread
+static const long kBinaryChunkSize = 16 * 1024;
+
+// inner rows shorter than this are not worth a simd loop
+static const long kBinaryMinSimdRow = 4;
+
+template <X86BinaryOpType op_type>
+struct X86BinaryOp {};
+
+template <>
+struct X86BinaryOp<X86BinaryOpType::kADD> {
+    static inline float Apply(float a, float b) {
+        return a + b;
+    }
+    template <typename VEC>
+    static inline VEC Apply(const VEC &a, const VEC &b) {
+        return VEC::add(a, b);
+    }
+};
+
+template <>
+struct X86BinaryOp<X86BinaryOpType::kSUB> {
+    static inline float Apply(float a, float b) {
+        return a - b;
+    }
+    template <typename VEC>
+    static inline VEC Apply(const VEC &a, const VEC &b) {
+        return VEC::sub(a, b);
+    }
+};
+
+template <>
+struct X86BinaryOp<X86BinaryOpType::kMUL> {
+    static inline float Apply(float a, float b) {
+        return a * b;
+    }
+    template <typename VEC>
+    static inline VEC Apply(const VEC &a, const VEC &b) {
+        return VEC::mul(a, b);
+    }
+};
+
+template <>
+struct X86BinaryOp<X86BinaryOpType::kDIV> {
+    static inline float Apply(float a, float b) {
+        return a / b;
+    }
+    template <typename VEC>
+    static inline VEC Apply(const VEC &a, const VEC &b) {
+        return VEC::div(a, b);
+    }
+};
+
+template <>
+struct X86BinaryOp<X86BinaryOpType::kMAX> {
+    static inline float Apply(float a, float b) {
+        return a > b ? a : b;
+    }
+    template <typename VEC>
+    static inline VEC Apply(const VEC &a, const VEC &b) {
+        return VEC::max(a, b);
+    }
+};
+
+template <>
+struct X86BinaryOp<X86BinaryOpType::kMIN> {
+    static inline float Apply(float a, float b) {
+        return a < b ? a : b;
+    }
+    template <typename VEC>
+    static inline VEC Apply(const VEC &a, const VEC &b) {
+        return VEC::min(a, b);
+    }
+};
+
+Status X86BroadcastPlanInit(const DimsVector &output_dims, const DimsVector &dims0, const DimsVector &dims1,
+                            X86BroadcastPlan &plan) {
+    const int rank = (int)output_dims.size();
+    if (dims0.size() > rank || dims1.size() > rank) {
+        return Status(TNNERR_PARAM_ERR, "binary op input has more dims than the output");
+    }
+
+    // strides of each operand on the output axes, 0 where it is broadcast
+    std::vector<long> strides[2];
+    const DimsVector *operand_dims[2] = {&dims0, &dims1};
+    for (int t = 0; t < 2; t++) {
+        const DimsVector &dims = *operand_dims[t];
+        const int pad          = rank - (int)dims.size();
+        strides[t].resize(rank);
+        long stride = 1;
+        for (int k = rank - 1; k >= 0; k--) {
+            const int dim = k < pad ? 1 : dims[k - pad];
+            if (dim == output_dims[k]) {
+                strides[t][k] = stride;
+            } else if (dim == 1) {
+                strides[t][k] = 0;
+            } else {
+                return Status(TNNERR_PARAM_ERR, "binary op input can not be broadcast to the output");
+            }
+            stride *= dim;
+        }
+    }
+
+    // drop dims of size 1 and merge neighbours which are contiguous or broadcast in both operands
+    plan.dims.clear();
+    plan.strides0.clear();
+    plan.strides1.clear();
+    for (int k = 0; k < rank; k++) {
+        if (output_dims[k] == 1) {
+            continue;
+        }
+        if (!plan.dims.empty() && plan.strides0.back() == strides[0][k] * output_dims[k] &&
+            plan.strides1.back() == strides[1][k] * output_dims[k]) {
+            plan.dims.back() *= output_dims[k];
+            plan.strides0.back() = strides[0][k];
+            plan.strides1.back() = strides[1][k];
+        } else {
+            plan.dims.push_back(output_dims[k]);
+            plan.strides0.push_back(strides[0][k]);
+            plan.strides1.push_back(strides[1][k]);
+        }
+    }
+    if (plan.dims.empty()) {
+        plan.dims     = {1};
+        plan.strides0 = {1};
+        plan.strides1 = {1};
+    }
+
+    const bool broadcast_inner = plan.strides0.back() == 0 || plan.strides1.back() == 0;
+    if (plan.dims.size() == 1) {
+        plan.kind = broadcast_inner ? X86_BROADCAST_SCALAR : X86_BROADCAST_ELEMENT;
+    } else if (plan.dims.back() < kBinaryMinSimdRow) {
+        plan.kind = X86_BROADCAST_GENERAL;
+    } else {
+        plan.kind = broadcast_inner ? X86_BROADCAST_CHANNEL : X86_BROADCAST_ROW;
+    }
+    return TNN_OK;
+}
+
+// walks the outer axes of a plan from a linear row index with the offsets in both operands
+class BroadcastCursor {
+public:
+    BroadcastCursor(const X86BroadcastPlan &plan, int rank, long index)
+        : plan_(plan), rank_(rank), index_(rank, 0) {
+        for (int k = rank_ - 1; k >= 0; k--) {
+            index_[k] = index % plan_.dims[k];
+            index /= plan_.dims[k];
+            offset0 += index_[k] * plan_.strides0[k];
+            offset1 += index_[k] * plan_.strides1[k];
+        }
+    }
+
+    void Next() {
+        for (int k = rank_ - 1; k >= 0; k--) {
+            offset0 += plan_.strides0[k];
+            offset1 += plan_.strides1[k];
+            if (++index_[k] < plan_.dims[k]) {
+                return;
+            }
+            offset0 -= plan_.strides0[k] * plan_.dims[k];
+            offset1 -= plan_.strides1[k] * plan_.dims[k];
+            index_[k] = 0;
+        }
+    }
+
+    long offset0 = 0;
+    long offset1 = 0;
+
+private:
+    const X86BroadcastPlan &plan_;
+    int rank_;
+    DimsVector index_;
+};
+
+// run func(row_begin, row_end, begin, end) over rows of count elements, split in tasks of at least
+// kBinaryChunkSize. long rows are split across tasks as well so that a few large rows still use all threads.
+template <typename FUNC>
+static void ParallelBinaryRows(long rows, long count, FUNC func) {
+    const long chunks = std::max(1L, rows * count / kBinaryChunkSize);
+    if (chunks <= 1) {
+        func(0, rows, 0, count);
+        return;
+    }
+    if (chunks <= rows) {
+        OMP_PARALLEL_FOR_
+        for (long c = 0; c < chunks; c++) {
+            func(rows * c / chunks, rows * (c + 1) / chunks, 0, count);
+        }
+        return;
+    }
+    const long pieces = chunks / rows;
+    OMP_PARALLEL_FOR_
+    for (long t = 0; t < rows * pieces; t++) {
+        const long r = t / pieces;
+        const long p = t % pieces;
+        func(r, r + 1, count * p / pieces, count * (p + 1) / pieces);
+    }
+}
+
+template <X86BinaryOpType op_type, typename VEC, int pack>
+static inline void BinaryRowVV(float *dst, const float *src0, const float *src1, long count) {
+    typedef X86BinaryOp<op_type> OP;
+    long i = 0;
+    for (; i + 2 * pack <= count; i += 2 * pack) {
+        VEC a0 = VEC::loadu(src0 + i);
+        VEC a1 = VEC::loadu(src0 + i + pack);
+        VEC b0 = VEC::loadu(src1 + i);
+        VEC b1 = VEC::loadu(src1 + i + pack);
+        VEC::saveu(dst + i, OP::Apply(a0, b0));
+        VEC::saveu(dst + i + pack, OP::Apply(a1, b1));
+    }
+    for (; i + pack <= count; i += pack) {
+        VEC::saveu(dst + i, OP::Apply(VEC::loadu(src0 + i), VEC::loadu(src1 + i)));
+    }
+    for (; i < count; i++) {
+        dst[i] = OP::Apply(src0[i], src1[i]);
+    }
+}
+
+template <X86BinaryOpType op_type, typename VEC, int pack>
+static inline void BinaryRowVS(float *dst, const float *src0, float src1, long count) {
+    typedef X86BinaryOp<op_type> OP;
+    const VEC b(src1);
+    long i = 0;
+    for (; i + 2 * pack <= count; i += 2 * pack) {
+        VEC a0 = VEC::loadu(src0 + i);
+        VEC a1 = VEC::loadu(src0 + i + pack);
+        VEC::saveu(dst + i, OP::Apply(a0, b));
+        VEC::saveu(dst + i + pack, OP::Apply(a1, b));
+    }
+    for (; i + pack <= count; i += pack) {
+        VEC::saveu(dst + i, OP::Apply(VEC::loadu(src0 + i), b));
+    }
+    for (; i < count; i++) {
+        dst[i] = OP::Apply(src0[i], src1);
+    }
+}
+
+template <X86BinaryOpType op_type, typename VEC, int pack>
+static inline void BinaryRowSV(float *dst, float src0, const float *src1, long count) {
+    typedef X86BinaryOp<op_type> OP;
+    const VEC a(src0);
+    long i = 0;
+    for (; i + 2 * pack <= count; i += 2 * pack) {
+        VEC b0 = VEC::loadu(src1 + i);
+        VEC b1 = VEC::loadu(src1 + i + pack);
+        VEC::saveu(dst + i, OP::Apply(a, b0));
+        VEC::saveu(dst + i + pack, OP::Apply(a, b1));
+    }
+    for (; i + pack <= count; i += pack) {
+        VEC::saveu(dst + i, OP::Apply(a, VEC::loadu(src1 + i)));
+    }
+    for (; i < count; i++) {
+        dst[i] = OP::Apply(src0, src1[i]);
+    }
+}
+
+template <X86BinaryOpType op_type>
+static inline void BinaryRowStrided(float *dst, const float *src0, long stride0, const float *src1, long stride1,
+                                    long count) {
+    for (long i = 0; i < count; i++) {
+        dst[i] = X86BinaryOp<op_type>::Apply(src0[i * stride0], src1[i * stride1]);
+    }
+}
+
+template <X86BinaryOpType op_type, typename VEC, int pack>
+void X86BinaryBroadcast(float *dst, const float *src0, const float *src1, const X86BroadcastPlan &plan) {
+    const int outer_rank = (int)plan.dims.size() - 1;
+    const long count     = plan.dims[outer_rank];
+    const long stride0   = plan.strides0[outer_rank];
+    const long stride1   = plan.strides1[outer_rank];
+    const auto kind      = plan.kind;
+    long rows            = 1;
+    for (int k = 0; k < outer_rank; k++) {
+        rows *= plan.dims[k];
+    }
+
+    ParallelBinaryRows(rows, count, [&](long row_begin, long row_end, long begin, long end) {
+        BroadcastCursor cursor(plan, outer_rank, row_begin);
+        for (long r = row_begin; r < row_end; r++, cursor.Next()) {
+            float *d       = dst + r * count + begin;
+            const float *a = src0 + cursor.offset0 + begin * stride0;
+            const float *b = src1 + cursor.offset1 + begin * stride1;
+            if (kind == X86_BROADCAST_GENERAL) {
+                BinaryRowStrided<op_type>(d, a, stride0, b, stride1, end - begin);
+            } else if (stride0 != 0 && stride1 != 0) {
+                BinaryRowVV<op_type, VEC, pack>(d, a, b, end - begin);
+            } else if (stride1 == 0) {
+                BinaryRowVS<op_type, VEC, pack>(d, a, b[0], end - begin);
+            } else {
+                BinaryRowSV<op_type, VEC, pack>(d, a[0], b, end - begin);
+            }
+        }
+    });
+}
+
+#define INSTANTIATE_X86_BINARY_BROADCAST(op_type)                                                                     \
+    template void X86BinaryBroadcast<op_type, Float4, 4>(float *dst, const float *src0, const float *src1,            \
+                                                         const X86BroadcastPlan &plan);                               \
+    template void X86BinaryBroadcast<op_type, Float8, 8>(float *dst, const float *src0, const float *src1,            \
+                                                         const X86BroadcastPlan &plan)
+
+INSTANTIATE_X86_BINARY_BROADCAST(X86BinaryOpType::kADD);
+INSTANTIATE_X86_BINARY_BROADCAST(X86BinaryOpType::kSUB);
+INSTANTIATE_X86_BINARY_BROADCAST(X86BinaryOpType::kMUL);
+INSTANTIATE_X86_BINARY_BROADCAST(X86BinaryOpType::kDIV);
+INSTANTIATE_X86_BINARY_BROADCAST(X86BinaryOpType::kMAX);
+INSTANTIATE_X86_BINARY_BROADCAST(X86BinaryOpType::kMIN);
+
+}  // namespace TNN_NS
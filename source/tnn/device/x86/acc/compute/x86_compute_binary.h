@@ -0,0 +1,69 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef TNN_SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_X86_COMPUTE_BINARY_H_
+#define TNN_SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_X86_COMPUTE_BINARY_H_
+
+#include <vector>
+
+#include "tnn/core/common.h"
+#include "tnn/core/status.h"
+
+namespace TNN_NS {
+
+enum class X86BinaryOpType : int {
+    kADD = 0,
+    kSUB = 1,
+    kMUL = 2,
+    kDIV = 3,
+    kMAX = 4,
+    kMIN = 5,
+};
+
+// shape classes of a broadcast binary op, after dims of size 1 are dropped and neighbours merged
+enum X86BroadcastKind {
+    // same shape, one flat loop
+    X86_BROADCAST_ELEMENT = 0,
+    // one operand is a single value
+    X86_BROADCAST_SCALAR = 1,
+    // one operand is constant along the inner axis, e.g. [n, c, hw] op [1, c, 1]
+    X86_BROADCAST_CHANNEL = 2,
+    // both operands are dense along the inner axis and one repeats along the outer axes, e.g. [n, c, hw] op [1, 1, hw]
+    X86_BROADCAST_ROW = 3,
+    // inner rows shorter than a simd vector, element by element
+    X86_BROADCAST_GENERAL = 4,
+};
+
+// @brief a binary op between two operands broadcast to dims, computed once at reshape.
+// strides are in elements and 0 on the axes an operand is broadcast along, the output is dense in dims.
+struct X86BroadcastPlan {
+    X86BroadcastKind kind = X86_BROADCAST_ELEMENT;
+    DimsVector dims;
+    std::vector<long> strides0;
+    std::vector<long> strides1;
+};
+
+// @brief classifies the broadcast of dims0 and dims1 to output_dims, shapes are aligned to the right as in numpy
+Status X86BroadcastPlanInit(const DimsVector &output_dims, const DimsVector &dims0, const DimsVector &dims1,
+                            X86BroadcastPlan &plan);
+
+// @brief dst = src0 op src1 as classified in plan, split across omp threads in chunks large enough to amortize
+// the fork. dst may alias an operand which is not broadcast, each element is read before it is written.
+template <X86BinaryOpType op_type, typename VEC, int pack>
+void X86BinaryBroadcast(float *dst, const float *src0, const float *src1, const X86BroadcastPlan &plan);
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_X86_COMPUTE_BINARY_H_
@@ -0,0 +1,354 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/device/x86/acc/compute/x86_compute_copy.h"
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "tnn/core/macro.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+// bytes copied by one omp task at least, smaller copies run on the calling thread
+static const long kCopyChunkBytes = 32 * 1024;
+
+std::vector<long> X86DenseStrides(const DimsVector &dims) {
+    std::vector<long> strides(dims.size(), 1);
+    for (int i = (int)dims.size() - 2; i >= 0; i--) {
+        strides[i] = strides[i + 1] * dims[i + 1];
+    }
+    return strides;
+}
+
+// drop dims of size 1 and merge neighbours which are contiguous in both src and dst
+static void CollapseCopyDims(DimsVector &dims, std::vector<long> &dst_strides, std::vector<long> &src_strides) {
+    DimsVector new_dims;
+    std::vector<long> new_dst_strides, new_src_strides;
+    for (int i = 0; i < dims.size(); i++) {
+        if (dims[i] == 1) {
+            continue;
+        }
+        if (!new_dims.empty() && new_dst_strides.back() == dst_strides[i] * dims[i] &&
+            new_src_strides.back() == src_strides[i] * dims[i]) {
+            new_dims.back() *= dims[i];
+            new_dst_strides.back() = dst_strides[i];
+            new_src_strides.back() = src_strides[i];
+        } else {
+            new_dims.push_back(dims[i]);
+            new_dst_strides.push_back(dst_strides[i]);
+            new_src_strides.push_back(src_strides[i]);
+        }
+    }
+    if (new_dims.empty()) {
+        new_dims        = {1};
+        new_dst_strides = {1};
+        new_src_strides = {1};
+    }
+    dims        = new_dims;
+    dst_strides = new_dst_strides;
+    src_strides = new_src_strides;
+}
+
+// walks the index space of dims from a linear index with the offsets in dst and src
+class CopyCursor {
+public:
+    CopyCursor(const DimsVector &dims, const std::vector<long> &dst_strides, const std::vector<long> &src_strides,
+               long index)
+        : dims_(dims), dst_strides_(dst_strides), src_strides_(src_strides), index_(dims.size(), 0) {
+        for (int k = (int)dims_.size() - 1; k >= 0; k--) {
+            index_[k] = index % dims_[k];
+            index /= dims_[k];
+            dst_offset += index_[k] * dst_strides_[k];
+            src_offset += index_[k] * src_strides_[k];
+        }
+    }
+
+    void Next() {
+        for (int k = (int)dims_.size() - 1; k >= 0; k--) {
+            dst_offset += dst_strides_[k];
+            src_offset += src_strides_[k];
+            if (++index_[k] < dims_[k]) {
+                return;
+            }
+            dst_offset -= dst_strides_[k] * dims_[k];
+            src_offset -= src_strides_[k] * dims_[k];
+            index_[k] = 0;
+        }
+    }
+
+    long dst_offset = 0;
+    long src_offset = 0;
+
+private:
+    const DimsVector &dims_;
+    const std::vector<long> &dst_strides_;
+    const std::vector<long> &src_strides_;
+    DimsVector index_;
+};
+
+// run func(begin, end) over rows split in tasks of at least kCopyChunkBytes
+template <typename FUNC>
+static void ParallelCopyRows(long rows, long row_bytes, FUNC func) {
+    const long chunks = std::min(rows, std::max(1L, rows * row_bytes / kCopyChunkBytes));
+    if (chunks <= 1) {
+        func(0, rows);
+        return;
+    }
+    OMP_PARALLEL_FOR_DYNAMIC_
+    for (long c = 0; c < chunks; c++) {
+        func(rows * c / chunks, rows * (c + 1) / chunks);
+    }
+}
+
+template <typename T>
+static inline void StridedRowCopy(char *dst, long dst_stride, const char *src, long src_stride, long count) {
+    T *d       = reinterpret_cast<T *>(dst);
+    const T *s = reinterpret_cast<const T *>(src);
+    for (long i = 0; i < count; i++) {
+        d[i * dst_stride] = s[i * src_stride];
+    }
+}
+
+static void StridedRowCopy(char *dst, long dst_stride, const char *src, long src_stride, long count,
+                           int elem_size) {
+    switch (elem_size) {
+        case 1:
+            StridedRowCopy<int8_t>(dst, dst_stride, src, src_stride, count);
+            break;
+        case 2:
+            StridedRowCopy<int16_t>(dst, dst_stride, src, src_stride, count);
+            break;
+        case 4:
+            StridedRowCopy<int32_t>(dst, dst_stride, src, src_stride, count);
+            break;
+        case 8:
+            StridedRowCopy<int64_t>(dst, dst_stride, src, src_stride, count);
+            break;
+        default:
+            for (long i = 0; i < count; i++) {
+                memcpy(dst + i * dst_stride * elem_size, src + i * src_stride * elem_size, elem_size);
+            }
+            break;
+    }
+}
+
+#ifdef __AVX__
+static const int kTransposeTile = 8;
+
+// dst row i is src column i of a 8x8 tile
+static inline void TransposeTile(const float *src, long ld_src, float *dst, long ld_dst) {
+    __m256 r0 = _mm256_loadu_ps(src + 0 * ld_src);
+    __m256 r1 = _mm256_loadu_ps(src + 1 * ld_src);
+    __m256 r2 = _mm256_loadu_ps(src + 2 * ld_src);
+    __m256 r3 = _mm256_loadu_ps(src + 3 * ld_src);
+    __m256 r4 = _mm256_loadu_ps(src + 4 * ld_src);
+    __m256 r5 = _mm256_loadu_ps(src + 5 * ld_src);
+    __m256 r6 = _mm256_loadu_ps(src + 6 * ld_src);
+    __m256 r7 = _mm256_loadu_ps(src + 7 * ld_src);
+
+    __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+    __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+    __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+    __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+    __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+    __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+    __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+    __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+
+    __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+    __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+    _mm256_storeu_ps(dst + 0 * ld_dst, _mm256_permute2f128_ps(s0, s4, 0x20));
+    _mm256_storeu_ps(dst + 1 * ld_dst, _mm256_permute2f128_ps(s1, s5, 0x20));
+    _mm256_storeu_ps(dst + 2 * ld_dst, _mm256_permute2f128_ps(s2, s6, 0x20));
+    _mm256_storeu_ps(dst + 3 * ld_dst, _mm256_permute2f128_ps(s3, s7, 0x20));
+    _mm256_storeu_ps(dst + 4 * ld_dst, _mm256_permute2f128_ps(s0, s4, 0x31));
+    _mm256_storeu_ps(dst + 5 * ld_dst, _mm256_permute2f128_ps(s1, s5, 0x31));
+    _mm256_storeu_ps(dst + 6 * ld_dst, _mm256_permute2f128_ps(s2, s6, 0x31));
+    _mm256_storeu_ps(dst + 7 * ld_dst, _mm256_permute2f128_ps(s3, s7, 0x31));
+}
+#else
+static const int kTransposeTile = 4;
+
+static inline void TransposeTile(const float *src, long ld_src, float *dst, long ld_dst) {
+    __m128 r0 = _mm_loadu_ps(src + 0 * ld_src);
+    __m128 r1 = _mm_loadu_ps(src + 1 * ld_src);
+    __m128 r2 = _mm_loadu_ps(src + 2 * ld_src);
+    __m128 r3 = _mm_loadu_ps(src + 3 * ld_src);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_storeu_ps(dst + 0 * ld_dst, r0);
+    _mm_storeu_ps(dst + 1 * ld_dst, r1);
+    _mm_storeu_ps(dst + 2 * ld_dst, r2);
+    _mm_storeu_ps(dst + 3 * ld_dst, r3);
+}
+#endif
+
+// axis a is contiguous in src and axis b is contiguous in dst, the (a, b) plane is copied in square tiles
+static void TransposeCopy(float *dst, const std::vector<long> &dst_strides, const float *src,
+                          const std::vector<long> &src_strides, const DimsVector &dims, int a, int b) {
+    DimsVector outer_dims;
+    std::vector<long> outer_dst_strides, outer_src_strides;
+    for (int k = 0; k < dims.size(); k++) {
+        if (k != a && k != b) {
+            outer_dims.push_back(dims[k]);
+            outer_dst_strides.push_back(dst_strides[k]);
+            outer_src_strides.push_back(src_strides[k]);
+        }
+    }
+    long outer_count = 1;
+    for (auto d : outer_dims) {
+        outer_count *= d;
+    }
+
+    const int tile           = kTransposeTile;
+    const long size_a        = dims[a];
+    const long size_b        = dims[b];
+    const long dst_stride_a  = dst_strides[a];
+    const long src_stride_b  = src_strides[b];
+    const long blocks_a      = UP_DIV(size_a, tile);
+    const long row_bytes     = tile * size_b * sizeof(float);
+
+    ParallelCopyRows(outer_count * blocks_a, row_bytes, [&](long begin, long end) {
+        for (long task = begin; task < end; task++) {
+            CopyCursor cursor(outer_dims, outer_dst_strides, outer_src_strides, task / blocks_a);
+            const long i0      = (task % blocks_a) * tile;
+            const long i_end   = std::min(i0 + tile, size_a);
+            const float *src_t = src + cursor.src_offset + i0;
+            float *dst_t       = dst + cursor.dst_offset + i0 * dst_stride_a;
+
+            long j0 = 0;
+            if (i_end - i0 == tile) {
+                for (; j0 + tile <= size_b; j0 += tile) {
+                    TransposeTile(src_t + j0 * src_stride_b, src_stride_b, dst_t + j0, dst_stride_a);
+                }
+            }
+            for (long i = 0; i < i_end - i0; i++) {
+                for (long j = j0; j < size_b; j++) {
+                    dst_t[i * dst_stride_a + j] = src_t[i + j * src_stride_b];
+                }
+            }
+        }
+    });
+}
+
+void X86StridedCopy(void *dst, const std::vector<long> &dst_strides, const void *src,
+                    const std::vector<long> &src_strides, const DimsVector &dims, int elem_size) {
+    for (auto d : dims) {
+        if (d <= 0) {
+            return;
+        }
+    }
+    DimsVector copy_dims              = dims;
+    std::vector<long> copy_dst_strides = dst_strides;
+    std::vector<long> copy_src_strides = src_strides;
+    CollapseCopyDims(copy_dims, copy_dst_strides, copy_src_strides);
+
+    const int rank       = (int)copy_dims.size();
+    char *dst_data       = static_cast<char *>(dst);
+    const char *src_data = static_cast<const char *>(src);
+
+    // contiguous rows
+    if (copy_dst_strides[rank - 1] == 1 && copy_src_strides[rank - 1] == 1) {
+        const long inner = copy_dims[rank - 1];
+        DimsVector outer_dims(copy_dims.begin(), copy_dims.end() - 1);
+        ParallelCopyRows(DimsVectorUtils::Count(outer_dims), inner * elem_size, [&](long begin, long end) {
+            CopyCursor cursor(outer_dims, copy_dst_strides, copy_src_strides, begin);
+            for (long r = begin; r < end; r++, cursor.Next()) {
+                memcpy(dst_data + cursor.dst_offset * elem_size, src_data + cursor.src_offset * elem_size,
+                       inner * elem_size);
+            }
+        });
+        return;
+    }
+
+    // transpose of 4 byte elements
+    if (elem_size == 4) {
+        int a = -1, b = -1;
+        for (int k = 0; k < rank; k++) {
+            if (copy_src_strides[k] == 1) {
+                a = k;
+            }
+            if (copy_dst_strides[k] == 1) {
+                b = k;
+            }
+        }
+        if (a >= 0 && b >= 0 && a != b && copy_dims[a] >= kTransposeTile && copy_dims[b] >= kTransposeTile) {
+            TransposeCopy(static_cast<float *>(dst), copy_dst_strides, static_cast<const float *>(src),
+                          copy_src_strides, copy_dims, a, b);
+            return;
+        }
+    }
+
+    // strided elements, a row walks the two innermost axes so that short innermost axes stay cheap
+    if (rank == 1) {
+        copy_dims.insert(copy_dims.begin(), 1);
+        copy_dst_strides.insert(copy_dst_strides.begin(), 0);
+        copy_src_strides.insert(copy_src_strides.begin(), 0);
+    }
+    const int r_rank     = (int)copy_dims.size();
+    const long size_y    = copy_dims[r_rank - 2];
+    const long size_x    = copy_dims[r_rank - 1];
+    const long dst_y     = copy_dst_strides[r_rank - 2];
+    const long src_y     = copy_src_strides[r_rank - 2];
+    const long dst_x     = copy_dst_strides[r_rank - 1];
+    const long src_x     = copy_src_strides[r_rank - 1];
+    DimsVector outer_dims(copy_dims.begin(), copy_dims.end() - 2);
+    ParallelCopyRows(DimsVectorUtils::Count(outer_dims), size_y * size_x * elem_size, [&](long begin, long end) {
+        CopyCursor cursor(outer_dims, copy_dst_strides, copy_src_strides, begin);
+        for (long r = begin; r < end; r++, cursor.Next()) {
+            for (long y = 0; y < size_y; y++) {
+                StridedRowCopy(dst_data + (cursor.dst_offset + y * dst_y) * elem_size, dst_x,
+                               src_data + (cursor.src_offset + y * src_y) * elem_size, src_x, size_x, elem_size);
+            }
+        }
+    });
+}
+
+void X86PermuteCopy(void *dst, const void *src, const DimsVector &input_dims, const std::vector<int> &orders,
+                    int elem_size) {
+    const auto input_strides = X86DenseStrides(input_dims);
+    DimsVector output_dims;
+    std::vector<long> src_strides;
+    for (auto axis : orders) {
+        output_dims.push_back(input_dims[axis]);
+        src_strides.push_back(input_strides[axis]);
+    }
+    X86StridedCopy(dst, X86DenseStrides(output_dims), src, src_strides, output_dims, elem_size);
+}
+
+void X86GatherRows(void *dst, const void *src, long batch, long src_rows, const int *indices, long index_count,
+                   long row_bytes) {
+    char *dst_data       = static_cast<char *>(dst);
+    const char *src_data = static_cast<const char *>(src);
+    ParallelCopyRows(batch * index_count, row_bytes, [&](long begin, long end) {
+        for (long r = begin; r < end; r++) {
+            const long b = r / index_count;
+            memcpy(dst_data + r * row_bytes, src_data + (b * src_rows + indices[r % index_count]) * row_bytes,
+                   row_bytes);
+        }
+    });
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,45 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_X86_COMPUTE_COPY_H_
+#define TNN_SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_X86_COMPUTE_COPY_H_
+
+#include <vector>
+
+#include "tnn/core/common.h"
+
+namespace TNN_NS {
+
+// @brief strides of a dense tensor with dims, in elements
+std::vector<long> X86DenseStrides(const DimsVector &dims);
+
+// @brief dst[sum(i_k * dst_strides[k])] = src[sum(i_k * src_strides[k])] for every index i of dims, strides
+// are in elements of elem_size bytes and may be negative. dims that are contiguous in both src and dst are
+// collapsed, contiguous rows are copied with memcpy, 4 byte transposes go through simd tiles, and the
+// work is split across omp threads in chunks large enough to amortize the fork.
+void X86StridedCopy(void *dst, const std::vector<long> &dst_strides, const void *src,
+                    const std::vector<long> &src_strides, const DimsVector &dims, int elem_size);
+
+// @brief dense permute, output axis i is input axis orders[i]
+void X86PermuteCopy(void *dst, const void *src, const DimsVector &input_dims, const std::vector<int> &orders,
+                    int elem_size);
+
+// @brief dst[b][i] = src[b][indices[i]] for rows of row_bytes, src has src_rows rows per batch and the
+// indices must be in [0, src_rows)
+void X86GatherRows(void *dst, const void *src, long batch, long src_rows, const int *indices, long index_count,
+                   long row_bytes);
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_X86_COMPUTE_COPY_H_
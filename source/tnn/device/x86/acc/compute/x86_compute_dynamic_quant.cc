@@ -0,0 +1,201 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/device/x86/acc/compute/x86_compute_dynamic_quant.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "tnn/device/x86/x86_common.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+long X86DynamicQuantRowBytes(long K) {
+    return ROUND_UP(K, 16);
+}
+
+void X86DynamicQuantPackWeight(int8_t *dst, const int8_t *src, long oc, long K) {
+    const long row_bytes = X86DynamicQuantRowBytes(K);
+    memset(dst, 0, ROUND_UP(oc, 4) * row_bytes);
+    for (long m = 0; m < oc; m++) {
+        memcpy(dst + m * row_bytes, src + m * K, K);
+    }
+}
+
+template <typename VEC, int pack>
+static float AbsMax(const float *src, long K) {
+    VEC vmax(0.f);
+    long k = 0;
+    for (; k + pack <= K; k += pack) {
+        vmax = VEC::max(vmax, VEC::abs(VEC::loadu(src + k)));
+    }
+    float buf[pack];
+    VEC::saveu(buf, vmax);
+    float result = 0.f;
+    for (int i = 0; i < pack; i++) {
+        result = std::max(result, buf[i]);
+    }
+    for (; k < K; k++) {
+        result = std::max(result, std::fabs(src[k]));
+    }
+    return result;
+}
+
+// round to nearest even as _mm_cvtps_epi32 does, |src| * multiplier never exceeds 127
+static void QuantizeRow(int8_t *dst, const float *src, long K, float multiplier) {
+    __m128 vmul = _mm_set1_ps(multiplier);
+    long k      = 0;
+    for (; k + 8 <= K; k += 8) {
+        __m128i v0  = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(src + k), vmul));
+        __m128i v1  = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(src + k + 4), vmul));
+        __m128i v16 = _mm_packs_epi32(v0, v1);
+        _mm_storel_epi64((__m128i *)(dst + k), _mm_packs_epi16(v16, v16));
+    }
+    for (; k < K; k++) {
+        dst[k] = static_cast<int8_t>(std::nearbyint(src[k] * multiplier));
+    }
+}
+
+template <typename VEC, int pack>
+void X86DynamicQuantize(int8_t *dst, float *scale, const float *src, long rows, long K, bool per_row) {
+    const long row_bytes = X86DynamicQuantRowBytes(K);
+    std::vector<float> row_max(rows);
+    OMP_PARALLEL_FOR_
+    for (long r = 0; r < rows; r++) {
+        row_max[r] = AbsMax<VEC, pack>(src + r * K, K);
+    }
+    if (!per_row) {
+        scale[0] = *std::max_element(row_max.begin(), row_max.end()) / 127.f;
+    }
+
+    OMP_PARALLEL_FOR_
+    for (long r = 0; r < rows; r++) {
+        float row_scale = per_row ? row_max[r] / 127.f : scale[0];
+        if (per_row) {
+            scale[r] = row_scale;
+        }
+        auto dst_row = dst + r * row_bytes;
+        QuantizeRow(dst_row, src + r * K, K, row_scale > 0.f ? 1.f / row_scale : 0.f);
+        memset(dst_row + K, 0, row_bytes - K);
+    }
+}
+template void X86DynamicQuantize<Float4, 4>(int8_t *dst, float *scale, const float *src, long rows, long K,
+                                            bool per_row);
+template void X86DynamicQuantize<Float8, 8>(int8_t *dst, float *scale, const float *src, long rows, long K,
+                                            bool per_row);
+
+static inline int32_t ReduceAdd(__m128i v) {
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(v);
+}
+
+// sum[i * 4 + j] = dot(src_i, weight_j) for 2 rows of src and 4 rows of weight
+typedef void (*DynamicQuantDotFunc)(const int8_t *src0, const int8_t *src1, const int8_t *weight, long row_bytes,
+                                    int32_t *sum);
+
+static void SSEDot2x4(const int8_t *src0, const int8_t *src1, const int8_t *weight, long row_bytes, int32_t *sum) {
+    __m128i acc[2][4];
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 4; j++) {
+            acc[i][j] = _mm_setzero_si128();
+        }
+    }
+    for (long k = 0; k < row_bytes; k += 8) {
+        __m128i a0 = _mm_cvtepi8_epi16(_mm_loadl_epi64((const __m128i *)(src0 + k)));
+        __m128i a1 = _mm_cvtepi8_epi16(_mm_loadl_epi64((const __m128i *)(src1 + k)));
+        for (int j = 0; j < 4; j++) {
+            __m128i b = _mm_cvtepi8_epi16(_mm_loadl_epi64((const __m128i *)(weight + j * row_bytes + k)));
+            acc[0][j] = _mm_add_epi32(acc[0][j], _mm_madd_epi16(a0, b));
+            acc[1][j] = _mm_add_epi32(acc[1][j], _mm_madd_epi16(a1, b));
+        }
+    }
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 4; j++) {
+            sum[i * 4 + j] = ReduceAdd(acc[i][j]);
+        }
+    }
+}
+
+#ifdef __AVX2__
+static void AVXDot2x4(const int8_t *src0, const int8_t *src1, const int8_t *weight, long row_bytes, int32_t *sum) {
+    __m256i acc[2][4];
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 4; j++) {
+            acc[i][j] = _mm256_setzero_si256();
+        }
+    }
+    for (long k = 0; k < row_bytes; k += 16) {
+        __m256i a0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(src0 + k)));
+        __m256i a1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(src1 + k)));
+        for (int j = 0; j < 4; j++) {
+            __m256i b = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(weight + j * row_bytes + k)));
+            acc[0][j] = _mm256_add_epi32(acc[0][j], _mm256_madd_epi16(a0, b));
+            acc[1][j] = _mm256_add_epi32(acc[1][j], _mm256_madd_epi16(a1, b));
+        }
+    }
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 4; j++) {
+            __m128i v      = _mm_add_epi32(_mm256_castsi256_si128(acc[i][j]), _mm256_extracti128_si256(acc[i][j], 1));
+            sum[i * 4 + j] = ReduceAdd(v);
+        }
+    }
+}
+#endif
+
+static void DynamicQuantGemm(DynamicQuantDotFunc dot_func, float *dst, long ld_dst, const int8_t *src,
+                             const float *src_scale, bool per_row, const int8_t *weight, const float *weight_scale,
+                             const float *bias, long rows, long oc, long K) {
+    const long row_bytes = X86DynamicQuantRowBytes(K);
+    OMP_PARALLEL_FOR_GUIDED_
+    for (long m = 0; m < oc; m += 4) {
+        const int8_t *weight_m = weight + m * row_bytes;
+        const int oc_eff       = MIN(oc - m, 4);
+        for (long r = 0; r < rows; r += 2) {
+            const int rows_eff  = MIN(rows - r, 2);
+            const int8_t *src0  = src + r * row_bytes;
+            const int8_t *src1  = rows_eff > 1 ? src0 + row_bytes : src0;
+            int32_t sum[8];
+            dot_func(src0, src1, weight_m, row_bytes, sum);
+            // dequantize in the epilogue
+            for (int i = 0; i < rows_eff; i++) {
+                const float scale_r = src_scale[per_row ? r + i : 0];
+                float *dst_r        = dst + (r + i) * ld_dst + m;
+                for (int j = 0; j < oc_eff; j++) {
+                    dst_r[j] = sum[i * 4 + j] * scale_r * weight_scale[m + j] + (bias ? bias[m + j] : 0.f);
+                }
+            }
+        }
+    }
+}
+
+void X86SSEDynamicQuantGemm(float *dst, long ld_dst, const int8_t *src, const float *src_scale, bool per_row,
+                            const int8_t *weight, const float *weight_scale, const float *bias, long rows, long oc,
+                            long K) {
+    DynamicQuantGemm(SSEDot2x4, dst, ld_dst, src, src_scale, per_row, weight, weight_scale, bias, rows, oc, K);
+}
+
+#ifdef __AVX2__
+void X86AVXDynamicQuantGemm(float *dst, long ld_dst, const int8_t *src, const float *src_scale, bool per_row,
+                            const int8_t *weight, const float *weight_scale, const float *bias, long rows, long oc,
+                            long K) {
+    DynamicQuantGemm(AVXDot2x4, dst, ld_dst, src, src_scale, per_row, weight, weight_scale, bias, rows, oc, K);
+}
+#endif
+
+}  // namespace TNN_NS
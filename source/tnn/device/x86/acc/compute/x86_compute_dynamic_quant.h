@@ -0,0 +1,55 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_X86_COMPUTE_DYNAMIC_QUANT_H_
+#define SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_X86_COMPUTE_DYNAMIC_QUANT_H_
+
+#include "tnn/core/common.h"
+#include "tnn/device/x86/acc/Float4.h"
+#include "tnn/device/x86/acc/Float8.h"
+
+namespace TNN_NS {
+
+// Dynamic int8 quantization: the weight is quantized offline with one symmetric scale per output channel
+// (weight-only int8 with group 0), the activations are quantized at runtime with one symmetric scale per
+// tensor or per row, and the gemm accumulates in int32 and dequantizes in its epilogue.
+//   weight: [ROUND_UP(oc, 4)][row_bytes] int8
+//   src   : [rows][row_bytes] int8
+// rows are padded with zeros to row_bytes.
+
+// @brief bytes of one quantized row of K elements
+long X86DynamicQuantRowBytes(long K);
+
+// @brief pack weight rows [oc][K] into [ROUND_UP(oc, 4)][row_bytes]
+void X86DynamicQuantPackWeight(int8_t *dst, const int8_t *src, long oc, long K);
+
+// @brief quantize src[rows][K] to dst[rows][row_bytes], scale has rows entries if per_row, else one
+template <typename VEC, int pack>
+void X86DynamicQuantize(int8_t *dst, float *scale, const float *src, long rows, long K, bool per_row);
+
+// @brief dst[r][m] = src_scale[r] * weight_scale[m] * sum(src[r][k] * weight[m][k]) + bias[m] with int32
+//        accumulation, bias may be nullptr
+void X86SSEDynamicQuantGemm(float *dst, long ld_dst, const int8_t *src, const float *src_scale, bool per_row,
+                            const int8_t *weight, const float *weight_scale, const float *bias, long rows, long oc,
+                            long K);
+#ifdef __AVX2__
+void X86AVXDynamicQuantGemm(float *dst, long ld_dst, const int8_t *src, const float *src_scale, bool per_row,
+                            const int8_t *weight, const float *weight_scale, const float *bias, long rows, long oc,
+                            long K);
+#endif
+
+}  // namespace TNN_NS
+
+#endif  // SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_X86_COMPUTE_DYNAMIC_QUANT_H_
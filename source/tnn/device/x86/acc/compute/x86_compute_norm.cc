@@ -0,0 +1,222 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/device/x86/acc/compute/x86_compute_norm.h"
+
+#include <cmath>
+
+#include "tnn/device/x86/acc/compute/x86_compute.h"
+#include "tnn/utils/dims_utils.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+template <typename VEC>
+static inline VEC NormLoad(const float *src, const float *residual, float *sum, long i) {
+    if (!residual) {
+        return VEC::loadu(src + i);
+    }
+    VEC x = VEC::loadu(src + i) + VEC::loadu(residual + i);
+    VEC::saveu(sum + i, x);
+    return x;
+}
+
+// merge the statistics of another part into (n, mean, m2), see Chan et al. for the parallel variance
+static inline void NormMerge(long &n, double &mean, double &m2, long n_b, double mean_b, double m2_b) {
+    if (n_b == 0) {
+        return;
+    }
+    const long n_ab     = n + n_b;
+    const double delta  = mean_b - mean;
+    mean += delta * n_b / n_ab;
+    m2 += m2_b + delta * delta * n * n_b / n_ab;
+    n = n_ab;
+}
+
+template <typename VEC, int pack>
+void X86NormStatistics(const float *src, const float *residual, float *sum, long count, float eps, float &mean,
+                       float &inv_std) {
+    // two independent accumulators on even and odd blocks hide the latency of the updates
+    const long blocks = count / pack;
+    VEC mean0(0.f), m2_0(0.f), mean1(0.f), m2_1(0.f);
+    long n0 = 0, n1 = 0;
+    long b  = 0;
+    for (; b + 1 < blocks; b += 2) {
+        VEC x0 = NormLoad<VEC>(src, residual, sum, b * pack);
+        VEC x1 = NormLoad<VEC>(src, residual, sum, (b + 1) * pack);
+        n0++;
+        n1++;
+        const float r = 1.f / n0;
+        VEC d0        = x0 - mean0;
+        VEC d1        = x1 - mean1;
+        mean0         = mean0 + d0 * r;
+        mean1         = mean1 + d1 * r;
+        VEC::mla(m2_0, d0, x0 - mean0);
+        VEC::mla(m2_1, d1, x1 - mean1);
+    }
+    if (b < blocks) {
+        VEC x0 = NormLoad<VEC>(src, residual, sum, b * pack);
+        n0++;
+        VEC d0 = x0 - mean0;
+        mean0  = mean0 + d0 * (1.f / n0);
+        VEC::mla(m2_0, d0, x0 - mean0);
+    }
+
+    float mean_buf0[pack], m2_buf0[pack], mean_buf1[pack], m2_buf1[pack];
+    VEC::saveu(mean_buf0, mean0);
+    VEC::saveu(m2_buf0, m2_0);
+    VEC::saveu(mean_buf1, mean1);
+    VEC::saveu(m2_buf1, m2_1);
+    long n         = 0;
+    double mean_d  = 0;
+    double m2_d    = 0;
+    for (int i = 0; i < pack; i++) {
+        NormMerge(n, mean_d, m2_d, n0, mean_buf0[i], m2_buf0[i]);
+        NormMerge(n, mean_d, m2_d, n1, mean_buf1[i], m2_buf1[i]);
+    }
+    for (long i = blocks * pack; i < count; i++) {
+        float x = src[i];
+        if (residual) {
+            x += residual[i];
+            sum[i] = x;
+        }
+        NormMerge(n, mean_d, m2_d, 1, x, 0);
+    }
+
+    double variance = count > 0 ? m2_d / count : 0;
+    mean            = (float)mean_d;
+    inv_std         = (float)(1.0 / std::sqrt((variance > 0 ? variance : 0) + eps));
+}
+template void X86NormStatistics<Float4, 4>(const float *src, const float *residual, float *sum, long count,
+                                           float eps, float &mean, float &inv_std);
+template void X86NormStatistics<Float8, 8>(const float *src, const float *residual, float *sum, long count,
+                                           float eps, float &mean, float &inv_std);
+
+template <typename VEC, int pack>
+void X86LayerNorm(const float *src, const float *residual, float *sum, float *dst, long rows, long area,
+                  const float *scale, const float *bias, float eps, int activation_type) {
+    OMP_PARALLEL_FOR_GUIDED_
+    for (long r = 0; r < rows; r++) {
+        const float *src_r = src + r * area;
+        const float *res_r = residual ? residual + r * area : nullptr;
+        float *dst_r       = dst + r * area;
+        // without the sum output, the sum is normalized in place in dst
+        float *sum_r = residual ? (sum ? sum + r * area : dst_r) : nullptr;
+
+        float mean, inv_std;
+        X86NormStatistics<VEC, pack>(src_r, res_r, sum_r, area, eps, mean, inv_std);
+
+        const float *x_r = residual ? sum_r : src_r;
+        VEC v_mean(mean), v_inv_std(inv_std);
+        long i = 0;
+        for (; i + pack <= area; i += pack) {
+            VEC v   = (VEC::loadu(x_r + i) - v_mean) * v_inv_std;
+            VEC out = VEC::loadu(bias + i);
+            VEC::mla(out, v, VEC::loadu(scale + i));
+            VEC::saveu(dst_r + i, out);
+        }
+        for (; i < area; i++) {
+            dst_r[i] = (x_r[i] - mean) * inv_std * scale[i] + bias[i];
+        }
+        if (activation_type != ActivationType_None) {
+            X86ActivationPost<VEC, pack>(dst_r, area, 1, area, activation_type);
+        }
+    }
+}
+template void X86LayerNorm<Float4, 4>(const float *src, const float *residual, float *sum, float *dst, long rows,
+                                      long area, const float *scale, const float *bias, float eps,
+                                      int activation_type);
+template void X86LayerNorm<Float8, 8>(const float *src, const float *residual, float *sum, float *dst, long rows,
+                                      long area, const float *scale, const float *bias, float eps,
+                                      int activation_type);
+
+template <typename VEC, int pack>
+void X86GroupNorm(const float *src, const float *residual, float *sum, float *dst, long batch, long channels,
+                  long group, long area, const float *scale, const float *bias, float eps, int activation_type) {
+    const long channels_per_group = channels / group;
+    const long group_area         = channels_per_group * area;
+
+    OMP_PARALLEL_FOR_GUIDED_
+    for (long bg = 0; bg < batch * group; bg++) {
+        const long offset  = bg * group_area;
+        const float *src_g = src + offset;
+        const float *res_g = residual ? residual + offset : nullptr;
+        float *dst_g       = dst + offset;
+        float *sum_g       = residual ? (sum ? sum + offset : dst_g) : nullptr;
+
+        float mean, inv_std;
+        X86NormStatistics<VEC, pack>(src_g, res_g, sum_g, group_area, eps, mean, inv_std);
+
+        const float *x_g = residual ? sum_g : src_g;
+        for (long c = 0; c < channels_per_group; c++) {
+            const long channel = (bg % group) * channels_per_group + c;
+            const float k      = (scale ? scale[channel] : 1.f) * inv_std;
+            const float b      = (bias ? bias[channel] : 0.f) - mean * k;
+            const float *x_c   = x_g + c * area;
+            float *dst_c       = dst_g + c * area;
+            VEC v_k(k), v_b(b);
+            long i = 0;
+            for (; i + pack <= area; i += pack) {
+                VEC out = v_b;
+                VEC::mla(out, VEC::loadu(x_c + i), v_k);
+                VEC::saveu(dst_c + i, out);
+            }
+            for (; i < area; i++) {
+                dst_c[i] = x_c[i] * k + b;
+            }
+        }
+        if (activation_type != ActivationType_None) {
+            X86ActivationPost<VEC, pack>(dst_g, group_area, 1, group_area, activation_type);
+        }
+    }
+}
+template void X86GroupNorm<Float4, 4>(const float *src, const float *residual, float *sum, float *dst, long batch,
+                                      long channels, long group, long area, const float *scale, const float *bias,
+                                      float eps, int activation_type);
+template void X86GroupNorm<Float8, 8>(const float *src, const float *residual, float *sum, float *dst, long batch,
+                                      long channels, long group, long area, const float *scale, const float *bias,
+                                      float eps, int activation_type);
+
+void X86NormBroadcastAdd(const float *a, const DimsVector &dims_a, const float *b, const DimsVector &dims_b,
+                         float *dst, const DimsVector &dims_dst) {
+    const int rank = (int)dims_dst.size();
+    // strides of a and b on the dims of dst, 0 on broadcast dims
+    auto broadcast_strides = [&](const DimsVector &dims) {
+        DimsVector strides(rank, 0);
+        int stride = 1;
+        for (int i = (int)dims.size() - 1, j = rank - 1; i >= 0; i--, j--) {
+            strides[j] = dims[i] == 1 ? 0 : stride;
+            stride *= dims[i];
+        }
+        return strides;
+    };
+    const DimsVector strides_a = broadcast_strides(dims_a);
+    const DimsVector strides_b = broadcast_strides(dims_b);
+    const int count            = DimsVectorUtils::Count(dims_dst);
+
+    OMP_PARALLEL_FOR_
+    for (int i = 0; i < count; i++) {
+        int offset_a = 0, offset_b = 0;
+        int index    = i;
+        for (int d = rank - 1; d >= 0; d--) {
+            const int pos = index % dims_dst[d];
+            index /= dims_dst[d];
+            offset_a += pos * strides_a[d];
+            offset_b += pos * strides_b[d];
+        }
+        dst[i] = a[offset_a] + b[offset_b];
+    }
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,48 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_X86_COMPUTE_NORM_H_
+#define SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_X86_COMPUTE_NORM_H_
+
+#include "tnn/core/common.h"
+#include "tnn/device/x86/acc/Float4.h"
+#include "tnn/device/x86/acc/Float8.h"
+
+namespace TNN_NS {
+
+// mean and 1 / sqrt(variance + eps) of count elements read once, with Welford updates on each lane.
+// if residual is not null, the statistics are of src + residual, which is written to sum
+template <typename VEC, int pack>
+void X86NormStatistics(const float *src, const float *residual, float *sum, long count, float eps, float &mean,
+                       float &inv_std);
+
+// LayerNorm of rows * area, scale and bias are per element of a row.
+// residual is added to src before the normalization if not null, and the sum is kept in sum if not null
+template <typename VEC, int pack>
+void X86LayerNorm(const float *src, const float *residual, float *sum, float *dst, long rows, long area,
+                  const float *scale, const float *bias, float eps, int activation_type);
+
+// GroupNorm of [batch, channels, area], scale and bias are per channel and may be null.
+// InstanceNorm is GroupNorm with group == channels
+template <typename VEC, int pack>
+void X86GroupNorm(const float *src, const float *residual, float *sum, float *dst, long batch, long channels,
+                  long group, long area, const float *scale, const float *bias, float eps, int activation_type);
+
+// dst = a + b broadcast to dims_dst, for residuals of a shape different from the input
+void X86NormBroadcastAdd(const float *a, const DimsVector &dims_a, const float *b, const DimsVector &dims_b,
+                         float *dst, const DimsVector &dims_dst);
+
+}  // namespace TNN_NS
+
+#endif  // SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_X86_COMPUTE_NORM_H_
@@ -0,0 +1,203 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/device/x86/acc/compute/x86_compute_sparse.h"
+
+#include "tnn/device/x86/acc/compute/x86_compute.h"
+#include "tnn/device/x86/x86_common.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+float X86SparseWeightDensity(const float *weight, long oc, long ic) {
+    long count = oc * ic;
+    if (count <= 0) {
+        return 1.f;
+    }
+    long nnz = 0;
+    for (long i = 0; i < count; i++) {
+        nnz += weight[i] != 0.f;
+    }
+    return (float)nnz / count;
+}
+
+Status X86SparseWeightPack(const float *weight, long oc, long ic, X86SparseWeight &sparse) {
+    long nnz = 0;
+    for (long i = 0; i < oc * ic; i++) {
+        nnz += weight[i] != 0.f;
+    }
+    if (nnz > INT32_MAX) {
+        return Status(TNNERR_MODEL_ERR, "too many nonzero weights for sparse kernels");
+    }
+
+    // keep at least one element, RawBuffer of size 0 has no data
+    RawBuffer row_offsets((oc + 1) * sizeof(int32_t));
+    RawBuffer col_index(MAX(nnz, 1) * sizeof(int32_t));
+    RawBuffer values(MAX(nnz, 1) * sizeof(float));
+    auto row_ptr   = row_offsets.force_to<int32_t *>();
+    auto col_ptr   = col_index.force_to<int32_t *>();
+    auto value_ptr = values.force_to<float *>();
+
+    int32_t idx = 0;
+    for (long o = 0; o < oc; o++) {
+        row_ptr[o]    = idx;
+        auto weight_o = weight + o * ic;
+        for (long i = 0; i < ic; i++) {
+            if (weight_o[i] != 0.f) {
+                col_ptr[idx]   = i;
+                value_ptr[idx] = weight_o[i];
+                idx++;
+            }
+        }
+    }
+    row_ptr[oc] = idx;
+
+    row_offsets.SetDataType(DATA_TYPE_INT32);
+    col_index.SetDataType(DATA_TYPE_INT32);
+    values.SetDataType(DATA_TYPE_FLOAT);
+    sparse.row_offsets = row_offsets;
+    sparse.col_index   = col_index;
+    sparse.values      = values;
+    return TNN_OK;
+}
+
+template <typename VEC, int pack>
+void X86SparseConv1x1(float *dst, const float *src, long hw, long oc, X86SparseWeight &sparse,
+                      const float *bias, long act_type) {
+    auto row_ptr   = sparse.row_offsets.force_to<int32_t *>();
+    auto col_ptr   = sparse.col_index.force_to<int32_t *>();
+    auto value_ptr = sparse.values.force_to<float *>();
+
+    // a tile of input columns is reused by all output channels while it is in cache
+    const long tile_size = 4 * pack;
+    const long tile_num  = UP_DIV(hw, tile_size);
+
+    OMP_PARALLEL_FOR_GUIDED_
+    for (long t = 0; t < tile_num; t++) {
+        const long i_begin = t * tile_size;
+        const long i_end   = MIN(i_begin + tile_size, hw);
+        const float *src_t = src + i_begin;
+
+        for (long o = 0; o < oc; o++) {
+            const int32_t begin = row_ptr[o];
+            const int32_t end   = row_ptr[o + 1];
+            const float b       = bias ? bias[o] : 0.f;
+            float *dst_t        = dst + o * hw + i_begin;
+
+            if (i_end - i_begin == tile_size) {
+                VEC c0(b), c1(b), c2(b), c3(b);
+                for (int32_t j = begin; j < end; j++) {
+                    VEC w(value_ptr[j]);
+                    const float *s = src_t + col_ptr[j] * hw;
+                    VEC::mla(c0, VEC::loadu(s), w);
+                    VEC::mla(c1, VEC::loadu(s + pack), w);
+                    VEC::mla(c2, VEC::loadu(s + 2 * pack), w);
+                    VEC::mla(c3, VEC::loadu(s + 3 * pack), w);
+                }
+                VEC::saveu(dst_t, c0);
+                VEC::saveu(dst_t + pack, c1);
+                VEC::saveu(dst_t + 2 * pack, c2);
+                VEC::saveu(dst_t + 3 * pack, c3);
+            } else {
+                long i = 0;
+                for (; i + pack <= i_end - i_begin; i += pack) {
+                    VEC c(b);
+                    for (int32_t j = begin; j < end; j++) {
+                        VEC::mla(c, VEC::loadu(src_t + col_ptr[j] * hw + i), VEC(value_ptr[j]));
+                    }
+                    VEC::saveu(dst_t + i, c);
+                }
+                for (; i < i_end - i_begin; i++) {
+                    float c = b;
+                    for (int32_t j = begin; j < end; j++) {
+                        c += value_ptr[j] * src_t[col_ptr[j] * hw + i];
+                    }
+                    dst_t[i] = c;
+                }
+            }
+            if (act_type != ActivationType_None) {
+                X86ActivationPost<VEC, pack>(dst_t, i_end - i_begin, 1, i_end - i_begin, act_type);
+            }
+        }
+    }
+}
+template void X86SparseConv1x1<Float4, 4>(float *dst, const float *src, long hw, long oc,
+                                          X86SparseWeight &sparse, const float *bias, long act_type);
+template void X86SparseConv1x1<Float8, 8>(float *dst, const float *src, long hw, long oc,
+                                          X86SparseWeight &sparse, const float *bias, long act_type);
+
+// sum of values[j] * src[col_index[j]] for j in [begin, end)
+template <typename VEC, int pack>
+struct SparseRowDot {
+    static inline float Dot(const float *src, const float *values, const int32_t *col_index, int32_t begin,
+                            int32_t end) {
+        float sum0 = 0.f, sum1 = 0.f;
+        int32_t j  = begin;
+        for (; j + 1 < end; j += 2) {
+            sum0 += values[j] * src[col_index[j]];
+            sum1 += values[j + 1] * src[col_index[j + 1]];
+        }
+        for (; j < end; j++) {
+            sum0 += values[j] * src[col_index[j]];
+        }
+        return sum0 + sum1;
+    }
+};
+
+#ifdef __AVX2__
+template <>
+struct SparseRowDot<Float8, 8> {
+    static inline float Dot(const float *src, const float *values, const int32_t *col_index, int32_t begin,
+                            int32_t end) {
+        __m256 acc = _mm256_setzero_ps();
+        int32_t j  = begin;
+        for (; j + 7 < end; j += 8) {
+            __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(col_index + j));
+            acc         = _mm256_fmadd_ps(_mm256_loadu_ps(values + j), _mm256_i32gather_ps(src, idx, 4), acc);
+        }
+        __m128 sum = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+        sum        = _mm_hadd_ps(sum, sum);
+        sum        = _mm_hadd_ps(sum, sum);
+        float res  = _mm_cvtss_f32(sum);
+        for (; j < end; j++) {
+            res += values[j] * src[col_index[j]];
+        }
+        return res;
+    }
+};
+#endif
+
+template <typename VEC, int pack>
+void X86SparseSgemv(float *dst, long ld_dst, const float *src, long ld_src, long batch, long oc,
+                    X86SparseWeight &sparse, const float *bias) {
+    auto row_ptr   = sparse.row_offsets.force_to<int32_t *>();
+    auto col_ptr   = sparse.col_index.force_to<int32_t *>();
+    auto value_ptr = sparse.values.force_to<float *>();
+
+    // rows have different nonzero counts
+    OMP_PARALLEL_FOR_DYNAMIC_
+    for (long o = 0; o < oc; o++) {
+        const float b = bias ? bias[o] : 0.f;
+        for (long n = 0; n < batch; n++) {
+            dst[n * ld_dst + o] =
+                b + SparseRowDot<VEC, pack>::Dot(src + n * ld_src, value_ptr, col_ptr, row_ptr[o], row_ptr[o + 1]);
+        }
+    }
+}
+template void X86SparseSgemv<Float4, 4>(float *dst, long ld_dst, const float *src, long ld_src, long batch, long oc,
+                                        X86SparseWeight &sparse, const float *bias);
+template void X86SparseSgemv<Float8, 8>(float *dst, long ld_dst, const float *src, long ld_src, long batch, long oc,
+                                        X86SparseWeight &sparse, const float *bias);
+
+}  // namespace TNN_NS
@@ -0,0 +1,61 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_X86_COMPUTE_SPARSE_H_
+#define SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_X86_COMPUTE_SPARSE_H_
+
+#include "tnn/core/common.h"
+#include "tnn/core/status.h"
+#include "tnn/device/x86/acc/Float4.h"
+#include "tnn/device/x86/acc/Float8.h"
+#include "tnn/interpreter/raw_buffer.h"
+
+namespace TNN_NS {
+
+// Sparse weights of pruned models are kept in CSR of the [oc][ic] weight matrix:
+//   row_offsets: [oc + 1] int32, nonzeros of output channel o are [row_offsets[o], row_offsets[o + 1])
+//   col_index  : [nnz] int32, input channel of each nonzero
+//   values     : [nnz] float
+// the dense kernels are faster unless most of the weights are zero
+struct X86SparseWeight {
+    RawBuffer row_offsets;
+    RawBuffer col_index;
+    RawBuffer values;
+};
+
+// max weight density to run 1x1 convolution with the sparse kernel
+static const float kX86SparseConvMaxDensity = 0.4f;
+// max weight density to run innerproduct with the sparse kernel
+static const float kX86SparseFcMaxDensity = 0.3f;
+
+// @brief ratio of nonzero weights of a [oc][ic] weight matrix
+float X86SparseWeightDensity(const float *weight, long oc, long ic);
+
+// @brief build CSR of a dense [oc][ic] weight matrix
+Status X86SparseWeightPack(const float *weight, long oc, long ic, X86SparseWeight &sparse);
+
+// @brief 1x1 convolution of one batch in nchw, dst[oc][hw] = act(bias + W * src[ic][hw])
+//        vectorized along hw, the weights of an output channel are broadcast to whole vectors
+template <typename VEC, int pack>
+void X86SparseConv1x1(float *dst, const float *src, long hw, long oc, X86SparseWeight &sparse,
+                      const float *bias, long act_type);
+
+// @brief dst[b][oc] = bias + W * src[b][ic] for every batch b
+template <typename VEC, int pack>
+void X86SparseSgemv(float *dst, long ld_dst, const float *src, long ld_src, long batch, long oc,
+                    X86SparseWeight &sparse, const float *bias);
+
+}  // namespace TNN_NS
+
+#endif  // SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_X86_COMPUTE_SPARSE_H_
@@ -0,0 +1,306 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/device/x86/acc/compute/x86_compute_weight_quant.h"
+
+#include <cstring>
+
+#include "tnn/device/x86/x86_common.h"
+#include "tnn/device/x86/acc/compute/jit/conv_data_packing.h"
+#include "tnn/device/x86/acc/compute/jit/conv_sgemm_driver.h"
+#include "tnn/utils/omp_utils.h"
+#include "tnn/utils/weight_quant_utils.h"
+
+namespace TNN_NS {
+
+// load pack quantized weights of one input channel as float
+template <typename VEC, int pack>
+struct WeightQuantLoader {
+    static inline VEC Int8(const int8_t *ptr) {
+        float buf[pack];
+        for (int i = 0; i < pack; i++) {
+            buf[i] = ptr[i];
+        }
+        return VEC::loadu(buf);
+    }
+    // lo: even input channel, hi: odd input channel
+    static inline void Int4(const int8_t *ptr, VEC &lo, VEC &hi) {
+        float buf_lo[pack];
+        float buf_hi[pack];
+        for (int i = 0; i < pack; i++) {
+            buf_lo[i] = GetWeightQuantValue(ptr + i, 0, 4);
+            buf_hi[i] = GetWeightQuantValue(ptr + i, 1, 4);
+        }
+        lo = VEC::loadu(buf_lo);
+        hi = VEC::loadu(buf_hi);
+    }
+};
+
+#ifndef VEC_NAIVE_IMPL
+template <>
+struct WeightQuantLoader<Float4, 4> {
+    static inline Float4 Int8(const int8_t *ptr) {
+        int32_t packed;
+        memcpy(&packed, ptr, sizeof(int32_t));
+        __m128i v = _mm_cvtepi8_epi32(_mm_cvtsi32_si128(packed));
+        return Float4(_mm_cvtepi32_ps(v));
+    }
+    static inline void Int4(const int8_t *ptr, Float4 &lo, Float4 &hi) {
+        int32_t packed;
+        memcpy(&packed, ptr, sizeof(int32_t));
+        __m128i v = _mm_cvtepi8_epi32(_mm_cvtsi32_si128(packed));
+        lo        = Float4(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(v, 28), 28)));
+        hi        = Float4(_mm_cvtepi32_ps(_mm_srai_epi32(v, 4)));
+    }
+};
+#endif
+
+#ifdef __AVX2__
+template <>
+struct WeightQuantLoader<Float8, 8> {
+    static inline Float8 Int8(const int8_t *ptr) {
+        __m256i v = _mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i *)ptr));
+        return Float8(_mm256_cvtepi32_ps(v));
+    }
+    static inline void Int4(const int8_t *ptr, Float8 &lo, Float8 &hi) {
+        __m256i v = _mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i *)ptr));
+        lo        = Float8(_mm256_cvtepi32_ps(_mm256_srai_epi32(_mm256_slli_epi32(v, 28), 28)));
+        hi        = Float8(_mm256_cvtepi32_ps(_mm256_srai_epi32(v, 4)));
+    }
+};
+#endif
+
+bool X86WeightQuantSupported(long ic, int bits, int group) {
+    if (bits == 8) {
+        return true;
+    }
+    if (bits == 4) {
+        return WeightQuantGroupCount(ic, group) == 1 || WeightQuantGroupSize(ic, group) % 2 == 0;
+    }
+    return false;
+}
+
+size_t X86WeightQuantPackedBytes(long oc, long ic, int bits, int pack) {
+    return (size_t)UP_DIV(oc, pack) * WeightQuantRowBytes(ic, bits) * pack;
+}
+
+size_t X86WeightQuantPackedScaleCount(long oc, long ic, int group, int pack) {
+    return (size_t)UP_DIV(oc, pack) * WeightQuantGroupCount(ic, group) * pack;
+}
+
+void X86WeightQuantPack(int8_t *dst_weight, float *dst_scale, const int8_t *src_weight, const float *src_scale,
+                        long oc, long ic, int bits, int group, int pack) {
+    const long row_bytes   = WeightQuantRowBytes(ic, bits);
+    const long group_count = WeightQuantGroupCount(ic, group);
+    const long oc_blocks   = UP_DIV(oc, pack);
+
+    memset(dst_weight, 0, X86WeightQuantPackedBytes(oc, ic, bits, pack));
+    memset(dst_scale, 0, X86WeightQuantPackedScaleCount(oc, ic, group, pack) * sizeof(float));
+    for (long ob = 0; ob < oc_blocks; ob++) {
+        auto w_dst = dst_weight + ob * row_bytes * pack;
+        auto s_dst = dst_scale + ob * group_count * pack;
+        long left  = MIN(oc - ob * pack, pack);
+        for (long i = 0; i < left; i++) {
+            auto w_src = src_weight + (ob * pack + i) * row_bytes;
+            auto s_src = src_scale + (ob * pack + i) * group_count;
+            for (long k = 0; k < row_bytes; k++) {
+                w_dst[k * pack + i] = w_src[k];
+            }
+            for (long g = 0; g < group_count; g++) {
+                s_dst[g * pack + i] = s_src[g];
+            }
+        }
+    }
+}
+
+template <typename VEC, int pack>
+void X86WeightQuantSgemv(float *dst, long ld_dst, const float *src, long ld_src, const int8_t *weight,
+                         const float *scale, const float *bias, long batch, long oc, long ic, int bits, int group) {
+    typedef WeightQuantLoader<VEC, pack> Loader;
+    const long row_bytes   = WeightQuantRowBytes(ic, bits);
+    const long group_size  = WeightQuantGroupSize(ic, group);
+    const long group_count = WeightQuantGroupCount(ic, group);
+    const long oc_blocks   = UP_DIV(oc, pack);
+
+    for (long b = 0; b < batch; b++) {
+        const float *src_b = src + b * ld_src;
+        float *dst_b       = dst + b * ld_dst;
+
+        OMP_PARALLEL_FOR_GUIDED_
+        for (long ob = 0; ob < oc_blocks; ob++) {
+            auto w_ob      = weight + ob * row_bytes * pack;
+            auto s_ob      = scale + ob * group_count * pack;
+            long oc_start  = ob * pack;
+            long left      = MIN(oc - oc_start, pack);
+            auto init_data = bias ? bias + oc_start : dst_b + oc_start;
+
+            float buf[pack] = {0};
+            VEC res;
+            if (left == pack) {
+                res = VEC::loadu(init_data);
+            } else {
+                memcpy(buf, init_data, left * sizeof(float));
+                res = VEC::loadu(buf);
+            }
+
+            for (long g = 0; g < group_count; g++) {
+                long k     = g * group_size;
+                long k_end = MIN(k + group_size, ic);
+                VEC acc(0.f);
+                if (bits == 8) {
+                    for (; k + 3 < k_end; k += 4) {
+                        auto w_k = w_ob + k * pack;
+                        VEC::mla(acc, Loader::Int8(w_k), VEC(src_b[k]));
+                        VEC::mla(acc, Loader::Int8(w_k + pack), VEC(src_b[k + 1]));
+                        VEC::mla(acc, Loader::Int8(w_k + pack * 2), VEC(src_b[k + 2]));
+                        VEC::mla(acc, Loader::Int8(w_k + pack * 3), VEC(src_b[k + 3]));
+                    }
+                    for (; k < k_end; k++) {
+                        VEC::mla(acc, Loader::Int8(w_ob + k * pack), VEC(src_b[k]));
+                    }
+                } else {
+                    for (; k < k_end; k += 2) {
+                        VEC lo, hi;
+                        Loader::Int4(w_ob + (k >> 1) * pack, lo, hi);
+                        VEC::mla(acc, lo, VEC(src_b[k]));
+                        if (k + 1 < k_end) {
+                            VEC::mla(acc, hi, VEC(src_b[k + 1]));
+                        }
+                    }
+                }
+                VEC::mla(res, acc, VEC::loadu(s_ob + g * pack));
+            }
+
+            if (left == pack) {
+                VEC::saveu(dst_b + oc_start, res);
+            } else {
+                VEC::saveu(buf, res);
+                memcpy(dst_b + oc_start, buf, left * sizeof(float));
+            }
+        }
+    }
+}
+template void X86WeightQuantSgemv<Float4, 4>(float *dst, long ld_dst, const float *src, long ld_src,
+                                             const int8_t *weight, const float *scale, const float *bias, long batch,
+                                             long oc, long ic, int bits, int group);
+template void X86WeightQuantSgemv<Float8, 8>(float *dst, long ld_dst, const float *src, long ld_src,
+                                             const int8_t *weight, const float *scale, const float *bias, long batch,
+                                             long oc, long ic, int bits, int group);
+
+// dequantize rows [m_begin, m_begin + cur_m) and input channels [k_begin, k_begin + cur_k) of the packed weight
+// into the layout of pack_col_a_t, so that the jit sgemm kernels can be used directly
+template <typename VEC, int pack>
+static void X86WeightQuantPackA(float *dst, const int8_t *weight, const float *scale, long m_begin, long cur_m,
+                                long k_begin, long cur_k, long K, int bits, int group, long m_block, long K_c) {
+    typedef WeightQuantLoader<VEC, pack> Loader;
+    const long row_bytes   = WeightQuantRowBytes(K, bits);
+    const long group_size  = WeightQuantGroupSize(K, group);
+    const long group_count = WeightQuantGroupCount(K, group);
+    const long k_end       = k_begin + cur_k;
+
+    for (long i = 0; i < cur_m; i += pack) {
+        long ob    = (m_begin + i) / pack;
+        auto w_ob  = weight + ob * row_bytes * pack;
+        auto s_ob  = scale + ob * group_count * pack;
+        auto dst_i = dst + i / m_block * m_block * K_c + i % m_block;
+
+        long k = k_begin;
+        while (k < k_end) {
+            long g       = k / group_size;
+            long seg_end = MIN((g + 1) * group_size, k_end);
+            VEC s        = VEC::loadu(s_ob + g * pack);
+            if (bits == 8) {
+                for (; k < seg_end; k++) {
+                    VEC::saveu(dst_i + (k - k_begin) * m_block, VEC::mul(Loader::Int8(w_ob + k * pack), s));
+                }
+            } else {
+                for (; k < seg_end; k += 2) {
+                    VEC lo, hi;
+                    Loader::Int4(w_ob + (k >> 1) * pack, lo, hi);
+                    VEC::saveu(dst_i + (k - k_begin) * m_block, VEC::mul(lo, s));
+                    if (k + 1 < seg_end) {
+                        VEC::saveu(dst_i + (k + 1 - k_begin) * m_block, VEC::mul(hi, s));
+                    }
+                }
+            }
+        }
+    }
+}
+
+size_t X86WeightQuantSgemmWorkspaceSize(long N, conv_gemm_config<float, float, float> &conv_gemm_conf) {
+    size_t pack_b_size = ROUND_UP(conv_gemm_conf.K_c_ * ROUND_UP(N, conv_gemm_conf.n_block_) * sizeof(float), 32);
+    size_t pack_a_size = conv_gemm_conf.M_c_ * conv_gemm_conf.K_c_ * sizeof(float) * OMP_MAX_THREADS_NUM_;
+    return pack_b_size + pack_a_size;
+}
+
+template <typename VEC, int pack>
+void X86WeightQuantSgemm(long M, long N, long K, const int8_t *weight, const float *scale, int bits, int group,
+                         const float *src_b, long ldb, float *dst, long ldc, const float *bias, long act_type,
+                         float *workspace, conv_gemm_config<float, float, float> &conv_gemm_conf) {
+    dim_t M_c     = conv_gemm_conf.M_c_;
+    dim_t K_c     = conv_gemm_conf.K_c_;
+    dim_t m_block = conv_gemm_conf.m_block_;
+    dim_t n_block = conv_gemm_conf.n_block_;
+
+    float *pack_b_buf = workspace;
+    float *pack_a_buf = workspace + ROUND_UP(K_c * ROUND_UP(N, n_block) * sizeof(float), 32) / sizeof(float);
+
+    dim_t first = 0;
+    dim_t post_type;
+
+    // if no bias, first set to 1, load c from dst
+    if (bias == nullptr) {
+        first = 1;
+    }
+
+    for (dim_t k = 0; k < K; k += K_c) {
+        post_type   = k + K_c >= K ? act_type : 0;
+        dim_t cur_k = MIN(K - k, K_c);
+
+        // pack b -> K_c * N;
+        pack_col_b_n(src_b + k, ldb, pack_b_buf, K_c, cur_k, N, conv_gemm_conf);
+
+        OMP_PARALLEL_FOR_DYNAMIC_
+        for (dim_t i = 0; i < M; i += M_c) {
+            auto pack_a_per_t = pack_a_buf + OMP_TID_ * M_c * K_c;
+            dim_t cur_m       = MIN(M - i, M_c);
+            // dequantize a -> M_c * K_c;
+            X86WeightQuantPackA<VEC, pack>(pack_a_per_t, weight, scale, i, cur_m, k, cur_k, K, bits, group, m_block,
+                                           K_c);
+
+            for (dim_t j = 0; j < N;) {
+                dim_t cur_n  = MIN(N - j, conv_gemm_conf.kernel_n_r_);
+                float *cur_c = dst + i + j * ldc;
+
+                const float *packed_cur_b = pack_b_buf + j / n_block * n_block * K_c + j % n_block;
+                const float *cur_bias     = bias + j;
+                conv_sgemm_block_n(cur_m, cur_n, cur_k, pack_a_per_t, K, packed_cur_b, ldb, cur_c, ldc, cur_bias,
+                                   first, post_type, conv_gemm_conf);
+                j += cur_n;
+            }
+        }
+        // if k != 0, first = 1
+        first = 1;
+    }
+}
+template void X86WeightQuantSgemm<Float4, 4>(long M, long N, long K, const int8_t *weight, const float *scale,
+                                             int bits, int group, const float *src_b, long ldb, float *dst,
+                                             long ldc, const float *bias, long act_type, float *workspace,
+                                             conv_gemm_config<float, float, float> &conv_gemm_conf);
+template void X86WeightQuantSgemm<Float8, 8>(long M, long N, long K, const int8_t *weight, const float *scale,
+                                             int bits, int group, const float *src_b, long ldb, float *dst,
+                                             long ldc, const float *bias, long act_type, float *workspace,
+                                             conv_gemm_config<float, float, float> &conv_gemm_conf);
+
+}  // namespace TNN_NS
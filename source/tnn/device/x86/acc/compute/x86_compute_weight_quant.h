@@ -0,0 +1,62 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_X86_COMPUTE_WEIGHT_QUANT_H_
+#define SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_X86_COMPUTE_WEIGHT_QUANT_H_
+
+#include "tnn/core/common.h"
+#include "tnn/device/x86/acc/compute/jit/conv_gemm_config.h"
+#include "tnn/device/x86/acc/Float4.h"
+#include "tnn/device/x86/acc/Float8.h"
+
+namespace TNN_NS {
+
+// Packed layout of weight-only quantized weights (see tnn/utils/weight_quant_utils.h):
+//   weight: [UP_DIV(oc, pack)][row_bytes][pack] int8, int4 bytes keep both nibbles of the row
+//   scale : [UP_DIV(oc, pack)][group_count][pack] float
+// padded output channels are filled with zeros.
+
+// @brief whether the x86 kernels can run the given weight-only quantized weight,
+//        int4 groups must start on a byte boundary
+bool X86WeightQuantSupported(long ic, int bits, int group);
+
+// @brief bytes of packed weight
+size_t X86WeightQuantPackedBytes(long oc, long ic, int bits, int pack);
+
+// @brief count of packed scales
+size_t X86WeightQuantPackedScaleCount(long oc, long ic, int group, int pack);
+
+// @brief pack weight rows [oc][row_bytes] and scales [oc][group_count] into blocks of pack output channels
+void X86WeightQuantPack(int8_t *dst_weight, float *dst_scale, const int8_t *src_weight, const float *src_scale,
+                        long oc, long ic, int bits, int group, int pack);
+
+// @brief dst[b][oc] = bias + W * src[b][ic] for every batch b, dst is accumulated if bias is nullptr
+template <typename VEC, int pack>
+void X86WeightQuantSgemv(float *dst, long ld_dst, const float *src, long ld_src, const int8_t *weight,
+                         const float *scale, const float *bias, long batch, long oc, long ic, int bits, int group);
+
+// @brief workspace bytes of X86WeightQuantSgemm
+size_t X86WeightQuantSgemmWorkspaceSize(long N, conv_gemm_config<float, float, float> &conv_gemm_conf);
+
+// @brief col major C[M * N] = W[M * K] * B[K * N], bias and act_type as conv_sgemm_tn_col_major_prepack_a
+//        W is packed by X86WeightQuantPack, each thread dequantizes its M_c * K_c block of W
+//        into the gemm packing buffer, the fp32 weight is never expanded as a whole
+template <typename VEC, int pack>
+void X86WeightQuantSgemm(long M, long N, long K, const int8_t *weight, const float *scale, int bits, int group,
+                         const float *src_b, long ldb, float *dst, long ldc, const float *bias, long act_type,
+                         float *workspace, conv_gemm_config<float, float, float> &conv_gemm_conf);
+
+}  // namespace TNN_NS
+
+#endif  // SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_X86_COMPUTE_WEIGHT_QUANT_H_
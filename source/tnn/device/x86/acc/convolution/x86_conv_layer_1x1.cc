@@ -50,6 +50,26 @@ bool X86ConvLayer1x1::isPrefered(ConvLayerParam *param, const std::vector<Blob *
 
 X86ConvLayer1x1::~X86ConvLayer1x1() {}
 
+Status X86ConvLayer1x1::allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    ConvLayerResource *conv_res = dynamic_cast<ConvLayerResource *>(resource_);
+    CHECK_PARAM_NULL(conv_res);
+
+    if (!buffer_weight_.GetBytesSize() && !use_sparse_ &&
+        conv_res->filter_handle.GetDataType() == DATA_TYPE_FLOAT) {
+        int oc = outputs[0]->GetBlobDesc().dims[1];
+        int ic = inputs[0]->GetBlobDesc().dims[1];
+        const float *src = conv_res->filter_handle.force_to<float *>();
+        if (X86SparseWeightDensity(src, oc, ic) <= kX86SparseConvMaxDensity) {
+            RETURN_ON_NEQ(X86SparseWeightPack(src, oc, ic, sparse_weight_), TNN_OK);
+            use_sparse_ = true;
+        }
+    }
+    if (use_sparse_) {
+        return TNN_OK;
+    }
+    return X86ConvLayerCommon::allocateBufferWeight(inputs, outputs);
+}
+
 Status X86ConvLayer1x1::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     ConvLayerParam *param = dynamic_cast<ConvLayerParam *>(param_);
 
@@ -69,6 +89,19 @@ Status X86ConvLayer1x1::DoForward(const std::vector<Blob *> &inputs, const std::
     const float *src_origin = reinterpret_cast<const float *>(input->GetHandle().base);
     float *dst_origin = reinterpret_cast<float *>(output->GetHandle().base);
 
+    if (use_sparse_) {
+        auto X86SparseConv1x1Func = X86SparseConv1x1<Float4, 4>;
+        if (arch_ == avx2) {
+            X86SparseConv1x1Func = X86SparseConv1x1<Float8, 8>;
+        }
+        for (int batch_idx = 0; batch_idx < batch; batch_idx++) {
+            X86SparseConv1x1Func(dst_origin + batch_idx * dims_output[1] * dst_z_step,
+                                 src_origin + batch_idx * dims_input[1] * src_z_step, src_z_step, dims_output[1],
+                                 sparse_weight_, bias_data, param->activation_type);
+        }
+        return TNN_OK;
+    }
+
     // X86_matrixMul in row major format
     int m = dims_output[1];
     int n = src_z_step;
@@ -15,6 +15,7 @@
 #ifndef TNN_SOURCE_TNN_DEVICE_X86_X86_CONV_LAYER_ACC_1x1_H_
 #define TNN_SOURCE_TNN_DEVICE_X86_X86_CONV_LAYER_ACC_1x1_H_
 
+#include "tnn/device/x86/acc/compute/x86_compute_sparse.h"
 #include "tnn/device/x86/acc/convolution/x86_conv_layer_common.h"
 
 namespace TNN_NS {
@@ -27,6 +28,13 @@ public:
 
     static bool isPrefered(ConvLayerParam *param, const std::vector<Blob *> &inputs,
                            const std::vector<Blob *> &outputs);
+
+    virtual Status allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+protected:
+    // pruned weights run with the sparse kernel instead of the packed gemm
+    bool use_sparse_ = false;
+    X86SparseWeight sparse_weight_;
 };
 
 }  // namespace TNN_NS
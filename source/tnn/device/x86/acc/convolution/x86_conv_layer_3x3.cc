@@ -554,6 +554,17 @@ static void output_trans_post_2x4(const float *src, int src_stride, int src_h_st
         dest01    = VEC::min(dest01, sixs);
         dest11    = VEC::min(dest11, sixs);
     }
+    if (relu_type == ActivationType_SIGMOID_MUL) {
+        dest00 = X86ActivationVec<ActivationType_SIGMOID_MUL, VEC>(dest00);
+        dest10 = X86ActivationVec<ActivationType_SIGMOID_MUL, VEC>(dest10);
+        dest01 = X86ActivationVec<ActivationType_SIGMOID_MUL, VEC>(dest01);
+        dest11 = X86ActivationVec<ActivationType_SIGMOID_MUL, VEC>(dest11);
+    } else if (relu_type == ActivationType_GELU) {
+        dest00 = X86ActivationVec<ActivationType_GELU, VEC>(dest00);
+        dest10 = X86ActivationVec<ActivationType_GELU, VEC>(dest10);
+        dest01 = X86ActivationVec<ActivationType_GELU, VEC>(dest01);
+        dest11 = X86ActivationVec<ActivationType_GELU, VEC>(dest11);
+    }
 
     VEC::saveu(dest, dest00);
     VEC::saveu(dest + dest_stride, dest10);
@@ -566,8 +577,8 @@ template void output_trans_post_2x4<Float8>(const float *src, int src_stride, in
 template void output_trans_post_2x4<Float4>(const float *src, int src_stride, int src_h_stride, float *dest,
                                             int dest_stride, int dest_h_stride, const float *bias_value, int relu_type);
 
-bool X86ConvLayer3x3::isPrefered(ConvLayerParam *param, const std::vector<Blob *> &inputs,
-                                 const std::vector<Blob *> &outputs) {
+bool X86ConvLayer3x3::isSupported(ConvLayerParam *param, const std::vector<Blob *> &inputs,
+                                  const std::vector<Blob *> &outputs) {
     if (!param) {
         return false;
     }
@@ -582,9 +593,13 @@ bool X86ConvLayer3x3::isPrefered(ConvLayerParam *param, const std::vector<Blob *
     const int dh = param->dialations[1];
     const int sw = param->strides[0];
     const int sh = param->strides[1];
-    const int ic = inputs[0]->GetBlobDesc().dims[1];
 
-    return kw == 3 && kh == 3 && dw == 1 && dh == 1 && sw == 1 && sh == 1 && ic >= 16;
+    return kw == 3 && kh == 3 && dw == 1 && dh == 1 && sw == 1 && sh == 1;
+}
+
+bool X86ConvLayer3x3::isPrefered(ConvLayerParam *param, const std::vector<Blob *> &inputs,
+                                 const std::vector<Blob *> &outputs) {
+    return isSupported(param, inputs, outputs) && inputs[0]->GetBlobDesc().dims[1] >= 16;
 }
 
 X86ConvLayer3x3::~X86ConvLayer3x3() {}
@@ -610,14 +625,20 @@ Status X86ConvLayer3x3::allocateBufferWeight(const std::vector<Blob *> &inputs,
         const int data_byte_size = DataTypeUtils::GetBytesSize(conv_res->filter_handle.GetDataType());
 
         if (conv_res->filter_handle.GetDataType() == DATA_TYPE_FLOAT) {
-            RawBuffer pack_buffer(weight_count * data_byte_size);
-            float *dst = pack_buffer.force_to<float *>();
-
-            const float G[4][3] = {{1.0f, 0.0f, 0.0f}, {0.5f, 0.5f, 0.5f}, {0.5f, -0.5f, 0.5f}, {0.0f, 0.0f, 1.0f}};
-            weight_transform(src, dst, 3, 4, input_channel, output_channel, CH_PACK, G);
-
-            pack_buffer.SetDataType(DATA_TYPE_FLOAT);
-            buffer_weight_ = pack_buffer;
+            auto pack_weight = [&](RawBuffer &packed) {
+                RawBuffer pack_buffer(weight_count * data_byte_size);
+                float *dst = pack_buffer.force_to<float *>();
+
+                const float G[4][3] = {{1.0f, 0.0f, 0.0f}, {0.5f, 0.5f, 0.5f}, {0.5f, -0.5f, 0.5f}, {0.0f, 0.0f, 1.0f}};
+                weight_transform(src, dst, 3, 4, input_channel, output_channel, CH_PACK, G);
+
+                pack_buffer.SetDataType(DATA_TYPE_FLOAT);
+                packed = pack_buffer;
+                return Status(TNN_OK);
+            };
+            RETURN_ON_NEQ(PackWeightShared(conv_res->filter_handle, "conv_winograd",
+                                           {input_channel, output_channel, CH_PACK}, pack_weight, buffer_weight_),
+                          TNN_OK);
         } else {
             LOGE("Error: DataType %d not support\n", conv_res->filter_handle.GetDataType());
             return Status(TNNERR_MODEL_ERR, "conv_res DataType is not supported");
@@ -28,6 +28,10 @@ public:
     static bool isPrefered(ConvLayerParam *param, const std::vector<Blob *> &inputs,
                            const std::vector<Blob *> &outputs);
 
+    // the winograd kernel handles any channels, isPrefered skips the small ones by default
+    static bool isSupported(ConvLayerParam *param, const std::vector<Blob *> &inputs,
+                            const std::vector<Blob *> &outputs);
+
     virtual Status allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 };
 
@@ -20,6 +20,7 @@
 #include "tnn/device/x86/acc/convolution/x86_conv_layer_common.h"
 #include "tnn/device/x86/acc/convolution/x86_conv_int8_layer_common.h"
 #include "tnn/device/x86/acc/convolution/x86_conv_int8_layer_depthwise.h"
+#include "tnn/utils/dims_utils.h"
 
 namespace TNN_NS {
 
@@ -46,6 +47,81 @@ void X86ConvLayerAccFactory::CreateImpFP(const std::vector<Blob *> &inputs, cons
     }
 }
 
+/*
+all impls able to run the conv, with the gemm block sizes worth trying for the gemm based ones
+X86ConvLayerCommon is always a candidate
+*/
+std::vector<std::vector<int>> X86ConvLayerAccFactory::GetTuneCandidatesFP(const std::vector<Blob *> &inputs,
+                                                                          const std::vector<Blob *> &outputs,
+                                                                          LayerParam *param) {
+    auto conv_param = dynamic_cast<ConvLayerParam *>(param);
+    std::vector<int> imps = {X86_CONV_IMP_COMMON};
+    if (X86ConvLayerDepthwise::isPrefered(conv_param, inputs, outputs)) {
+        imps.push_back(X86_CONV_IMP_DEPTHWISE);
+    }
+    if (X86ConvLayer1x1::isPrefered(conv_param, inputs, outputs)) {
+        imps.push_back(X86_CONV_IMP_1X1);
+    }
+    if (X86ConvLayer3x3::isSupported(conv_param, inputs, outputs)) {
+        imps.push_back(X86_CONV_IMP_3X3);
+    }
+
+    auto dims_output = outputs[0]->GetBlobDesc().dims;
+    // gemm M is the output spatial size and gemm K the kernel size times the input channels of a group,
+    // a block twice as large as the whole dim gives the same packing as the smaller one
+    const int gemm_m = DimsVectorUtils::Count(dims_output, 2);
+    const int gemm_k =
+        inputs[0]->GetBlobDesc().dims[1] * conv_param->kernels[0] * conv_param->kernels[1] / conv_param->group;
+
+    std::vector<std::vector<int>> candidates;
+    for (auto imp : imps) {
+        if (imp == X86_CONV_IMP_DEPTHWISE || imp == X86_CONV_IMP_3X3) {
+            candidates.push_back({imp, 0, 0});
+            continue;
+        }
+        for (int m_c : {32, 64, 128}) {
+            if (m_c > 32 && m_c / 2 >= gemm_m) {
+                continue;
+            }
+            for (int k_c : {128, 256, 512}) {
+                if (k_c > 128 && k_c / 2 >= gemm_k) {
+                    continue;
+                }
+                candidates.push_back({imp, m_c, k_c});
+            }
+        }
+    }
+    return candidates;
+}
+
+std::shared_ptr<X86LayerAcc> X86ConvLayerAccFactory::CreateTunedImpFP(const std::vector<int> &candidate) {
+    if (candidate.size() != 3) {
+        return nullptr;
+    }
+
+    std::shared_ptr<X86ConvLayerCommon> conv_acc_impl = nullptr;
+    switch (candidate[0]) {
+        case X86_CONV_IMP_COMMON:
+            conv_acc_impl = std::make_shared<X86ConvLayerCommon>();
+            break;
+        case X86_CONV_IMP_DEPTHWISE:
+            conv_acc_impl = std::make_shared<X86ConvLayerDepthwise>();
+            break;
+        case X86_CONV_IMP_1X1:
+            conv_acc_impl = std::make_shared<X86ConvLayer1x1>();
+            break;
+        case X86_CONV_IMP_3X3:
+            conv_acc_impl = std::make_shared<X86ConvLayer3x3>();
+            break;
+        default:
+            return nullptr;
+    }
+    if (candidate[1] > 0 && candidate[2] > 0) {
+        conv_acc_impl->SetGemmBlockSize(candidate[1], candidate[2]);
+    }
+    return conv_acc_impl;
+}
+
 /*
 get different impl based on conv params
 X86ConvInt8LayerCommon always as the last solution
@@ -21,6 +21,13 @@
 
 namespace TNN_NS {
 
+typedef enum {
+    X86_CONV_IMP_COMMON    = 0,
+    X86_CONV_IMP_DEPTHWISE = 1,
+    X86_CONV_IMP_1X1       = 2,
+    X86_CONV_IMP_3X3       = 3,
+} X86ConvImpType;
+
 class X86ConvLayerAccFactory {
 public:
     static void CreateImpFP(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs, LayerParam *param,
@@ -28,6 +35,14 @@ public:
 
     static void CreateImpInt8(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs, LayerParam *param,
                             std::shared_ptr<X86LayerAcc> &conv_acc_impl);
+
+    // @brief candidates of the fp32 conv for kernel tuning, each one is {X86ConvImpType, M_c, K_c},
+    // M_c and K_c are 0 for the impls not based on the conv gemm
+    static std::vector<std::vector<int>> GetTuneCandidatesFP(const std::vector<Blob *> &inputs,
+                                                             const std::vector<Blob *> &outputs, LayerParam *param);
+
+    // @brief create the fp32 conv impl of a tuning candidate, nullptr if the candidate is invalid
+    static std::shared_ptr<X86LayerAcc> CreateTunedImpFP(const std::vector<int> &candidate);
 };
 
 }  // namespace TNN_NS
@@ -55,17 +55,23 @@ Status X86ConvLayerCommon::allocateBufferWeight(const std::vector<Blob *> &input
         const float *src = conv_res->filter_handle.force_to<float *>();
 
         if (conv_res->filter_handle.GetDataType() == DATA_TYPE_FLOAT) {
-            RawBuffer temp_buffer(weight_pack_per_group * param->group * sizeof(float));
-            float *dst = temp_buffer.force_to<float *>();
-
-            for (int g = 0; g < param->group; g++) {
-                auto src_g = src + K * M * g;
-                auto dst_g = dst + weight_pack_per_group * g;
-                conv_pack_col_b_n(M, K, src_g, K, dst_g, conv_gemm_conf_);
-            }
-
-            temp_buffer.SetDataType(DATA_TYPE_FLOAT);
-            buffer_weight_ = temp_buffer;
+            auto pack_weight = [&](RawBuffer &packed) {
+                RawBuffer temp_buffer(weight_pack_per_group * param->group * sizeof(float));
+                float *dst = temp_buffer.force_to<float *>();
+
+                for (int g = 0; g < param->group; g++) {
+                    auto src_g = src + K * M * g;
+                    auto dst_g = dst + weight_pack_per_group * g;
+                    conv_pack_col_b_n(M, K, src_g, K, dst_g, conv_gemm_conf_);
+                }
+
+                temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+                packed = temp_buffer;
+                return Status(TNN_OK);
+            };
+            RETURN_ON_NEQ(PackWeightShared(conv_res->filter_handle, "conv_gemm", {K, M, param->group, k_c, n_block},
+                                           pack_weight, buffer_weight_),
+                          TNN_OK);
         } else {
             LOGE("Error: DataType %d not support\n", conv_res->filter_handle.GetDataType());
             return Status(TNNERR_MODEL_ERR, "conv_res DataType is not supported");
@@ -94,6 +100,11 @@ Status X86ConvLayerCommon::allocateBufferBias(const std::vector<Blob *> &inputs,
     return TNN_OK;
 }
 
+void X86ConvLayerCommon::SetGemmBlockSize(int m_c, int k_c) {
+    tuned_m_c_ = m_c;
+    tuned_k_c_ = k_c;
+}
+
 Status X86ConvLayerCommon::Init(Context *context, LayerParam *param, LayerResource *resource,
                                 const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto status = X86LayerAcc::Init(context, param, resource, inputs, outputs);
@@ -101,6 +112,10 @@ Status X86ConvLayerCommon::Init(Context *context, LayerParam *param, LayerResour
         return status;
     }
     conv_gemm_conf_ = conv_gemm_config<float, float, float>();
+    if (tuned_m_c_ > 0 && tuned_k_c_ > 0) {
+        conv_gemm_conf_.M_c_ = tuned_m_c_;
+        conv_gemm_conf_.K_c_ = tuned_k_c_;
+    }
 
     RETURN_ON_NEQ(allocateBufferWeight(inputs, outputs), TNN_OK);
     RETURN_ON_NEQ(allocateBufferBias(inputs, outputs), TNN_OK);
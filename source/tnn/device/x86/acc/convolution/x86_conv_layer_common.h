@@ -44,8 +44,13 @@ public:
 
     virtual Status allocateBufferBias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
+    // set the gemm block sizes chosen by the kernel tuning, must be called before Init
+    void SetGemmBlockSize(int m_c, int k_c);
+
 protected:
     bool do_im2col_ = true;
+    int tuned_m_c_  = 0;
+    int tuned_k_c_  = 0;
     RawBuffer buffer_weight_;
     RawBuffer buffer_bias_;
     conv_gemm_config<float, float, float> conv_gemm_conf_;
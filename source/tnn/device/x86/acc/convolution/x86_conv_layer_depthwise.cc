@@ -60,16 +60,22 @@ Status X86ConvLayerDepthwise::allocateBufferWeight(const std::vector<Blob *> &in
         int data_byte_size = DataTypeUtils::GetBytesSize(conv_res->filter_handle.GetDataType());
 
         if (conv_res->filter_handle.GetDataType() == DATA_TYPE_FLOAT) {
-            RawBuffer temp_buffer(weight_count * data_byte_size);
-            float *dst = temp_buffer.force_to<float *>();
-
-            if (arch_ == avx2) {
-                PackC8(dst, src, kh * kw, kh * kw, kh * kw, group);
-            } else if (arch_ == sse42) {
-                PackC4(dst, src, kh * kw, kh * kw, kh * kw, group);
-            }
-            temp_buffer.SetDataType(DATA_TYPE_FLOAT);
-            buffer_weight_ = temp_buffer;
+            auto pack_weight = [&](RawBuffer &packed) {
+                RawBuffer temp_buffer(weight_count * data_byte_size);
+                float *dst = temp_buffer.force_to<float *>();
+
+                if (arch_ == avx2) {
+                    PackC8(dst, src, kh * kw, kh * kw, kh * kw, group);
+                } else if (arch_ == sse42) {
+                    PackC4(dst, src, kh * kw, kh * kw, kh * kw, group);
+                }
+                temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+                packed = temp_buffer;
+                return Status(TNN_OK);
+            };
+            RETURN_ON_NEQ(PackWeightShared(conv_res->filter_handle, "conv_depthwise", {kh, kw, group, (int)arch_},
+                                           pack_weight, buffer_weight_),
+                          TNN_OK);
         } else {
             LOGE("Error: DataType %d not support\n", conv_res->filter_handle.GetDataType());
             return Status(TNNERR_MODEL_ERR, "conv_res DataType is not supported");
@@ -150,6 +156,14 @@ Status X86ConvLayerDepthwise::DoForward(const std::vector<Blob *> &inputs, const
         }
     }
 
+    // other activations are applied on the packed output of each channel block before unpacking
+    bool post_act = param->activation_type != ActivationType_None && param->activation_type != ActivationType_ReLU &&
+                    param->activation_type != ActivationType_ReLU6;
+    auto PostActivation = X86ActivationPost<Float8, 8>;
+    if (arch_ == sse42) {
+        PostActivation = X86ActivationPost<Float4, 4>;
+    }
+
     auto PackWithPadAcc = PackWithPad<8>;
     if (arch_ == sse42) {
         PackWithPadAcc = PackWithPad<4>;
@@ -183,6 +197,9 @@ Status X86ConvLayerDepthwise::DoForward(const std::vector<Blob *> &inputs, const
             dw_full(dst_buf, src_buf, weight_dz, bias_z, dims_output[3], param->strides[0] * c_pack,
                     param->kernels[0], param->kernels[1], dilate_x_step, dilate_y_step,
                     dims_output[2], src_pad_w * c_pack * param->strides[1], dims_output[3] * c_pack);
+            if (post_act) {
+                PostActivation(dst_buf, dst_z_step * c_pack, 1, dst_z_step * c_pack, param->activation_type);
+            }
             UnpackAcc(dst_z, dst_buf, dst_z_step, dst_z_step, dst_z_step, real_dz);
         }
     }
@@ -126,6 +126,14 @@ Status X86DeconvLayerCommon::Init(Context *context, LayerParam *param, LayerReso
             post_func_ = (arch_ == avx2) ? X86_Post_Exec<ActivationType_ReLU6, Float8, 8>
                                          : X86_Post_Exec<ActivationType_ReLU6, Float4, 4>;
             break;
+        case ActivationType_SIGMOID_MUL:
+            post_func_ = (arch_ == avx2) ? X86_Post_Exec<ActivationType_SIGMOID_MUL, Float8, 8>
+                                         : X86_Post_Exec<ActivationType_SIGMOID_MUL, Float4, 4>;
+            break;
+        case ActivationType_GELU:
+            post_func_ = (arch_ == avx2) ? X86_Post_Exec<ActivationType_GELU, Float8, 8>
+                                         : X86_Post_Exec<ActivationType_GELU, Float4, 4>;
+            break;
         default:
             break;
     }
@@ -20,12 +20,15 @@
 
 namespace TNN_NS {
 
+X86AddLayerAcc::X86AddLayerAcc() {
+    op_type_ = X86BinaryOpType::kADD;
+}
+
 X86AddLayerAcc::~X86AddLayerAcc() {}
 
 Status X86AddLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
                             const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     RETURN_ON_NEQ(X86BinaryOpLayerAcc::Init(context, param, resource, inputs, outputs), TNN_OK);
-    op_type_ = X86BinaryOpType::kADD;
     return allocateBufferParam(inputs, outputs);
 }
 
@@ -22,6 +22,7 @@ namespace TNN_NS {
 // @brief conv layer cpu acc
 class X86AddLayerAcc : public X86BinaryOpLayerAcc {
 public:
+    X86AddLayerAcc();
     virtual ~X86AddLayerAcc();
 
     Status Init(Context *context, LayerParam *param, LayerResource *resource, const std::vector<Blob *> &inputs,
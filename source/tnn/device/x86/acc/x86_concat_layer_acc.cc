@@ -16,6 +16,7 @@
 #include "tnn/device/x86/x86_device.h"
 #include "tnn/utils/dims_utils.h"
 #include "tnn/utils/data_type_utils.h"
+#include "tnn/device/x86/acc/compute/x86_compute_copy.h"
 #include "tnn/device/x86/acc/compute/x86_compute_int8.h"
 
 namespace TNN_NS {
@@ -55,30 +56,17 @@ Status X86ConcatLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std
         return Status(TNNERR_PARAM_ERR, "Concat layer param invalid");
     }
 
-    int num_concats = 1;
-    for (int i = 0; i < axis; i++) {
-        num_concats *= dims[i];
-    }
-
-    int concate_size = 1;
-    for (int i = axis + 1; i < dims.size(); i++) {
-        concate_size *= dims[i];
-    }
-
+    // each input is a strided copy into its slice of the output
     auto datasize                 = DataTypeUtils::GetBytesSize(input->GetBlobDesc().data_type);
+    auto output_dims              = output->GetBlobDesc().dims;
+    auto output_strides           = X86DenseStrides(output_dims);
     int8_t *output_data           = static_cast<int8_t *>(output->GetHandle().base);
-    int output_concat_axis        = output->GetBlobDesc().dims[axis];
     int output_concat_axis_offset = 0;
     for (size_t i = 0; i < inputs.size(); ++i) {
-        // use int8_t for all types
-        int8_t *input_data          = static_cast<int8_t *>(inputs[i]->GetHandle().base);
-        const int input_concat_axis = inputs[i]->GetBlobDesc().dims[axis];
-        for (int n = 0; n < num_concats; ++n) {
-            memcpy(output_data + (n * output_concat_axis + output_concat_axis_offset) * concate_size * datasize,
-                   input_data + n * input_concat_axis * concate_size * datasize,
-                   input_concat_axis * concate_size * datasize);
-        }
-        output_concat_axis_offset += input_concat_axis;
+        auto input_dims = inputs[i]->GetBlobDesc().dims;
+        X86StridedCopy(output_data + output_concat_axis_offset * output_strides[axis] * datasize, output_strides,
+                       inputs[i]->GetHandle().base, X86DenseStrides(input_dims), input_dims, datasize);
+        output_concat_axis_offset += input_dims[axis];
     }
     return TNN_OK;
 }
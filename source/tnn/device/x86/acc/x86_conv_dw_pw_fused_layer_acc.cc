@@ -0,0 +1,222 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/device/x86/acc/x86_conv_dw_pw_fused_layer_acc.h"
+
+#include "tnn/device/x86/acc/compute/x86_compute.h"
+#include "tnn/device/x86/x86_common.h"
+#include "tnn/device/x86/x86_util.h"
+#include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/omp_utils.h"
+
+#if defined(__ANDROID__) || defined(__linux__)
+#include "tnn/utils/cpu_info.h"
+#endif
+
+namespace TNN_NS {
+
+// bytes of the depthwise output of one tile, all channels, used when the os does not report the L2 cache size
+static const int kDefaultDwPwTileBytes = 128 * 1024;
+
+// half of the L2 cache, the other half holds the input rows and the pointwise weights of the tile
+static int GetDwPwTileBytes() {
+    uint32_t cache_size = 0;
+#if defined(__ANDROID__) || defined(__linux__)
+    cache_size = cpuinfo_linux_get_cache_size(2);
+#endif
+    return cache_size > 0 ? (int)(cache_size / 2) : kDefaultDwPwTileBytes;
+}
+
+X86ConvDwPwFusedLayerAcc::~X86ConvDwPwFusedLayerAcc() {}
+
+Status X86ConvDwPwFusedLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
+                                      const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    RETURN_ON_NEQ(X86LayerAcc::Init(context, param, resource, inputs, outputs), TNN_OK);
+    if (outputs[0]->GetBlobDesc().data_type != DATA_TYPE_FLOAT) {
+        return Status(TNNERR_DEVICE_ACC_DATA_FORMAT_NOT_SUPPORT, "Error: x86 device not support this data type");
+    }
+    conv_gemm_conf_ = conv_gemm_config<float, float, float>();
+    return allocateBufferWeight(inputs, outputs);
+}
+
+static RawBuffer FloatHandle(RawBuffer &buf) {
+    return buf.GetDataType() == DATA_TYPE_HALF ? ConvertHalfHandle(buf) : buf;
+}
+
+Status X86ConvDwPwFusedLayerAcc::allocateBufferWeight(const std::vector<Blob *> &inputs,
+                                                      const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<ConvDwPwFusedLayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+    auto res = dynamic_cast<ConvDwPwFusedLayerResource *>(resource_);
+    CHECK_PARAM_NULL(res);
+
+    const int channel = param->dw_param.output_channel;
+    const int oc      = param->pw_param.output_channel;
+    const int c_pack  = arch_ == avx2 ? 8 : 4;
+
+    // depthwise weights packed as [channel / c_pack][9][c_pack], see X86ConvLayerDepthwise
+    RawBuffer dw_filter = FloatHandle(res->dw_resource.filter_handle);
+    buffer_dw_weight_   = RawBuffer(ROUND_UP(channel, c_pack) * 9 * sizeof(float));
+    if (arch_ == avx2) {
+        PackC8(buffer_dw_weight_.force_to<float *>(), dw_filter.force_to<float *>(), 9, 9, 9, channel);
+    } else {
+        PackC4(buffer_dw_weight_.force_to<float *>(), dw_filter.force_to<float *>(), 9, 9, 9, channel);
+    }
+    buffer_dw_bias_ = RawBuffer(ROUND_UP(channel, 8) * sizeof(float));
+    if (param->dw_param.bias) {
+        RawBuffer dw_bias = FloatHandle(res->dw_resource.bias_handle);
+        memcpy(buffer_dw_bias_.force_to<float *>(), dw_bias.force_to<float *>(), channel * sizeof(float));
+    }
+
+    // pointwise weights packed for the gemm, see X86ConvLayerCommon
+    int k_c            = conv_gemm_conf_.K_c_;
+    int n_block        = conv_gemm_conf_.n_block_;
+    RawBuffer pw_filter = FloatHandle(res->pw_resource.filter_handle);
+    buffer_pw_weight_  = RawBuffer(ROUND_UP(channel, k_c) * ROUND_UP(oc, n_block) * sizeof(float));
+    conv_pack_col_b_n(oc, channel, pw_filter.force_to<float *>(), channel, buffer_pw_weight_.force_to<float *>(),
+                      conv_gemm_conf_);
+    buffer_pw_bias_ = RawBuffer(ROUND_UP(oc, 8) * sizeof(float));
+    if (param->pw_param.bias) {
+        RawBuffer pw_bias = FloatHandle(res->pw_resource.bias_handle);
+        memcpy(buffer_pw_bias_.force_to<float *>(), pw_bias.force_to<float *>(), oc * sizeof(float));
+    }
+    return TNN_OK;
+}
+
+int X86ConvDwPwFusedLayerAcc::GetTileRows(const DimsVector &dims_input, const DimsVector &dims_output) {
+    const int channel = dims_input[1];
+    const int oh      = dims_output[2];
+    const int ow      = dims_output[3];
+    static const int tile_bytes = GetDwPwTileBytes();
+    int rows = MAX(1, tile_bytes / (int)(channel * ow * sizeof(float)));
+    // keep enough tiles for all threads
+    int max_num_threads = OMP_MAX_THREADS_NUM_;
+    rows = MIN(rows, MAX(1, dims_output[0] * oh / max_num_threads));
+    return MIN(rows, oh);
+}
+
+// rows [iy_begin, iy_begin + rows) of channels [0, channels) with pads, packed as [rows][pad_w][c_pack]
+template <int c_pack>
+static void PackRowsWithPad(float *dst, const float *src, int iy_begin, int rows, int ih, int iw, int pad_left,
+                            int pad_right, int channels) {
+    auto PackAcc = c_pack == 8 ? PackC8 : PackC4;
+    int pad_w_stride = (iw + pad_left + pad_right) * c_pack;
+    for (int i = 0; i < rows; i++) {
+        int iy     = iy_begin + i;
+        auto dst_h = dst + i * pad_w_stride;
+        if (iy < 0 || iy >= ih) {
+            memset(dst_h, 0, pad_w_stride * sizeof(float));
+            continue;
+        }
+        memset(dst_h, 0, pad_left * c_pack * sizeof(float));
+        PackAcc(dst_h + pad_left * c_pack, src + iy * iw, iw, ih * iw, iw, channels);
+        memset(dst_h + (pad_left + iw) * c_pack, 0, pad_right * c_pack * sizeof(float));
+    }
+}
+
+Status X86ConvDwPwFusedLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param     = dynamic_cast<ConvDwPwFusedLayerParam *>(param_);
+    auto &dw_param = param->dw_param;
+    auto &pw_param = param->pw_param;
+
+    auto dims_input  = inputs[0]->GetBlobDesc().dims;
+    auto dims_output = outputs[0]->GetBlobDesc().dims;
+    const int batch   = dims_output[0];
+    const int channel = dims_input[1];
+    const int oc      = dims_output[1];
+    const int ih = dims_input[2], iw = dims_input[3];
+    const int oh = dims_output[2], ow = dims_output[3];
+    const int stride_w = dw_param.strides[0], stride_h = dw_param.strides[1];
+    const int c_pack   = arch_ == avx2 ? 8 : 4;
+
+    auto dw_func = DepthwiseConv<ActivationType_None, Float8, 8>;
+    if (dw_param.activation_type == ActivationType_ReLU) {
+        dw_func = DepthwiseConv<ActivationType_ReLU, Float8, 8>;
+    } else if (dw_param.activation_type == ActivationType_ReLU6) {
+        dw_func = DepthwiseConv<ActivationType_ReLU6, Float8, 8>;
+    }
+    auto PackRowsAcc    = PackRowsWithPad<8>;
+    auto UnpackAcc      = UnpackC8;
+    auto PostActivation = X86ActivationPost<Float8, 8>;
+    if (arch_ == sse42) {
+        dw_func = DepthwiseConv<ActivationType_None, Float4, 4>;
+        if (dw_param.activation_type == ActivationType_ReLU) {
+            dw_func = DepthwiseConv<ActivationType_ReLU, Float4, 4>;
+        } else if (dw_param.activation_type == ActivationType_ReLU6) {
+            dw_func = DepthwiseConv<ActivationType_ReLU6, Float4, 4>;
+        }
+        PackRowsAcc    = PackRowsWithPad<4>;
+        UnpackAcc      = UnpackC4;
+        PostActivation = X86ActivationPost<Float4, 4>;
+    }
+    bool dw_post_act = dw_param.activation_type != ActivationType_None &&
+                       dw_param.activation_type != ActivationType_ReLU &&
+                       dw_param.activation_type != ActivationType_ReLU6;
+
+    const int tile_rows   = GetTileRows(dims_input, dims_output);
+    const int tiles       = UP_DIV(oh, tile_rows);
+    const int src_pad_w   = iw + dw_param.pads[0] + dw_param.pads[1];
+    const int src_rows    = (tile_rows - 1) * stride_h + 3;
+    size_t src_pad_size   = ROUND_UP(src_pad_w * src_rows * c_pack * sizeof(float), 32);
+    size_t dw_dst_size    = ROUND_UP(tile_rows * ow * c_pack * sizeof(float), 32);
+    size_t tile_size      = ROUND_UP(channel * tile_rows * ow * sizeof(float), 32);
+    size_t trans_size     = ROUND_UP(conv_gemm_conf_.M_c_ * conv_gemm_conf_.K_c_ * sizeof(float), 32);
+    size_t thread_size    = src_pad_size + dw_dst_size + tile_size + trans_size;
+    int max_num_threads   = OMP_MAX_THREADS_NUM_;
+    auto workspace = reinterpret_cast<char *>(context_->GetSharedWorkSpace(thread_size * max_num_threads));
+
+    const float *src_origin = reinterpret_cast<const float *>(inputs[0]->GetHandle().base);
+    float *dst_origin       = reinterpret_cast<float *>(outputs[0]->GetHandle().base);
+    float *dw_weight        = buffer_dw_weight_.force_to<float *>();
+    float *dw_bias          = buffer_dw_bias_.force_to<float *>();
+    float *pw_weight        = buffer_pw_weight_.force_to<float *>();
+    float *pw_bias          = buffer_pw_bias_.force_to<float *>();
+
+    OMP_PARALLEL_FOR_GUIDED_
+    for (int t = 0; t < batch * tiles; t++) {
+        int b        = t / tiles;
+        int oy_begin = (t % tiles) * tile_rows;
+        int rows     = MIN(tile_rows, oh - oy_begin);
+        int pixels   = rows * ow;
+        auto buf     = workspace + OMP_TID_ * thread_size;
+        auto src_buf = reinterpret_cast<float *>(buf);
+        auto dw_buf  = reinterpret_cast<float *>(buf + src_pad_size);
+        auto tile    = reinterpret_cast<float *>(buf + src_pad_size + dw_dst_size);
+        auto trans   = reinterpret_cast<float *>(buf + src_pad_size + dw_dst_size + tile_size);
+
+        auto src_b = src_origin + b * channel * ih * iw;
+        for (int dz = 0; dz < channel; dz += c_pack) {
+            int real_dz = MIN(c_pack, channel - dz);
+            PackRowsAcc(src_buf, src_b + dz * ih * iw, oy_begin * stride_h - dw_param.pads[2],
+                        (rows - 1) * stride_h + 3, ih, iw, dw_param.pads[0], dw_param.pads[1], real_dz);
+            dw_func(dw_buf, src_buf, dw_weight + dz * 9, dw_bias + dz, ow, stride_w * c_pack, 3, 3, c_pack,
+                    src_pad_w * c_pack, rows, src_pad_w * c_pack * stride_h, ow * c_pack);
+            if (dw_post_act) {
+                PostActivation(dw_buf, pixels * c_pack, 1, pixels * c_pack, dw_param.activation_type);
+            }
+            UnpackAcc(tile + dz * pixels, dw_buf, pixels, pixels, pixels, real_dz);
+        }
+
+        // the gemm runs in a nested parallel region of one thread, so it uses trans of this thread only
+        conv_sgemm_nn_col_major_prepack_b(pixels, oc, channel, tile, pixels, pw_weight, channel,
+                                          dst_origin + b * oc * oh * ow + oy_begin * ow, oh * ow, pw_bias,
+                                          pw_param.activation_type, trans, conv_gemm_conf_);
+    }
+    return TNN_OK;
+}
+
+REGISTER_X86_ACC(ConvDwPwFused, LAYER_CONV_DW_PW_FUSED);
+
+}  // namespace TNN_NS
@@ -0,0 +1,48 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef TNN_SOURCE_TNN_DEVICE_X86_X86_CONV_DW_PW_FUSED_LAYER_ACC_H_
+#define TNN_SOURCE_TNN_DEVICE_X86_X86_CONV_DW_PW_FUSED_LAYER_ACC_H_
+
+#include "tnn/device/x86/acc/x86_layer_acc.h"
+#include "tnn/device/x86/acc/compute/jit/conv_sgemm_driver.h"
+
+namespace TNN_NS {
+
+// @brief depthwise 3x3 conv followed by pointwise 1x1 conv. the depthwise output of a few rows is kept in a
+// buffer of each thread small enough to stay in L2, and consumed by the pointwise gemm right away.
+class X86ConvDwPwFusedLayerAcc : public X86LayerAcc {
+public:
+    virtual ~X86ConvDwPwFusedLayerAcc();
+
+    Status Init(Context *context, LayerParam *param, LayerResource *resource, const std::vector<Blob *> &inputs,
+                const std::vector<Blob *> &outputs) override;
+    virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+
+protected:
+    Status allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+    // @brief output rows of one tile
+    int GetTileRows(const DimsVector &dims_input, const DimsVector &dims_output);
+
+    RawBuffer buffer_dw_weight_;
+    RawBuffer buffer_dw_bias_;
+    RawBuffer buffer_pw_weight_;
+    RawBuffer buffer_pw_bias_;
+    conv_gemm_config<float, float, float> conv_gemm_conf_;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_DEVICE_X86_X86_CONV_DW_PW_FUSED_LAYER_ACC_H_
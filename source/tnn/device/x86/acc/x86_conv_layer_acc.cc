@@ -13,9 +13,16 @@
 // specific language governing permissions and limitations under the License.
 
 #include "x86_conv_layer_acc.h"
+
+#include <cfloat>
+#include <chrono>
+
 #include "tnn/device/x86/acc/compute/x86_compute.h"
 #include "tnn/device/x86/acc/convolution/x86_conv_layer_acc_factory.h"
+#include "tnn/device/x86/x86_context.h"
 #include "tnn/interpreter/layer_resource_generator.h"
+#include "tnn/utils/dims_utils.h"
+#include "tnn/utils/omp_utils.h"
 
 namespace TNN_NS {
 
@@ -41,16 +48,20 @@ Status X86ConvLayerAcc::Init(Context *context, LayerParam *param, LayerResource
     }
 
     auto data_type = inputs[0]->GetBlobDesc().data_type;
-    if (data_type == DATA_TYPE_INT8) {
-        X86ConvLayerAccFactory::CreateImpInt8(inputs, outputs, param_, conv_acc_impl_);
+    if (data_type != DATA_TYPE_INT8 && context_->GetEnableTuneKernel()) {
+        ret = TuneImpFP(inputs, outputs);
     } else {
-        X86ConvLayerAccFactory::CreateImpFP(inputs, outputs, param_, conv_acc_impl_);
-    }
+        if (data_type == DATA_TYPE_INT8) {
+            X86ConvLayerAccFactory::CreateImpInt8(inputs, outputs, param_, conv_acc_impl_);
+        } else {
+            X86ConvLayerAccFactory::CreateImpFP(inputs, outputs, param_, conv_acc_impl_);
+        }
 
-    if (!conv_acc_impl_) {
-        return Status(TNNERR_NET_ERR, "Could not create conv impl_");
+        if (!conv_acc_impl_) {
+            return Status(TNNERR_NET_ERR, "Could not create conv impl_");
+        }
+        ret = conv_acc_impl_->Init(context_, param_, resource_, inputs, outputs);
     }
-    ret = conv_acc_impl_->Init(context_, param_, resource_, inputs, outputs);
 
     // converted weights are assumed to be packed, and can be freed now
     if (conv_acc_f32_resource_) {
@@ -61,6 +72,80 @@ Status X86ConvLayerAcc::Init(Context *context, LayerParam *param, LayerResource
     return ret;
 }
 
+Status X86ConvLayerAcc::TuneImpFP(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto x86_context = dynamic_cast<X86Context *>(context_);
+    CHECK_PARAM_NULL(x86_context);
+    auto conv_param = dynamic_cast<ConvLayerParam *>(param_);
+    CHECK_PARAM_NULL(conv_param);
+
+    std::vector<int> key_values = inputs[0]->GetBlobDesc().dims;
+    for (auto values : {outputs[0]->GetBlobDesc().dims, conv_param->kernels, conv_param->strides,
+                        conv_param->dialations, conv_param->pads}) {
+        key_values.insert(key_values.end(), values.begin(), values.end());
+    }
+    key_values.push_back(conv_param->group);
+    key_values.push_back(x86_context->GetNumThreads());
+    std::string key = "conv";
+    for (auto value : key_values) {
+        key += "_" + std::to_string(value);
+    }
+
+    std::vector<int> best_candidate;
+    if (x86_context->GetTuneResult(key, best_candidate)) {
+        conv_acc_impl_ = X86ConvLayerAccFactory::CreateTunedImpFP(best_candidate);
+        if (!conv_acc_impl_) {
+            LOGE("X86ConvLayerAcc invalid tune result of %s, use the default impl\n", key.c_str());
+            X86ConvLayerAccFactory::CreateImpFP(inputs, outputs, param_, conv_acc_impl_);
+        }
+        return conv_acc_impl_->Init(context_, param_, resource_, inputs, outputs);
+    }
+
+    // blob memory is not allocated in init, the candidates run on scratch blobs of the same shapes
+    Blob tune_input(inputs[0]->GetBlobDesc(), true);
+    Blob tune_output(outputs[0]->GetBlobDesc(), true);
+    std::vector<Blob *> tune_inputs  = {&tune_input};
+    std::vector<Blob *> tune_outputs = {&tune_output};
+    memset(tune_input.GetHandle().base, 0, DimsVectorUtils::Count(tune_input.GetBlobDesc().dims) * sizeof(float));
+    OMP_SET_THREADS_(x86_context->GetNumThreads());
+
+    const int warmup_count = 1;
+    const int run_count    = 3;
+    double best_time       = DBL_MAX;
+    for (const auto &candidate : X86ConvLayerAccFactory::GetTuneCandidatesFP(inputs, outputs, param_)) {
+        auto conv_acc_impl = X86ConvLayerAccFactory::CreateTunedImpFP(candidate);
+        if (!conv_acc_impl || conv_acc_impl->Init(context_, param_, resource_, inputs, outputs) != TNN_OK ||
+            conv_acc_impl->Reshape(tune_inputs, tune_outputs) != TNN_OK) {
+            continue;
+        }
+
+        double time = DBL_MAX;
+        for (int i = 0; i < warmup_count + run_count; i++) {
+            auto start = std::chrono::steady_clock::now();
+            if (conv_acc_impl->DoForward(tune_inputs, tune_outputs) != TNN_OK) {
+                time = DBL_MAX;
+                break;
+            }
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            if (i >= warmup_count) {
+                time = std::min(time, elapsed.count());
+            }
+        }
+        if (time < best_time) {
+            best_time      = time;
+            best_candidate = candidate;
+            conv_acc_impl_ = conv_acc_impl;
+        }
+    }
+
+    if (!conv_acc_impl_) {
+        return Status(TNNERR_NET_ERR, "Could not create conv impl_");
+    }
+    LOGD("X86ConvLayerAcc %s tuned impl %d m_c %d k_c %d, %.3f ms\n", key.c_str(), best_candidate[0],
+         best_candidate[1], best_candidate[2], best_time * 1000);
+    x86_context->SetTuneResult(key, best_candidate);
+    return TNN_OK;
+}
+
 Status X86ConvLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     if (conv_acc_impl_) {
         return conv_acc_impl_->DoForward(inputs, outputs);
@@ -33,6 +33,10 @@ public:
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
 
 protected:
+    // @brief pick the fastest fp32 impl and gemm block sizes for the layer shape, the result is
+    // cached in the x86 context by cpu model and shape
+    Status TuneImpFP(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
     std::shared_ptr<X86LayerAcc> conv_acc_impl_ = nullptr;
     std::shared_ptr<LayerResource> conv_acc_f32_resource_ = nullptr;
 };
@@ -12,6 +12,7 @@
 // CONDITIONS OF ANY KIND, either express or implied. See the License for the
 // specific language governing permissions and limitations under the License.
 
+#include "tnn/device/x86/acc/compute/x86_compute_copy.h"
 #include "tnn/device/x86/acc/x86_layer_acc.h"
 #include "tnn/utils/data_type_utils.h"
 #include "tnn/utils/dims_utils.h"
@@ -60,23 +61,16 @@ Status X86GatherLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std
     const int ele_size = DataTypeUtils::GetBytesSize(outputs[0]->GetBlobDesc().data_type);
     auto output_data_ptr = (char*)outputs[0]->GetHandle().base;
     
-    for (int b=0; b<batch; b++) {
-        int input_index_b = b*input_slice_count*slice_size;
-        int output_index_b = b*output_slice_count*slice_size;
-        for (int i=0; i<output_slice_count; i++) {
-            int slice_index = indices_data_ptr[i];
-            if (slice_index < 0 || slice_index >= input_slice_count) {
-                LOGE("X86GatherLayerAcc::Forward invalid slice_index\n");
-                return Status(TNNERR_MODEL_ERR, "X86GatherLayerAcc::Forward invalid slice_index");
-            }
-            int input_index = input_index_b + slice_index*slice_size;
-            int output_index = output_index_b + i*slice_size;
-            
-            memcpy(output_data_ptr + output_index*ele_size,
-                   input_data_ptr + input_index*ele_size,
-                   slice_size * ele_size);
+    for (int i = 0; i < output_slice_count; i++) {
+        int slice_index = indices_data_ptr[i];
+        if (slice_index < 0 || slice_index >= input_slice_count) {
+            LOGE("X86GatherLayerAcc::Forward invalid slice_index\n");
+            return Status(TNNERR_MODEL_ERR, "X86GatherLayerAcc::Forward invalid slice_index");
         }
     }
+
+    X86GatherRows(output_data_ptr, input_data_ptr, batch, input_slice_count, indices_data_ptr, output_slice_count,
+                  (long)slice_size * ele_size);
     return TNN_OK;
 }
 
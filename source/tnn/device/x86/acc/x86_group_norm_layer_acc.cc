@@ -0,0 +1,88 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/device/x86/acc/compute/x86_compute_norm.h"
+#include "tnn/device/x86/acc/x86_layer_acc.h"
+#include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+DECLARE_X86_ACC(GroupNorm, LAYER_GROUP_NORM);
+
+Status X86GroupNormLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto layer_param = dynamic_cast<GroupNormLayerParam *>(param_);
+    auto input_blob  = inputs[0];
+    auto scale_blob  = inputs[1];
+    auto bias_blob   = inputs[2];
+    auto output_blob = outputs[0];
+    auto dims_input  = input_blob->GetBlobDesc().dims;
+    auto dims_output = output_blob->GetBlobDesc().dims;
+
+    const int group    = layer_param->group;
+    const int batch    = dims_output[0];
+    const int channels = dims_output[1];
+    const int area     = DimsVectorUtils::Count(dims_output, 2);
+    if (0 == area || group <= 0 || channels % group != 0) {
+        LOGE("Error: invalid group or blob count is zero\n");
+        return Status(TNNERR_COMMON_ERROR, "Error: invalid group or blob count is zero");
+    }
+
+    float *k_data = (float *)((char *)scale_blob->GetHandle().base + scale_blob->GetHandle().bytes_offset);
+    float *b_data = (float *)((char *)bias_blob->GetHandle().base + bias_blob->GetHandle().bytes_offset);
+
+    auto func = X86GroupNorm<Float8, 8>;
+    if (arch_ == sse42) {
+        func = X86GroupNorm<Float4, 4>;
+    }
+
+    if (output_blob->GetBlobDesc().data_type == DATA_TYPE_FLOAT) {
+        float *input_data  = (float *)((char *)input_blob->GetHandle().base + input_blob->GetHandle().bytes_offset);
+        float *output_data = (float *)((char *)output_blob->GetHandle().base + output_blob->GetHandle().bytes_offset);
+
+        // same residual handling as X86LayerNormLayerAcc
+        float *residual_data = nullptr;
+        float *sum_data      = nullptr;
+        if (outputs.size() > 1) {
+            sum_data = (float *)((char *)outputs[1]->GetHandle().base + outputs[1]->GetHandle().bytes_offset);
+        }
+        if (inputs.size() > 3) {
+            auto residual_blob = inputs[3];
+            auto dims_residual = residual_blob->GetBlobDesc().dims;
+            residual_data =
+                (float *)((char *)residual_blob->GetHandle().base + residual_blob->GetHandle().bytes_offset);
+            if (!DimsVectorUtils::Equal(dims_input, dims_output) ||
+                !DimsVectorUtils::Equal(dims_residual, dims_output)) {
+                if (!sum_data) {
+                    sum_data = reinterpret_cast<float *>(
+                        context_->GetSharedWorkSpace(DimsVectorUtils::Count(dims_output) * sizeof(float)));
+                }
+                X86NormBroadcastAdd(input_data, dims_input, residual_data, dims_residual, sum_data, dims_output);
+                input_data    = sum_data;
+                residual_data = nullptr;
+            }
+        }
+
+        func(input_data, residual_data, sum_data, output_data, batch, channels, group, area, k_data, b_data,
+             layer_param->eps, layer_param->activation_type);
+    } else {
+        LOGE("Error: layer acc dont support datatype: %d\n", output_blob->GetBlobDesc().data_type);
+        return Status(TNNERR_MODEL_ERR, "Error: layer acc dont support datatype");
+    }
+
+    return TNN_OK;
+}
+
+REGISTER_X86_ACC(GroupNorm, LAYER_GROUP_NORM);
+}  // namespace TNN_NS
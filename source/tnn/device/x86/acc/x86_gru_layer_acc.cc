@@ -0,0 +1,347 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/device/x86/acc/x86_gru_layer_acc.h"
+
+#include <cmath>
+
+#include "tnn/device/x86/acc/Float4.h"
+#include "tnn/device/x86/acc/Float8.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+static inline float GRUSigmoid(float x) {
+    return 1.f / (1.f + std::exp(-x));
+}
+
+// gates_zr: [batch, 2 * hidden_size] sums of the update and reset gates, activated in place.
+// rh = r * h_t for the hidden gate if linear_before_reset is 0
+template <typename VEC, int pack>
+static void X86GRUResetGate(float *gates_zr, const float *h_t, float *rh, int batch, int hidden_size) {
+    OMP_PARALLEL_FOR_GUIDED_
+    for (int n = 0; n < batch; n++) {
+        float *z_n       = gates_zr + n * 2 * hidden_size;
+        float *r_n       = z_n + hidden_size;
+        const float *h_n = h_t + n * hidden_size;
+        float *rh_n      = rh ? rh + n * hidden_size : nullptr;
+        int j            = 0;
+        for (; j + pack <= hidden_size; j += pack) {
+            VEC::saveu(z_n + j, VEC::sigmoid(VEC::loadu(z_n + j)));
+            VEC r = VEC::sigmoid(VEC::loadu(r_n + j));
+            VEC::saveu(r_n + j, r);
+            if (rh_n) {
+                VEC::saveu(rh_n + j, r * VEC::loadu(h_n + j));
+            }
+        }
+        for (; j < hidden_size; j++) {
+            z_n[j] = GRUSigmoid(z_n[j]);
+            r_n[j] = GRUSigmoid(r_n[j]);
+            if (rh_n) {
+                rh_n[j] = r_n[j] * h_n[j];
+            }
+        }
+    }
+}
+
+// n = tanh(x_h + r * (R_h * h + Rb_h)) if linear_before_reset, else n = tanh(gates_h),
+// gates_h already holds x_h + R_h * (r * h) + Rb_h. h = n + z * (h - n)
+template <typename VEC, int pack>
+static void X86GRUUpdate(const float *gates_zr, const float *gates_x, const float *gates_h, float *h_t, float *y,
+                         int batch, int hidden_size, int linear_before_reset) {
+    OMP_PARALLEL_FOR_GUIDED_
+    for (int n = 0; n < batch; n++) {
+        const float *z_n  = gates_zr + n * 2 * hidden_size;
+        const float *r_n  = z_n + hidden_size;
+        const float *xh_n = gates_x + n * 3 * hidden_size + 2 * hidden_size;
+        const float *gh_n = gates_h + n * hidden_size;
+        float *h_n        = h_t + n * hidden_size;
+        float *y_n        = y + n * hidden_size;
+        int j             = 0;
+        for (; j + pack <= hidden_size; j += pack) {
+            VEC cand = VEC::loadu(gh_n + j);
+            if (linear_before_reset) {
+                cand = VEC::loadu(xh_n + j) + VEC::loadu(r_n + j) * cand;
+            }
+            cand  = VEC::tanh(cand);
+            VEC h = cand + VEC::loadu(z_n + j) * (VEC::loadu(h_n + j) - cand);
+            VEC::saveu(h_n + j, h);
+            VEC::saveu(y_n + j, h);
+        }
+        for (; j < hidden_size; j++) {
+            float cand = linear_before_reset ? std::tanh(xh_n[j] + r_n[j] * gh_n[j]) : std::tanh(gh_n[j]);
+            float h    = cand + z_n[j] * (h_n[j] - cand);
+            h_n[j]     = h;
+            y_n[j]     = h;
+        }
+    }
+}
+
+// dst[N * M] += weight[M * K] * src[N * K], weight packed by conv_pack_col_a_t
+static void X86GRUGemmAcc(int M, int N, int K, const float *weight, const float *src, float *dst, float *gemm_buf,
+                          conv_gemm_config<float, float, float> &conv_gemm_conf) {
+    conv_sgemm_tn_col_major_prepack_a(M, N, K, weight, K, src, K, dst, M, nullptr, ActivationType_None, gemm_buf,
+                                      conv_gemm_conf);
+}
+
+Status X86GRUONNXLayerAcc::GRUOneDirection(const float *x, float *y, const float *w, const float *r_zr,
+                                           const float *r_h, const float *b, float *h_t, int seq_len, int batch_size,
+                                           int input_size, int hidden_size, int reverse) {
+    auto layer_param        = dynamic_cast<GRUONNXLayerParam *>(param_);
+    int linear_before_reset = layer_param->linear_before_reset;
+
+    int k_c     = conv_gemm_conf_.K_c_;
+    int n_block = conv_gemm_conf_.n_block_;
+    int N       = seq_len * batch_size;
+    int M       = 3 * hidden_size;
+
+    // gemm_buf, gates of the input for all time steps, gates of one step and r * h
+    size_t gemm_buf_size    = ROUND_UP(k_c * ROUND_UP(N, n_block) * sizeof(float), 32);
+    size_t gates_x_size     = ROUND_UP(N * M * sizeof(float), 32);
+    size_t gates_zr_size    = ROUND_UP(batch_size * 2 * hidden_size * sizeof(float), 32);
+    size_t gates_h_size     = ROUND_UP(batch_size * hidden_size * sizeof(float), 32);
+    size_t workspace_size   = gemm_buf_size + gates_x_size + gates_zr_size + 2 * gates_h_size;
+    float *workspace        = reinterpret_cast<float *>(context_->GetSharedWorkSpace(workspace_size));
+    float *gemm_buf         = workspace;
+    float *gates_x          = gemm_buf + gemm_buf_size / sizeof(float);
+    float *gates_zr         = gates_x + gates_x_size / sizeof(float);
+    float *gates_h          = gates_zr + gates_zr_size / sizeof(float);
+    float *rh               = gates_h + gates_h_size / sizeof(float);
+    const float *rb_h       = b + M;
+
+    // one gemm of W for all time steps, starting from the bias of the gates
+    for (int i = 0; i < N; i++) {
+        memcpy(gates_x + i * M, b, M * sizeof(float));
+    }
+    X86GRUGemmAcc(M, N, input_size, w, x, gates_x, gemm_buf, conv_gemm_conf_);
+
+    auto X86GRUResetGateFunc = X86GRUResetGate<Float4, 4>;
+    auto X86GRUUpdateFunc    = X86GRUUpdate<Float4, 4>;
+    if (arch_ == avx2) {
+        X86GRUResetGateFunc = X86GRUResetGate<Float8, 8>;
+        X86GRUUpdateFunc    = X86GRUUpdate<Float8, 8>;
+    }
+
+    for (int t = 0; t < seq_len; t++) {
+        int ti         = reverse ? seq_len - 1 - t : t;
+        auto gates_x_t = gates_x + ti * batch_size * M;
+        auto y_t       = y + ti * batch_size * hidden_size;
+
+        // update and reset gates
+        for (int n = 0; n < batch_size; n++) {
+            memcpy(gates_zr + n * 2 * hidden_size, gates_x_t + n * M, 2 * hidden_size * sizeof(float));
+        }
+        X86GRUGemmAcc(2 * hidden_size, batch_size, hidden_size, r_zr, h_t, gates_zr, gemm_buf, conv_gemm_conf_);
+        X86GRUResetGateFunc(gates_zr, h_t, linear_before_reset ? nullptr : rh, batch_size, hidden_size);
+
+        // recurrence of the hidden gate, on h or on r * h
+        for (int n = 0; n < batch_size; n++) {
+            float *gates_h_n = gates_h + n * hidden_size;
+            if (linear_before_reset) {
+                memcpy(gates_h_n, rb_h, hidden_size * sizeof(float));
+            } else {
+                const float *x_h_n = gates_x_t + n * M + 2 * hidden_size;
+                for (int j = 0; j < hidden_size; j++) {
+                    gates_h_n[j] = x_h_n[j] + rb_h[j];
+                }
+            }
+        }
+        X86GRUGemmAcc(hidden_size, batch_size, hidden_size, r_h, linear_before_reset ? h_t : rh, gates_h, gemm_buf,
+                      conv_gemm_conf_);
+
+        X86GRUUpdateFunc(gates_zr, gates_x_t, gates_h, h_t, y_t, batch_size, hidden_size, linear_before_reset);
+    }
+    return TNN_OK;
+}
+
+X86GRUONNXLayerAcc::~X86GRUONNXLayerAcc() {}
+
+Status X86GRUONNXLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
+                                const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto status = X86LayerAcc::Init(context, param, resource, inputs, outputs);
+    RETURN_ON_NEQ(status, TNN_OK);
+
+    auto layer_param = dynamic_cast<GRUONNXLayerParam *>(param_);
+    CHECK_PARAM_NULL(layer_param);
+    if (inputs.size() < 3) {
+        return Status(TNNERR_LAYER_ERR, "GRU has invalid inputs");
+    }
+    auto w_dims = inputs[1]->GetBlobDesc().dims;
+    auto r_dims = inputs[2]->GetBlobDesc().dims;
+    if (w_dims.size() != 3 || r_dims.size() != 3 || w_dims[1] != 3 * layer_param->hidden_size ||
+        r_dims[1] != 3 * layer_param->hidden_size || r_dims[2] != layer_param->hidden_size) {
+        return Status(TNNERR_LAYER_ERR, "GRU has invalid weights");
+    }
+
+    RETURN_ON_NEQ(allocateBufferWeight(inputs, outputs), TNN_OK);
+    RETURN_ON_NEQ(allocateBufferBias(inputs, outputs), TNN_OK);
+
+    return TNN_OK;
+}
+
+Status X86GRUONNXLayerAcc::allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    // weights for gates, [num_direction, 3 * hidden_size, input_size]
+    auto w_dims  = inputs[1]->GetBlobDesc().dims;
+    float *w_ptr = (float *)((char *)(inputs[1]->GetHandle().base) + inputs[1]->GetHandle().bytes_offset);
+    // recurrence weights, [num_direction, 3 * hidden_size, hidden_size]
+    auto r_dims  = inputs[2]->GetBlobDesc().dims;
+    float *r_ptr = (float *)((char *)(inputs[2]->GetHandle().base) + inputs[2]->GetHandle().bytes_offset);
+
+    int k_c         = conv_gemm_conf_.K_c_;
+    int m_block     = conv_gemm_conf_.m_block_;
+    int hidden_size = r_dims[2];
+    int input_size  = w_dims[2];
+
+    // align pointer of packed weights, since gemm use aligned load for input A
+    size_t w_pack_size    = ROUND_UP(input_size, k_c) * ROUND_UP(3 * hidden_size, m_block);
+    size_t r_zr_pack_size = ROUND_UP(hidden_size, k_c) * ROUND_UP(2 * hidden_size, m_block);
+    size_t r_h_pack_size  = ROUND_UP(hidden_size, k_c) * ROUND_UP(hidden_size, m_block);
+    RawBuffer w_temp_buffer(w_dims[0] * w_pack_size * sizeof(float), 32);
+    RawBuffer r_zr_temp_buffer(r_dims[0] * r_zr_pack_size * sizeof(float), 32);
+    RawBuffer r_h_temp_buffer(r_dims[0] * r_h_pack_size * sizeof(float), 32);
+
+    // gates stay in the onnx order z, r, h, so the rows are packed without transpose
+    for (int d = 0; d < w_dims[0]; d++) {
+        const float *w_src = w_ptr + d * 3 * hidden_size * input_size;
+        conv_pack_col_a_t(3 * hidden_size, input_size, w_src, input_size,
+                          w_temp_buffer.force_to<float *>() + d * w_pack_size, conv_gemm_conf_);
+
+        const float *r_src = r_ptr + d * 3 * hidden_size * hidden_size;
+        conv_pack_col_a_t(2 * hidden_size, hidden_size, r_src, hidden_size,
+                          r_zr_temp_buffer.force_to<float *>() + d * r_zr_pack_size, conv_gemm_conf_);
+        conv_pack_col_a_t(hidden_size, hidden_size, r_src + 2 * hidden_size * hidden_size, hidden_size,
+                          r_h_temp_buffer.force_to<float *>() + d * r_h_pack_size, conv_gemm_conf_);
+    }
+
+    w_temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+    r_zr_temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+    r_h_temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+    buffer_w_    = w_temp_buffer;
+    buffer_r_zr_ = r_zr_temp_buffer;
+    buffer_r_h_  = r_h_temp_buffer;
+
+    return TNN_OK;
+}
+
+Status X86GRUONNXLayerAcc::allocateBufferBias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto layer_param   = dynamic_cast<GRUONNXLayerParam *>(param_);
+    int num_directions = layer_param->direction >= 2 ? 2 : 1;
+    int hidden_size    = layer_param->hidden_size;
+    int bias_size      = 4 * hidden_size;
+    RawBuffer b_temp_buffer(num_directions * bias_size * sizeof(float));
+
+    // bias for gate and recurrence, [num_directions, 6*hidden_size], zero if not specified
+    if (inputs.size() >= 4) {
+        float *b_ptr = (float *)((char *)(inputs[3]->GetHandle().base) + inputs[3]->GetHandle().bytes_offset);
+        for (int d = 0; d < num_directions; d++) {
+            float *wb_d  = b_ptr + d * 6 * hidden_size;
+            float *rb_d  = wb_d + 3 * hidden_size;
+            float *b_dst = b_temp_buffer.force_to<float *>() + d * bias_size;
+
+            // Rb of the hidden gate is scaled by the reset gate, keep it apart
+            for (int i = 0; i < 2 * hidden_size; i++) {
+                b_dst[i] = wb_d[i] + rb_d[i];
+            }
+            for (int i = 2 * hidden_size; i < 3 * hidden_size; i++) {
+                b_dst[i]               = wb_d[i];
+                b_dst[i + hidden_size] = rb_d[i];
+            }
+        }
+    }
+    b_temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+    buffer_b_ = b_temp_buffer;
+
+    return TNN_OK;
+}
+
+Status X86GRUONNXLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto layer_param   = dynamic_cast<GRUONNXLayerParam *>(param_);
+    int num_directions = layer_param->direction >= 2 ? 2 : 1;
+
+    const auto input_dims  = inputs[0]->GetBlobDesc().dims;
+    const auto T           = input_dims[0];                             // length of sequence
+    const auto batch       = input_dims[1];                             // batch_size
+    const auto input_size  = DimsVectorUtils::Count(input_dims, 2);     // input dimension
+    const auto hidden_size = layer_param->hidden_size;                  // output dimension
+    int k_c                = conv_gemm_conf_.K_c_;
+    int m_block            = conv_gemm_conf_.m_block_;
+
+    // X shape [sequence batch_size input_size]
+    float *x = (float *)((char *)(inputs[0]->GetHandle().base) + inputs[0]->GetHandle().bytes_offset);
+    // Y shape [sequence batch_size num_directions *hidden_size]
+    float *y = (float *)((char *)(outputs[0]->GetHandle().base) + outputs[0]->GetHandle().bytes_offset);
+
+    float *w    = buffer_w_.force_to<float *>();
+    float *r_zr = buffer_r_zr_.force_to<float *>();
+    float *r_h  = buffer_r_h_.force_to<float *>();
+    float *b    = buffer_b_.force_to<float *>();
+
+    // Y_h is optional, keep the hidden state in the workspace of the acc if it is not an output
+    const int state_count = num_directions * batch * hidden_size;
+    std::shared_ptr<float> h_temp;
+    float *h_t = nullptr;
+    if (outputs.size() >= 2) {
+        h_t = (float *)((char *)(outputs[1]->GetHandle().base) + outputs[1]->GetHandle().bytes_offset);
+    } else {
+        h_temp = std::shared_ptr<float>(new float[state_count], [](float *p) { delete[] p; });
+        h_t    = h_temp.get();
+    }
+    // initial_h, initial value of the hidden, If not specified - assumed to be 0.
+    if (inputs.size() >= 5) {
+        auto h_0 = (float *)((char *)(inputs[4]->GetHandle().base) + inputs[4]->GetHandle().bytes_offset);
+        memcpy((void *)h_t, h_0, state_count * sizeof(float));
+    } else {
+        memset((void *)h_t, 0, state_count * sizeof(float));
+    }
+
+    Status status = TNN_OK;
+    if (layer_param->direction == 0 || layer_param->direction == 1) {
+        status = GRUOneDirection(x, y, w, r_zr, r_h, b, h_t, T, batch, input_size, hidden_size,
+                                 layer_param->direction);
+    } else if (layer_param->direction == 2) {
+        // Y shape [num_directions sequence batch_size hidden_size]
+        auto y_temp =
+            std::shared_ptr<float>(new float[num_directions * T * batch * hidden_size], [](float *p) { delete[] p; });
+        auto y0 = y_temp.get();
+        auto y1 = y0 + T * batch * hidden_size;
+        status  = GRUOneDirection(x, y0, w, r_zr, r_h, b, h_t, T, batch, input_size, hidden_size, 0);
+        RETURN_ON_NEQ(status, TNN_OK);
+
+        auto w1    = w + ROUND_UP(input_size, k_c) * ROUND_UP(3 * hidden_size, m_block);
+        auto r_zr1 = r_zr + ROUND_UP(hidden_size, k_c) * ROUND_UP(2 * hidden_size, m_block);
+        auto r_h1  = r_h + ROUND_UP(hidden_size, k_c) * ROUND_UP(hidden_size, m_block);
+        auto b1    = b + 4 * hidden_size;
+        auto h_t1  = h_t + batch * hidden_size;
+        status     = GRUOneDirection(x, y1, w1, r_zr1, r_h1, b1, h_t1, T, batch, input_size, hidden_size, 1);
+        RETURN_ON_NEQ(status, TNN_OK);
+
+        // transpose [num_directions sequence batch_size hidden_size] to [sequence batch_size
+        // num_directions*hidden_size]
+        for (int i = 0; i < T * batch; i++) {
+            auto y0_data = y0 + i * hidden_size;
+            auto y1_data = y1 + i * hidden_size;
+            auto y_data  = y + i * num_directions * hidden_size;
+
+            memcpy(y_data, y0_data, hidden_size * sizeof(float));
+            memcpy(y_data + hidden_size, y1_data, hidden_size * sizeof(float));
+        }
+    } else {
+        return Status(TNNERR_PARAM_ERR, "GRUONNX has invalid direction param");
+    }
+    return status;
+}
+
+REGISTER_X86_ACC(GRUONNX, LAYER_GRUONNX);
+}  // namespace TNN_NS
@@ -17,9 +17,12 @@
 #include "tnn/device/x86/x86_util.h"
 #include "tnn/utils/data_type_utils.h"
 #include "tnn/device/x86/acc/compute/x86_compute.h"
+#include "tnn/device/x86/acc/compute/x86_compute_dynamic_quant.h"
 #include "tnn/device/x86/acc/compute/x86_compute_int8.h"
+#include "tnn/device/x86/acc/compute/x86_compute_weight_quant.h"
 #include "tnn/device/x86/acc/x86_inner_product_layer_acc.h"
 #include "tnn/interpreter/layer_resource_generator.h"
+#include "tnn/utils/weight_quant_utils.h"
 
 namespace TNN_NS {
 
@@ -53,11 +56,30 @@ Status X86InnerProductLayerAcc::Init(Context *context, LayerParam *param, LayerR
         impl_ = InnerProductSgemm;
     }
 
+    auto fc_param = dynamic_cast<InnerProductLayerParam *>(param);
+    CHECK_PARAM_NULL(fc_param);
     auto res = dynamic_cast<InnerProductLayerResource *>(resource);
     CHECK_PARAM_NULL(res);
 
+    // weight-only quantized weights are dequantized on the fly by the gemm kernels
+    weight_quant_ = res->weight_handle.GetDataType() == DATA_TYPE_INT8 && !fc_param->quantized &&
+                    fc_param->weight_quant_bits > 0 && outputs[0]->GetBlobDesc().data_type == DATA_TYPE_FLOAT;
+    int ic = DimsVectorUtils::Count(input_dims, 1);
+    if (weight_quant_ && !X86WeightQuantSupported(ic, fc_param->weight_quant_bits, fc_param->weight_quant_group)) {
+        weight_quant_ = false;
+        auto fp32_res = std::make_shared<InnerProductLayerResource>(*res);
+        RETURN_ON_NEQ(DequantizeWeightOnly(res->weight_handle, res->scale_handle, output_dims[1], ic,
+                                           fc_param->weight_quant_bits, fc_param->weight_quant_group,
+                                           fp32_res->weight_handle), TNN_OK);
+        fc_acc_f32_resource_ = fp32_res;
+    }
+    dynamic_quant_ = weight_quant_ && fc_param->dynamic_quant > 0 && fc_param->weight_quant_bits == 8 &&
+                     fc_param->weight_quant_group == 0;
+
     Status ret;
-    if (res->weight_handle.GetDataType() == DATA_TYPE_HALF) {
+    if (fc_acc_f32_resource_) {
+        ret = X86LayerAcc::Init(context, param, fc_acc_f32_resource_.get(), inputs, outputs);
+    } else if (res->weight_handle.GetDataType() == DATA_TYPE_HALF) {
         LayerResource *fp32_res = nullptr;
         RETURN_ON_NEQ(ConvertHalfResource(LAYER_INNER_PRODUCT, res, &fp32_res), TNN_OK);
         fc_acc_f32_resource_ = std::shared_ptr<LayerResource>(fp32_res);
@@ -91,9 +113,64 @@ Status X86InnerProductLayerAcc::allocateBufferWeight(const std::vector<Blob *> &
     auto input_dims   = inputs[0]->GetBlobDesc().dims;
     auto output_dims  = outputs[0]->GetBlobDesc().dims;
 
-    if (!buffer_weight_.GetBytesSize()) {
-        if (res->weight_handle.GetDataType() == DATA_TYPE_FLOAT) {
-            if (impl_ == InnerProductSgemv) {
+    if (!buffer_weight_.GetBytesSize() && !use_sparse_) {
+        if (dynamic_quant_) {
+            int ic = DimsVectorUtils::Count(input_dims, 1);
+            int oc = output_dims[1];
+
+            RawBuffer w_scale = res->scale_handle;
+            if (w_scale.GetDataType() == DATA_TYPE_HALF)
+                w_scale = ConvertHalfHandle(w_scale);
+            if (w_scale.GetDataCount() < oc || res->weight_handle.GetBytesSize() < oc * ic) {
+                LOGE("Error: invalid dynamic quantized innerproduct weight\n");
+                return Status(TNNERR_MODEL_ERR, "invalid dynamic quantized innerproduct weight");
+            }
+
+            RawBuffer temp_buffer(ROUND_UP(oc, 4) * X86DynamicQuantRowBytes(ic));
+            X86DynamicQuantPackWeight(temp_buffer.force_to<int8_t *>(), res->weight_handle.force_to<int8_t *>(), oc,
+                                      ic);
+            RawBuffer temp_scale(oc * sizeof(float));
+            memcpy(temp_scale.force_to<float *>(), w_scale.force_to<float *>(), oc * sizeof(float));
+
+            temp_buffer.SetDataType(DATA_TYPE_INT8);
+            temp_scale.SetDataType(DATA_TYPE_FLOAT);
+            buffer_weight_       = temp_buffer;
+            buffer_weight_scale_ = temp_scale;
+        } else if (weight_quant_) {
+            // the same packed layout serves both sgemv and sgemm
+            int pack = arch_ == avx2 ? 8 : 4;
+            int ic   = DimsVectorUtils::Count(input_dims, 1);
+            int oc   = output_dims[1];
+            int bits = param->weight_quant_bits;
+            int group = param->weight_quant_group;
+
+            RawBuffer w_scale = res->scale_handle;
+            if (w_scale.GetDataType() == DATA_TYPE_HALF)
+                w_scale = ConvertHalfHandle(w_scale);
+            if (w_scale.GetDataCount() < oc * WeightQuantGroupCount(ic, group) ||
+                res->weight_handle.GetBytesSize() < oc * WeightQuantRowBytes(ic, bits)) {
+                LOGE("Error: invalid weight-only quantized innerproduct weight\n");
+                return Status(TNNERR_MODEL_ERR, "invalid weight-only quantized innerproduct weight");
+            }
+
+            RawBuffer temp_buffer(X86WeightQuantPackedBytes(oc, ic, bits, pack));
+            RawBuffer temp_scale(X86WeightQuantPackedScaleCount(oc, ic, group, pack) * sizeof(float));
+            X86WeightQuantPack(temp_buffer.force_to<int8_t *>(), temp_scale.force_to<float *>(),
+                               res->weight_handle.force_to<int8_t *>(), w_scale.force_to<float *>(), oc, ic, bits,
+                               group, pack);
+
+            temp_buffer.SetDataType(DATA_TYPE_INT8);
+            temp_scale.SetDataType(DATA_TYPE_FLOAT);
+            buffer_weight_       = temp_buffer;
+            buffer_weight_scale_ = temp_scale;
+        } else if (res->weight_handle.GetDataType() == DATA_TYPE_FLOAT) {
+            const float *weight = res->weight_handle.force_to<float *>();
+            int ic = DimsVectorUtils::Count(input_dims, 1);
+            if (impl_ == InnerProductSgemv &&
+                X86SparseWeightDensity(weight, output_dims[1], ic) <= kX86SparseFcMaxDensity) {
+                RETURN_ON_NEQ(X86SparseWeightPack(weight, output_dims[1], ic, sparse_weight_), TNN_OK);
+                use_sparse_ = true;
+            } else if (impl_ == InnerProductSgemv) {
                 int oc_rup = 8;
                 if (arch_ == sse42) {
                     oc_rup = 4;
@@ -103,17 +180,23 @@ Status X86InnerProductLayerAcc::allocateBufferWeight(const std::vector<Blob *> &
                 size_t weight_count = ROUND_UP(output_dims[1], oc_rup) * input_stride;
                 int data_byte_size = DataTypeUtils::GetBytesSize(res->weight_handle.GetDataType());
 
-                RawBuffer temp_buffer(weight_count * data_byte_size);
-                float *dst = temp_buffer.force_to<float *>();
+                auto pack_weight = [&](RawBuffer &packed) {
+                    RawBuffer temp_buffer(weight_count * data_byte_size);
+                    float *dst = temp_buffer.force_to<float *>();
 
-                if (arch_ == avx2) {
-                    PackC8(dst, src, input_stride, input_stride, input_stride, output_dims[1]);
-                } else if (arch_ == sse42) {
-                    PackC4(dst, src, input_stride, input_stride, input_stride, output_dims[1]);
-                }
+                    if (arch_ == avx2) {
+                        PackC8(dst, src, input_stride, input_stride, input_stride, output_dims[1]);
+                    } else if (arch_ == sse42) {
+                        PackC4(dst, src, input_stride, input_stride, input_stride, output_dims[1]);
+                    }
 
-                temp_buffer.SetDataType(DATA_TYPE_FLOAT);
-                buffer_weight_ = temp_buffer;
+                    temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+                    packed = temp_buffer;
+                    return Status(TNN_OK);
+                };
+                RETURN_ON_NEQ(PackWeightShared(res->weight_handle, "fc_sgemv", {(int)input_stride, output_dims[1], oc_rup},
+                                               pack_weight, buffer_weight_),
+                              TNN_OK);
             } else {
                 int k_c = conv_gemm_conf_.K_c_;
                 int m_block = conv_gemm_conf_.m_block_;
@@ -122,14 +205,20 @@ Status X86InnerProductLayerAcc::allocateBufferWeight(const std::vector<Blob *> &
                 size_t weight_pack_size = ROUND_UP(K, k_c) * ROUND_UP(M, m_block);
                 const float *src = res->weight_handle.force_to<float *>();
 
-                // align pointer of packed weights, since gemm use aligned load for input A
-                RawBuffer temp_buffer(weight_pack_size * sizeof(float), 32);
-                float *dst = temp_buffer.force_to<float *>();
+                auto pack_weight = [&](RawBuffer &packed) {
+                    // align pointer of packed weights, since gemm use aligned load for input A
+                    RawBuffer temp_buffer(weight_pack_size * sizeof(float), 32);
+                    float *dst = temp_buffer.force_to<float *>();
 
-                conv_pack_col_a_t(M, K, src, K, dst, conv_gemm_conf_);
+                    conv_pack_col_a_t(M, K, src, K, dst, conv_gemm_conf_);
 
-                temp_buffer.SetDataType(DATA_TYPE_FLOAT);
-                buffer_weight_ = temp_buffer;
+                    temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+                    packed = temp_buffer;
+                    return Status(TNN_OK);
+                };
+                RETURN_ON_NEQ(PackWeightShared(res->weight_handle, "fc_sgemm", {K, M, k_c, m_block}, pack_weight,
+                                               buffer_weight_),
+                              TNN_OK);
             }
         } else if (res->weight_handle.GetDataType() == DATA_TYPE_INT8) {
             // trans nchw to nhwc4
@@ -246,7 +335,22 @@ Status X86InnerProductLayerAcc::DoForward(const std::vector<Blob *> &inputs, con
         float *weight_data = buffer_weight_.force_to<float *>();
         float *bias_data   = buffer_bias_.force_to<float *>();
 
-        if (impl_ == InnerProductSgemv) {
+        if (dynamic_quant_) {
+            return DoForwardDynamicQuant(input_data, output_data, bias_data, input_dims, output_dims);
+        }
+        if (weight_quant_) {
+            return DoForwardWeightQuant(input_data, output_data, bias_data, input_dims, output_dims);
+        }
+
+        if (use_sparse_) {
+            auto X86SparseSgemvFunc = X86SparseSgemv<Float4, 4>;
+            if (arch_ == avx2) {
+                X86SparseSgemvFunc = X86SparseSgemv<Float8, 8>;
+            }
+            int K = DimsVectorUtils::Count(input_dims, 1);
+            int M = DimsVectorUtils::Count(output_dims, 1);
+            X86SparseSgemvFunc(output_data, M, input_data, K, input_dims[0], M, sparse_weight_, bias_data);
+        } else if (impl_ == InnerProductSgemv) {
             X86SgemvFunc(output_data, input_data, weight_data, bias_data, input_dims, output_dims);
         } else {
             int k_c = conv_gemm_conf_.K_c_;
@@ -291,6 +395,84 @@ Status X86InnerProductLayerAcc::DoForward(const std::vector<Blob *> &inputs, con
     return TNN_OK;
 }
 
+Status X86InnerProductLayerAcc::DoForwardWeightQuant(const float *input_data, float *output_data,
+                                                     const float *bias_data, DimsVector input_dims,
+                                                     DimsVector output_dims) {
+    auto param = dynamic_cast<InnerProductLayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+
+    int K     = DimsVectorUtils::Count(input_dims, 1);
+    int N     = input_dims[0];
+    int M     = DimsVectorUtils::Count(output_dims, 1);
+    int bits  = param->weight_quant_bits;
+    int group = param->weight_quant_group;
+
+    const int8_t *weight_data = buffer_weight_.force_to<int8_t *>();
+    const float *scale_data   = buffer_weight_scale_.force_to<float *>();
+
+    if (impl_ == InnerProductSgemv) {
+        auto X86WeightQuantSgemvFunc = X86WeightQuantSgemv<Float4, 4>;
+        if (arch_ == avx2) {
+            X86WeightQuantSgemvFunc = X86WeightQuantSgemv<Float8, 8>;
+        }
+        X86WeightQuantSgemvFunc(output_data, M, input_data, K, weight_data, scale_data, bias_data, N, M, K, bits,
+                                group);
+    } else {
+        auto X86WeightQuantSgemmFunc = X86WeightQuantSgemm<Float4, 4>;
+        void (*X86VecAddFunc)(float *, const float *, long) = X86_VectorAdd<Float4, 4>;
+        if (arch_ == avx2) {
+            X86WeightQuantSgemmFunc = X86WeightQuantSgemm<Float8, 8>;
+            X86VecAddFunc           = X86_VectorAdd<Float8, 8>;
+        }
+
+        size_t workspace_size = X86WeightQuantSgemmWorkspaceSize(N, conv_gemm_conf_);
+        float *workspace = reinterpret_cast<float *>(context_->GetSharedWorkSpace(workspace_size));
+
+        RawBuffer fake_bias(N * sizeof(float));
+        float *fake_bias_ptr = fake_bias.force_to<float *>();
+
+        X86WeightQuantSgemmFunc(M, N, K, weight_data, scale_data, bits, group, input_data, K, output_data, M,
+                                fake_bias_ptr, ActivationType_None, workspace, conv_gemm_conf_);
+        for (int i = 0; i < N; i++) {
+            auto dst = output_data + i * M;
+            X86VecAddFunc(dst, bias_data, M);
+        }
+    }
+    return TNN_OK;
+}
+
+Status X86InnerProductLayerAcc::DoForwardDynamicQuant(const float *input_data, float *output_data,
+                                                      const float *bias_data, DimsVector input_dims,
+                                                      DimsVector output_dims) {
+    auto param = dynamic_cast<InnerProductLayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+
+    int K        = DimsVectorUtils::Count(input_dims, 1);
+    int N        = input_dims[0];
+    int M        = DimsVectorUtils::Count(output_dims, 1);
+    bool per_row = param->dynamic_quant == 2;
+
+    auto X86DynamicQuantizeFunc = X86DynamicQuantize<Float4, 4>;
+    auto X86DynamicQuantGemmFunc = X86SSEDynamicQuantGemm;
+#ifdef __AVX2__
+    if (arch_ == avx2) {
+        X86DynamicQuantizeFunc  = X86DynamicQuantize<Float8, 8>;
+        X86DynamicQuantGemmFunc = X86AVXDynamicQuantGemm;
+    }
+#endif
+
+    // quantized input and its scales
+    size_t src_bytes      = ROUND_UP(N * X86DynamicQuantRowBytes(K), 32);
+    size_t workspace_size = src_bytes + N * sizeof(float);
+    int8_t *workspace     = reinterpret_cast<int8_t *>(context_->GetSharedWorkSpace(workspace_size));
+    float *src_scale      = reinterpret_cast<float *>(workspace + src_bytes);
+
+    X86DynamicQuantizeFunc(workspace, src_scale, input_data, N, K, per_row);
+    X86DynamicQuantGemmFunc(output_data, M, workspace, src_scale, per_row, buffer_weight_.force_to<int8_t *>(),
+                            buffer_weight_scale_.force_to<float *>(), bias_data, N, M, K);
+    return TNN_OK;
+}
+
 REGISTER_X86_ACC(InnerProduct, LAYER_INNER_PRODUCT);
 
 }  // namespace TNN_NS
\ No newline at end of file
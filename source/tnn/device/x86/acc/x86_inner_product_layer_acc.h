@@ -17,6 +17,7 @@
 
 #include "tnn/device/x86/acc/x86_layer_acc.h"
 #include "tnn/device/x86/acc/compute/jit/conv_sgemm_driver.h"
+#include "tnn/device/x86/acc/compute/x86_compute_sparse.h"
 
 enum InnerProductCompute {
     InnerProductSgemv = 0x0000,
@@ -35,9 +36,22 @@ public:
     virtual Status allocateBufferBias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
 protected:
+    Status DoForwardWeightQuant(const float *input_data, float *output_data, const float *bias_data,
+                                DimsVector input_dims, DimsVector output_dims);
+    Status DoForwardDynamicQuant(const float *input_data, float *output_data, const float *bias_data,
+                                 DimsVector input_dims, DimsVector output_dims);
+
     RawBuffer buffer_weight_;
     RawBuffer buffer_bias_;
     RawBuffer buffer_scale_;
+    // scales of weight-only quantized weight
+    RawBuffer buffer_weight_scale_;
+    bool weight_quant_ = false;
+    // int8 weights with int8 activations quantized at runtime
+    bool dynamic_quant_ = false;
+    // pruned weights run with the sparse kernel instead of the packed sgemv
+    bool use_sparse_ = false;
+    X86SparseWeight sparse_weight_;
     conv_gemm_config<float, float, float> conv_gemm_conf_;
     InnerProductCompute impl_;
     std::shared_ptr<LayerResource> fc_acc_f32_resource_ = nullptr;
@@ -13,10 +13,43 @@
 // specific language governing permissions and limitations under the License.
 
 #include "tnn/device/x86/acc/x86_layer_acc.h"
+
+#include <map>
+#include <mutex>
+#include <tuple>
+
 #include "tnn/utils/blob_transfer_utils.h"
 
 namespace TNN_NS {
 
+namespace {
+struct SharedPackedWeightKey {
+    const void *src;
+    int src_bytes;
+    std::string kind;
+    std::vector<int> pack_params;
+    int numa_node;
+
+    bool operator<(const SharedPackedWeightKey &other) const {
+        return std::tie(src, src_bytes, kind, pack_params, numa_node) <
+               std::tie(other.src, other.src_bytes, other.kind, other.pack_params, other.numa_node);
+    }
+};
+
+struct SharedPackedWeight {
+    // the address of a freed src, e.g. the fp32 copy of half weights, may be reused by another src
+    std::weak_ptr<char> src_storage;
+    std::weak_ptr<RawBuffer> packed;
+};
+}  // namespace
+
+static std::mutex g_shared_packed_weight_mutex;
+static std::map<SharedPackedWeightKey, SharedPackedWeight> g_shared_packed_weights;
+
+static bool SameStorage(const std::weak_ptr<char> &a, const std::weak_ptr<char> &b) {
+    return !a.owner_before(b) && !b.owner_before(a);
+}
+
 X86LayerAcc::~X86LayerAcc() {}
 
 Status X86LayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
@@ -40,6 +73,33 @@ Status X86LayerAcc::Init(Context *context, LayerParam *param, LayerResource *res
     return Reshape(inputs, outputs);
 }
 
+Status X86LayerAcc::PackWeightShared(RawBuffer &src, const std::string &kind, const std::vector<int> &pack_params,
+                                     std::function<Status(RawBuffer &)> pack, RawBuffer &packed) {
+    // instances not bound to a numa node share the weights packed by each other
+    int numa_node = context_->GetNumaNode();
+    SharedPackedWeightKey key = {src.force_to<void *>(), src.GetBytesSize(), kind, pack_params, numa_node};
+    auto src_storage          = src.GetStorage();
+    std::lock_guard<std::mutex> guard(g_shared_packed_weight_mutex);
+    auto iter = g_shared_packed_weights.find(key);
+    std::shared_ptr<RawBuffer> shared_weight;
+    if (iter != g_shared_packed_weights.end() && SameStorage(iter->second.src_storage, src_storage)) {
+        shared_weight = iter->second.packed.lock();
+    }
+    if (!shared_weight) {
+        // the thread packing the weights prefers memory of the numa node in instance init
+        shared_weight = std::make_shared<RawBuffer>();
+        RETURN_ON_NEQ(pack(*shared_weight), TNN_OK);
+        for (auto it = g_shared_packed_weights.begin(); it != g_shared_packed_weights.end();) {
+            bool expired = it->second.packed.expired() || it->second.src_storage.expired();
+            it           = expired ? g_shared_packed_weights.erase(it) : std::next(it);
+        }
+        g_shared_packed_weights[key] = {src_storage, shared_weight};
+    }
+    shared_packed_weights_.push_back(shared_weight);
+    packed = *shared_weight;
+    return TNN_OK;
+}
+
 std::vector<DataFormat> X86LayerAcc::SupportDataFormat(DataType data_type, int dims_size, BlobType blob_type) {
     std::vector<DataFormat> support_list;
     if (dims_size == 4) {
@@ -83,6 +143,7 @@ Status X86LayerAcc::ReloadConstantBlobs(const std::vector<Blob *> &inputs, bool
     auto const_resource = const_resource_;
     auto const_resource_flag = const_resource_flag_;
     auto const_blob_map = const_blob_map_;
+    auto const_buffer_map = const_buffer_map_;
     for (auto iter : inputs) {
         auto name = iter->GetBlobDesc().name;
         if (const_resource == nullptr || const_resource->find(name) == const_resource->end()) {
@@ -93,20 +154,20 @@ Status X86LayerAcc::ReloadConstantBlobs(const std::vector<Blob *> &inputs, bool
             continue;
         }
 
+        // the constants are immutable and shared by the instances of the model, the blob reads them in place
         auto buffer = (*const_resource)[name];
         std::shared_ptr<Blob> blob = nullptr;
-        if (const_blob_map.find(name) != const_blob_map.end()) {
-            blob = const_blob_map[name];
-        }
-        auto status = RawBuffer2Blob(buffer.get(), blob);
+        auto status = RawBuffer2SharedBlob(buffer.get(), blob);
         RETURN_ON_NEQ(status, TNN_OK);
 
         blob->SetFlag(DATA_FLAG_CHANGE_NEVER);
         const_blob_map[name] = blob;
+        const_buffer_map[name] = buffer;
         iter->SetHandle(blob->GetHandle());
         LOGD("Reload constant blob: %s\n", name.c_str());
     }
     const_blob_map_ = const_blob_map;
+    const_buffer_map_ = const_buffer_map;
     return TNN_OK;
 }
 
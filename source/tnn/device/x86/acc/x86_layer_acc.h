@@ -15,6 +15,8 @@
 #ifndef TNN_SOURCE_TNN_DEVICE_X86_X86_LAYER_ACC_H_
 #define TNN_SOURCE_TNN_DEVICE_X86_X86_LAYER_ACC_H_
 
+#include <functional>
+#include <memory>
 #include <vector>
 
 #include "tnn/core/abstract_layer_acc.h"
@@ -49,10 +51,19 @@ public:
 #endif
 
 protected:
+    // @brief packed weights of src are shared by the instances bound to the same numa node, pack is
+    // called only if no instance on the node has packed src with the same pack_params. instances not
+    // bound to a numa node share the weights among themselves. src is told apart by its storage, not by
+    // its address, so temporary copies such as the fp32 weights of half models are never taken for each other.
+    Status PackWeightShared(RawBuffer &src, const std::string &kind, const std::vector<int> &pack_params,
+                            std::function<Status(RawBuffer &)> pack, RawBuffer &packed);
+
     LayerParam* param_          = nullptr;
     LayerResource* resource_    = nullptr;
     X86Context *context_           = nullptr;
     x86_isa_t arch_;
+    // keep the shared packed weights alive
+    std::vector<std::shared_ptr<RawBuffer>> shared_packed_weights_;
 
 private:
     // @brief return device layer acc support data format
@@ -17,7 +17,9 @@
 #include "tnn/utils/dims_vector_utils.h"
 #include "tnn/device/x86/acc/x86_lstm_layer_acc.h"
 #include "tnn/device/x86/acc/Float4.h"
+#include "tnn/device/x86/acc/compute/x86_compute_weight_quant.h"
 #include "tnn/utils/omp_utils.h"
+#include "tnn/utils/weight_quant_utils.h"
 namespace TNN_NS {
 
 static void X86LSTMActivate(const float *gates, float *h_t, float *c_t, float *y, int len) {
@@ -61,9 +63,105 @@ static void X86LSTMActivate(const float *gates, float *h_t, float *c_t, float *y
     }
 }
 
-Status X86LSTMONNXLayerAcc::LSTMOneDirection(const float *x, float *y, const float *w, const float *r,
-                              const float *b, float *h_t, float *c_t, int seq_len, int batch_size,
-                              int input_size, int hidden_size, int reverse) {
+// gates[n][m] = bias[m] + dot(weight[m], src[n]) for the rows of the step weight
+template <typename VEC, int pack>
+static void X86LSTMStepGemv(float *gates, const float *src, const float *weight, const float *bias, int batch, int M,
+                            int K) {
+    OMP_PARALLEL_FOR_GUIDED_
+    for (int m = 0; m < M; m++) {
+        const float *w_m = weight + (long)m * K;
+        for (int n = 0; n < batch; n++) {
+            const float *src_n = src + (long)n * K;
+            VEC acc0(0.f), acc1(0.f);
+            int k = 0;
+            for (; k + 2 * pack <= K; k += 2 * pack) {
+                VEC::mla(acc0, VEC::loadu(w_m + k), VEC::loadu(src_n + k));
+                VEC::mla(acc1, VEC::loadu(w_m + k + pack), VEC::loadu(src_n + k + pack));
+            }
+            for (; k + pack <= K; k += pack) {
+                VEC::mla(acc0, VEC::loadu(w_m + k), VEC::loadu(src_n + k));
+            }
+            float acc_buf[pack];
+            VEC::saveu(acc_buf, acc0 + acc1);
+            float sum = bias[m];
+            for (int i = 0; i < pack; i++) {
+                sum += acc_buf[i];
+            }
+            for (; k < K; k++) {
+                sum += w_m[k] * src_n[k];
+            }
+            gates[(long)n * M + m] = sum;
+        }
+    }
+}
+
+void X86LSTMONNXLayerAcc::LSTMGemm(int M, int N, int K, const void *weight, const float *weight_scale,
+                                   const float *src, float *dst, bool accumulate, float *gemm_buf) {
+    if (!weight_quant_) {
+        RawBuffer fake_bias(N * sizeof(float));
+        conv_sgemm_tn_col_major_prepack_a(M, N, K, (const float *)weight, K, src, K, dst, M,
+                accumulate ? nullptr : fake_bias.force_to<float *>(), ActivationType_None, gemm_buf, conv_gemm_conf_);
+        return;
+    }
+
+    auto layer_param    = dynamic_cast<LSTMONNXLayerParam *>(param_);
+    int bits            = layer_param->weight_quant_bits;
+    int group           = layer_param->weight_quant_group;
+    auto weight_data    = (const int8_t *)weight;
+    // few columns: read the quantized weight directly instead of dequantizing it into gemm blocks
+    if (N <= 4) {
+        auto X86WeightQuantSgemvFunc = X86WeightQuantSgemv<Float4, 4>;
+        if (arch_ == avx2) {
+            X86WeightQuantSgemvFunc = X86WeightQuantSgemv<Float8, 8>;
+        }
+        RawBuffer zero_bias(M * sizeof(float));
+        X86WeightQuantSgemvFunc(dst, M, src, K, weight_data, weight_scale,
+                                accumulate ? nullptr : zero_bias.force_to<float *>(), N, M, K, bits, group);
+    } else {
+        auto X86WeightQuantSgemmFunc = X86WeightQuantSgemm<Float4, 4>;
+        if (arch_ == avx2) {
+            X86WeightQuantSgemmFunc = X86WeightQuantSgemm<Float8, 8>;
+        }
+        RawBuffer fake_bias(N * sizeof(float));
+        X86WeightQuantSgemmFunc(M, N, K, weight_data, weight_scale, bits, group, src, K, dst, M,
+                                accumulate ? nullptr : fake_bias.force_to<float *>(), ActivationType_None, gemm_buf,
+                                conv_gemm_conf_);
+    }
+}
+
+Status X86LSTMONNXLayerAcc::LSTMStep(const float *x, float *y, const float *wr_step, const float *b, float *h_t,
+                                     float *c_t, int batch_size, int input_size, int hidden_size) {
+    const int K = input_size + hidden_size;
+    const int M = 4 * hidden_size;
+
+    size_t src_buf_size   = ROUND_UP(batch_size * K * sizeof(float), 32);
+    size_t gates_buf_size = ROUND_UP(batch_size * M * sizeof(float), 32);
+    float *workspace = reinterpret_cast<float *>(context_->GetSharedWorkSpace(src_buf_size + gates_buf_size));
+    float *src_buf   = workspace;
+    float *gates_buf = workspace + src_buf_size / sizeof(float);
+
+    for (int n = 0; n < batch_size; n++) {
+        memcpy(src_buf + n * K, x + n * input_size, input_size * sizeof(float));
+        memcpy(src_buf + n * K + input_size, h_t + n * hidden_size, hidden_size * sizeof(float));
+    }
+
+    auto X86LSTMStepGemvFunc = X86LSTMStepGemv<Float4, 4>;
+    if (arch_ == avx2) {
+        X86LSTMStepGemvFunc = X86LSTMStepGemv<Float8, 8>;
+    }
+    X86LSTMStepGemvFunc(gates_buf, src_buf, wr_step, b, batch_size, M, K);
+
+    X86LSTMActivate(gates_buf, h_t, c_t, y, batch_size * hidden_size);
+    return TNN_OK;
+}
+
+Status X86LSTMONNXLayerAcc::LSTMOneDirection(const float *x, float *y, const void *w, const float *w_scale,
+                              const void *r, const float *r_scale, const float *b, const float *wr_step, float *h_t,
+                              float *c_t, int seq_len, int batch_size, int input_size, int hidden_size, int reverse) {
+    if (seq_len == 1 && wr_step) {
+        return LSTMStep(x, y, wr_step, b, h_t, c_t, batch_size, input_size, hidden_size);
+    }
+
     int k_c = conv_gemm_conf_.K_c_;
     int n_block = conv_gemm_conf_.n_block_;
 
@@ -76,16 +174,16 @@ Status X86LSTMONNXLayerAcc::LSTMOneDirection(const float *x, float *y, const flo
 
     // two temp buf: gemm_buf and gates_buf
     size_t gemm_buf_size = ROUND_UP(k_c * ROUND_UP(N, n_block) * sizeof(float), 32);
+    if (weight_quant_) {
+        gemm_buf_size = ROUND_UP(X86WeightQuantSgemmWorkspaceSize(N, conv_gemm_conf_), 32);
+    }
     size_t gates_buf_size = ROUND_UP(N * M * sizeof(float), 32);
     size_t workspace_size = gemm_buf_size + gates_buf_size;
     float *workspace = reinterpret_cast<float *>(context_->GetSharedWorkSpace(workspace_size));
     float *gemm_buf = workspace;
     float *gates_buf = workspace + gemm_buf_size / sizeof(float);
 
-    RawBuffer fake_bias(N * sizeof(float));
-    float *fake_bias_ptr = fake_bias.force_to<float *>();
-    conv_sgemm_tn_col_major_prepack_a(M, N, K, w, K, x, K, gates_buf, M,
-            fake_bias_ptr, ActivationType_None, gemm_buf, conv_gemm_conf_);
+    LSTMGemm(M, N, K, w, w_scale, x, gates_buf, false, gemm_buf);
     
     for (int t = 0; t < seq_len; t++) {
         int ti = reverse ? seq_len - 1 - t : t;
@@ -109,8 +207,7 @@ Status X86LSTMONNXLayerAcc::LSTMOneDirection(const float *x, float *y, const flo
         K = hidden_size;
         N = batch_size;
         M = 4 * hidden_size;
-        conv_sgemm_tn_col_major_prepack_a(M, N, K, r, K, h_t, K, gates_t, M,
-                nullptr, ActivationType_None, gemm_buf, conv_gemm_conf_);
+        LSTMGemm(M, N, K, r, r_scale, h_t, gates_t, true, gemm_buf);
 
         // activation for h_t, c_t, output
         X86LSTMActivate(gates_t, h_t, c_t, y_t, batch_size * hidden_size);
@@ -135,7 +232,98 @@ Status X86LSTMONNXLayerAcc::Init(Context *context, LayerParam *param, LayerResou
     return TNN_OK;
 }
 
+Status X86LSTMONNXLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto layer_param = dynamic_cast<LSTMONNXLayerParam *>(param_);
+    CHECK_PARAM_NULL(layer_param);
+    if (context_->GetEnableRecurrentState()) {
+        // a new stream, or a batch different from the saved state starts from zero
+        int num_directions    = layer_param->direction >= 2 ? 2 : 1;
+        DimsVector state_dims = {num_directions, inputs[0]->GetBlobDesc().dims[1], layer_param->hidden_size};
+        if (state_h_.GetBufferDims() != state_dims || state_c_.GetBufferDims() != state_dims) {
+            int64_t state_bytes = (int64_t)DimsVectorUtils::Count(state_dims) * sizeof(float);
+            state_h_            = RawBuffer(state_bytes, state_dims);
+            state_c_            = RawBuffer(state_bytes, state_dims);
+        }
+    }
+    return TNN_OK;
+}
+
+static Status GetWeightQuantConstant(ConstantResource *const_resource, Blob *blob, RawBuffer &weight,
+                                     RawBuffer &scale) {
+    auto name = blob->GetBlobDesc().name;
+    if (!const_resource || const_resource->find(name) == const_resource->end() ||
+        const_resource->find(name + WEIGHT_QUANT_SCALE_SUFFIX) == const_resource->end()) {
+        LOGE("Error: LSTM weight-only quantized weight %s has no scale\n", name.c_str());
+        return Status(TNNERR_MODEL_ERR, "LSTM weight-only quantized weight has no scale");
+    }
+    weight = *((*const_resource)[name]);
+    scale  = *((*const_resource)[name + WEIGHT_QUANT_SCALE_SUFFIX]);
+    if (scale.GetDataType() == DATA_TYPE_HALF) {
+        scale = ConvertHalfHandle(scale);
+    }
+    return TNN_OK;
+}
+
+Status X86LSTMONNXLayerAcc::PackWeightQuant(Blob *blob, RawBuffer &packed, RawBuffer &packed_scale) {
+    auto layer_param = dynamic_cast<LSTMONNXLayerParam *>(param_);
+    int bits         = layer_param->weight_quant_bits;
+    int group        = layer_param->weight_quant_group;
+
+    RawBuffer weight, scale;
+    RETURN_ON_NEQ(GetWeightQuantConstant(const_resource_, blob, weight, scale), TNN_OK);
+
+    // [num_direction, 4 * hidden_size, K]
+    auto dims        = blob->GetBlobDesc().dims;
+    int M            = dims[1];
+    int K            = dims[2];
+    int hidden_size  = M / 4;
+    int row_bytes    = WeightQuantRowBytes(K, bits);
+    int group_count  = WeightQuantGroupCount(K, group);
+    if (weight.GetBytesSize() < dims[0] * M * row_bytes || scale.GetDataCount() < dims[0] * M * group_count) {
+        return Status(TNNERR_MODEL_ERR, "invalid LSTM weight-only quantized weight");
+    }
+
+    int pack                = arch_ == avx2 ? 8 : 4;
+    size_t pack_bytes       = X86WeightQuantPackedBytes(M, K, bits, pack);
+    size_t pack_scale_count = X86WeightQuantPackedScaleCount(M, K, group, pack);
+    RawBuffer temp_buffer(dims[0] * pack_bytes);
+    RawBuffer temp_scale(dims[0] * pack_scale_count * sizeof(float));
+    RawBuffer trans_buf(M * row_bytes);
+    RawBuffer trans_scale(M * group_count * sizeof(float));
+    auto trans_ptr       = trans_buf.force_to<int8_t *>();
+    auto trans_scale_ptr = trans_scale.force_to<float *>();
+
+    for (int d = 0; d < dims[0]; d++) {
+        auto w_src = weight.force_to<int8_t *>() + d * M * row_bytes;
+        auto s_src = scale.force_to<float *>() + d * M * group_count;
+
+        // transpose rows and their scales from 4 * hidden_size to hidden_size * 4
+        for (int i = 0; i < 4; i++) {
+            for (int j = 0; j < hidden_size; j++) {
+                memcpy(trans_ptr + (j * 4 + i) * row_bytes, w_src + (i * hidden_size + j) * row_bytes, row_bytes);
+                memcpy(trans_scale_ptr + (j * 4 + i) * group_count, s_src + (i * hidden_size + j) * group_count,
+                       group_count * sizeof(float));
+            }
+        }
+
+        X86WeightQuantPack(temp_buffer.force_to<int8_t *>() + d * pack_bytes,
+                           temp_scale.force_to<float *>() + d * pack_scale_count, trans_ptr, trans_scale_ptr, M, K,
+                           bits, group, pack);
+    }
+
+    temp_buffer.SetDataType(DATA_TYPE_INT8);
+    temp_scale.SetDataType(DATA_TYPE_FLOAT);
+    packed       = temp_buffer;
+    packed_scale = temp_scale;
+    return TNN_OK;
+}
+
 Status X86LSTMONNXLayerAcc::allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto layer_param = dynamic_cast<LSTMONNXLayerParam *>(param_);
+    CHECK_PARAM_NULL(layer_param);
+    int bits  = layer_param->weight_quant_bits;
+    int group = layer_param->weight_quant_group;
+
     // weights for gates, [num_direction, 4 * hidden_size, input_size]
     auto w_dims = inputs[1]->GetBlobDesc().dims;
     int w_direction_size = DimsVectorUtils::Count(w_dims, 1);
@@ -146,6 +334,27 @@ Status X86LSTMONNXLayerAcc::allocateBufferWeight(const std::vector<Blob *> &inpu
     int r_direction_size = DimsVectorUtils::Count(r_dims, 1);
     float *r_ptr = (float *)((char*)(inputs[2]->GetHandle().base) + inputs[2]->GetHandle().bytes_offset);
 
+    RawBuffer w_f32, r_f32;
+    if (bits > 0 && inputs[1]->GetBlobDesc().data_type == DATA_TYPE_INT8) {
+        if (X86WeightQuantSupported(w_dims[2], bits, group) && X86WeightQuantSupported(r_dims[2], bits, group)) {
+            // weight-only quantized weights are dequantized on the fly by the gemm kernels
+            RETURN_ON_NEQ(PackWeightQuant(inputs[1], buffer_w_, buffer_w_scale_), TNN_OK);
+            RETURN_ON_NEQ(PackWeightQuant(inputs[2], buffer_r_, buffer_r_scale_), TNN_OK);
+            weight_quant_ = true;
+            return TNN_OK;
+        }
+
+        RawBuffer w_quant, w_scale, r_quant, r_scale;
+        RETURN_ON_NEQ(GetWeightQuantConstant(const_resource_, inputs[1], w_quant, w_scale), TNN_OK);
+        RETURN_ON_NEQ(GetWeightQuantConstant(const_resource_, inputs[2], r_quant, r_scale), TNN_OK);
+        RETURN_ON_NEQ(DequantizeWeightOnly(w_quant, w_scale, w_dims[0] * w_dims[1], w_dims[2], bits, group, w_f32),
+                      TNN_OK);
+        RETURN_ON_NEQ(DequantizeWeightOnly(r_quant, r_scale, r_dims[0] * r_dims[1], r_dims[2], bits, group, r_f32),
+                      TNN_OK);
+        w_ptr = w_f32.force_to<float *>();
+        r_ptr = r_f32.force_to<float *>();
+    }
+
     int k_c = conv_gemm_conf_.K_c_;
     int m_block = conv_gemm_conf_.m_block_;
     // gate weights
@@ -161,6 +370,14 @@ Status X86LSTMONNXLayerAcc::allocateBufferWeight(const std::vector<Blob *> &inpu
     int hidden_size = w_dims[1] / 4;
     float *trans_ptr = trans_buf.force_to<float *>();
 
+    // streaming runs one step per forward, keep [W R] unpacked for the step gemv
+    const bool pack_step = context_->GetEnableRecurrentState();
+    const int step_k     = w_dims[2] + r_dims[2];
+    RawBuffer step_buffer;
+    if (pack_step) {
+        step_buffer = RawBuffer(w_dims[0] * w_dims[1] * step_k * sizeof(float), 32);
+    }
+
     for (int d = 0; d < w_dims[0]; d++) {
         float *w_src = w_ptr + d * w_direction_size;
         float *w_dst = w_temp_buffer.force_to<float *>() + d * w_pack_size;
@@ -173,6 +390,12 @@ Status X86LSTMONNXLayerAcc::allocateBufferWeight(const std::vector<Blob *> &inpu
                 memcpy(trans_dst, trans_src, w_dims[2] * sizeof(float));
             }
         }
+        if (pack_step) {
+            float *step_dst = step_buffer.force_to<float *>() + d * M * step_k;
+            for (int m = 0; m < M; m++) {
+                memcpy(step_dst + m * step_k, trans_ptr + m * K, K * sizeof(float));
+            }
+        }
 
         conv_pack_col_a_t(M, K, trans_ptr, K, w_dst, conv_gemm_conf_);
     }
@@ -194,9 +417,19 @@ Status X86LSTMONNXLayerAcc::allocateBufferWeight(const std::vector<Blob *> &inpu
                 memcpy(trans_dst, trans_src, r_dims[2] * sizeof(float));
             }
         }
+        if (pack_step) {
+            float *step_dst = step_buffer.force_to<float *>() + d * M * step_k + w_dims[2];
+            for (int m = 0; m < M; m++) {
+                memcpy(step_dst + m * step_k, trans_ptr + m * K, K * sizeof(float));
+            }
+        }
 
         conv_pack_col_a_t(M, K, trans_ptr, K, r_dst, conv_gemm_conf_);
     }
+    if (pack_step) {
+        step_buffer.SetDataType(DATA_TYPE_FLOAT);
+        buffer_wr_step_ = step_buffer;
+    }
 
     w_temp_buffer.SetDataType(DATA_TYPE_FLOAT);
     r_temp_buffer.SetDataType(DATA_TYPE_FLOAT);
@@ -268,14 +501,25 @@ Status X86LSTMONNXLayerAcc::DoForward(const std::vector<Blob *> &inputs, const s
     float *y = (float *)((char*)(outputs[0]->GetHandle().base) + outputs[0]->GetHandle().bytes_offset);
     
     //W[iofc], weight tensor for the gates, shape [num_directions, 4*hidden_size, input_size]
-    float *w = (float *)buffer_w_.force_to<float *>();
+    char *w = buffer_w_.force_to<char *>();
+    float *w_scale = buffer_w_scale_.force_to<float *>();
     auto w_dims = inputs[1]->GetBlobDesc().dims;
-    size_t w_pack_size = ROUND_UP(w_dims[2], k_c) * ROUND_UP(w_dims[1], m_block);
+    size_t w_pack_size = ROUND_UP(w_dims[2], k_c) * ROUND_UP(w_dims[1], m_block) * sizeof(float);
 
     //R[iofc], recurrence weight tensor, shape [num_directions, 4*hidden_size, hidden_size]
-    float *r = (float *)buffer_r_.force_to<float *>();
+    char *r = buffer_r_.force_to<char *>();
+    float *r_scale = buffer_r_scale_.force_to<float *>();
     auto r_dims = inputs[2]->GetBlobDesc().dims;
-    size_t r_pack_size = ROUND_UP(r_dims[2], k_c) * ROUND_UP(r_dims[1], m_block);
+    size_t r_pack_size = ROUND_UP(r_dims[2], k_c) * ROUND_UP(r_dims[1], m_block) * sizeof(float);
+
+    size_t w_scale_size = 0;
+    size_t r_scale_size = 0;
+    if (weight_quant_) {
+        w_pack_size  = buffer_w_.GetBytesSize() / w_dims[0];
+        r_pack_size  = buffer_r_.GetBytesSize() / r_dims[0];
+        w_scale_size = buffer_w_scale_.GetDataCount() / w_dims[0];
+        r_scale_size = buffer_r_scale_.GetDataCount() / r_dims[0];
+    }
     
     //B[iofc] Concatenation of [Wb[iofc], Rb[iofc]], [num_directions, 8*hidden_size]
     float *b = (float *)buffer_b_.force_to<float *>();
@@ -285,32 +529,54 @@ Status X86LSTMONNXLayerAcc::DoForward(const std::vector<Blob *> &inputs, const s
     //initial_c, initial value of the cell, If not specified - assumed to be 0. shape [num_directions, batch_size, hidden_size]
     auto c_t = (float *)((char*)(outputs[2]->GetHandle().base) + outputs[2]->GetHandle().bytes_offset);
 
-    if (inputs.size() >= 6) {
+    const bool keep_state     = context_->GetEnableRecurrentState();
+    const int state_count     = num_directions * batch * hidden_size;
+    const int64_t state_bytes = (int64_t)state_count * sizeof(float);
+    if (keep_state) {
+        if (state_h_.GetBytesSize64() != state_bytes || state_c_.GetBytesSize64() != state_bytes) {
+            return Status(TNNERR_LAYER_ERR, "LSTM recurrent state does not match the batch");
+        }
+        memcpy((void *)h_t, state_h_.force_to<float *>(), state_bytes);
+        memcpy((void *)c_t, state_c_.force_to<float *>(), state_bytes);
+    } else if (inputs.size() >= 6) {
         auto h_0 = (float *)((char*)(blob_h0->GetHandle().base) + blob_h0->GetHandle().bytes_offset);
         auto c_0 = (float *)((char*)(blob_c0->GetHandle().base) + blob_c0->GetHandle().bytes_offset);
-        memcpy((void *)h_t, h_0, num_directions * batch * hidden_size * sizeof(float));
-        memcpy((void *)c_t, c_0, num_directions * batch * hidden_size * sizeof(float));
+        memcpy((void *)h_t, h_0, state_bytes);
+        memcpy((void *)c_t, c_0, state_bytes);
     } else {
-        memset((void *)h_t, 0, num_directions * batch * hidden_size * sizeof(float));
-        memset((void *)c_t, 0, num_directions * batch * hidden_size * sizeof(float));
+        memset((void *)h_t, 0, state_bytes);
+        memset((void *)c_t, 0, state_bytes);
     }
-    
+
+    // [W R] rows for sequence length 1, float weights only
+    const float *wr_step = buffer_wr_step_.force_to<float *>();
+    size_t wr_step_size  = 4 * hidden_size * (input_size + hidden_size);
+
+    Status status = TNN_OK;
     if (layer_param->direction == 0 || layer_param->direction == 1) {
-        return LSTMOneDirection(x, y, w, r, b, h_t, c_t, T, batch, input_size, hidden_size, layer_param->direction);
+        status = LSTMOneDirection(x, y, w, w_scale, r, r_scale, b, wr_step, h_t, c_t, T, batch, input_size,
+                                  hidden_size, layer_param->direction);
     } else if (layer_param->direction == 2) {
         //Y shape [num_directions sequence batch_size hidden_size]
         auto y_temp = std::shared_ptr<float>(new float[num_directions*T*batch*hidden_size], [](float* p) { delete[] p; });
         auto y0 = y_temp.get();
         auto y1 = y0 + T * batch * hidden_size;
-        LSTMOneDirection(x, y0, w, r, b, h_t, c_t, T, batch, input_size, hidden_size, 0);
-        
+        status = LSTMOneDirection(x, y0, w, w_scale, r, r_scale, b, wr_step, h_t, c_t, T, batch, input_size,
+                                  hidden_size, 0);
+        RETURN_ON_NEQ(status, TNN_OK);
+
         auto w1 = w + w_pack_size;
         auto r1 = r + r_pack_size;
+        auto w_scale1 = w_scale ? w_scale + w_scale_size : nullptr;
+        auto r_scale1 = r_scale ? r_scale + r_scale_size : nullptr;
         auto b1 = b + 4 * hidden_size;
+        auto wr_step1 = wr_step ? wr_step + wr_step_size : nullptr;
         auto h_t1 = h_t + batch * hidden_size;
         auto c_t1 = c_t + batch * hidden_size;
-        LSTMOneDirection(x, y1, w1, r1, b1, h_t1, c_t1, T, batch, input_size, hidden_size, 1);
-        
+        status = LSTMOneDirection(x, y1, w1, w_scale1, r1, r_scale1, b1, wr_step1, h_t1, c_t1, T, batch, input_size,
+                                  hidden_size, 1);
+        RETURN_ON_NEQ(status, TNN_OK);
+
         //transpose [num_directions sequence batch_size hidden_size] to [sequence batch_size num_directions*hidden_size]
         for (int i = 0; i < T*batch; i++) {
             auto y0_data = y0 + i * hidden_size;
@@ -323,7 +589,20 @@ Status X86LSTMONNXLayerAcc::DoForward(const std::vector<Blob *> &inputs, const s
     } else {
         return Status(TNNERR_PARAM_ERR, "LSTMONNX has invalid direction param");
     }
+    RETURN_ON_NEQ(status, TNN_OK);
+
+    if (keep_state) {
+        memcpy(state_h_.force_to<float *>(), h_t, state_bytes);
+        memcpy(state_c_.force_to<float *>(), c_t, state_bytes);
+    }
+    return TNN_OK;
+}
 
+Status X86LSTMONNXLayerAcc::GetRecurrentStates(std::map<std::string, RawBuffer *> &states) {
+    if (context_->GetEnableRecurrentState()) {
+        states["h"] = &state_h_;
+        states["c"] = &state_c_;
+    }
     return TNN_OK;
 }
 
@@ -26,17 +26,40 @@ public:
 
     Status Init(Context *context, LayerParam *param, LayerResource *resource, const std::vector<Blob *> &inputs,
                 const std::vector<Blob *> &outputs) override;
+    virtual Status Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
     virtual Status allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
     virtual Status allocateBufferBias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+    virtual Status GetRecurrentStates(std::map<std::string, RawBuffer *> &states) override;
 protected:
-    Status LSTMOneDirection(const float *x, float *y, const float *w, const float *r,
-                           const float *b, float *h_t, float *c_t, int seq_len, int batch_size,
-                           int input_size, int hidden_size, int reverse);
+    Status LSTMOneDirection(const float *x, float *y, const void *w, const float *w_scale, const void *r,
+                           const float *r_scale, const float *b, const float *wr_step, float *h_t, float *c_t,
+                           int seq_len, int batch_size, int input_size, int hidden_size, int reverse);
+
+    // one time step as a single gemv of [W R] with the concatenation of x and h_t
+    Status LSTMStep(const float *x, float *y, const float *wr_step, const float *b, float *h_t, float *c_t,
+                    int batch_size, int input_size, int hidden_size);
+
+    // dst[N * M] = weight[M * K] * src[N * K], or dst += weight * src if accumulate
+    void LSTMGemm(int M, int N, int K, const void *weight, const float *weight_scale, const float *src, float *dst,
+                  bool accumulate, float *gemm_buf);
+
+    // reorder gates to hidden_size * 4 and pack weight-only quantized weights
+    Status PackWeightQuant(Blob *blob, RawBuffer &packed, RawBuffer &packed_scale);
 
     RawBuffer buffer_w_;
     RawBuffer buffer_r_;
     RawBuffer buffer_b_;
+    // scales of weight-only quantized W and R
+    RawBuffer buffer_w_scale_;
+    RawBuffer buffer_r_scale_;
+    bool weight_quant_ = false;
+    // [num_directions, hidden_size * 4, input_size + hidden_size], rows of W and R side by side
+    // for the single step forward of streaming, float weights only
+    RawBuffer buffer_wr_step_;
+    // [num_directions, batch, hidden_size] hidden and cell states kept across forward calls
+    RawBuffer state_h_;
+    RawBuffer state_c_;
     conv_gemm_config<float, float, float> conv_gemm_conf_;
 };
 
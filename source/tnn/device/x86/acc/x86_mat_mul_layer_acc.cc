@@ -15,11 +15,164 @@
 #include "tnn/device/x86/acc/x86_layer_acc.h"
 #include "tnn/utils/dims_vector_utils.h"
 #include "tnn/device/x86/acc/x86_mat_mul_layer_acc.h"
+#include "tnn/device/x86/acc/compute/x86_compute_dynamic_quant.h"
+#include "tnn/device/x86/acc/compute/x86_compute_weight_quant.h"
+#include "tnn/utils/weight_quant_utils.h"
 
 namespace TNN_NS {
 
 X86MatMulLayerAcc::~X86MatMulLayerAcc() {}
 
+Status X86MatMulLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
+                               const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    RETURN_ON_NEQ(X86LayerAcc::Init(context, param, resource, inputs, outputs), TNN_OK);
+
+    auto layer_param = dynamic_cast<MatMulLayerParam *>(param);
+    CHECK_PARAM_NULL(layer_param);
+    auto layer_res = dynamic_cast<MatMulLayerResource *>(resource);
+    if (inputs.size() != 1 || !layer_res || layer_res->weight.GetDataType() != DATA_TYPE_INT8) {
+        return TNN_OK;
+    }
+
+    // weight-only quantized weight B[K * M] is stored as rows of B^T[M * K]
+    auto weight_dims = layer_res->weight.GetBufferDims();
+    if (layer_param->weight_quant_bits <= 0 || layer_param->weight_position != 1 || weight_dims.size() != 2 ||
+        layer_param->transpose_a) {
+        LOGE("Error: MatMul only supports weight-only quantized 2-dim weight at position 1 with untransposed input\n");
+        return Status(TNNERR_LAYER_ERR, "MatMul weight-only quantized weight is not supported");
+    }
+    int K     = weight_dims[0];
+    int M     = weight_dims[1];
+    int bits  = layer_param->weight_quant_bits;
+    int group = layer_param->weight_quant_group;
+    int pack  = arch_ == avx2 ? 8 : 4;
+
+    RawBuffer w_scale = layer_res->scale_handle;
+    if (w_scale.GetDataType() == DATA_TYPE_HALF)
+        w_scale = ConvertHalfHandle(w_scale);
+    if (w_scale.GetDataCount() < M * WeightQuantGroupCount(K, group) ||
+        layer_res->weight.GetBytesSize() < M * WeightQuantRowBytes(K, bits)) {
+        return Status(TNNERR_MODEL_ERR, "invalid weight-only quantized MatMul weight");
+    }
+
+    if (!X86WeightQuantSupported(K, bits, group)) {
+        // fall back to fp32 weight [K * M]
+        RawBuffer weight_t;
+        RETURN_ON_NEQ(DequantizeWeightOnly(layer_res->weight, w_scale, M, K, bits, group, weight_t), TNN_OK);
+        RawBuffer weight_f32(K * M * sizeof(float));
+        auto src = weight_t.force_to<float *>();
+        auto dst = weight_f32.force_to<float *>();
+        for (int k = 0; k < K; k++) {
+            for (int m = 0; m < M; m++) {
+                dst[k * M + m] = src[m * K + k];
+            }
+        }
+        weight_f32.SetDataType(DATA_TYPE_FLOAT);
+        buffer_weight_ = weight_f32;
+        return TNN_OK;
+    }
+
+    if (layer_param->dynamic_quant > 0 && bits == 8 && group == 0) {
+        RawBuffer temp_buffer(ROUND_UP(M, 4) * X86DynamicQuantRowBytes(K));
+        X86DynamicQuantPackWeight(temp_buffer.force_to<int8_t *>(), layer_res->weight.force_to<int8_t *>(), M, K);
+        RawBuffer temp_scale(M * sizeof(float));
+        memcpy(temp_scale.force_to<float *>(), w_scale.force_to<float *>(), M * sizeof(float));
+        temp_buffer.SetDataType(DATA_TYPE_INT8);
+        temp_scale.SetDataType(DATA_TYPE_FLOAT);
+        buffer_weight_       = temp_buffer;
+        buffer_weight_scale_ = temp_scale;
+        weight_quant_        = true;
+        dynamic_quant_       = true;
+        return TNN_OK;
+    }
+
+    RawBuffer temp_buffer(X86WeightQuantPackedBytes(M, K, bits, pack));
+    RawBuffer temp_scale(X86WeightQuantPackedScaleCount(M, K, group, pack) * sizeof(float));
+    X86WeightQuantPack(temp_buffer.force_to<int8_t *>(), temp_scale.force_to<float *>(),
+                       layer_res->weight.force_to<int8_t *>(), w_scale.force_to<float *>(), M, K, bits, group, pack);
+    temp_buffer.SetDataType(DATA_TYPE_INT8);
+    temp_scale.SetDataType(DATA_TYPE_FLOAT);
+    buffer_weight_       = temp_buffer;
+    buffer_weight_scale_ = temp_scale;
+    weight_quant_        = true;
+
+    return TNN_OK;
+}
+
+Status X86MatMulLayerAcc::DoForwardWeightQuant(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param  = dynamic_cast<MatMulLayerParam *>(param_);
+    auto a_dims = inputs[0]->GetBlobDesc().dims;
+    // weight is 2-dim, so all the batches of A can be merged
+    int K       = a_dims[a_dims.size() - 1];
+    int N       = DimsVectorUtils::Count(a_dims) / K;
+    int M       = DimsVectorUtils::Count(outputs[0]->GetBlobDesc().dims) / N;
+    int bits    = param->weight_quant_bits;
+    int group   = param->weight_quant_group;
+
+    auto matrix_a = static_cast<float *>(inputs[0]->GetHandle().base);
+    auto matrix_c = static_cast<float *>(outputs[0]->GetHandle().base);
+    auto weight   = buffer_weight_.force_to<int8_t *>();
+    auto scale    = buffer_weight_scale_.force_to<float *>();
+
+    // few rows of A: read the quantized weight directly instead of dequantizing it into gemm blocks
+    if (N <= 4) {
+        auto X86WeightQuantSgemvFunc = X86WeightQuantSgemv<Float4, 4>;
+        if (arch_ == avx2) {
+            X86WeightQuantSgemvFunc = X86WeightQuantSgemv<Float8, 8>;
+        }
+        RawBuffer zero_bias(M * sizeof(float));
+        X86WeightQuantSgemvFunc(matrix_c, M, matrix_a, K, weight, scale, zero_bias.force_to<float *>(), N, M, K,
+                                bits, group);
+        return TNN_OK;
+    }
+
+    auto X86WeightQuantSgemmFunc = X86WeightQuantSgemm<Float4, 4>;
+    if (arch_ == avx2) {
+        X86WeightQuantSgemmFunc = X86WeightQuantSgemm<Float8, 8>;
+    }
+    size_t workspace_size = X86WeightQuantSgemmWorkspaceSize(N, conv_gemm_conf_);
+    float *workspace = reinterpret_cast<float *>(context_->GetSharedWorkSpace(workspace_size));
+
+    RawBuffer fake_bias(N * sizeof(float));
+    // row major A[N * K] * B[K * M] = C[N * M]
+    // equals to
+    // col major B^T[M * K] * A[K * N] = C[M * N]
+    X86WeightQuantSgemmFunc(M, N, K, weight, scale, bits, group, matrix_a, K, matrix_c, M,
+                            fake_bias.force_to<float *>(), ActivationType_None, workspace, conv_gemm_conf_);
+    return TNN_OK;
+}
+
+Status X86MatMulLayerAcc::DoForwardDynamicQuant(const std::vector<Blob *> &inputs,
+                                                const std::vector<Blob *> &outputs) {
+    auto param   = dynamic_cast<MatMulLayerParam *>(param_);
+    auto a_dims  = inputs[0]->GetBlobDesc().dims;
+    int K        = a_dims[a_dims.size() - 1];
+    int N        = DimsVectorUtils::Count(a_dims) / K;
+    int M        = DimsVectorUtils::Count(outputs[0]->GetBlobDesc().dims) / N;
+    bool per_row = param->dynamic_quant == 2;
+
+    auto X86DynamicQuantizeFunc  = X86DynamicQuantize<Float4, 4>;
+    auto X86DynamicQuantGemmFunc = X86SSEDynamicQuantGemm;
+#ifdef __AVX2__
+    if (arch_ == avx2) {
+        X86DynamicQuantizeFunc  = X86DynamicQuantize<Float8, 8>;
+        X86DynamicQuantGemmFunc = X86AVXDynamicQuantGemm;
+    }
+#endif
+
+    // quantized A and its scales
+    size_t src_bytes      = ROUND_UP(N * X86DynamicQuantRowBytes(K), 32);
+    size_t workspace_size = src_bytes + N * sizeof(float);
+    int8_t *workspace     = reinterpret_cast<int8_t *>(context_->GetSharedWorkSpace(workspace_size));
+    float *src_scale      = reinterpret_cast<float *>(workspace + src_bytes);
+
+    X86DynamicQuantizeFunc(workspace, src_scale, static_cast<float *>(inputs[0]->GetHandle().base), N, K, per_row);
+    X86DynamicQuantGemmFunc(static_cast<float *>(outputs[0]->GetHandle().base), M, workspace, src_scale, per_row,
+                            buffer_weight_.force_to<int8_t *>(), buffer_weight_scale_.force_to<float *>(), nullptr,
+                            N, M, K);
+    return TNN_OK;
+}
+
 Status X86MatMulLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto param               = dynamic_cast<MatMulLayerParam *>(param_);
     auto resource            = dynamic_cast<MatMulLayerResource *>(resource_);
@@ -33,6 +186,12 @@ Status X86MatMulLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std
     }
     DataType data_type       = inputs[0]->GetBlobDesc().data_type;
     auto matrix_c_dims       = outputs[0]->GetBlobDesc().dims;
+    if (data_type == DATA_TYPE_FLOAT && dynamic_quant_) {
+        return DoForwardDynamicQuant(inputs, outputs);
+    }
+    if (data_type == DATA_TYPE_FLOAT && weight_quant_) {
+        return DoForwardWeightQuant(inputs, outputs);
+    }
     if (data_type == DATA_TYPE_FLOAT) {
         float *matrix_a;
         float *matrix_b;
@@ -41,7 +200,9 @@ Status X86MatMulLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std
             matrix_a = static_cast<float *>(inputs[0]->GetHandle().base);
             matrix_b = static_cast<float *>(inputs[1]->GetHandle().base);
         } else {
-            auto weight = resource->weight.force_to<float *>();
+            // weight-only quantized weight which the kernels can not run is dequantized at Init
+            auto weight = buffer_weight_.GetBytesSize() > 0 ? buffer_weight_.force_to<float *>()
+                                                             : resource->weight.force_to<float *>();
             matrix_a    = param->weight_position == 0 ? weight : static_cast<float *>(inputs[0]->GetHandle().base);
             matrix_b    = param->weight_position == 1 ? weight : static_cast<float *>(inputs[0]->GetHandle().base);
         }
@@ -79,8 +240,10 @@ Status X86MatMulLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std
             // row major A[N * K] * B[K * M] = C[N * M]
             // equals to
             // col major B[M * K] * A[K * N] = C[M * N]
-            conv_sgemm_nn_col_major(M, N, K, b_ptr, M, a_ptr, K, c_ptr, M,
-                fake_bias_ptr, ActivationType_None, workspace, conv_gemm_conf_);
+            // a blob holding A^T or B^T is read transposed by the packing of the gemm
+            conv_sgemm_col_major(param->transpose_b, param->transpose_a, M, N, K, b_ptr,
+                                 param->transpose_b ? K : M, a_ptr, param->transpose_a ? N : K, c_ptr, M,
+                                 fake_bias_ptr, ActivationType_None, workspace, conv_gemm_conf_);
         }
     }
 
@@ -23,10 +23,21 @@ class X86MatMulLayerAcc : public X86LayerAcc {
 public:
     virtual ~X86MatMulLayerAcc();
 
+    Status Init(Context *context, LayerParam *param, LayerResource *resource, const std::vector<Blob *> &inputs,
+                const std::vector<Blob *> &outputs) override;
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
 
 protected:
+    Status DoForwardWeightQuant(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+    Status DoForwardDynamicQuant(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
     conv_gemm_config<float, float, float> conv_gemm_conf_;
+    // packed weight-only quantized weight and its scales
+    RawBuffer buffer_weight_;
+    RawBuffer buffer_weight_scale_;
+    bool weight_quant_ = false;
+    // int8 weight with int8 input quantized at runtime
+    bool dynamic_quant_ = false;
 };
 
 }  // namespace TNN_NS
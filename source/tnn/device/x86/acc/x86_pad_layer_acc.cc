@@ -12,8 +12,11 @@
 // CONDITIONS OF ANY KIND, either express or implied. See the License for the
 // specific language governing permissions and limitations under the License.
 
+#include <algorithm>
+
 #include "tnn/device/x86/acc/x86_layer_acc.h"
 #include "tnn/device/x86/x86_device.h"
+#include "tnn/utils/omp_utils.h"
 
 namespace TNN_NS {
 
@@ -41,36 +44,28 @@ Status X86_CONST_PAD(float *input_data, float *output_data, const int batch,
     int wb_border = pad_l;
     int we_border = pad_l + input_width;
 
-    for (int n = 0; n < batch; n++) {
-        auto output_data_ptr = output_data + n * output_channel * output_height * output_width;
-        for (int idx = 0; idx < cb_border * output_height * output_width; idx++) { // c_b
-            output_data_ptr[idx] = value;
-        }
-        output_data_ptr += cb_border * output_height * output_width;
-        for (int c = cb_border; c < ce_border; c++) {
-            auto input_data_ptr = input_data + (n * input_channel + c - cb_border) * input_height * input_width;
-            for (int h = 0; h < hb_border * output_width; h++) { // h_b
-                output_data_ptr[h] = value;
-            }
-            for (int h = hb_border; h < he_border; h++) { // h_center
-                for (int w = 0; w < wb_border; w++) { // w_b
-                    output_data_ptr[h * output_width + w] = value;
-                }
-                memcpy(output_data_ptr + h * output_width + wb_border, 
-                        input_data_ptr + (h - hb_border) * input_width,
-                        input_width * sizeof(float));
-                for (int w = we_border; w < output_width; w++) { // w_e
-                    output_data_ptr[h * output_width + w] = value;
-                }
-            }
-            for (int h = he_border * output_width; h < output_height * output_width; h++) { // h_e
-                output_data_ptr[h] = value;
-            }
-            output_data_ptr += output_height * output_width;
+    const int output_area = output_height * output_width;
+
+    // one plane of the output per task, planes in the channel pads are filled with value
+    OMP_PARALLEL_FOR_
+    for (int nc = 0; nc < batch * output_channel; nc++) {
+        const int n          = nc / output_channel;
+        const int c          = nc % output_channel;
+        auto output_data_ptr = output_data + nc * output_area;
+        if (c < cb_border || c >= ce_border) {
+            std::fill(output_data_ptr, output_data_ptr + output_area, value);
+            continue;
         }
-        for (int idx = 0; idx < pad_c_e * output_height * output_width; idx++) { // c_e
-            output_data_ptr[idx] = value;
+        auto input_data_ptr = input_data + (n * input_channel + c - cb_border) * input_height * input_width;
+        std::fill(output_data_ptr, output_data_ptr + hb_border * output_width, value);  // h_b
+        for (int h = hb_border; h < he_border; h++) {                                   // h_center
+            auto output_row = output_data_ptr + h * output_width;
+            std::fill(output_row, output_row + wb_border, value);  // w_b
+            memcpy(output_row + wb_border, input_data_ptr + (h - hb_border) * input_width,
+                   input_width * sizeof(float));
+            std::fill(output_row + we_border, output_row + output_width, value);  // w_e
         }
+        std::fill(output_data_ptr + he_border * output_width, output_data_ptr + output_area, value);  // h_e
     }
 
     return TNN_OK;
@@ -82,6 +77,7 @@ Status X86_REFELCT_PAD(float *input_data, float *output_data, const int batch,
                        PadLayerParam* layer_param) {
     GetPadCommonParams;
 
+    OMP_PARALLEL_FOR_
     for (int c = 0; c < batch * output_channel; c++) {
         auto input_data_ptr = input_data + c * input_height * input_width;
         auto output_data_ptr = output_data + c * output_height * output_width;
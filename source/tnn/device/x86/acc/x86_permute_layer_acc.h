@@ -24,28 +24,6 @@ class X86PermuteLayerAcc : public X86LayerAcc {
     virtual ~X86PermuteLayerAcc();
 
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
-
-private:
-    /**
-     * @brief Compute the volume of a slice; i.e., the product of dimensions
-     *        among a range of axes.
-     *
-     * @param dimes the dimensions
-     *
-     * @param start_axis The first axis to include in the slice.
-     *
-     */
-    inline int count(std::vector<int> dimes, int start_axis) const {
-        const int end_axis = int(dimes.size());
-        ASSERT(start_axis <= end_axis);
-        ASSERT(start_axis >= 0);
-        ASSERT(end_axis >= 0);
-        int count = 1;
-        for (int i = start_axis; i < end_axis; ++i) {
-            count *= dimes[i];
-        }
-        return count;
-    };
 };
 
 }  // namespace TNN_NS
@@ -12,6 +12,7 @@
 // CONDITIONS OF ANY KIND, either express or implied. See the License for the
 // specific language governing permissions and limitations under the License.
 
+#include "tnn/device/x86/acc/compute/x86_compute_copy.h"
 #include "tnn/device/x86/acc/x86_layer_acc.h"
 #include "tnn/utils/dims_vector_utils.h"
 
@@ -33,22 +34,12 @@ Status X86PixelShuffleLayerAcc::DoForward(const std::vector<Blob *> &inputs, con
     if (input_blob->GetBlobDesc().data_type == DATA_TYPE_FLOAT) {
         auto input_prt  = static_cast<float *>(input_blob->GetHandle().base);
         auto output_ptr = static_cast<float *>(output_blob->GetHandle().base);
-        for (int s = 0; s < slice_size; ++s) {
-            for (int i = 0; i < upscale_factor; ++i) {
-                for (int j = 0; j < upscale_factor; ++j) {
-                    for (int h = 0; h < input_h; ++h) {
-                        for (int w = 0; w < input_w; ++w) {
-                            output_ptr[s * input_h * upscale_factor * input_w * upscale_factor +
-                                       h * upscale_factor * input_w * upscale_factor + i * input_w * upscale_factor +
-                                       w * upscale_factor + j] =
-                                input_prt[s * upscale_factor * upscale_factor * input_h * input_w +
-                                          i * upscale_factor * input_h * input_w + j * input_h * input_w + h * input_w +
-                                          w];
-                        }
-                    }
-                }
-            }
-        }
+        // output [s][h][i][w][j] is input [s][i][j][h][w]
+        const long r     = upscale_factor;
+        const long plane = (long)input_h * input_w;
+        DimsVector dims  = {slice_size, input_h, upscale_factor, input_w, upscale_factor};
+        X86StridedCopy(output_ptr, X86DenseStrides(dims), input_prt, {r * r * plane, input_w, r * plane, 1, plane},
+                       dims, sizeof(float));
     }
     return TNN_OK;
 }
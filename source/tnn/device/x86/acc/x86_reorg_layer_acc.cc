@@ -14,9 +14,9 @@
 
 #include <cmath>
 
+#include "tnn/device/x86/acc/compute/x86_compute_copy.h"
 #include "tnn/device/x86/acc/x86_layer_acc.h"
 #include "tnn/utils/dims_vector_utils.h"
-#include "tnn/utils/naive_compute.h"
 
 namespace TNN_NS {
 
@@ -32,23 +32,39 @@ Status X86ReorgLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std:
     int forward = layer_param->forward;
     int mode    = layer_param->mode;
 
+    if (mode != 0 && mode != 1) {
+        LOGE("Error: unsupported reorg mode %d\n", mode);
+        return Status(TNNERR_PARAM_ERR, "Error: unsupported reorg mode");
+    }
+
     if (input_blob->GetBlobDesc().data_type == DATA_TYPE_FLOAT) {
+        // the dims of the depth tensor, the input of forward and the output of backward
+        DimsVector dims    = forward ? input_blob->GetBlobDesc().dims : output_blob->GetBlobDesc().dims;
+        const long batch   = dims[0];
+        const long channel = dims[1];
+        const long height  = dims[2];
+        const long width   = dims[3];
+        const long out_c   = channel / (stride * stride);
+        const long area    = height * width;
+
+        // the depth and the space tensor are both indexed by [n][c2][h][sh][w][sw], the channel of the depth
+        // tensor is sh * stride * out_c + sw * out_c + c2 in DCR mode and c2 * stride * stride + sh * stride + sw
+        // in CRD mode
+        DimsVector index_dims           = {(int)batch, (int)out_c, (int)height, stride, (int)width, stride};
+        std::vector<long> space_strides = X86DenseStrides(index_dims);
+        std::vector<long> depth_strides;
+        if (mode == 0) {
+            depth_strides = {channel * area, area, width, stride * out_c * area, 1, out_c * area};
+        } else {
+            depth_strides = {channel * area, stride * stride * area, width, stride * area, 1, area};
+        }
+
         float *bottom_data = static_cast<float *>(input_blob->GetHandle().base);
         float *top_data    = static_cast<float *>(output_blob->GetHandle().base);
         if (forward) {
-            DimsVector input_dims = input_blob->GetBlobDesc().dims;
-            int batch             = input_dims[0];
-            int channel           = input_dims[1];
-            int height            = input_dims[2];
-            int width             = input_dims[3];
-            NaiveReorg(bottom_data, width, height, channel, batch, stride, forward, mode, top_data);
+            X86StridedCopy(top_data, space_strides, bottom_data, depth_strides, index_dims, sizeof(float));
         } else {
-            DimsVector output_dims = output_blob->GetBlobDesc().dims;
-            int batch              = output_dims[0];
-            int channel            = output_dims[1];
-            int height             = output_dims[2];
-            int width              = output_dims[3];
-            NaiveReorg(bottom_data, width, height, channel, batch, stride, forward, mode, top_data);
+            X86StridedCopy(top_data, depth_strides, bottom_data, space_strides, index_dims, sizeof(float));
         }
     }
 
@@ -15,6 +15,7 @@
 #include "tnn/core/macro.h"
 #include "tnn/core/blob_int8.h"
 #include "tnn/device/x86/x86_blob_converter.h"
+#include "tnn/device/x86/x86_blob_preprocess.h"
 #include "tnn/device/x86/x86_mat_util.h"
 #include "tnn/utils/data_format_converter.h"
 #include "tnn/utils/naive_compute.h"
@@ -136,6 +137,39 @@ Status X86BlobConverterAcc::ConvertFromMatAsync(Mat &image, MatConvertParam para
     return ret;
 }
 
+Status X86BlobConverterAcc::ConvertFromMatWithPreprocess(Mat &image, MatPreprocessParam preprocess,
+                                                         MatConvertParam param, void *command_queue) {
+    if (blob_ == nullptr) {
+        return Status(TNNERR_NULL_PARAM, "input/output blob_ is null");
+    }
+    auto desc = blob_->GetBlobDesc();
+    if (!X86PreprocessSupported(image, preprocess, desc)) {
+        return BlobConverterAcc::ConvertFromMatWithPreprocess(image, preprocess, param, command_queue);
+    }
+
+    const int channel = desc.dims[1];
+    std::vector<float> scale(param.scale.begin(), param.scale.begin() + channel);
+    std::vector<float> bias(param.bias.begin(), param.bias.begin() + channel);
+    if (desc.data_type == DATA_TYPE_INT8) {
+        auto scale_handle = reinterpret_cast<BlobInt8 *>(blob_)->GetIntResource()->scale_handle;
+        auto scale_data   = scale_handle.force_to<float *>();
+        auto scale_count  = scale_handle.GetDataCount();
+        for (int i = 0; i < channel; i++) {
+            auto scale_idx = scale_count == 1 ? 0 : i;
+            if (scale_data[scale_idx] != 0) {
+                scale[i] = scale[i] / scale_data[scale_idx];
+                bias[i]  = bias[i] / scale_data[scale_idx];
+            } else {
+                scale[i] = 0;
+                bias[i]  = 0;
+            }
+        }
+    }
+
+    return X86PreprocessToBlob(image, preprocess, param.reverse_channel, scale.data(), bias.data(), desc,
+                               blob_->GetHandle().base);
+}
+
 Status X86BlobConverterAcc::ConvertToMat(Mat &image, MatConvertParam param, void *command_queue) {
     return ConvertToMatAsync(image, param, command_queue);
 }
@@ -0,0 +1,443 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/device/x86/x86_blob_preprocess.h"
+
+#include <cmath>
+#include <vector>
+
+#include "tnn/device/x86/acc/Float4.h"
+#include "tnn/utils/mat_converter_utils.h"
+#include "tnn/utils/naive_compute.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+// value = (1 - weight) * pixel[pos0] + weight * pixel[pos1]
+struct SamplePos {
+    int pos0;
+    int pos1;
+    float weight;
+};
+
+// half pixel centers clamped to the region, as the resize of MatUtils
+static void ResizeSamplePos(int dst_len, int src_len, int offset, InterpType type, std::vector<SamplePos>& sample) {
+    sample.resize(dst_len);
+    const double scale = (double)src_len / dst_len;
+    for (int i = 0; i < dst_len; i++) {
+        float pos_f = (float)((i + 0.5) * scale - 0.5);
+        int pos_i   = static_cast<int>(floor(pos_f));
+        float rat_f = pos_f - pos_i;
+        if (pos_i < 0) {
+            pos_i = 0;
+            rat_f = 0.f;
+        }
+        if (pos_i >= src_len - 1) {
+            pos_i = src_len - 1;
+            rat_f = 0.f;
+        }
+        if (type == INTERP_TYPE_NEAREST) {
+            pos_i = rat_f <= 0.5f ? pos_i : pos_i + 1;
+            rat_f = 0.f;
+        }
+        sample[i].pos0   = offset + pos_i;
+        sample[i].pos1   = offset + MIN(pos_i + 1, src_len - 1);
+        sample[i].weight = rat_f;
+    }
+}
+
+// the pixel loads write the channels of a pixel with a stride of the plane size
+template <int channel>
+struct PackedPixel {
+    static const int kChannel = channel;
+    static inline void Load(const uint8_t* image, int width, int height, int x, int y, float* v, int stride) {
+        const uint8_t* p = image + ((long)y * width + x) * channel;
+        for (int c = 0; c < channel; c++) {
+            v[c * stride] = p[c];
+        }
+    }
+    static inline void Convert(float* row, int width) {}
+    static inline long BatchStride(int width, int height) {
+        return (long)width * height * channel;
+    }
+};
+
+// yuv of one pixel of a nv12 or nv21 image, converted to bgr after the sampling as the staged path does
+template <bool is_nv12>
+struct YUVPixel {
+    static const int kChannel = 3;
+    static inline void Load(const uint8_t* image, int width, int height, int x, int y, float* v, int stride) {
+        const uint8_t* uv = image + (long)width * height + (long)(y >> 1) * width + (x & ~1);
+        v[0]              = image[(long)y * width + x];
+        v[stride]         = is_nv12 ? uv[0] : uv[1];
+        v[2 * stride]     = is_nv12 ? uv[1] : uv[0];
+    }
+    // the formula of the x86 CvtColor in float
+    static inline void Convert(float* row, int width) {
+        float* p0 = row;
+        float* p1 = row + width;
+        float* p2 = row + 2 * width;
+        int x     = 0;
+        for (; x + 4 <= width; x += 4) {
+            const Float4 yy = Float4::mul(Float4::sub(Float4::loadu(p0 + x), Float4(16.f)), Float4(1.164f));
+            const Float4 u  = Float4::sub(Float4::loadu(p1 + x), Float4(128.f));
+            const Float4 w  = Float4::sub(Float4::loadu(p2 + x), Float4(128.f));
+            Float4 b = yy, g = yy, r = yy;
+            Float4::mla(b, u, Float4(2.018f));
+            Float4::mls(g, w, Float4(0.813f));
+            Float4::mls(g, u, Float4(0.391f));
+            Float4::mla(r, w, Float4(1.596f));
+            Float4::saveu(p0 + x, Float4::min(Float4::max(b, Float4(0.f)), Float4(255.f)));
+            Float4::saveu(p1 + x, Float4::min(Float4::max(g, Float4(0.f)), Float4(255.f)));
+            Float4::saveu(p2 + x, Float4::min(Float4::max(r, Float4(0.f)), Float4(255.f)));
+        }
+        for (; x < width; x++) {
+            const float yy = 1.164f * (p0[x] - 16);
+            const float u  = p1[x] - 128.f;
+            const float w  = p2[x] - 128.f;
+            p0[x]          = MIN(MAX(yy + 2.018f * u, 0.f), 255.f);
+            p1[x]          = MIN(MAX(yy - 0.813f * w - 0.391f * u, 0.f), 255.f);
+            p2[x]          = MIN(MAX(yy + 1.596f * w, 0.f), 255.f);
+        }
+    }
+    static inline long BatchStride(int width, int height) {
+        return (long)width * height * 3 / 2;
+    }
+};
+
+struct PreprocessArgs {
+    int batch;
+    int channel;
+    int height;
+    int width;
+    int src_w;
+    int src_h;
+    bool reverse_channel;
+    bool int8;
+    const float* scale;
+    const float* bias;
+    void* dst;
+};
+
+// the pixels around the samples of a row, planes [src channel][width] of the top left, top right, bottom left and
+// bottom right neighbors, and the weights of the right and bottom ones
+struct RowNeighbors {
+    float* v[4];
+    float* wx;
+    float* wy;
+};
+
+// a sample on the top left neighbor only, the others are set to it for the blend
+static inline void SetSingleSample(const RowNeighbors& nb, int channel, int width, int x) {
+    for (int c = 0; c < channel; c++) {
+        const int i = c * width + x;
+        nb.v[1][i] = nb.v[2][i] = nb.v[3][i] = nb.v[0][i];
+    }
+    nb.wx[x] = 0.f;
+    nb.wy[x] = 0.f;
+}
+
+// neighbors of the row of the crop resized to the blob size
+template <typename Pixel>
+static void ResizeRow(const uint8_t* image, const PreprocessArgs& args, const SamplePos& sy,
+                      const std::vector<SamplePos>& sx, const RowNeighbors& nb) {
+    const int width = args.width;
+    for (int x = 0; x < width; x++) {
+        const auto& s = sx[x];
+        Pixel::Load(image, args.src_w, args.src_h, s.pos0, sy.pos0, nb.v[0] + x, width);
+        if (s.weight == 0.f && sy.weight == 0.f) {
+            SetSingleSample(nb, Pixel::kChannel, width, x);
+            continue;
+        }
+        Pixel::Load(image, args.src_w, args.src_h, s.pos1, sy.pos0, nb.v[1] + x, width);
+        Pixel::Load(image, args.src_w, args.src_h, s.pos0, sy.pos1, nb.v[2] + x, width);
+        Pixel::Load(image, args.src_w, args.src_h, s.pos1, sy.pos1, nb.v[3] + x, width);
+        nb.wx[x] = s.weight;
+        nb.wy[x] = sy.weight;
+    }
+}
+
+template <typename Pixel>
+static inline void LoadWithBorder(const uint8_t* image, const PreprocessArgs& args, const WarpAffineParam& warp,
+                                  int x, int y, float* v, int stride) {
+    if (x < 0 || y < 0 || x >= args.src_w || y >= args.src_h) {
+        if (warp.border_type == BORDER_TYPE_CONSTANT) {
+            for (int c = 0; c < Pixel::kChannel; c++) {
+                v[c * stride] = warp.border_val;
+            }
+            return;
+        }
+        x = MIN(MAX(x, 0), args.src_w - 1);
+        y = MIN(MAX(y, 0), args.src_h - 1);
+    }
+    Pixel::Load(image, args.src_w, args.src_h, x, y, v, stride);
+}
+
+// round(v * 1024) as the staged WarpAffineBilinear does
+static inline int WarpFixedPoint(double v) {
+    v *= 1024;
+    return (int)(v + (v >= 0 ? 0.5 : -0.5));
+}
+
+// the x and y terms of the inverse transform in fixed point of 10 fraction bits, adelta [dst_w][2] and bdelta
+// [dst_h][2]
+static void WarpAffineDeltas(const double* m, int width, int height, std::vector<int>& adelta,
+                             std::vector<int>& bdelta) {
+    adelta.resize(width * 2);
+    bdelta.resize(height * 2);
+    for (int x = 0; x < width; x++) {
+        adelta[x * 2]     = WarpFixedPoint(m[0] * x);
+        adelta[x * 2 + 1] = WarpFixedPoint(m[3] * x);
+    }
+    for (int y = 0; y < height; y++) {
+        bdelta[y * 2]     = WarpFixedPoint(m[1] * y + m[2]);
+        bdelta[y * 2 + 1] = WarpFixedPoint(m[4] * y + m[5]);
+    }
+}
+
+// neighbors of the row of the image sampled through the inverse of the affine transform. the sample positions are
+// rounded to the 1/32 pixel grid of the staged path and OpenCV
+template <typename Pixel>
+static void WarpAffineRow(const uint8_t* image, const PreprocessArgs& args, const WarpAffineParam& warp,
+                          const int* adelta, const int* bdelta, const RowNeighbors& nb) {
+    const int width = args.width;
+    for (int x = 0; x < width; x++) {
+        const int sx = adelta[x * 2] + bdelta[0] + 16;
+        const int sy = adelta[x * 2 + 1] + bdelta[1] + 16;
+        const int x0 = sx >> 10;
+        const int y0 = sy >> 10;
+        const int fx = (sx >> 5) & 31;
+        const int fy = (sy >> 5) & 31;
+        if (warp.interp_type == INTERP_TYPE_NEAREST) {
+            LoadWithBorder<Pixel>(image, args, warp, x0 + (fx >= 16), y0 + (fy >= 16), nb.v[0] + x, width);
+            SetSingleSample(nb, Pixel::kChannel, width, x);
+            continue;
+        }
+        LoadWithBorder<Pixel>(image, args, warp, x0, y0, nb.v[0] + x, width);
+        LoadWithBorder<Pixel>(image, args, warp, x0 + 1, y0, nb.v[1] + x, width);
+        LoadWithBorder<Pixel>(image, args, warp, x0, y0 + 1, nb.v[2] + x, width);
+        LoadWithBorder<Pixel>(image, args, warp, x0 + 1, y0 + 1, nb.v[3] + x, width);
+        nb.wx[x] = fx / 32.f;
+        nb.wy[x] = fy / 32.f;
+    }
+}
+
+// bilinear blend of the neighbors into row [src channel][width]
+static void BlendRow(const RowNeighbors& nb, int channel, int width, float* row) {
+    for (int c = 0; c < channel; c++) {
+        const float* v00 = nb.v[0] + c * width;
+        const float* v01 = nb.v[1] + c * width;
+        const float* v10 = nb.v[2] + c * width;
+        const float* v11 = nb.v[3] + c * width;
+        float* dst       = row + c * width;
+        int x            = 0;
+        for (; x + 4 <= width; x += 4) {
+            const Float4 wx = Float4::loadu(nb.wx + x);
+            Float4 top      = Float4::loadu(v00 + x);
+            Float4 bottom   = Float4::loadu(v10 + x);
+            Float4::mla(top, Float4::sub(Float4::loadu(v01 + x), top), wx);
+            Float4::mla(bottom, Float4::sub(Float4::loadu(v11 + x), bottom), wx);
+            Float4::mla(top, Float4::sub(bottom, top), Float4::loadu(nb.wy + x));
+            Float4::saveu(dst + x, top);
+        }
+        for (; x < width; x++) {
+            const float top    = v00[x] + (v01[x] - v00[x]) * nb.wx[x];
+            const float bottom = v10[x] + (v11[x] - v10[x]) * nb.wx[x];
+            dst[x]             = top + (bottom - top) * nb.wy[x];
+        }
+    }
+}
+
+// scale and bias of the row planes into blob row y of batch n
+static void StoreRow(const float* const* planes, const PreprocessArgs& args, int n, int y) {
+    const int width   = args.width;
+    const int channel = args.channel;
+    if (!args.int8) {
+        for (int c = 0; c < channel; c++) {
+            const float* src = planes[c];
+            float* dst = reinterpret_cast<float*>(args.dst) + (((long)n * channel + c) * args.height + y) * width;
+            const Float4 scale(args.scale[c]);
+            const Float4 bias(args.bias[c]);
+            int x = 0;
+            for (; x + 4 <= width; x += 4) {
+                Float4 v = bias;
+                Float4::mla(v, Float4::loadu(src + x), scale);
+                Float4::saveu(dst + x, v);
+            }
+            for (; x < width; x++) {
+                dst[x] = args.scale[c] * src[x] + args.bias[c];
+            }
+        }
+    } else {
+        const int c_r4 = ROUND_UP(channel, 4);
+        int8_t* dst    = reinterpret_cast<int8_t*>(args.dst) + ((long)n * args.height + y) * width * c_r4;
+        for (int x = 0; x < width; x++) {
+            int c = 0;
+            for (; c < channel; c++) {
+                dst[x * c_r4 + c] = float2int8(args.scale[c] * planes[c][x] + args.bias[c]);
+            }
+            for (; c < c_r4; c++) {
+                dst[x * c_r4 + c] = 0;
+            }
+        }
+    }
+}
+
+template <typename Pixel>
+static void PreprocessImpl(const uint8_t* image, const MatPreprocessParam& preprocess, const PreprocessArgs& args) {
+    const int width   = args.width;
+    const int src_c   = Pixel::kChannel;
+    const bool gray   = args.channel == 1 && src_c > 1;
+    const int b_plane = args.reverse_channel ? 2 : 0;
+    const int r_plane = args.reverse_channel ? 0 : 2;
+
+    std::vector<SamplePos> sx, sy;
+    std::vector<int> adelta, bdelta;
+    if (preprocess.warp_affine) {
+        double m[6];
+        WarpAffineMatrixInverse(preprocess.warp_affine_param.transform, m);
+        WarpAffineDeltas(m, width, args.height, adelta, bdelta);
+    } else {
+        const auto& crop = preprocess.crop;
+        ResizeSamplePos(width, crop.width, crop.top_left_x, preprocess.interp_type, sx);
+        ResizeSamplePos(args.height, crop.height, crop.top_left_y, preprocess.interp_type, sy);
+    }
+
+    // planes of the source channels and one for gray, then the neighbors and their weights
+    const long row_size = (long)(src_c + 1 + 4 * src_c + 2) * width;
+    std::vector<float> row_buffer(row_size * OMP_MAX_THREADS_NUM_);
+    const long batch_stride = Pixel::BatchStride(args.src_w, args.src_h);
+    const int row_count     = args.batch * args.height;
+
+    OMP_PARALLEL_FOR_
+    for (int r = 0; r < row_count; r++) {
+        const int n        = r / args.height;
+        const int y        = r % args.height;
+        const uint8_t* src = image + n * batch_stride;
+        float* row         = row_buffer.data() + OMP_TID_ * row_size;
+
+        RowNeighbors nb;
+        for (int i = 0; i < 4; i++) {
+            nb.v[i] = row + (src_c + 1 + i * src_c) * width;
+        }
+        nb.wx = row + (5 * src_c + 1) * width;
+        nb.wy = nb.wx + width;
+        if (preprocess.warp_affine) {
+            WarpAffineRow<Pixel>(src, args, preprocess.warp_affine_param, adelta.data(), bdelta.data() + y * 2, nb);
+        } else {
+            ResizeRow<Pixel>(src, args, sy[y], sx, nb);
+        }
+        BlendRow(nb, src_c, width, row);
+        Pixel::Convert(row, width);
+
+        const float* planes[4];
+        if (gray) {
+            float* gray_plane = row + src_c * width;
+            const float* b    = row + b_plane * width;
+            const float* g    = row + width;
+            const float* rr   = row + r_plane * width;
+            for (int x = 0; x < width; x++) {
+                gray_plane[x] = 0.114f * b[x] + 0.587f * g[x] + 0.299f * rr[x];
+            }
+            planes[0] = gray_plane;
+        } else {
+            for (int c = 0; c < args.channel; c++) {
+                int plane = c;
+                if (args.reverse_channel && src_c >= 3 && c != 1 && c < 3) {
+                    plane = 2 - c;
+                }
+                planes[c] = row + plane * width;
+            }
+        }
+        StoreRow(planes, args, n, y);
+    }
+}
+
+static int GetImageChannel(MatType mat_type) {
+    switch (mat_type) {
+        case N8UC4:
+            return 4;
+        case N8UC3:
+        case NNV12:
+        case NNV21:
+            return 3;
+        case NGRAY:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+bool X86PreprocessSupported(Mat& image, const MatPreprocessParam& preprocess, const BlobDesc& desc) {
+    if (image.GetDeviceType() != DEVICE_X86 && image.GetDeviceType() != DEVICE_NAIVE) {
+        return false;
+    }
+    if (desc.dims.size() != 4) {
+        return false;
+    }
+    if (!(desc.data_type == DATA_TYPE_FLOAT && desc.data_format == DATA_FORMAT_NCHW) &&
+        desc.data_type != DATA_TYPE_INT8) {
+        return false;
+    }
+    const int src_c   = GetImageChannel(image.GetMatType());
+    const int channel = desc.dims[1];
+    if (src_c == 0 || !(channel == 1 || (src_c > 1 && channel <= src_c))) {
+        return false;
+    }
+    if (preprocess.warp_affine && preprocess.warp_affine_param.border_type != BORDER_TYPE_CONSTANT &&
+        preprocess.warp_affine_param.border_type != BORDER_TYPE_EDGE) {
+        return false;
+    }
+    return true;
+}
+
+Status X86PreprocessToBlob(Mat& image, const MatPreprocessParam& preprocess, bool reverse_channel,
+                           const float* scale, const float* bias, const BlobDesc& desc, void* dst) {
+    PreprocessArgs args;
+    args.batch           = desc.dims[0];
+    args.channel         = desc.dims[1];
+    args.height          = desc.dims[2];
+    args.width           = desc.dims[3];
+    args.src_w           = image.GetWidth();
+    args.src_h           = image.GetHeight();
+    args.reverse_channel = reverse_channel;
+    args.int8            = desc.data_type == DATA_TYPE_INT8;
+    args.scale           = scale;
+    args.bias            = bias;
+    args.dst             = dst;
+
+    auto data = reinterpret_cast<const uint8_t*>(image.GetData());
+    switch (image.GetMatType()) {
+        case N8UC4:
+            PreprocessImpl<PackedPixel<4>>(data, preprocess, args);
+            break;
+        case N8UC3:
+            PreprocessImpl<PackedPixel<3>>(data, preprocess, args);
+            break;
+        case NGRAY:
+            PreprocessImpl<PackedPixel<1>>(data, preprocess, args);
+            break;
+        case NNV12:
+            PreprocessImpl<YUVPixel<true>>(data, preprocess, args);
+            break;
+        case NNV21:
+            PreprocessImpl<YUVPixel<false>>(data, preprocess, args);
+            break;
+        default:
+            return Status(TNNERR_PARAM_ERR, "X86PreprocessToBlob does not support the mat type");
+    }
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,36 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_DEVICE_X86_X86_BLOB_PREPROCESS_H_
+#define TNN_SOURCE_TNN_DEVICE_X86_X86_BLOB_PREPROCESS_H_
+
+#include "tnn/core/blob.h"
+#include "tnn/core/mat.h"
+#include "tnn/core/status.h"
+#include "tnn/utils/blob_converter.h"
+
+namespace TNN_NS {
+
+// @brief whether X86PreprocessToBlob handles the image, the preprocess and the blob
+bool X86PreprocessSupported(Mat& image, const MatPreprocessParam& preprocess, const BlobDesc& desc);
+
+// @brief samples the image into the blob in one pass over the blob rows: crop and resize or warp affine,
+// color conversion and dst = scale * pixel + bias. float blobs are nchw, int8 blobs are nhwc4.
+// crop in preprocess must be resolved to a valid region of the image.
+Status X86PreprocessToBlob(Mat& image, const MatPreprocessParam& preprocess, bool reverse_channel,
+                           const float* scale, const float* bias, const BlobDesc& desc, void* dst);
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_DEVICE_X86_X86_BLOB_PREPROCESS_H_
@@ -13,10 +13,42 @@
 // specific language governing permissions and limitations under the License.
 
 #include "tnn/device/x86/x86_context.h"
+
+#include <fstream>
+
+#include "tnn/device/x86/acc/compute/jit/utils/cpu_isa.h"
+#include "tnn/utils/md5.h"
+#include "tnn/utils/huge_page_utils.h"
+#include "tnn/utils/numa_utils.h"
 #include "tnn/utils/omp_utils.h"
 
 namespace TNN_NS {
 
+std::mutex X86Context::s_tune_mutex_;
+
+// cache file format: map size, then one line of "key value_size value..." for each entry
+static bool LoadTuneCacheFile(const std::string &cache_file, std::map<std::string, std::vector<int>> &tune_map) {
+    std::ifstream cache_stream(cache_file);
+    uint32_t map_size = 0;
+    if (!cache_stream.is_open() || !(cache_stream >> map_size)) {
+        return true;
+    }
+    for (uint32_t i = 0; i < map_size; ++i) {
+        std::string key;
+        uint32_t value_size = 0;
+        cache_stream >> key >> value_size;
+        std::vector<int> value(value_size);
+        for (auto &v : value) {
+            cache_stream >> v;
+        }
+        if (cache_stream.fail()) {
+            return false;
+        }
+        tune_map[key] = value;
+    }
+    return true;
+}
+
 Status X86Context::LoadLibrary(std::vector<std::string> path) {
     return TNN_OK;
 }
@@ -28,6 +60,10 @@ Status X86Context::GetCommandQueue(void** command_queue) {
 Status X86Context::OnInstanceForwardBegin() {
     Context::OnInstanceForwardBegin();
     OMP_SET_THREADS_(GetNumThreads());
+    if (numa_node_ >= 0) {
+        // workspace and blob memory are first touched by threads on the node
+        RETURN_ON_NEQ(NumaBindThreads(numa_node_, GetNumThreads()), TNN_OK);
+    }
     return TNN_OK;
 }
 
@@ -35,6 +71,40 @@ Status X86Context::OnInstanceForwardEnd() {
     return TNN_OK;
 }
 
+Status X86Context::OnInstanceReshapeEnd() {
+    auto cache_file = GetTuneCacheFile();
+    if (cache_file.empty() || tune_map_.size() <= tune_map_saved_size_) {
+        return TNN_OK;
+    }
+
+    std::lock_guard<std::mutex> lock(s_tune_mutex_);
+    // merge the results tuned by other instances since the cache was loaded
+    std::map<std::string, std::vector<int>> saved_map;
+    LoadTuneCacheFile(cache_file, saved_map);
+    for (const auto &iter : tune_map_) {
+        saved_map[iter.first] = iter.second;
+    }
+
+    std::ofstream out_stream(cache_file);
+    if (!out_stream.is_open()) {
+        LOGE("X86Context open tune cache file %s failed\n", cache_file.c_str());
+        return TNN_OK;
+    }
+    out_stream << saved_map.size() << std::endl;
+    for (const auto &iter : saved_map) {
+        out_stream << iter.first << " " << iter.second.size();
+        for (auto v : iter.second) {
+            out_stream << " " << v;
+        }
+        out_stream << std::endl;
+    }
+    if (!out_stream.good()) {
+        LOGE("X86Context write tune cache file %s failed\n", cache_file.c_str());
+    }
+    tune_map_saved_size_ = tune_map_.size();
+    return TNN_OK;
+}
+
 Status X86Context::Synchronize() {
     return TNN_OK;
 }
@@ -53,6 +123,7 @@ void* X86Context::GetSharedWorkSpace(size_t size) {
 }
 
 void* X86Context::GetSharedWorkSpace(size_t size, int index) {
+    HugePageScope huge_page_scope(enable_huge_page_);
     while(work_space_.size() < index + 1) {
         work_space_.push_back(RawBuffer(size, 32));
     }
@@ -62,4 +133,39 @@ void* X86Context::GetSharedWorkSpace(size_t size, int index) {
     return work_space_[index].force_to<void*>();
 }
 
+std::string X86Context::GetTuneCacheFile() {
+    if (cache_path_.empty()) {
+        return "";
+    }
+    // tuned kernels are only valid on the same cpu model, the shapes are part of the keys
+    static std::string cpu_model = md5(cpu_model_name());
+    return cache_path_ + "/tnn_x86_tune_" + cpu_model;
+}
+
+bool X86Context::GetTuneResult(const std::string &key, std::vector<int> &value) {
+    if (!tune_cache_loaded_) {
+        tune_cache_loaded_ = true;
+        auto cache_file    = GetTuneCacheFile();
+        if (!cache_file.empty()) {
+            std::lock_guard<std::mutex> lock(s_tune_mutex_);
+            if (!LoadTuneCacheFile(cache_file, tune_map_)) {
+                LOGE("X86Context tune cache file %s is broken\n", cache_file.c_str());
+                tune_map_.clear();
+            }
+            tune_map_saved_size_ = tune_map_.size();
+        }
+    }
+
+    auto iter = tune_map_.find(key);
+    if (iter == tune_map_.end()) {
+        return false;
+    }
+    value = iter->second;
+    return true;
+}
+
+void X86Context::SetTuneResult(const std::string &key, const std::vector<int> &value) {
+    tune_map_[key] = value;
+}
+
 }  // namespace TNN_NS
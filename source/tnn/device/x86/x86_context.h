@@ -15,6 +15,8 @@
 #ifndef TNN_SOURCE_TNN_DEVICE_X86_X86_CONTEXT_H_
 #define TNN_SOURCE_TNN_DEVICE_X86_X86_CONTEXT_H_
 
+#include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -38,6 +40,9 @@ public:
     // @brief after instance forward
     virtual Status OnInstanceForwardEnd() override;
 
+    // @brief after instance reshape, save the kernels tuned in init and reshape to the cache file
+    virtual Status OnInstanceReshapeEnd() override;
+
     // @brief wait for jobs in the current context to complete
     virtual Status Synchronize() override;
 
@@ -50,9 +55,23 @@ public:
     void* GetSharedWorkSpace(size_t size);
     void* GetSharedWorkSpace(size_t size, int index);
 
+    // @brief get the kernel config tuned for key on this cpu model, the cache file under cache path is
+    // loaded on first use
+    bool GetTuneResult(const std::string &key, std::vector<int> &value);
+
+    // @brief record the kernel config tuned for key
+    void SetTuneResult(const std::string &key, const std::vector<int> &value);
+
 private:
+    std::string GetTuneCacheFile();
+
     int num_threads_ = 1;
     std::vector<RawBuffer> work_space_;
+
+    std::map<std::string, std::vector<int>> tune_map_;
+    bool tune_cache_loaded_ = false;
+    size_t tune_map_saved_size_ = 0;
+    static std::mutex s_tune_mutex_;
 };
 
 }  // namespace TNN_NS
@@ -13,9 +13,14 @@
 // specific language governing permissions and limitations under the License.
 
 #include "tnn/device/x86/x86_device.h"
+
+#include <functional>
+#include <numeric>
+
 #include "tnn/device/x86/x86_context.h"
 #include "tnn/utils/blob_memory_size_utils.h"
 #include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/huge_page_utils.h"
 
 namespace TNN_NS {
 
@@ -24,16 +29,14 @@ X86Device::X86Device(DeviceType device_type) : AbstractDevice(device_type) {}
 X86Device::~X86Device() {}
 
 BlobMemorySizeInfo X86Device::Calculate1DMemorySize(BlobDesc &desc) {
-    BlobMemorySizeInfo info;
-    info.data_type = desc.data_type;
-    int count      = 0;
+    int64_t count = 1;
     if (desc.data_type == DATA_TYPE_INT8) {
-        count = desc.dims[0] * ROUND_UP(desc.dims[1], 4) * DimsVectorUtils::Count(desc.dims, 2);
+        count = (int64_t)desc.dims[0] * ROUND_UP(desc.dims[1], 4);
+        count = std::accumulate(desc.dims.begin() + 2, desc.dims.end(), count, std::multiplies<int64_t>());
     } else {
-        count = DimsVectorUtils::Count(desc.dims);
+        count = std::accumulate(desc.dims.begin(), desc.dims.end(), count, std::multiplies<int64_t>());
     }
-    info.dims.push_back(count);
-    return info;
+    return Get1DBlobMemorySizeInfo(desc.data_type, count);
 }
 
 BlobMemorySizeInfo X86Device::Calculate(BlobDesc &desc) {
@@ -63,7 +66,15 @@ Status X86Device::Allocate(void** handle, MatType mat_type, DimsVector dims) {
 
 Status X86Device::Allocate(void** handle, BlobMemorySizeInfo& size_info) {
     if (handle) {
-        *handle = malloc(GetBlobMemoryBytesSize(size_info));
+        auto size = GetBlobMemoryBytesSize(size_info);
+        if (size < 0) {
+            return Status(TNNERR_PARAM_ERR, "X86Device::Allocate malloc bytes size < 0");
+        }
+        *handle = HugePageMalloc(size);
+        if (*handle == nullptr && size > 0) {
+            LOGE("X86Device::Allocate failed to malloc %lld bytes\n", (long long)size);
+            return Status(TNNERR_OUTOFMEMORY, "X86Device::Allocate malloc failed");
+        }
     }
     return TNN_OK;
 }
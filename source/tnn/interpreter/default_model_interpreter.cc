@@ -41,4 +41,8 @@ std::vector<std::string> DefaultModelInterpreter::GetParamsMd5() {
     return params_md5_;
 }
 
+Status DefaultModelInterpreter::ReplaceModel(std::string &model_content) {
+    return Status(TNNERR_MODEL_ERR, "the model interpreter does not support replacing the model");
+}
+
 }  // namespace TNN_NS
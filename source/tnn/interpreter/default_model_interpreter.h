@@ -44,6 +44,12 @@ public:
     //@brief GetParamsMd5 return md5 string of params string
     std::vector<std::string> GetParamsMd5();
 
+    // @brief replace the weights with the ones of another model of the same structure. the resources of
+    // every layer and the constants must have the same layout as the ones they replace, the interpreter
+    // is left unchanged otherwise
+    // @param model_content model contents in the format of the interpreter
+    virtual Status ReplaceModel(std::string &model_content);
+
 protected:
     std::vector<std::string> params_md5_;
     NetStructure *net_structure_;
@@ -58,6 +58,7 @@ enum ActivationType {
     ActivationType_ReLU        = 0x0001,
     ActivationType_ReLU6       = 0x0002,
     ActivationType_SIGMOID_MUL = 0x0100,
+    ActivationType_GELU        = 0x0200,
 };
 
 enum FusionType {
@@ -79,16 +80,21 @@ struct InstanceNormLayerParam : public LayerParam {
     PARAM_COPY(InstanceNormLayerParam)
 };
 
+// inputs[3], if present, is a residual added to inputs[0] before the normalization and
+// outputs[1], if present, keeps the sum. activation_type is set by net_optimizer_fuse_norm.
 struct GroupNormLayerParam : public LayerParam {
-    int group = 0;
-    float eps = 1e-5f;
+    int group           = 0;
+    float eps           = 1e-5f;
+    int activation_type = ActivationType_None;
 
     PARAM_COPY(GroupNormLayerParam)
 };
 
+// residual and activation as in GroupNormLayerParam
 struct LayerNormLayerParam : public LayerParam {
     int reduce_dims_size = 0;
     float eps            = 1e-5f;
+    int activation_type  = ActivationType_None;
 
     PARAM_COPY(LayerNormLayerParam)
 };
@@ -132,6 +138,14 @@ struct ConvLayerParam : public LayerParam {
     PARAM_COPY(ConvLayerParam)
 };
 
+// depthwise conv followed by a pointwise conv reading its output only, set by the optimizer
+struct ConvDwPwFusedLayerParam : public LayerParam {
+    ConvLayerParam dw_param;
+    ConvLayerParam pw_param;
+
+    PARAM_COPY(ConvDwPwFusedLayerParam)
+};
+
 struct PadLayerParam : public LayerParam {
     // for old Pad the order is  [w_begin, w_end, h_begin, h_end, c_begin, c_end]
     // for PadV2 the order correspand to input dims, same as ONNX, like [x1_begin, x2_begin,...,x1_end, x2_end,...]
@@ -321,6 +335,13 @@ struct InnerProductLayerParam : public LayerParam {
     int has_bias   = 0;
     int transpose  = 0;
     int axis       = 0;
+    // weight-only quantization, 0: fp32 weights, 8: int8, 4: int4
+    int weight_quant_bits = 0;
+    // input channels sharing one weight scale, 0: one scale per output channel
+    int weight_quant_group = 0;
+    // int8 weights with group 0 only, quantize the input to int8 at runtime and run an int8 gemm,
+    // 0: off, 1: one scale for the whole input, 2: one scale per input row
+    int dynamic_quant = 0;
 
     PARAM_COPY(InnerProductLayerParam)
 };
@@ -606,10 +627,23 @@ struct LSTMONNXLayerParam : public LayerParam {
     int hidden_size      = 0;
     // 0: forward 1:reverse 2:bidirection
     int direction = 0;
+    // weight-only quantization of W and R, see InnerProductLayerParam
+    int weight_quant_bits  = 0;
+    int weight_quant_group = 0;
 
     PARAM_COPY(LSTMONNXLayerParam)
 };
 
+struct GRUONNXLayerParam : public LayerParam {
+    int hidden_size = 0;
+    // 0: forward 1:reverse 2:bidirection
+    int direction = 0;
+    // 1: apply the reset gate after the recurrence gemm of the hidden gate, see onnx GRU
+    int linear_before_reset = 0;
+
+    PARAM_COPY(GRUONNXLayerParam)
+};
+
 struct ExpandLayerParam : public LayerParam {
     std::vector<int> shape;
 
@@ -621,6 +655,14 @@ struct MatMulLayerParam : public LayerParam {
     DimsVector matrix_a_dims;
     DimsVector matrix_b_dims;
     int axis = 0;
+    // weight-only quantization of the constant weight, see InnerProductLayerParam
+    int weight_quant_bits  = 0;
+    int weight_quant_group = 0;
+    int dynamic_quant      = 0;
+    // the input blob holds the operand with its last two dims swapped, set by the permute fusion of the
+    // optimizer, matrix_a_dims and matrix_b_dims are the dims of the operands after the swap
+    bool transpose_a = false;
+    bool transpose_b = false;
 
     PARAM_COPY(MatMulLayerParam)
 };
@@ -29,6 +29,9 @@ typedef std::map<std::string, DataType> BlobDataTypeMap;
 typedef std::map<std::string, std::shared_ptr<RawBuffer> > ConstantResource;
 typedef std::map<std::string, int > ConstantResourceFlag;
 
+// suffix of the constant holding scales of a weight-only quantized constant weight
+#define WEIGHT_QUANT_SCALE_SUFFIX "_weight_quant_scale_"
+
 struct LayerResource {
     std::string name = "";
     // default virtual destructor
@@ -55,6 +58,11 @@ struct ConvLayerResource : public LayerResource {
     RawBuffer zero_point_handle;
 };
 
+struct ConvDwPwFusedLayerResource : public LayerResource {
+    ConvLayerResource dw_resource;
+    ConvLayerResource pw_resource;
+};
+
 struct BatchNormLayerResource : public LayerResource {
     // bn k buffer
     RawBuffer scale_handle;
@@ -159,6 +167,8 @@ struct UnsqueezeLayerResource : public SqueezeLayerResource {};
 
 struct MatMulLayerResource : public LayerResource {
     RawBuffer weight;
+    // scale of weight-only quantized weight
+    RawBuffer scale_handle;
 };
 
 struct BiasAddLayerResource : public LayerResource {
@@ -17,6 +17,7 @@
 #include "tnn/utils/dims_utils.h"
 #include "tnn/utils/bfp16.h"
 #include "tnn/utils/half_utils_inner.h"
+#include "tnn/utils/weight_quant_utils.h"
 
 #include <mutex>
 
@@ -211,6 +212,32 @@ class InnerProductLayerResourceGenerator : public LayerResourceGenerator {
             layer_res->zero_point_handle.SetDataType(DATA_TYPE_INT8);
             InitRandom(layer_res->zero_point_handle.force_to<int8_t*>(), layer_param->num_output, (int8_t)0);
 
+        } else if (layer_param->weight_quant_bits > 0) {
+            // weight-only quantization, generate fp32 weights and quantize them as the model tools do
+            int oc          = layer_param->num_output;
+            int ic          = DimsVectorUtils::Count(dims, 1);
+            int bits        = layer_param->weight_quant_bits;
+            int group       = layer_param->weight_quant_group;
+            int scale_count = oc * WeightQuantGroupCount(ic, group);
+
+            RawBuffer weight_f32(weight_handle_size * sizeof(float));
+            InitRandom(weight_f32.force_to<float*>(), weight_handle_size, 1.0f);
+
+            layer_res->weight_handle     = RawBuffer(oc * WeightQuantRowBytes(ic, bits), {oc, ic});
+            layer_res->scale_handle      = RawBuffer(scale_count * sizeof(float));
+            layer_res->zero_point_handle = RawBuffer(scale_count * sizeof(int8_t));
+            layer_res->weight_handle.SetDataType(DATA_TYPE_INT8);
+            layer_res->scale_handle.SetDataType(DATA_TYPE_FLOAT);
+            layer_res->zero_point_handle.SetDataType(DATA_TYPE_INT8);
+            RETURN_ON_NEQ(QuantizeWeightOnly(weight_f32.force_to<float*>(), oc, ic, bits, group,
+                                             layer_res->weight_handle.force_to<int8_t*>(),
+                                             layer_res->scale_handle.force_to<float*>()),
+                          TNN_OK);
+
+            if (layer_param->has_bias) {
+                layer_res->bias_handle = RawBuffer(layer_param->num_output * sizeof(float));
+                InitRandom(layer_res->bias_handle.force_to<float*>(), layer_param->num_output, 1.0f);
+            }
         } else {
             layer_res->weight_handle = RawBuffer(weight_handle_size * sizeof(float));
             InitRandom(layer_res->weight_handle.force_to<float*>(), weight_handle_size, 1.0f);
@@ -527,6 +554,43 @@ class LSTMONNXLayerResourceGenerator : public LayerResourceGenerator {
     }
 };
 
+class GRUONNXLayerResourceGenerator : public LayerResourceGenerator {
+    virtual Status GenLayerConstantResource(LayerParam* param, LayerResource** resource,
+                                            std::vector<Blob*>& inputs, ConstantResource* consts) {
+        LOGD("GRUONNXLayerResourceGenerator\n");
+        // W, R and the optional B, initial_h is a real input
+        const int weight_end = MIN((int)inputs.size(), 4);
+        for (int i = 1; i < weight_end; i++) {
+            auto blob      = inputs[i];
+            auto blob_name = blob->GetBlobDesc().name;
+            auto data_type = blob->GetBlobDesc().data_type;
+            auto count     = DimsVectorUtils::Count(blob->GetBlobDesc().dims);
+            if (consts->count(blob_name) > 0) {
+                continue;
+            }
+            if (data_type == DATA_TYPE_FLOAT) {
+                auto buffer = std::make_shared<RawBuffer>(count * sizeof(float));
+                buffer->SetBufferDims(blob->GetBlobDesc().dims);
+                buffer->SetDataType(DATA_TYPE_FLOAT);
+                InitRandom(buffer->force_to<float *>(), count, 1.0f);
+                (*consts)[blob_name] = buffer;
+            } else if (data_type == DATA_TYPE_HALF) {
+                auto buffer = std::make_shared<RawBuffer>(count * sizeof(fp16_t));
+                buffer->SetBufferDims(blob->GetBlobDesc().dims);
+                buffer->SetDataType(DATA_TYPE_HALF);
+                InitRandom(buffer->force_to<fp16_t *>(), count, fp16_t(1));
+                (*consts)[blob_name] = buffer;
+            }
+        }
+
+        return TNN_OK;
+    }
+
+    virtual Status ConvertHalfLayerResource(LayerResource* fp16_res, LayerResource** fp32_res) {
+        return TNN_OK;
+    }
+};
+
 REGISTER_LAYER_RESOURCE(Convolution, LAYER_CONVOLUTION);
 REGISTER_LAYER_RESOURCE(Deconvolution, LAYER_DECONVOLUTION);
 REGISTER_LAYER_RESOURCE(Convolution1D, LAYER_CONVOLUTION_1D);
@@ -551,5 +615,6 @@ REGISTER_LAYER_RESOURCE(SquaredDifference, LAYER_SQUARED_DIFFERENCE);
 REGISTER_LAYER_RESOURCE(HdrGuide, LAYER_HDRGUIDE);
 
 REGISTER_LAYER_CONSTANT_RESOURCE(LSTMONNX, LAYER_LSTMONNX);
+REGISTER_LAYER_CONSTANT_RESOURCE(GRUONNX, LAYER_GRUONNX);
 
 }  // namespace TNN_NS
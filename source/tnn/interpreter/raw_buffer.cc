@@ -13,6 +13,8 @@
 // specific language governing permissions and limitations under the License.
 
 #include "tnn/interpreter/raw_buffer.h"
+#include <limits.h>
+
 #include <fstream>
 #include <string>
 #include <typeinfo>
@@ -20,6 +22,7 @@
 #include "tnn/utils/bfp16.h"
 #include "tnn/utils/bfp16_utils.h"
 #include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/huge_page_utils.h"
 
 using namespace TNN_NS;
 
@@ -32,8 +35,11 @@ RawBuffer::RawBuffer() :
   bytes_size_(0),
   data_type_(DATA_TYPE_FLOAT) {}
 
-RawBuffer::RawBuffer(int bytes_size) {
-    if (bytes_size > 0) {
+RawBuffer::RawBuffer(int64_t bytes_size) {
+    if (bytes_size > 0 && HugePageEnabled() && bytes_size >= (int64_t)kHugePageSize) {
+        buff_ = shared_ptr<char>(static_cast<char *>(HugePageMalloc(bytes_size)), [](char *p) { free(p); });
+        memset(buff_.get(), 0, bytes_size);
+    } else if (bytes_size > 0) {
         buff_ = shared_ptr<char>(new char[bytes_size], [](char *p) { delete[] p; });
         memset(buff_.get(), 0, bytes_size);
     } else {
@@ -43,11 +49,11 @@ RawBuffer::RawBuffer(int bytes_size) {
     bytes_size_ = bytes_size;
 }
 
-RawBuffer::RawBuffer(int bytes_size, DimsVector dims) : RawBuffer(bytes_size){
+RawBuffer::RawBuffer(int64_t bytes_size, DimsVector dims) : RawBuffer(bytes_size){
     this->dims_ = dims;
 }
 
-RawBuffer::RawBuffer(int bytes_size, char *buffer) {
+RawBuffer::RawBuffer(int64_t bytes_size, char *buffer) {
     if (bytes_size > 0) {
         buff_ = shared_ptr<char>(new char[bytes_size], [](char *p) { delete[] p; });
         memcpy(buff_.get(), buffer, bytes_size);
@@ -58,7 +64,7 @@ RawBuffer::RawBuffer(int bytes_size, char *buffer) {
     bytes_size_ = bytes_size;
 }
 
-RawBuffer::RawBuffer(int bytes_size, char* buffer, DimsVector dims) : RawBuffer(bytes_size, buffer) {
+RawBuffer::RawBuffer(int64_t bytes_size, char* buffer, DimsVector dims) : RawBuffer(bytes_size, buffer) {
           this->dims_ = dims;
 }
 
@@ -92,8 +98,13 @@ void aligned_free(void *align_ptr) {
     free(((void**)align_ptr)[-1]);
 }
 
-RawBuffer::RawBuffer(int bytes_size, int alignment) {
-    buff_ = shared_ptr<char>(static_cast<char*>(aligned_malloc(bytes_size, alignment)), &aligned_free);
+RawBuffer::RawBuffer(int64_t bytes_size, int alignment) {
+    if (HugePageEnabled() && bytes_size >= (int64_t)kHugePageSize && alignment <= (int)kHugePageSize) {
+        // huge page aligned memory satisfies the alignment
+        buff_ = shared_ptr<char>(static_cast<char *>(HugePageMalloc(bytes_size)), [](char *p) { free(p); });
+    } else {
+        buff_ = shared_ptr<char>(static_cast<char*>(aligned_malloc(bytes_size, alignment)), &aligned_free);
+    }
     memset(buff_.get(), 0, bytes_size);
     bytes_size_ = bytes_size;
 }
@@ -137,7 +148,7 @@ RawBuffer &RawBuffer::operator=(RawBuffer buf) {
     return *this;
 }
 
-void RawBuffer::buffer(char *buf, int bytes_size) {
+void RawBuffer::buffer(char *buf, int64_t bytes_size) {
     if (bytes_size > bytes_size_) {
         return;
     }
@@ -157,19 +168,35 @@ DataType RawBuffer::GetDataType() {
 }
 
 int RawBuffer::GetBytesSize() {
+    if (bytes_size_ > INT_MAX) {
+        LOGE("RawBuffer::GetBytesSize: %lld bytes overflow int, use GetBytesSize64\n", (long long)bytes_size_);
+        return -1;
+    }
+    return static_cast<int>(bytes_size_);
+}
+
+int64_t RawBuffer::GetBytesSize64() {
     return bytes_size_;
 }
 
 int RawBuffer::GetDataCount() {
     int elem_size = DataTypeUtils::GetBytesSize(data_type_);
-    return elem_size > 0 ? bytes_size_ / elem_size : 0;
+    if (elem_size <= 0) {
+        return 0;
+    }
+    int64_t count = bytes_size_ / elem_size;
+    if (count > INT_MAX) {
+        LOGE("RawBuffer::GetDataCount: %lld elements overflow int\n", (long long)count);
+        return -1;
+    }
+    return static_cast<int>(count);
 }
 
 /*
  * Convert the data handle form half to Float32
  */
 RawBuffer ConvertHalfHandle(RawBuffer &buf) {
-    if (buf.GetBytesSize() > 0 && buf.GetDataType() == DATA_TYPE_HALF) {
+    if (buf.GetBytesSize64() > 0 && buf.GetDataType() == DATA_TYPE_HALF) {
         auto data_count = buf.GetDataCount();
         RawBuffer buf_f32(data_count * sizeof(float));
         ConvertFromHalfToFloat(buf.force_to<void *>(), buf_f32.force_to<float *>(), data_count);
@@ -183,7 +210,7 @@ RawBuffer ConvertHalfHandle(RawBuffer &buf) {
  * Convert the data handle form float to bfp16
  */
 RawBuffer ConvertFloatToBFP16(RawBuffer &buf) {
-    if (buf.GetBytesSize() > 0 && buf.GetDataType() == DATA_TYPE_FLOAT) {
+    if (buf.GetBytesSize64() > 0 && buf.GetDataType() == DATA_TYPE_FLOAT) {
         auto data_count = buf.GetDataCount();
         RawBuffer buf_bfp16(data_count * sizeof(bfp16_t));
         ConvertFromFloatToBFP16(buf.force_to<float *>(), buf_bfp16.force_to<void *>(), data_count);
@@ -198,7 +225,7 @@ RawBuffer ConvertFloatToBFP16(RawBuffer &buf) {
  * Convert the data handle form half to bfp16
  */
 RawBuffer ConvertHalfToBFP16(RawBuffer &buf) {
-    if (buf.GetBytesSize() > 0 && buf.GetDataType() == DATA_TYPE_HALF) {
+    if (buf.GetBytesSize64() > 0 && buf.GetDataType() == DATA_TYPE_HALF) {
         auto buf_fp32   = ConvertHalfHandle(buf);
         auto data_count = buf_fp32.GetDataCount();
         RawBuffer buf_bfp16(data_count * sizeof(bfp16_t));
@@ -211,9 +238,9 @@ RawBuffer ConvertHalfToBFP16(RawBuffer &buf) {
 }
 
 std::shared_ptr<float> GetFloatFromRawBuffer(RawBuffer &raw_buffer) {
-    int element_size = 0;
-    DataType type    = raw_buffer.GetDataType();
-    int bytes        = raw_buffer.GetBytesSize();
+    int64_t element_size = 0;
+    DataType type        = raw_buffer.GetDataType();
+    int64_t bytes        = raw_buffer.GetBytesSize64();
     if (0 == bytes)
         return nullptr;
 
@@ -235,7 +262,7 @@ std::shared_ptr<float> GetFloatFromRawBuffer(RawBuffer &raw_buffer) {
 }
 
 RawBuffer ConvertFloatToFP16(RawBuffer &buf) {
-    if (buf.GetBytesSize() > 0 && buf.GetDataType() == DATA_TYPE_FLOAT) {
+    if (buf.GetBytesSize64() > 0 && buf.GetDataType() == DATA_TYPE_FLOAT) {
         int data_count = buf.GetDataCount();
         RawBuffer buf_fp16(data_count * sizeof(fp16_t));
         ConvertFromFloatToHalf(buf.force_to<float *>(), buf_fp16.force_to<fp16_t *>(), data_count);
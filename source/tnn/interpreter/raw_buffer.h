@@ -30,23 +30,26 @@ using std::shared_ptr;
 class RawBuffer {
 public:
     RawBuffer();
-    explicit RawBuffer(int bytes_size);
-    RawBuffer(int bytes_size, DimsVector dims);
-    RawBuffer(int bytes_size, char *buffer);
-    RawBuffer(int bytes_size, char* buffer, DimsVector dims);
+    explicit RawBuffer(int64_t bytes_size);
+    RawBuffer(int64_t bytes_size, DimsVector dims);
+    RawBuffer(int64_t bytes_size, char *buffer);
+    RawBuffer(int64_t bytes_size, char* buffer, DimsVector dims);
     RawBuffer(const RawBuffer &buf);
-    RawBuffer(int bytes_size, int alignment);
+    RawBuffer(int64_t bytes_size, int alignment);
     RawBuffer &operator=(RawBuffer buf);
     ~RawBuffer();
 
-    void buffer(char *buf, int bytes_size);
+    void buffer(char *buf, int64_t bytes_size);
     void SetDataType(DataType data_type);
     void SetBufferDims(DimsVector shape);
 
 
 
     DataType GetDataType();
+    // @brief bytes size, logs an error and returns -1 if it does not fit in int, use GetBytesSize64 for
+    // buffers which may exceed 2GB
     int GetBytesSize();
+    int64_t GetBytesSize64();
     int GetDataCount();
     DimsVector GetBufferDims();
 
@@ -57,9 +60,15 @@ public:
         return reinterpret_cast<T>(buff_ ? buff_.get() : nullptr);
     }
 
+    // @brief the storage shared by the copies of the buffer, unlike the data address it is never
+    // reused by another buffer while referenced
+    std::weak_ptr<char> GetStorage() {
+        return buff_;
+    }
+
 private:
     shared_ptr<char> buff_ = nullptr;
-    int bytes_size_        = 0;
+    int64_t bytes_size_    = 0;
     DataType data_type_    = DATA_TYPE_FLOAT;
     DimsVector dims_ = {};
 };
@@ -28,7 +28,7 @@ Status CastLayerInterpreter::InterpretResource(Deserializer &deserializer, Layer
     return TNN_OK;
 }
 
-Status CastLayerInterpreter::SaveProto(std::ofstream &output_stream, LayerParam *param) {
+Status CastLayerInterpreter::SaveProto(std::ostream &output_stream, LayerParam *param) {
     auto layer_param = dynamic_cast<CastLayerParam *>(param);
     if (nullptr == layer_param) {
         LOGE("invalid layer param to save\n");
@@ -93,7 +93,7 @@ Status ConvLayerInterpreter::InterpretResource(Deserializer& deserializer, Layer
     return TNN_OK;
 }
 
-Status ConvLayerInterpreter::SaveProto(std::ofstream& output_stream, LayerParam* param) {
+Status ConvLayerInterpreter::SaveProto(std::ostream& output_stream, LayerParam* param) {
     CAST_OR_RET_ERROR(layer_param, ConvLayerParam, "invalid layer param to save", param);
 
     output_stream << layer_param->group << " ";
@@ -47,7 +47,7 @@ Status DetectionOutputLayerInterpreter::InterpretResource(Deserializer &deserial
     return TNN_OK;
 }
 
-Status DetectionOutputLayerInterpreter::SaveProto(std::ofstream &output_stream, LayerParam *param) {
+Status DetectionOutputLayerInterpreter::SaveProto(std::ostream &output_stream, LayerParam *param) {
     CAST_OR_RET_ERROR(layer_param, DetectionOutputLayerParam, "invalid layer param to save", param);
 
     output_stream << layer_param->num_classes << " ";
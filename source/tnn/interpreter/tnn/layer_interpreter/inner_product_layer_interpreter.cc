@@ -29,6 +29,9 @@ Status InnerProductLayerInterpreter::InterpretProto(str_arr layer_cfg_arr, int s
     layer_param->has_bias   = atoi(layer_cfg_arr[index++].c_str());
     layer_param->transpose  = atoi(layer_cfg_arr[index++].c_str());
     layer_param->axis       = atoi(layer_cfg_arr[index++].c_str());
+    GET_INT_1_OR_DEFAULT(layer_param->weight_quant_bits, 0);
+    GET_INT_1_OR_DEFAULT(layer_param->weight_quant_group, 0);
+    GET_INT_1_OR_DEFAULT(layer_param->dynamic_quant, 0);
 
     return TNN_OK;
 }
@@ -72,7 +75,7 @@ Status InnerProductLayerInterpreter::InterpretResource(Deserializer& deserialize
     return TNN_OK;
 }
 
-Status InnerProductLayerInterpreter::SaveProto(std::ofstream& output_stream, LayerParam* param) {
+Status InnerProductLayerInterpreter::SaveProto(std::ostream& output_stream, LayerParam* param) {
     InnerProductLayerParam* layer_param = dynamic_cast<InnerProductLayerParam*>(param);
     if (nullptr == layer_param) {
         LOGE("invalid layer param to save\n");
@@ -83,6 +86,13 @@ Status InnerProductLayerInterpreter::SaveProto(std::ofstream& output_stream, Lay
     output_stream << layer_param->has_bias << " ";
     output_stream << layer_param->transpose << " ";
     output_stream << layer_param->axis << " ";
+    if (layer_param->weight_quant_bits > 0) {
+        output_stream << layer_param->weight_quant_bits << " ";
+        output_stream << layer_param->weight_quant_group << " ";
+        if (layer_param->dynamic_quant > 0) {
+            output_stream << layer_param->dynamic_quant << " ";
+        }
+    }
 
     return TNN_OK;
 }
@@ -103,7 +113,7 @@ Status InnerProductLayerInterpreter::SaveResource(Serializer& serializer, LayerP
     serializer.PutRaw(layer_res->weight_handle);
     serializer.PutRaw(layer_res->bias_handle);
 
-    if (layer_param->quantized) {
+    if (layer_param->quantized || layer_param->weight_quant_bits > 0) {
         // put zero_point_handle in front of scale_handle to distinguish the old and new versions
         serializer.PutRaw(layer_res->zero_point_handle);
         serializer.PutRaw(layer_res->scale_handle);
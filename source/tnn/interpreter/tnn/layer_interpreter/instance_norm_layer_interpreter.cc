@@ -39,7 +39,7 @@ Status InstanceNormLayerInterpreter::InterpretResource(Deserializer& deserialize
     return TNN_OK;
 }
 
-Status InstanceNormLayerInterpreter::SaveProto(std::ofstream& output_stream, LayerParam* param) {
+Status InstanceNormLayerInterpreter::SaveProto(std::ostream& output_stream, LayerParam* param) {
     CAST_OR_RET_ERROR(layer_param, InstanceNormLayerParam, "invalid group norm layer param to save", param);
     output_stream << layer_param->channels << " ";
     output_stream << layer_param->eps << " ";
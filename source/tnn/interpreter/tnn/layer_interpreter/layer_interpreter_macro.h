@@ -22,7 +22,7 @@
     public:                                                                                                            \
         virtual Status InterpretProto(str_arr layer_cfg_arr, int start_index, LayerParam **param);                     \
         virtual Status InterpretResource(Deserializer &deserializer, LayerResource **resource);                        \
-        virtual Status SaveProto(std::ofstream &output_stream, LayerParam *param);                                     \
+        virtual Status SaveProto(std::ostream &output_stream, LayerParam *param);                                      \
         virtual Status SaveResource(Serializer &serializer, LayerParam *param, LayerResource *resource);               \
     }
 
@@ -23,6 +23,8 @@ Status LSTMONNXLayerInterpreter::InterpretProto(str_arr layer_cfg_arr, int index
     GET_FLOAT_1_OR_DEFAULT(layer_param->clip_threshold, 0);
     GET_INT_1_OR_DEFAULT(layer_param->hidden_size, 0);
     GET_INT_1_OR_DEFAULT(layer_param->direction, 0);
+    GET_INT_1_OR_DEFAULT(layer_param->weight_quant_bits, 0);
+    GET_INT_1_OR_DEFAULT(layer_param->weight_quant_group, 0);
     return TNN_OK;
 }
 
@@ -30,13 +32,16 @@ Status LSTMONNXLayerInterpreter::InterpretResource(Deserializer& deserializer, L
     return TNN_OK;
 }
 
-Status LSTMONNXLayerInterpreter::SaveProto(std::ofstream& output_stream, LayerParam* param) {
+Status LSTMONNXLayerInterpreter::SaveProto(std::ostream& output_stream, LayerParam* param) {
     auto layer_param = dynamic_cast<LSTMONNXLayerParam*>(param);
     if (layer_param == nullptr) {
         LOGE("invalid layer param to save\n");
         return Status(TNNERR_NULL_PARAM, "invalid layer param to save");
     }
     output_stream << layer_param->clip_threshold << " " << layer_param->hidden_size << " " << layer_param->direction << " ";
+    if (layer_param->weight_quant_bits > 0) {
+        output_stream << layer_param->weight_quant_bits << " " << layer_param->weight_quant_group << " ";
+    }
 
     return TNN_OK;
 }
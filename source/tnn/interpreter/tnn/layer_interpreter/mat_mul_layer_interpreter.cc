@@ -26,6 +26,14 @@ Status MatMulLayerInterpreter::InterpretProto(str_arr layer_cfg_arr, int index,
     if (index < layer_cfg_arr.size()) {
        layer_param->weight_position = atoi(layer_cfg_arr[index++].c_str());
     }
+    GET_INT_1_OR_DEFAULT(layer_param->weight_quant_bits, 0);
+    GET_INT_1_OR_DEFAULT(layer_param->weight_quant_group, 0);
+    GET_INT_1_OR_DEFAULT(layer_param->dynamic_quant, 0);
+    int transpose_a = 0, transpose_b = 0;
+    GET_INT_1_OR_DEFAULT(transpose_a, 0);
+    GET_INT_1_OR_DEFAULT(transpose_b, 0);
+    layer_param->transpose_a = transpose_a != 0;
+    layer_param->transpose_b = transpose_b != 0;
     return TNN_OK;
 }
 
@@ -34,21 +42,39 @@ Status MatMulLayerInterpreter::InterpretResource(Deserializer& deserializer, Lay
     RawBuffer buf;
     deserializer.GetRaw(buf);
     layer_res->weight = buf;
+    if (buf.GetDataType() == DATA_TYPE_INT8) {
+        // weight-only quantized weight is followed by its scale
+        GET_BUFFER_FOR_ATTR(layer_res, scale_handle, deserializer);
+    }
     return TNN_OK;
 }
 
-Status MatMulLayerInterpreter::SaveProto(std::ofstream& output_stream, LayerParam* param) {
+Status MatMulLayerInterpreter::SaveProto(std::ostream& output_stream, LayerParam* param) {
     auto layer_param = dynamic_cast<MatMulLayerParam*>(param);
     if (nullptr == layer_param) {
         return Status(TNNERR_NULL_PARAM, "invalid layer param to save");
     }
     output_stream << layer_param->weight_position << " ";
+    // the transpose flags set by the permute fusion follow the quantization params
+    const bool transposed = layer_param->transpose_a || layer_param->transpose_b;
+    if (layer_param->weight_quant_bits > 0 || transposed) {
+        output_stream << layer_param->weight_quant_bits << " " << layer_param->weight_quant_group << " ";
+        if (layer_param->dynamic_quant > 0 || transposed) {
+            output_stream << layer_param->dynamic_quant << " ";
+        }
+    }
+    if (transposed) {
+        output_stream << (int)layer_param->transpose_a << " " << (int)layer_param->transpose_b << " ";
+    }
     return TNN_OK;
 }
 
 Status MatMulLayerInterpreter::SaveResource(Serializer& serializer, LayerParam* param, LayerResource* resource) {
     CAST_OR_RET_ERROR(layer_res, MatMulLayerResource, "invalid layer res to save", resource);
     serializer.PutRaw(layer_res->weight);
+    if (layer_res->weight.GetDataType() == DATA_TYPE_INT8) {
+        serializer.PutRaw(layer_res->scale_handle);
+    }
     return TNN_OK;
 }
 
@@ -46,7 +46,7 @@ Status Pooling1DLayerInterpreter::InterpretResource(Deserializer& deserializer,
     return TNN_OK;
 }
 
-Status Pooling1DLayerInterpreter::SaveProto(std::ofstream& output_stream, LayerParam* param) {
+Status Pooling1DLayerInterpreter::SaveProto(std::ostream& output_stream, LayerParam* param) {
     CAST_OR_RET_ERROR(layer_param, PoolingLayerParam, "invalid layer param to save", param);
 
     output_stream << layer_param->pool_type << " ";
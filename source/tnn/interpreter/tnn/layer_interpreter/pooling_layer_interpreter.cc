@@ -61,7 +61,7 @@ Status PoolingLayerInterpreter::InterpretResource(Deserializer& deserializer, La
     return TNN_OK;
 }
 
-Status PoolingLayerInterpreter::SaveProto(std::ofstream& output_stream, LayerParam* param) {
+Status PoolingLayerInterpreter::SaveProto(std::ostream& output_stream, LayerParam* param) {
     CAST_OR_RET_ERROR(layer_param, PoolingLayerParam, "invalid layer param to save", param);
 
     output_stream << layer_param->pool_type << " ";
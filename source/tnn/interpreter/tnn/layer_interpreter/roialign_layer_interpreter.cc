@@ -32,7 +32,7 @@ Status RoiAlignLayerInterpreter::InterpretResource(Deserializer& deserializer, L
     return TNN_OK;
 }
 
-Status RoiAlignLayerInterpreter::SaveProto(std::ofstream& output_stream, LayerParam* param) {
+Status RoiAlignLayerInterpreter::SaveProto(std::ostream& output_stream, LayerParam* param) {
     auto* layer_param = dynamic_cast<RoiAlignLayerParam*>(param);
     if (nullptr == layer_param) {
         LOGE("invalid layer param to save\n");
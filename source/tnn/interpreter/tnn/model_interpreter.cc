@@ -14,12 +14,17 @@
 
 #include "tnn/interpreter/tnn/model_interpreter.h"
 #include <stdlib.h>
+#include <cstring>
+#include <istream>
+#include <set>
 #include <sstream>
+#include <streambuf>
 
 #include "tnn/core/common.h"
 #include "tnn/interpreter/tnn/layer_interpreter/abstract_layer_interpreter.h"
 #include "tnn/interpreter/tnn/objseri.h"
-#include "tnn/utils/md5.h"
+#include "tnn/utils/hash_utils.h"
+#include "tnn/utils/omp_utils.h"
 
 namespace TNN_NS {
 
@@ -35,6 +40,104 @@ bool ModelInterpreter::IsValidVersionNumber(uint32_t number) {
     return number == g_version_magic_number || number == g_version_magic_number_v2;
 }
 
+// read-only stream buffer over the model content, the content is not copied like std::istringstream does
+class ModelContentStreamBuf : public std::streambuf {
+public:
+    ModelContentStreamBuf(const char *data, size_t size) {
+        char *begin = const_cast<char *>(data);
+        setg(begin, begin, begin + size);
+    }
+
+protected:
+    virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) {
+        char *base = dir == std::ios_base::beg ? eback() : (dir == std::ios_base::cur ? gptr() : egptr());
+        if (off < eback() - base || off > egptr() - base) {
+            return pos_type(off_type(-1));
+        }
+        setg(eback(), base + off, egptr());
+        return pos_type(gptr() - eback());
+    }
+
+    virtual pos_type seekpos(pos_type pos, std::ios_base::openmode which) {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+};
+
+// Deserializer that only reads the headers of raw buffers in the model content. The payload offsets are
+// recorded while the layers are parsed, and all payloads are copied by multiple threads in Flush.
+class DeferredDeserializer : public Deserializer {
+public:
+    DeferredDeserializer(std::istream &is, const std::string &content) : Deserializer(is), content_(content) {}
+
+    virtual void GetRaw(TNN_NS::RawBuffer &value) {
+        auto magic_number = static_cast<uint32_t>(GetInt());
+        auto data_type    = (TNN_NS::DataType)GetInt();
+        int64_t length    = GetRawLength(magic_number);
+        if (length <= 0) {
+            return;
+        }
+
+        DimsVector dims;
+        if (magic_number == g_version_magic_number_v2 || magic_number == g_version_magic_number_v3) {
+            int size = GetInt();
+            for (int i = 0; i < size; ++i) {
+                dims.push_back(GetInt());
+            }
+        }
+
+        if (skip_) {
+            // resource of a layer not in the net structure, keep the description only
+            value = TNN_NS::RawBuffer();
+            value.SetDataType(data_type);
+            value.SetBufferDims(dims);
+            _istream.seekg(length, std::ios::cur);
+            return;
+        }
+
+        value = TNN_NS::RawBuffer(length);
+        value.SetDataType(data_type);
+        value.SetBufferDims(dims);
+        if (_istream.eof()) {
+            return;
+        }
+
+        const std::streamoff offset = _istream.tellg();
+        if (offset < 0 || offset + length > static_cast<std::streamoff>(content_.length())) {
+            // truncated model, read what is left as the base Deserializer does
+            _istream.read(value.force_to<char *>(), static_cast<std::streamsize>(length));
+            return;
+        }
+        // RawBuffer copies share the data, the resource holding value sees the payload after Flush
+        jobs_.push_back({value, offset, length});
+        _istream.seekg(length, std::ios::cur);
+    }
+
+    void SetSkip(bool skip) {
+        skip_ = skip;
+    }
+
+    void Flush() {
+        const long job_count = static_cast<long>(jobs_.size());
+        OMP_PARALLEL_FOR_DYNAMIC_
+        for (long i = 0; i < job_count; i++) {
+            auto &job = jobs_[i];
+            memcpy(job.buffer.force_to<char *>(), content_.data() + job.offset, job.length);
+        }
+        jobs_.clear();
+    }
+
+private:
+    struct CopyJob {
+        RawBuffer buffer;
+        std::streamoff offset;
+        int64_t length;
+    };
+
+    const std::string &content_;
+    std::vector<CopyJob> jobs_;
+    bool skip_ = false;
+};
+
 std::shared_ptr<Deserializer> ModelInterpreter::GetDeserializer(std::istream &is) {
     return std::make_shared<Deserializer>(is);
 }
@@ -98,9 +201,10 @@ Status ModelInterpreter::Interpret(std::vector<std::string> &params) {
         return status;
     }
 
+    // digest of the params, used as the key of caches built from the model
     for (const auto& item : params) {
-        params_md5_.push_back(md5(item));
-        LOGD("model params md5: %s\n", md5(item).c_str());
+        params_md5_.push_back(ContentDigest(item));
+        LOGD("model params digest: %s\n", params_md5_.back().c_str());
     }
     return status;
 }
@@ -111,6 +215,93 @@ std::shared_ptr<AbstractModelInterpreter> ModelInterpreter::Copy() {
     return interp;
 }
 
+// writes the layout of the buffers in place of their data, the resources of two models have the same layout
+// if they serialize to the same content
+class ResourceLayoutSerializer : public Serializer {
+public:
+    explicit ResourceLayoutSerializer(std::ostream &os) : Serializer(os) {}
+
+    virtual void PutRaw(TNN_NS::RawBuffer &value) {
+        PutInt(value.GetDataType());
+        put_basic_t<int64_t>(value.GetBytesSize64());
+        auto dims = value.GetBufferDims();
+        PutInt((int)dims.size());
+        for (auto dim : dims) {
+            PutInt(dim);
+        }
+    }
+};
+
+static Status GetResourceLayout(LayerInfo *layer, LayerResource *resource, std::string &layout) {
+    auto &layer_interpreter_map = ModelInterpreter::GetLayerInterpreterMap();
+    auto layer_interpreter      = layer_interpreter_map[layer->type];
+    if (layer_interpreter == nullptr) {
+        return Status(TNNERR_LOAD_MODEL, "Error: layer_interpreter is nil");
+    }
+    std::ostringstream os;
+    ResourceLayoutSerializer serializer(os);
+    RETURN_ON_NEQ(layer_interpreter->SaveResource(serializer, layer->param.get(), resource), TNN_OK);
+    layout = os.str();
+    return TNN_OK;
+}
+
+static Status CheckSameResourceLayout(NetStructure *structure, NetResource &expected, NetResource &actual) {
+    for (auto layer : structure->layers) {
+        const auto &name  = layer->name;
+        bool has_expected = expected.resource_map.count(name) > 0;
+        bool has_actual   = actual.resource_map.count(name) > 0;
+        if (has_expected != has_actual) {
+            LOGE("ReplaceModel: resource of layer %s is missing in one of the models\n", name.c_str());
+            return Status(TNNERR_INVALID_MODEL, "layer resources of the models do not match");
+        }
+        if (!has_expected) {
+            continue;
+        }
+        std::string expected_layout, actual_layout;
+        RETURN_ON_NEQ(GetResourceLayout(layer.get(), expected.resource_map[name].get(), expected_layout), TNN_OK);
+        RETURN_ON_NEQ(GetResourceLayout(layer.get(), actual.resource_map[name].get(), actual_layout), TNN_OK);
+        if (expected_layout != actual_layout) {
+            LOGE("ReplaceModel: resource of layer %s has a different layout\n", name.c_str());
+            return Status(TNNERR_INVALID_MODEL, "layer resources of the models do not match");
+        }
+    }
+
+    if (expected.constant_map.size() != actual.constant_map.size()) {
+        return Status(TNNERR_INVALID_MODEL, "constants of the models do not match");
+    }
+    for (auto iter : expected.constant_map) {
+        auto other = actual.constant_map.find(iter.first);
+        if (other == actual.constant_map.end() || iter.second->GetDataType() != other->second->GetDataType() ||
+            iter.second->GetBytesSize64() != other->second->GetBytesSize64() ||
+            iter.second->GetBufferDims() != other->second->GetBufferDims()) {
+            LOGE("ReplaceModel: constant %s has a different layout\n", iter.first.c_str());
+            return Status(TNNERR_INVALID_MODEL, "constants of the models do not match");
+        }
+    }
+    return TNN_OK;
+}
+
+Status ModelInterpreter::ReplaceModel(std::string &model_content) {
+    NetResource *net_resource = GetNetResource();
+    NetResource old_resource  = *net_resource;
+    net_resource->resource_map.clear();
+    net_resource->constant_map.clear();
+
+    Status status = InterpretModel(model_content);
+    if (status == TNN_OK) {
+        status = CheckSameResourceLayout(GetNetStructure(), old_resource, *net_resource);
+    }
+    if (status != TNN_OK) {
+        *net_resource = old_resource;
+        return status;
+    }
+
+    if (params_md5_.size() > 1) {
+        params_md5_[1] = ContentDigest(model_content);
+    }
+    return TNN_OK;
+}
+
 Status ModelInterpreter::InterpretProto(std::string &content) {
     Status ret              = TNN_OK;
     NetStructure *structure = GetNetStructure();
@@ -345,8 +536,8 @@ Status ModelInterpreter::InterpretModel(std::string &model_content) {
 #endif
     }
 
-    std::istringstream content_stream;
-    content_stream.str(model_content);
+    ModelContentStreamBuf content_buf(model_content.data(), model_length);
+    std::istream content_stream(&content_buf);
 
     uint32_t magic_version_number = 0;
     content_stream.read(reinterpret_cast<char *>(&magic_version_number), sizeof(g_version_magic_number));
@@ -356,17 +547,39 @@ Status ModelInterpreter::InterpretModel(std::string &model_content) {
 
     res_header header;
     auto deserializer = GetDeserializer(content_stream);
+    // the default deserializer is replaced by the deferred one, subclasses keep their own deserializer
+    std::shared_ptr<DeferredDeserializer> deferred_deserializer;
+    const auto &default_deserializer = *deserializer;
+    if (typeid(default_deserializer) == typeid(Deserializer)) {
+        deferred_deserializer = std::make_shared<DeferredDeserializer>(content_stream, model_content);
+        deserializer          = deferred_deserializer;
+    }
     header.deserialize(*deserializer);
     if (header.layer_cnt_ < 0 || header.layer_cnt_ >= 10000) {
         LOGE("tnnmodel is invalid, maybe you should upgrade TNN\n");
         return Status(TNNERR_INVALID_MODEL, "Error: model is illegal");
     }
     
+    std::set<std::string> layer_names;
+    for (const auto &layer : GetNetStructure()->layers) {
+        layer_names.insert(layer->name);
+    }
+
     auto &layer_interpreter_map = GetLayerInterpreterMap();
     for (int index = 0; index < header.layer_cnt_; ++index) {
         layer_header ly_head;
         ly_head.deserialize(*deserializer);
 
+        // resources of layers removed from the proto are parsed to skip them, the payloads are not loaded
+        const auto &name = ly_head.name_;
+        const bool used  = layer_names.find(name) != layer_names.end() ||
+                          (name.length() > strlen(BLOB_SCALE_SUFFIX) &&
+                           name.compare(name.length() - strlen(BLOB_SCALE_SUFFIX), std::string::npos,
+                                        BLOB_SCALE_SUFFIX) == 0);
+        if (deferred_deserializer) {
+            deferred_deserializer->SetSkip(!used);
+        }
+
         LayerResource *layer_resource = NULL;
         auto layer_interpreter        = layer_interpreter_map[ly_head.type_];
         // refactor later, layer_interpreter NULL return error_code.
@@ -375,7 +588,11 @@ Status ModelInterpreter::InterpretModel(std::string &model_content) {
             if (result != TNN_OK) {
                 return result;
             }
-            net_resource->resource_map[ly_head.name_] = std::shared_ptr<LayerResource>(layer_resource);
+            if (!deferred_deserializer || used) {
+                net_resource->resource_map[ly_head.name_] = std::shared_ptr<LayerResource>(layer_resource);
+            } else {
+                delete layer_resource;
+            }
         } else {
             LOGE(
                 "Error: layer_interpreter nil name:%s type_from_str:%s "
@@ -384,6 +601,9 @@ Status ModelInterpreter::InterpretModel(std::string &model_content) {
             return Status(TNNERR_LOAD_MODEL, "Error: layer_interpreter is nil");
         }
     }
+    if (deferred_deserializer) {
+        deferred_deserializer->SetSkip(false);
+    }
 
     //解析constant_map
     const auto pos_cur = content_stream.tellg();
@@ -391,6 +611,9 @@ Status ModelInterpreter::InterpretModel(std::string &model_content) {
     auto pos_diff = content_stream.tellg() - pos_cur;
     content_stream.seekg(pos_cur, std::ios::beg);
     if (pos_diff < 4) {
+        if (deferred_deserializer) {
+            deferred_deserializer->Flush();
+        }
         return TNN_OK;
     }
 
@@ -406,6 +629,9 @@ Status ModelInterpreter::InterpretModel(std::string &model_content) {
     }
     net_resource->constant_map = const_map;
 
+    if (deferred_deserializer) {
+        deferred_deserializer->Flush();
+    }
     return TNN_OK;
 }
 
@@ -106,6 +106,9 @@ public:
     // @brief copy interpreter
     virtual std::shared_ptr<AbstractModelInterpreter> Copy();
 
+    // @brief replace the weights with the ones of a tnnmodel of the same structure
+    virtual Status ReplaceModel(std::string& model_content);
+
 protected:
     virtual Status InterpretProto(std::string& content);
     virtual Status InterpretModel(std::string& model_content);
@@ -15,6 +15,8 @@
 #ifndef TNN_SOURCE_TNN_INTERPRETER_TNN_OBJSERI_H_
 #define TNN_SOURCE_TNN_INTERPRETER_TNN_OBJSERI_H_
 
+#include <limits.h>
+
 #include <string>
 #include <fstream>
 #include <string>
@@ -28,6 +30,8 @@
 namespace TNN_NS {
     static const uint32_t g_version_magic_number = 0x0FABC0002;
     static const uint32_t g_version_magic_number_v2 = 0x0FABC0004;
+    // raw buffers larger than 2GB, the length is stored as int64
+    static const uint32_t g_version_magic_number_v3 = 0x0FABC0006;
 
     class Serializer {
     public:
@@ -47,18 +51,25 @@ namespace TNN_NS {
         }
 
         virtual void PutRaw(TNN_NS::RawBuffer &value) {
-            int length = value.GetBytesSize();
+            int64_t length = value.GetBytesSize64();
             auto data_type = (TNN_NS::DataType)value.GetDataType();
             DimsVector  dims  = value.GetBufferDims();
             char *buffer = value.force_to<char *>();
             PutRaw(length, buffer, dims, data_type);
         }
         
-        void PutRaw(int length, char* buffer, std::vector<int> dims, DataType data_type = DATA_TYPE_FLOAT)
+        void PutRaw(int64_t length, char* buffer, std::vector<int> dims, DataType data_type = DATA_TYPE_FLOAT)
         {
-            PutInt(g_version_magic_number_v2);
-            PutInt(data_type);
-            PutInt(static_cast<int>(length));
+            // v2 is kept for buffers which fit in int, so models stay readable by older versions
+            if (length > INT_MAX) {
+                PutInt(g_version_magic_number_v3);
+                PutInt(data_type);
+                put_basic_t<int64_t>(length);
+            } else {
+                PutInt(g_version_magic_number_v2);
+                PutInt(data_type);
+                PutInt(static_cast<int>(length));
+            }
             if (length <= 0) {
                 return;
             }
@@ -141,13 +152,13 @@ namespace TNN_NS {
         virtual void GetRaw(TNN_NS::RawBuffer &value) {
             auto magic_number  = static_cast<uint32_t>(GetInt());
             auto data_type = (TNN_NS::DataType)GetInt();
-            int length = GetInt();
+            int64_t length = GetRawLength(magic_number);
             if (length <= 0) {
                 return;
             }
 
             DimsVector dims;
-            if(magic_number == g_version_magic_number_v2) {
+            if (magic_number == g_version_magic_number_v2 || magic_number == g_version_magic_number_v3) {
                 int size = GetInt();
                 for (int i = 0; i < size; ++i) {
                     dims.push_back(GetInt());
@@ -168,6 +179,13 @@ namespace TNN_NS {
 
     protected:
         std::istream &_istream;
+
+        int64_t GetRawLength(uint32_t magic_number) {
+            if (magic_number == g_version_magic_number_v3) {
+                return get_basic_t<int64_t>();
+            }
+            return GetInt();
+        }
         
         template <typename T>
         T get_basic_t();
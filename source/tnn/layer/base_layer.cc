@@ -30,6 +30,7 @@ BaseLayer::BaseLayer(LayerType type) {
 }
 
 BaseLayer::~BaseLayer() {
+    DiscardResource();
     if (layer_acc_ != NULL) {
         delete layer_acc_;
         layer_acc_ = NULL;
@@ -258,6 +259,7 @@ Status BaseLayer::InferShapeAhead(std::vector<Blob*>& input_blobs, std::vector<B
 }
 
 void BaseLayer::SetRuntimeBlobMemoryPool(BlobMemoryPool *runtime_blob_pool) {
+    runtime_blob_pool_ = runtime_blob_pool;
     if (layer_acc_) {
         layer_acc_->SetRuntimeBlobMemoryPool(runtime_blob_pool);
     }
@@ -293,6 +295,112 @@ void BaseLayer::SetRuntimeMode(RuntimeMode mode) {
     runtime_model_ = mode;
 }
 
+Status BaseLayer::GetRecurrentStates(std::map<std::string, RawBuffer *> &states) {
+    if (!layer_acc_) {
+        return TNN_OK;
+    }
+    return layer_acc_->GetRecurrentStates(states);
+}
+
+int BaseLayer::GetInplaceInputIndex() {
+    if (!layer_acc_) {
+        return -1;
+    }
+    return layer_acc_->GetInplaceInputIndex(input_blobs_, output_blobs_);
+}
+
+Status BaseLayer::PrepareResource(Context* context, LayerResource* resource, ConstantResource* consts,
+                                  AbstractDevice* device) {
+    DiscardResource();
+    // layers with constant outputs run no acc
+    if (!layer_acc_) {
+        return TNN_OK;
+    }
+
+    auto layer_acc = device->CreateLayerAcc(type_);
+    if (layer_acc == NULL) {
+        LOGE("layer acc of type(%d) is nil\n", type_);
+        return Status(TNNERR_LAYER_ERR, "layer acc is nil");
+    }
+    layer_acc->SetRuntimeMode(runtime_model_);
+    layer_acc->SetConstantResource(consts);
+    layer_acc->SetConstantResourceFlag(const_resource_flag_);
+    layer_acc->SetRuntimeBlobMemoryPool(runtime_blob_pool_);
+
+    // forward may run on the blobs of the layer meanwhile, the acc is prepared on copies of them as init points
+    // the constant inputs to blobs of the acc
+    std::vector<std::shared_ptr<Blob>> blob_copies;
+    std::vector<Blob*> inputs, outputs;
+    for (auto blob : input_blobs_) {
+        blob_copies.push_back(std::make_shared<Blob>(blob->GetBlobDesc(), blob->GetHandle()));
+        blob_copies.back()->SetFlag(blob->GetFlag());
+        inputs.push_back(blob_copies.back().get());
+    }
+    for (auto blob : output_blobs_) {
+        blob_copies.push_back(std::make_shared<Blob>(blob->GetBlobDesc(), blob->GetHandle()));
+        blob_copies.back()->SetFlag(blob->GetFlag());
+        outputs.push_back(blob_copies.back().get());
+    }
+    auto status = layer_acc->Init(context, param_, resource, inputs, outputs);
+    if (status == TNN_OK) {
+        status = layer_acc->Reshape(inputs, outputs);
+    }
+    if (status != TNN_OK) {
+        LOGE("Error prepare resource of layer %s (err: %d or 0x%X)\n", layer_name_.c_str(), (int)status, (int)status);
+        delete layer_acc;
+        return status;
+    }
+
+    pending_layer_acc_ = layer_acc;
+    pending_resource_  = resource;
+    return TNN_OK;
+}
+
+Status BaseLayer::CommitResource() {
+    if (!pending_layer_acc_) {
+        return TNN_OK;
+    }
+    if (retired_layer_acc_) {
+        delete retired_layer_acc_;
+    }
+    retired_layer_acc_ = layer_acc_;
+    retired_resource_  = resource_;
+    layer_acc_         = pending_layer_acc_;
+    resource_          = pending_resource_;
+    pending_layer_acc_ = nullptr;
+    pending_resource_  = nullptr;
+
+    layer_acc_->SetConstantResource(const_resource_);
+    return layer_acc_->ReloadConstantBlobs(input_blobs_, false);
+}
+
+Status BaseLayer::RevertResource() {
+    if (!retired_layer_acc_) {
+        return TNN_OK;
+    }
+    delete layer_acc_;
+    layer_acc_         = retired_layer_acc_;
+    resource_          = retired_resource_;
+    retired_layer_acc_ = nullptr;
+    retired_resource_  = nullptr;
+
+    // the constant blobs of the old acc are pointed to again
+    return layer_acc_->ReloadConstantBlobs(input_blobs_, false);
+}
+
+void BaseLayer::DiscardResource() {
+    if (pending_layer_acc_) {
+        delete pending_layer_acc_;
+        pending_layer_acc_ = nullptr;
+    }
+    pending_resource_ = nullptr;
+    if (retired_layer_acc_) {
+        delete retired_layer_acc_;
+        retired_layer_acc_ = nullptr;
+    }
+    retired_resource_ = nullptr;
+}
+
 std::map<LayerType, std::shared_ptr<LayerCreator>>& GetGlobalLayerCreatorMap() {
     // static shared_ptr of LayerCreatorMap.
     static std::once_flag once;
@@ -83,6 +83,27 @@ public:
     // @brief set runtime mode
     void SetRuntimeMode(RuntimeMode mode);
 
+    // @brief states kept by the layer acc across forward calls, by state name
+    Status GetRecurrentStates(std::map<std::string, RawBuffer *> &states);
+
+    // @brief index of the input blob the output may share memory with, -1 if the layer can not run in place
+    int GetInplaceInputIndex();
+
+    // @brief create a layer acc for a new resource of the same layout next to the running one, the running
+    // acc and the blobs of the layer are not touched until CommitResource, so forward may run meanwhile
+    // @param consts constants the new acc reads in init, the layer switches back to its own in commit
+    Status PrepareResource(Context* context, LayerResource* resource, ConstantResource* consts,
+                           AbstractDevice* device);
+
+    // @brief switch to the layer acc created by PrepareResource, the old one is kept for RevertResource
+    Status CommitResource();
+
+    // @brief switch back to the layer acc replaced by CommitResource
+    Status RevertResource();
+
+    // @brief release the layer acc created by PrepareResource and the one replaced by CommitResource
+    void DiscardResource();
+
 protected:
     LayerType type_;
 
@@ -90,6 +111,11 @@ protected:
     std::vector<Blob*> input_blobs_;
     std::vector<Blob*> output_blobs_;
     AbstractLayerAcc* layer_acc_;
+    AbstractLayerAcc* pending_layer_acc_ = nullptr;
+    LayerResource* pending_resource_     = nullptr;
+    AbstractLayerAcc* retired_layer_acc_ = nullptr;
+    LayerResource* retired_resource_     = nullptr;
+    BlobMemoryPool* runtime_blob_pool_   = nullptr;
 
     LayerParam* param_;
     LayerResource* resource_;
@@ -0,0 +1,51 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/layer/base_layer.h"
+
+namespace TNN_NS {
+
+DECLARE_LAYER(ConvDwPwFused, LAYER_CONV_DW_PW_FUSED);
+
+Status ConvDwPwFusedLayer::InferOutputDataType() {
+    return BaseLayer::InferOutputDataType();
+}
+
+Status ConvDwPwFusedLayer::InferOutputShape(bool ignore_error) {
+    BaseLayer::InferOutputShape(ignore_error);
+
+    auto param = dynamic_cast<ConvDwPwFusedLayerParam*>(param_);
+    CHECK_PARAM_NULL(param);
+    auto& dw_param = param->dw_param;
+
+    // the optimizer only fuses depthwise convs with explicit pads
+    auto dims_input = input_blobs_[0]->GetBlobDesc().dims;
+    int height_out  = (dims_input[2] + dw_param.pads[2] + dw_param.pads[3] -
+                      dw_param.dialations[1] * (dw_param.kernels[1] - 1) - 1) / dw_param.strides[1] + 1;
+    int width_out   = (dims_input[3] + dw_param.pads[0] + dw_param.pads[1] -
+                     dw_param.dialations[0] * (dw_param.kernels[0] - 1) - 1) / dw_param.strides[0] + 1;
+    if (height_out <= 0 || width_out <= 0) {
+        LOGE_IF(!ignore_error, "Error: ConvDwPwFusedLayer invalid height_out(%d) or width_out(%d)\n", height_out,
+                width_out);
+        return Status(TNNERR_PARAM_ERR, "ConvDwPwFusedLayer height_out or width_out is less than zero");
+    }
+
+    output_blobs_[0]->GetBlobDesc().dims = {dims_input[0], param->pw_param.output_channel, height_out, width_out};
+    return TNN_OK;
+}
+
+REGISTER_LAYER(ConvDwPwFused, LAYER_CONV_DW_PW_FUSED);
+
+}  // namespace TNN_NS
@@ -13,6 +13,7 @@
 // specific language governing permissions and limitations under the License.
 
 #include "tnn/layer/elementwise_layer.h"
+#include "tnn/utils/dims_function_utils.h"
 
 namespace TNN_NS {
 
@@ -25,10 +26,19 @@ Status GroupNormLayer::InferOutputDataType() {
 Status GroupNormLayer::InferOutputShape(bool ignore_error) {
     BaseLayer::InferOutputShape(ignore_error);
     
-    Blob* input_blob  = input_blobs_[0];
-    Blob* output_blob = output_blobs_[0];
-
-    output_blob->GetBlobDesc().dims = input_blob->GetBlobDesc().dims;
+    Blob* input_blob = input_blobs_[0];
+    auto dims_output = input_blob->GetBlobDesc().dims;
+
+    // the residual fused by net_optimizer_fuse_norm
+    if (input_blobs_.size() > 3) {
+        Status status = TNN_OK;
+        dims_output   = DimsFunctionUtils::Broadcast(dims_output, input_blobs_[3]->GetBlobDesc().dims, &status);
+        RETURN_ON_NEQ(status, TNN_OK);
+    }
+
+    for (auto output_blob : output_blobs_) {
+        output_blob->GetBlobDesc().dims = dims_output;
+    }
     return TNN_OK;
 }
 
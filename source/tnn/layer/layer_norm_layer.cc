@@ -13,6 +13,7 @@
 // specific language governing permissions and limitations under the License.
 
 #include "tnn/layer/elementwise_layer.h"
+#include "tnn/utils/dims_function_utils.h"
 
 namespace TNN_NS {
 
@@ -39,6 +40,13 @@ Status LayerNormLayer::InferOutputShape(bool ignore_error) {
     auto dims_scale = scale_blob->GetBlobDesc().dims;
     auto dims_bias = bias_blob->GetBlobDesc().dims;
 
+    // the residual fused by net_optimizer_fuse_norm
+    if (input_blobs_.size() > 3) {
+        Status status = TNN_OK;
+        dims_input    = DimsFunctionUtils::Broadcast(dims_input, input_blobs_[3]->GetBlobDesc().dims, &status);
+        RETURN_ON_NEQ(status, TNN_OK);
+    }
+
     if (layer_param->reduce_dims_size != dims_scale.size() || !DimsVectorUtils::Equal(dims_scale, dims_bias)) {
         return Status(TNNERR_PARAM_ERR, "LayerNormLayer has invalid dims for input blob of scale or bias");
     }
@@ -51,7 +59,9 @@ Status LayerNormLayer::InferOutputShape(bool ignore_error) {
         }
     }
     
-    output_blobs_[0]->GetBlobDesc().dims =dims_input;
+    for (auto output_blob : output_blobs_) {
+        output_blob->GetBlobDesc().dims = dims_input;
+    }
     
     return TNN_OK;
 }
@@ -13,6 +13,7 @@
 // specific language governing permissions and limitations under the License.
 
 #include <cmath>
+#include <utility>
 
 #include "tnn/layer/base_layer.h"
 #include "tnn/utils/dims_utils.h"
@@ -137,6 +138,12 @@ Status MatMulLayer::InferOutputShape(bool ignore_error) {
     } else {
         return Status(TNNERR_INVALID_MODEL, "MatMul input size is error");
     }
+    if (param->transpose_a && matrix_a_dims.size() >= 2) {
+        std::swap(matrix_a_dims[matrix_a_dims.size() - 1], matrix_a_dims[matrix_a_dims.size() - 2]);
+    }
+    if (param->transpose_b && matrix_b_dims.size() >= 2) {
+        std::swap(matrix_b_dims[matrix_b_dims.size() - 1], matrix_b_dims[matrix_b_dims.size() - 2]);
+    }
     param->matrix_a_dims = matrix_a_dims;
     param->matrix_b_dims = matrix_b_dims;
 
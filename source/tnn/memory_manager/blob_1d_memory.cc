@@ -22,8 +22,8 @@ Blob1DMemory::Blob1DMemory(AbstractDevice* device, BlobMemorySizeInfo& size_info
 Blob1DMemory::~Blob1DMemory() {}
 
 void Blob1DMemory::UpdateBlobMemorySizeInfo(BlobMemorySizeInfo info) {
-    int current_bytes_size = GetBlobMemoryBytesSize(size_info_);
-    int new_bytes_size     = GetBlobMemoryBytesSize(info);
+    int64_t current_bytes_size = GetBlobMemoryBytesSize(size_info_);
+    int64_t new_bytes_size     = GetBlobMemoryBytesSize(info);
     if (new_bytes_size > current_bytes_size) {
         size_info_ = info;
     }
@@ -89,7 +89,7 @@ BlobMemoryNode *Blob2DMemoryPool::ExtractNearestBlobMemoryNode(BlobMemorySizeInf
                 min_diff_exist = std::make_tuple(node_prev, node_cur, bytes_diff);
             }
         } else {
-            int target_bytes_size = GetBlobMemoryBytesSize(size_info);
+            int64_t target_bytes_size = GetBlobMemoryBytesSize(size_info);
             if (bytes_diff < target_bytes_size) {
                 // can extend
                 if (bytes_diff < std::get<2>(min_diff_extend)) {
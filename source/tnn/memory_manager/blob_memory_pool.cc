@@ -120,7 +120,7 @@ Status BlobMemoryPool::AssignAllBlobMemory(MemoryAssignStrategy &strategy) {
     return strategy.AssignAllBlobMemory(blob_memory_library_);
 }
 
-int BlobMemoryPool::GetAllBlobMemorySize() {
+int64_t BlobMemoryPool::GetAllBlobMemorySize() {
     CalculateAllBlobMemorySize();
     return all_blob_memory_size_;
 }
@@ -35,7 +35,7 @@ public:
     virtual ~BlobMemoryPool();
     BlobMemory *BorrowBlobMemory(int use_count, BlobMemorySizeInfo &size_info, bool use_new_memory = false);
     void RefundBlobMemory(BlobMemory *blob_memory);
-    int GetAllBlobMemorySize();
+    int64_t GetAllBlobMemorySize();
     Status AssignAllBlobMemory(MemoryAssignStrategy &strategy);
     virtual void ClearBlobMemoryPool();
     AbstractDevice *GetDevice();
@@ -56,7 +56,7 @@ private:
     // extract the closest BlobMemoryNode from BlobMemoryNode list
     virtual BlobMemoryNode *ExtractNearestBlobMemoryNode(BlobMemorySizeInfo &size_info);
 
-    int all_blob_memory_size_ = 0;;
+    int64_t all_blob_memory_size_ = 0;
     std::set<BlobMemory *> blob_memory_library_ = {};
 };
 
@@ -13,6 +13,10 @@
 // specific language governing permissions and limitations under the License.
 
 #include "tnn/memory_manager/blob_memory_size_info.h"
+
+#include <limits.h>
+
+#include "tnn/core/macro.h"
 #include "tnn/utils/data_type_utils.h"
 #include "tnn/utils/dims_utils.h"
 
@@ -35,4 +39,26 @@ int64_t GetBlobMemoryBytesSize(BlobMemorySizeInfo& size_info) {
     }
 }
 
+BlobMemorySizeInfo GetBytesBlobMemorySizeInfo(int64_t bytes_size) {
+    BlobMemorySizeInfo info;
+    info.data_type = DATA_TYPE_INT8;
+    if (bytes_size > INT_MAX) {
+        info.data_type = bytes_size / 4 > INT_MAX ? DATA_TYPE_INT64 : DATA_TYPE_FLOAT;
+    }
+    int elem_size = DataTypeUtils::GetBytesSize(info.data_type);
+    info.dims.push_back(static_cast<int>((bytes_size + elem_size - 1) / elem_size));
+    return info;
+}
+
+BlobMemorySizeInfo Get1DBlobMemorySizeInfo(DataType data_type, int64_t count) {
+    BlobMemorySizeInfo info;
+    info.data_type = data_type;
+    if (count > INT_MAX) {
+        LOGE("blob memory of %lld elements is out of the int range\n", (long long)count);
+        count = -1;
+    }
+    info.dims.push_back(static_cast<int>(count));
+    return info;
+}
+
 }  // namespace TNN_NS
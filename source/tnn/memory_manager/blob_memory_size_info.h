@@ -29,6 +29,14 @@ struct BlobMemorySizeInfo {
 
 int64_t GetBlobMemoryBytesSize(BlobMemorySizeInfo& size_info);
 
+// @brief 1d size info of at least bytes_size bytes. dims are int, so buffers larger than 2GB
+// use wider data types to keep the element count in range.
+BlobMemorySizeInfo GetBytesBlobMemorySizeInfo(int64_t bytes_size);
+
+// @brief 1d size info of count elements. dims are int, so counts larger than INT_MAX give an
+// invalid size of -1 elements, which the devices and the blob manager refuse to allocate.
+BlobMemorySizeInfo Get1DBlobMemorySizeInfo(DataType data_type, int64_t count);
+
 }  // namespace TNN_NS
 
 #endif  // TNN_SOURCE_TNN_MEMORY_MANAGER_BLOB_MEMORY_SIZE_INFO_H_
@@ -22,7 +22,7 @@ MemoryUnifyAssignStrategy::MemoryUnifyAssignStrategy(void* data) {
 }
 
 Status MemoryUnifyAssignStrategy::AssignAllBlobMemory(std::set<BlobMemory*>& blob_memory_library) {
-    int blob_memory_start_offset = 0;
+    int64_t blob_memory_start_offset = 0;
     for (auto& iter : blob_memory_library) {
         BlobHandle handle;
         handle.base         = all_blob_memory_data_;
@@ -25,10 +25,16 @@ bool operator<(SharedMemoryId lhs, SharedMemoryId rhs) {
     }
 }
 
+bool operator<(SharedMemoryPoolId lhs, SharedMemoryPoolId rhs) {
+    return lhs.device_type < rhs.device_type || (lhs.device_type == rhs.device_type && lhs.device_id < rhs.device_id);
+}
+
 std::map<SharedMemoryId, SharedMemory> SharedMemoryManager::s_shared_forward_memory;
 std::map<SharedMemoryId, std::vector<ISharedMemoryChangeListener *>> SharedMemoryManager::s_shared_memory_instances;
+std::mutex SharedMemoryManager::s_pool_mutex;
+std::map<SharedMemoryPoolId, SharedMemoryPool> SharedMemoryManager::s_shared_memory_pools;
 
-SharedMemory SharedMemoryManager::GetSharedMemory(int forward_memory_size, std::thread::id thread_id,
+SharedMemory SharedMemoryManager::GetSharedMemory(int64_t forward_memory_size, std::thread::id thread_id,
                                                   AbstractDevice *device, int device_id,
                                                   ISharedMemoryChangeListener *listener,
                                                   Status &status) {
@@ -40,9 +46,7 @@ SharedMemory SharedMemoryManager::GetSharedMemory(int forward_memory_size, std::
     std::vector<ISharedMemoryChangeListener *> &shared_instances = s_shared_memory_instances[memory_id];
     if (forward_memory_size > share_memory.shared_memory_size) {
         void *new_shared_memory = NULL;
-        BlobMemorySizeInfo info;
-        info.data_type = DATA_TYPE_INT8; 
-        info.dims.push_back(forward_memory_size);
+        BlobMemorySizeInfo info = GetBytesBlobMemorySizeInfo(forward_memory_size);
         status = device->Allocate(&new_shared_memory, info);
         if (status != TNN_OK) {
             return SharedMemory();
@@ -83,4 +87,92 @@ void SharedMemoryManager::ReleaseSharedMemory(std::thread::id thread_id, Abstrac
     }
 }
 
+static SharedMemoryPoolId GetPoolId(AbstractDevice *device, int device_id) {
+    SharedMemoryPoolId pool_id;
+    pool_id.device_type = device->GetDeviceType();
+    pool_id.device_id   = device_id;
+    return pool_id;
+}
+
+void SharedMemoryManager::AddPoolInstance(AbstractDevice *device, int device_id) {
+    std::lock_guard<std::mutex> guard(s_pool_mutex);
+    s_shared_memory_pools[GetPoolId(device, device_id)].instance_count++;
+}
+
+void SharedMemoryManager::RemovePoolInstance(AbstractDevice *device, int device_id) {
+    std::lock_guard<std::mutex> guard(s_pool_mutex);
+    auto pool_id = GetPoolId(device, device_id);
+    auto iter    = s_shared_memory_pools.find(pool_id);
+    if (iter == s_shared_memory_pools.end()) {
+        return;
+    }
+    SharedMemoryPool &pool = iter->second;
+    pool.instance_count--;
+    if (pool.instance_count <= 0) {
+        for (auto &arena : pool.arenas) {
+            device->Free(arena.data);
+        }
+        s_shared_memory_pools.erase(iter);
+    }
+}
+
+Status SharedMemoryManager::LeaseForwardMemory(int64_t forward_memory_size, AbstractDevice *device, int device_id,
+                                               void **memory) {
+    std::lock_guard<std::mutex> guard(s_pool_mutex);
+    SharedMemoryPool &pool = s_shared_memory_pools[GetPoolId(device, device_id)];
+
+    // the smallest free arena which is large enough, otherwise the largest free arena is grown
+    SharedMemoryArena *target = NULL;
+    for (auto &arena : pool.arenas) {
+        if (arena.leased) {
+            continue;
+        }
+        if (!target) {
+            target = &arena;
+        } else if (arena.size >= forward_memory_size) {
+            if (target->size < forward_memory_size || arena.size < target->size) {
+                target = &arena;
+            }
+        } else if (target->size < forward_memory_size && arena.size > target->size) {
+            target = &arena;
+        }
+    }
+    if (!target) {
+        pool.arenas.push_back(SharedMemoryArena());
+        target = &pool.arenas.back();
+    }
+
+    if (target->size < forward_memory_size) {
+        void *new_memory = NULL;
+        BlobMemorySizeInfo info = GetBytesBlobMemorySizeInfo(forward_memory_size);
+        Status status = device->Allocate(&new_memory, info);
+        if (status != TNN_OK) {
+            if (!target->data) {
+                pool.arenas.pop_back();
+            }
+            return status;
+        }
+        if (target->data) {
+            device->Free(target->data);
+        }
+        target->data = new_memory;
+        target->size = forward_memory_size;
+    }
+
+    target->leased = true;
+    *memory        = target->data;
+    return TNN_OK;
+}
+
+void SharedMemoryManager::ReturnForwardMemory(void *memory, AbstractDevice *device, int device_id) {
+    std::lock_guard<std::mutex> guard(s_pool_mutex);
+    SharedMemoryPool &pool = s_shared_memory_pools[GetPoolId(device, device_id)];
+    for (auto &arena : pool.arenas) {
+        if (arena.data == memory) {
+            arena.leased = false;
+            return;
+        }
+    }
+}
+
 }  // namespace TNN_NS
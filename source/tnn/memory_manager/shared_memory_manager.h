@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <map>
+#include <mutex>
 #include <queue>
 #include <set>
 #include <thread>
@@ -27,7 +28,7 @@
 namespace TNN_NS {
 
 struct SharedMemory {
-    int shared_memory_size      = 0;
+    int64_t shared_memory_size  = 0;
     void *shared_memory_data    = NULL;
     int shared_memory_ref_count = 0;
 };
@@ -38,6 +39,25 @@ struct SharedMemoryId {
     int device_id;
 };
 
+struct SharedMemoryPoolId {
+    DeviceType device_type;
+    int device_id;
+};
+
+bool operator<(SharedMemoryPoolId lhs, SharedMemoryPoolId rhs);
+
+// forward memory of the pool, leased by one instance at a time
+struct SharedMemoryArena {
+    int64_t size = 0;
+    void *data   = NULL;
+    bool leased  = false;
+};
+
+struct SharedMemoryPool {
+    std::vector<SharedMemoryArena> arenas;
+    int instance_count = 0;
+};
+
 class ISharedMemoryChangeListener {
 public:
     virtual void OnSharedForwardMemoryChanged(void *memory) = 0;
@@ -48,7 +68,7 @@ bool operator<(SharedMemoryId lhs, SharedMemoryId rhs);
 class SharedMemoryManager {
 public:
     static SharedMemory GetSharedMemory(
-        int forward_memory_size, std::thread::id thread_id,
+        int64_t forward_memory_size, std::thread::id thread_id,
         AbstractDevice *device, int device_id,
         ISharedMemoryChangeListener *listener,
         Status &status);
@@ -57,10 +77,28 @@ public:
                                     AbstractDevice *device, int device_id,
                                     ISharedMemoryChangeListener *listener);
 
+    // @brief register an instance using the forward memory pool of the device
+    static void AddPoolInstance(AbstractDevice *device, int device_id);
+
+    // @brief unregister an instance, arenas are freed with the last instance of the device
+    static void RemovePoolInstance(AbstractDevice *device, int device_id);
+
+    // @brief lease an arena of at least forward_memory_size bytes from the pool of the device.
+    // a new arena is allocated only if all arenas are leased, so the pool grows with the number
+    // of concurrent forwards, not with the number of instances.
+    static Status LeaseForwardMemory(int64_t forward_memory_size, AbstractDevice *device, int device_id,
+                                     void **memory);
+
+    // @brief return a leased arena to the pool
+    static void ReturnForwardMemory(void *memory, AbstractDevice *device, int device_id);
+
 private:
     static std::map<SharedMemoryId, SharedMemory> s_shared_forward_memory;
     static std::map<SharedMemoryId, std::vector<ISharedMemoryChangeListener *>>
         s_shared_memory_instances;
+
+    static std::mutex s_pool_mutex;
+    static std::map<SharedMemoryPoolId, SharedMemoryPool> s_shared_memory_pools;
 };
 
 }  // namespace TNN_NS
@@ -0,0 +1,170 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/optimizer/net_optimizer_dequant_weight_only.h"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "tnn/core/layer_type.h"
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/interpreter/layer_resource.h"
+#include "tnn/optimizer/net_optimizer_manager.h"
+#include "tnn/optimizer/optimizer_const.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/weight_quant_utils.h"
+
+namespace TNN_NS {
+
+namespace optimizer {
+
+    // P0 priority: other optimizers see fp32 weights
+    NetOptimizerRegister<NetOptimizerDequantWeightOnly> g_net_optimizer_dequant_weight_only(OptPriority::P0);
+
+    std::string NetOptimizerDequantWeightOnly::Strategy() {
+        return kNetOptimizerDequantWeightOnly;
+    }
+
+    bool NetOptimizerDequantWeightOnly::IsSupported(const NetworkConfig &net_config) {
+        // x86 kernels dequantize weight-only quantized weights on the fly
+        return !(net_config.device_type == DEVICE_X86 && net_config.network_type != NETWORK_TYPE_OPENVINO);
+    }
+
+    static Status DequantInnerProduct(std::shared_ptr<LayerInfo> layer, NetResource *resource) {
+        auto param = dynamic_cast<InnerProductLayerParam *>(layer->param.get());
+        auto iter  = resource->resource_map.find(layer->name);
+        if (!param || param->quantized || param->weight_quant_bits <= 0 || iter == resource->resource_map.end()) {
+            return TNN_OK;
+        }
+        auto res = dynamic_cast<InnerProductLayerResource *>(iter->second.get());
+        if (!res || res->weight_handle.GetDataType() != DATA_TYPE_INT8) {
+            return TNN_OK;
+        }
+
+        // weight dims are [oc, ic], int4 rows are padded to whole bytes
+        int oc    = param->num_output;
+        auto dims = res->weight_handle.GetBufferDims();
+        int ic    = dims.empty() ? res->weight_handle.GetBytesSize() / oc : DimsVectorUtils::Count(dims) / oc;
+
+        // resources are shared between instances, replace instead of modifying in place
+        auto fp32_res = std::make_shared<InnerProductLayerResource>(*res);
+        RETURN_ON_NEQ(DequantizeWeightOnly(res->weight_handle, res->scale_handle, oc, ic, param->weight_quant_bits,
+                                           param->weight_quant_group, fp32_res->weight_handle),
+                      TNN_OK);
+        fp32_res->scale_handle      = RawBuffer();
+        fp32_res->zero_point_handle = RawBuffer();
+        iter->second                = fp32_res;
+        param->weight_quant_bits    = 0;
+        return TNN_OK;
+    }
+
+    static Status DequantMatMul(std::shared_ptr<LayerInfo> layer, NetResource *resource) {
+        auto param = dynamic_cast<MatMulLayerParam *>(layer->param.get());
+        auto iter  = resource->resource_map.find(layer->name);
+        if (!param || param->weight_quant_bits <= 0 || iter == resource->resource_map.end()) {
+            return TNN_OK;
+        }
+        auto res = dynamic_cast<MatMulLayerResource *>(iter->second.get());
+        if (!res || res->weight.GetDataType() != DATA_TYPE_INT8) {
+            return TNN_OK;
+        }
+        auto dims = res->weight.GetBufferDims();
+        if (dims.size() != 2) {
+            return Status(TNNERR_MODEL_ERR, "MatMul weight-only quantized weight must be 2-dim");
+        }
+
+        // weight B[K * M] is stored as rows of B^T[M * K]
+        int K = dims[0];
+        int M = dims[1];
+        RawBuffer weight_t;
+        RETURN_ON_NEQ(DequantizeWeightOnly(res->weight, res->scale_handle, M, K, param->weight_quant_bits,
+                                           param->weight_quant_group, weight_t),
+                      TNN_OK);
+        RawBuffer weight(K * M * sizeof(float), dims);
+        auto src = weight_t.force_to<float *>();
+        auto dst = weight.force_to<float *>();
+        for (int k = 0; k < K; k++) {
+            for (int m = 0; m < M; m++) {
+                dst[k * M + m] = src[m * K + k];
+            }
+        }
+        weight.SetDataType(DATA_TYPE_FLOAT);
+
+        auto fp32_res            = std::make_shared<MatMulLayerResource>();
+        fp32_res->name           = res->name;
+        fp32_res->weight         = weight;
+        iter->second             = fp32_res;
+        param->weight_quant_bits = 0;
+        return TNN_OK;
+    }
+
+    static Status DequantLSTM(std::shared_ptr<LayerInfo> layer, NetResource *resource) {
+        auto param = dynamic_cast<LSTMONNXLayerParam *>(layer->param.get());
+        if (!param || param->weight_quant_bits <= 0 || layer->inputs.size() < 3) {
+            return TNN_OK;
+        }
+
+        auto &constant_map = resource->constant_map;
+        // W and R, [num_directions, 4 * hidden_size, K]
+        for (int i = 1; i <= 2; i++) {
+            auto name       = layer->inputs[i];
+            auto scale_name = name + WEIGHT_QUANT_SCALE_SUFFIX;
+            if (constant_map.find(name) == constant_map.end() ||
+                constant_map.find(scale_name) == constant_map.end()) {
+                continue;
+            }
+            auto weight = constant_map[name];
+            auto dims   = weight->GetBufferDims();
+            if (weight->GetDataType() != DATA_TYPE_INT8 || dims.size() != 3) {
+                continue;
+            }
+
+            auto fp32_weight = std::make_shared<RawBuffer>();
+            RETURN_ON_NEQ(DequantizeWeightOnly(*weight, *constant_map[scale_name], dims[0] * dims[1], dims[2],
+                                               param->weight_quant_bits, param->weight_quant_group, *fp32_weight),
+                          TNN_OK);
+            constant_map[name] = fp32_weight;
+            constant_map.erase(scale_name);
+        }
+        param->weight_quant_bits = 0;
+        return TNN_OK;
+    }
+
+    Status NetOptimizerDequantWeightOnly::Optimize(NetStructure *structure, NetResource *resource) {
+        if (!structure) {
+            LOGE("Error: empty NetStructure\n");
+            return Status(TNNERR_NET_ERR, "Error: empty NetStructure");
+        }
+        if (!resource) {
+            LOGE("Error: empty NetResource\n");
+            return Status(TNNERR_NET_ERR, "Error: empty NetResource");
+        }
+
+        for (auto layer : structure->layers) {
+            if (layer->type == LAYER_INNER_PRODUCT) {
+                RETURN_ON_NEQ(DequantInnerProduct(layer, resource), TNN_OK);
+            } else if (layer->type == LAYER_MATMUL) {
+                RETURN_ON_NEQ(DequantMatMul(layer, resource), TNN_OK);
+            } else if (layer->type == LAYER_LSTMONNX) {
+                RETURN_ON_NEQ(DequantLSTM(layer, resource), TNN_OK);
+            }
+        }
+
+        return TNN_OK;
+    }
+
+}  // namespace optimizer
+
+}  // namespace TNN_NS
@@ -36,6 +36,8 @@ namespace optimizer {
 
     bool NetOptimizerFuseConvPost::IsSupported(const NetworkConfig &net_config) {
         auto device = net_config.device_type;
+        // the map is shared by networks of different devices
+        kLayerActivationMap.clear();
         if (device == DEVICE_METAL || device == DEVICE_OPENCL || device == DEVICE_ARM || device == DEVICE_NAIVE) {
             kLayerActivationMap[LAYER_RELU]    = ActivationType_ReLU;
             kLayerActivationMap[LAYER_RELU6]   = ActivationType_ReLU6;
@@ -47,8 +49,10 @@ namespace optimizer {
             return true;
         }
         if (device == DEVICE_X86 && net_config.network_type != NETWORK_TYPE_OPENVINO) {
-            kLayerActivationMap[LAYER_RELU]  = ActivationType_ReLU;
-            kLayerActivationMap[LAYER_RELU6] = ActivationType_ReLU6;
+            kLayerActivationMap[LAYER_RELU]    = ActivationType_ReLU;
+            kLayerActivationMap[LAYER_RELU6]   = ActivationType_ReLU6;
+            kLayerActivationMap[LAYER_SIGMOID] = ActivationType_SIGMOID_MUL;
+            kLayerActivationMap[LAYER_GELU]    = ActivationType_GELU;
             return true;
         }
         return false;
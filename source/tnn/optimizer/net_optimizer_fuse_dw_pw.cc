@@ -0,0 +1,151 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/optimizer/net_optimizer_fuse_dw_pw.h"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "tnn/core/layer_type.h"
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/interpreter/layer_resource.h"
+#include "tnn/optimizer/net_optimizer_manager.h"
+#include "tnn/optimizer/optimizer_const.h"
+
+namespace TNN_NS {
+
+namespace optimizer {
+
+    // P2 priority: activations must have been fused into the convs by the P1 conv post fusion
+    NetOptimizerRegister<NetOptimizerFuseDwPw> g_net_optimizer_fuse_dw_pw(OptPriority::P2);
+
+    std::string NetOptimizerFuseDwPw::Strategy() {
+        return kNetOptimizerFuseDwPw;
+    }
+
+    bool NetOptimizerFuseDwPw::IsSupported(const NetworkConfig &net_config) {
+#ifdef TNN_CONVERTER_RUNTIME
+        return false;
+#else
+        auto device = net_config.device_type;
+        return device == DEVICE_X86 && net_config.network_type != NETWORK_TYPE_OPENVINO;
+#endif
+    }
+
+    static bool IsFloatConv(std::shared_ptr<LayerInfo> layer, NetResource *resource, ConvLayerParam *&param,
+                            ConvLayerResource *&res) {
+        if (layer->type != LAYER_CONVOLUTION || layer->inputs.size() != 1 || layer->outputs.size() != 1) {
+            return false;
+        }
+        param = dynamic_cast<ConvLayerParam *>(layer->param.get());
+        if (!param || param->quantized || param->fusion_type != FusionType_None || param->pad_type != -1 ||
+            param->kernels.size() != 2 || param->strides.size() != 2 || param->dialations.size() != 2 ||
+            param->pads.size() < 4) {
+            return false;
+        }
+        auto iter = resource->resource_map.find(layer->name);
+        if (iter == resource->resource_map.end()) {
+            return false;
+        }
+        res = dynamic_cast<ConvLayerResource *>(iter->second.get());
+        if (!res || res->filter_format != OIHW) {
+            return false;
+        }
+        auto data_type = res->filter_handle.GetDataType();
+        return data_type == DATA_TYPE_FLOAT || data_type == DATA_TYPE_HALF;
+    }
+
+    static bool IsDepthwise3x3(ConvLayerParam *param, ConvLayerResource *res) {
+        return param->group > 1 && param->group == param->output_channel &&
+               res->filter_handle.GetDataCount() == param->output_channel * 9 && param->kernels[0] == 3 &&
+               param->kernels[1] == 3 && param->dialations[0] == 1 && param->dialations[1] == 1;
+    }
+
+    static bool IsPointwise(ConvLayerParam *param, ConvLayerResource *res, int input_channel) {
+        return param->group == 1 && param->kernels[0] == 1 && param->kernels[1] == 1 && param->strides[0] == 1 &&
+               param->strides[1] == 1 && param->dialations[0] == 1 && param->dialations[1] == 1 &&
+               param->pads[0] == 0 && param->pads[1] == 0 && param->pads[2] == 0 && param->pads[3] == 0 &&
+               res->filter_handle.GetDataCount() == param->output_channel * input_channel;
+    }
+
+    Status NetOptimizerFuseDwPw::Optimize(NetStructure *structure, NetResource *resource) {
+        if (!structure) {
+            LOGE("Error: empty NetStructure\n");
+            return Status(TNNERR_NET_ERR, "Error: empty NetStructure");
+        }
+
+        std::map<std::string, int> blob_uses;
+        for (auto layer : structure->layers) {
+            for (auto &input : layer->inputs) {
+                blob_uses[input]++;
+            }
+        }
+
+        std::vector<std::shared_ptr<LayerInfo>> layers_orig = structure->layers;
+        const int count                                     = (const int)layers_orig.size();
+        std::vector<std::shared_ptr<LayerInfo>> layers_fused;
+        for (int index = 0; index < count; index++) {
+            auto layer_dw = layers_orig[index];
+            ConvLayerParam *dw_param, *pw_param;
+            ConvLayerResource *dw_res, *pw_res;
+            if (index + 1 >= count || !IsFloatConv(layer_dw, resource, dw_param, dw_res) ||
+                !IsDepthwise3x3(dw_param, dw_res)) {
+                layers_fused.push_back(layer_dw);
+                continue;
+            }
+            // the depthwise output must be read by the pointwise conv only
+            auto layer_pw   = layers_orig[index + 1];
+            auto dw_output  = layer_dw->outputs[0];
+            if (!IsFloatConv(layer_pw, resource, pw_param, pw_res) || layer_pw->inputs[0] != dw_output ||
+                !IsPointwise(pw_param, pw_res, dw_param->output_channel) || blob_uses[dw_output] != 1 ||
+                structure->outputs.count(dw_output) > 0) {
+                layers_fused.push_back(layer_dw);
+                continue;
+            }
+
+            auto fused_param      = std::make_shared<ConvDwPwFusedLayerParam>();
+            fused_param->name     = layer_pw->name;
+            fused_param->type     = "ConvDwPwFused";
+            fused_param->dw_param = *dw_param;
+            fused_param->pw_param = *pw_param;
+
+            auto fused_res         = std::make_shared<ConvDwPwFusedLayerResource>();
+            fused_res->name        = layer_pw->name;
+            fused_res->dw_resource = *dw_res;
+            fused_res->pw_resource = *pw_res;
+
+            auto layer_fused      = std::make_shared<LayerInfo>();
+            layer_fused->type     = LAYER_CONV_DW_PW_FUSED;
+            layer_fused->type_str = "ConvDwPwFused";
+            layer_fused->name     = layer_pw->name;
+            layer_fused->inputs   = layer_dw->inputs;
+            layer_fused->outputs  = layer_pw->outputs;
+            layer_fused->param    = fused_param;
+            layers_fused.push_back(layer_fused);
+
+            resource->resource_map.erase(layer_dw->name);
+            resource->resource_map[layer_pw->name] = fused_res;
+            structure->blobs.erase(dw_output);
+            index++;
+        }
+        structure->layers = layers_fused;
+
+        return TNN_OK;
+    }
+
+}  // namespace optimizer
+
+}  // namespace TNN_NS
@@ -0,0 +1,268 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/optimizer/net_optimizer_fuse_norm.h"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "tnn/core/layer_type.h"
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/interpreter/layer_resource.h"
+#include "tnn/optimizer/net_optimizer_manager.h"
+#include "tnn/optimizer/optimizer_const.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+namespace optimizer {
+
+    // P1 priority: same as the activation fusion of convolution
+    NetOptimizerRegister<NetOptimizerFuseNorm> g_net_optimizer_fuse_norm(OptPriority::P1);
+
+    std::string NetOptimizerFuseNorm::Strategy() {
+        return kNetOptimizerFuseNorm;
+    }
+
+    bool NetOptimizerFuseNorm::IsSupported(const NetworkConfig &net_config) {
+#ifdef TNN_CONVERTER_RUNTIME
+        return false;
+#else
+        auto device = net_config.device_type;
+        kLayerActivationMap.clear();
+        if (device == DEVICE_X86 && net_config.network_type != NETWORK_TYPE_OPENVINO) {
+            kLayerActivationMap[LAYER_RELU]    = ActivationType_ReLU;
+            kLayerActivationMap[LAYER_RELU6]   = ActivationType_ReLU6;
+            kLayerActivationMap[LAYER_SIGMOID] = ActivationType_SIGMOID_MUL;
+            kLayerActivationMap[LAYER_GELU]    = ActivationType_GELU;
+            return true;
+        }
+        return false;
+#endif
+    }
+
+    // activation_type of the float LayerNorm or GroupNorm, nullptr for other layers
+    static int *GetNormActivation(std::shared_ptr<LayerInfo> layer_info) {
+        if (layer_info->param->quantized || layer_info->inputs.size() != 3 || layer_info->outputs.size() != 1) {
+            return nullptr;
+        }
+        if (layer_info->type == LAYER_LAYER_NORM) {
+            auto param = dynamic_cast<LayerNormLayerParam *>(layer_info->param.get());
+            return param ? &param->activation_type : nullptr;
+        }
+        if (layer_info->type == LAYER_GROUP_NORM) {
+            auto param = dynamic_cast<GroupNormLayerParam *>(layer_info->param.get());
+            return param ? &param->activation_type : nullptr;
+        }
+        return nullptr;
+    }
+
+    // whether blob is an output of the net or an input of layers from begin
+    static bool IsUsedAfter(NetStructure *structure, const std::vector<std::shared_ptr<LayerInfo>> &layers, int begin,
+                            const std::string &blob) {
+        if (structure->outputs.find(blob) != structure->outputs.end()) {
+            return true;
+        }
+        for (int i = begin; i < layers.size(); i++) {
+            for (const auto &input : layers[i]->inputs) {
+                if (input == blob) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    static int CountUses(const std::vector<std::shared_ptr<LayerInfo>> &layers, const std::string &blob) {
+        int uses = 0;
+        for (const auto &layer_info : layers) {
+            for (const auto &input : layer_info->inputs) {
+                uses += input == blob;
+            }
+        }
+        return uses;
+    }
+
+    static DimsVector StripLeadingOnes(DimsVector dims) {
+        while (!dims.empty() && dims[0] == 1) {
+            dims.erase(dims.begin());
+        }
+        return dims;
+    }
+
+    // the float constant of a Mul or Add with a single input, if it broadcasts like the scale of the norm
+    static RawBuffer *GetAffineConstant(std::shared_ptr<LayerInfo> layer_info, std::shared_ptr<LayerInfo> norm_info,
+                                        NetResource *resource, RawBuffer &scale) {
+        if ((layer_info->type != LAYER_MUL && layer_info->type != LAYER_ADD) || layer_info->inputs.size() != 1 ||
+            layer_info->outputs.size() != 1 || layer_info->param->quantized) {
+            return nullptr;
+        }
+        auto iter = resource->resource_map.find(layer_info->name);
+        if (iter == resource->resource_map.end()) {
+            return nullptr;
+        }
+        auto layer_resource = dynamic_cast<EltwiseLayerResource *>(iter->second.get());
+        if (!layer_resource || layer_resource->element_handle.GetDataType() != DATA_TYPE_FLOAT) {
+            return nullptr;
+        }
+
+        auto &constant = layer_resource->element_handle;
+        if (constant.GetDataCount() == 1) {
+            return &constant;
+        }
+        // per element constants only match the per element scale of LayerNorm, the channel scale of
+        // GroupNorm can not be told apart from other broadcasts without the blob shapes
+        if (norm_info->type == LAYER_LAYER_NORM && constant.GetDataCount() == scale.GetDataCount() &&
+            !constant.GetBufferDims().empty() &&
+            DimsVectorUtils::Equal(StripLeadingOnes(constant.GetBufferDims()),
+                                   StripLeadingOnes(scale.GetBufferDims()))) {
+            return &constant;
+        }
+        return nullptr;
+    }
+
+    // scale and bias after y * constant or y + constant, in new buffers as other networks may hold the old ones
+    static void FoldAffine(LayerType type, RawBuffer &constant, std::shared_ptr<RawBuffer> &scale,
+                           std::shared_ptr<RawBuffer> &bias) {
+        std::shared_ptr<RawBuffer> new_scale(
+            new RawBuffer(scale->GetBytesSize(), scale->force_to<char *>(), scale->GetBufferDims()));
+        std::shared_ptr<RawBuffer> new_bias(
+            new RawBuffer(bias->GetBytesSize(), bias->force_to<char *>(), bias->GetBufferDims()));
+        new_scale->SetDataType(DATA_TYPE_FLOAT);
+        new_bias->SetDataType(DATA_TYPE_FLOAT);
+
+        auto scale_data     = new_scale->force_to<float *>();
+        auto bias_data      = new_bias->force_to<float *>();
+        auto constant_data  = constant.force_to<float *>();
+        const int count     = new_scale->GetDataCount();
+        const bool is_shared = constant.GetDataCount() == 1;
+        for (int i = 0; i < count; i++) {
+            const float c = constant_data[is_shared ? 0 : i];
+            if (type == LAYER_MUL) {
+                scale_data[i] *= c;
+                bias_data[i] *= c;
+            } else {
+                bias_data[i] += c;
+            }
+        }
+        scale = new_scale;
+        bias  = new_bias;
+    }
+
+    Status NetOptimizerFuseNorm::Optimize(NetStructure *structure, NetResource *resource) {
+        if (!structure) {
+            LOGE("Error: empty NetStructure\n");
+            return Status(TNNERR_NET_ERR, "Error: empty NetStructure");
+        }
+
+        std::vector<std::shared_ptr<LayerInfo>> layers_orig = structure->layers;
+        const int count                                     = (const int)layers_orig.size();
+        if (count <= 1) {
+            return TNN_OK;
+        }
+
+        std::vector<std::shared_ptr<LayerInfo>> layers_fused;
+        for (int index = 0; index < count; index++) {
+            auto layer_info_current = layers_orig[index];
+            int *activation_type    = GetNormActivation(layer_info_current);
+            if (!activation_type || *activation_type != ActivationType_None) {
+                layers_fused.push_back(layer_info_current);
+                continue;
+            }
+
+            // step1: the add right before the norm becomes the residual input of the norm,
+            // the sum is kept in a second output of the norm if other layers use it
+            if (!layers_fused.empty()) {
+                auto layer_info_prev = layers_fused.back();
+                if (layer_info_prev->type == LAYER_ADD && !layer_info_prev->param->quantized &&
+                    layer_info_prev->inputs.size() == 2 && layer_info_prev->outputs.size() == 1 &&
+                    layer_info_prev->outputs[0] == layer_info_current->inputs[0] &&
+                    resource->resource_map.find(layer_info_prev->name) == resource->resource_map.end()) {
+                    const auto sum_name = layer_info_prev->outputs[0];
+                    layer_info_current->inputs[0] = layer_info_prev->inputs[0];
+                    layer_info_current->inputs.push_back(layer_info_prev->inputs[1]);
+                    if (IsUsedAfter(structure, layers_orig, index + 1, sum_name)) {
+                        layer_info_current->outputs.push_back(sum_name);
+                    }
+                    layers_fused.pop_back();
+                }
+            }
+
+            // step2: fold the constant mul and add after the norm into its scale and bias
+            const auto scale_name = layer_info_current->inputs[1];
+            const auto bias_name  = layer_info_current->inputs[2];
+            auto scale_iter       = resource->constant_map.find(scale_name);
+            auto bias_iter        = resource->constant_map.find(bias_name);
+            if (scale_iter != resource->constant_map.end() && bias_iter != resource->constant_map.end() &&
+                scale_iter->second->GetDataType() == DATA_TYPE_FLOAT &&
+                bias_iter->second->GetDataType() == DATA_TYPE_FLOAT &&
+                scale_iter->second->GetDataCount() == bias_iter->second->GetDataCount() &&
+                CountUses(layers_orig, scale_name) == 1 && CountUses(layers_orig, bias_name) == 1) {
+                while (index + 1 < count) {
+                    auto layer_info_next = layers_orig[index + 1];
+                    const auto norm_output = layer_info_current->outputs[0];
+                    if (layer_info_next->inputs.size() != 1 || layer_info_next->inputs[0] != norm_output ||
+                        IsUsedAfter(structure, layers_orig, index + 2, norm_output)) {
+                        break;
+                    }
+                    auto constant =
+                        GetAffineConstant(layer_info_next, layer_info_current, resource, *scale_iter->second);
+                    if (!constant) {
+                        break;
+                    }
+                    FoldAffine(layer_info_next->type, *constant, scale_iter->second, bias_iter->second);
+                    layer_info_current->outputs[0] = layer_info_next->outputs[0];
+                    index++;
+                }
+            }
+
+            // step3: fuse the activation after the norm, sigmoid followed by mul is swish
+            if (index + 1 < count) {
+                auto layer_info_next   = layers_orig[index + 1];
+                const auto norm_output = layer_info_current->outputs[0];
+                auto activation        = kLayerActivationMap.find(layer_info_next->type);
+                if (activation != kLayerActivationMap.end() && layer_info_next->inputs.size() == 1 &&
+                    layer_info_next->inputs[0] == norm_output) {
+                    int next_index = index + 1;
+                    if (activation->second == ActivationType_SIGMOID_MUL) {
+                        next_index = -1;
+                        if (index + 2 < count) {
+                            auto layer_info_mul = layers_orig[index + 2];
+                            auto mul_inputs     = layer_info_mul->inputs;
+                            if (layer_info_mul->type == LAYER_MUL && mul_inputs.size() == 2 &&
+                                mul_inputs[0] == norm_output && mul_inputs[1] == layer_info_next->outputs[0] &&
+                                !IsUsedAfter(structure, layers_orig, index + 3, layer_info_next->outputs[0])) {
+                                next_index = index + 2;
+                            }
+                        }
+                    }
+                    if (next_index > 0 && !IsUsedAfter(structure, layers_orig, next_index + 1, norm_output)) {
+                        *activation_type               = activation->second;
+                        layer_info_current->outputs[0] = layers_orig[next_index]->outputs[0];
+                        index                          = next_index;
+                    }
+                }
+            }
+
+            layers_fused.push_back(layer_info_current);
+        }
+        structure->layers = layers_fused;
+
+        return TNN_OK;
+    }
+
+}  // namespace optimizer
+
+}  // namespace TNN_NS
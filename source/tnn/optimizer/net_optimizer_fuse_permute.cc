@@ -0,0 +1,289 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/optimizer/net_optimizer_fuse_permute.h"
+
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "tnn/core/layer_type.h"
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/optimizer/net_optimizer_manager.h"
+#include "tnn/optimizer/optimizer_const.h"
+
+namespace TNN_NS {
+
+namespace optimizer {
+
+    // P0 priority: permutes sunk below activations leave them next to the convolution for the fusions of P1
+    NetOptimizerRegister<NetOptimizerFusePermute> g_net_optimizer_fuse_permute(OptPriority::P0);
+
+    // single input layers computing each element on its own, the layout of the data does not matter to them
+    static const std::set<LayerType> kPermuteSinkLayers = {
+        LAYER_RELU, LAYER_RELU6,      LAYER_SIGMOID,     LAYER_TANH,     LAYER_GELU,    LAYER_ABS,
+        LAYER_NEG,  LAYER_EXP,        LAYER_LOG,         LAYER_SQRT,     LAYER_CLIP,    LAYER_ELU,
+        LAYER_SELU, LAYER_HARDSWISH,  LAYER_HARDSIGMOID, LAYER_SOFTPLUS, LAYER_ERF,     LAYER_SIGN,
+        LAYER_SIN,  LAYER_COS,        LAYER_FLOOR,       LAYER_CEIL,     LAYER_SOFTSIGN, LAYER_RECIPROCAL,
+        LAYER_NOT,  LAYER_LOGSIGMOID, LAYER_SOFTMAX};
+
+    std::string NetOptimizerFusePermute::Strategy() {
+        return kNetOptimizerFusePermute;
+    }
+
+    bool NetOptimizerFusePermute::IsSupported(const NetworkConfig &net_config) {
+#ifdef TNN_CONVERTER_RUNTIME
+        return false;
+#else
+        // the transpose flags of MatMul are only read by x86 and naive, the naive device is left out as the
+        // quantization tool saves the net it optimizes, and the saved model must run on the other devices
+        return net_config.device_type == DEVICE_X86 && net_config.network_type != NETWORK_TYPE_OPENVINO;
+#endif
+    }
+
+    // orders of at least size dims, completed the same way as PermuteLayer does, false if orders is invalid
+    static bool NormalizeOrders(const std::vector<int> &orders, int size, std::vector<int> &result) {
+        for (auto order : orders) {
+            if (order < 0 || std::count(orders.begin(), orders.end(), order) != 1) {
+                return false;
+            }
+            size = std::max(size, order + 1);
+        }
+        result = orders;
+        for (int i = 0; i < size; i++) {
+            if (std::find(result.begin(), result.end(), i) == result.end()) {
+                result.push_back(i);
+            }
+        }
+        return true;
+    }
+
+    static bool IsIdentityOrders(const std::vector<int> &orders) {
+        for (int i = 0; i < (int)orders.size(); i++) {
+            if (orders[i] != i) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static PermuteLayerParam *GetPermuteParam(std::shared_ptr<LayerInfo> layer_info) {
+        if (layer_info->type != LAYER_PERMUTE || layer_info->inputs.size() != 1 ||
+            layer_info->outputs.size() != 1 || layer_info->param->quantized) {
+            return nullptr;
+        }
+        return dynamic_cast<PermuteLayerParam *>(layer_info->param.get());
+    }
+
+    // index of the only layer reading blob, -1 if the blob is read more than once or is a net output
+    static int GetOnlyConsumer(NetStructure *structure, const std::string &blob) {
+        if (structure->outputs.find(blob) != structure->outputs.end()) {
+            return -1;
+        }
+        int consumer = -1;
+        for (int i = 0; i < (int)structure->layers.size(); i++) {
+            for (const auto &input : structure->layers[i]->inputs) {
+                if (input == blob) {
+                    if (consumer >= 0) {
+                        return -1;
+                    }
+                    consumer = i;
+                }
+            }
+        }
+        return consumer;
+    }
+
+    // permute(permute(x, first), second) is permute(x, first[second[i]])
+    static bool MergePermutes(NetStructure *structure, int first_index, int second_index) {
+        auto &layers = structure->layers;
+        auto first   = layers[first_index];
+        auto second  = layers[second_index]->Copy();
+        const auto &raw_first_orders = GetPermuteParam(first)->orders;
+        const auto &raw_orders       = GetPermuteParam(second)->orders;
+        std::vector<int> first_orders, orders;
+        int size = std::max(raw_first_orders.size(), raw_orders.size());
+        if (!NormalizeOrders(raw_first_orders, size, first_orders) ||
+            !NormalizeOrders(raw_orders, first_orders.size(), orders) ||
+            !NormalizeOrders(raw_first_orders, orders.size(), first_orders)) {
+            return false;
+        }
+
+        std::vector<int> merged_orders;
+        for (auto order : orders) {
+            merged_orders.push_back(first_orders[order]);
+        }
+
+        const auto input_name  = first->inputs[0];
+        const auto output_name = second->outputs[0];
+        if (IsIdentityOrders(merged_orders) && structure->outputs.find(output_name) == structure->outputs.end()) {
+            layers.erase(layers.begin() + second_index);
+            layers.erase(layers.begin() + first_index);
+            for (auto &layer_info : layers) {
+                if (std::find(layer_info->inputs.begin(), layer_info->inputs.end(), output_name) ==
+                    layer_info->inputs.end()) {
+                    continue;
+                }
+                layer_info = layer_info->Copy();
+                std::replace(layer_info->inputs.begin(), layer_info->inputs.end(), output_name, input_name);
+            }
+            return true;
+        }
+
+        GetPermuteParam(second)->orders = merged_orders;
+        second->inputs                  = first->inputs;
+        layers[second_index]            = second;
+        layers.erase(layers.begin() + first_index);
+        return true;
+    }
+
+    // layer(permute(x)) becomes permute(layer(x)), softmax reduces over the axis the permute moved
+    static bool SinkPermute(NetStructure *structure, int permute_index, int layer_index) {
+        auto &layers    = structure->layers;
+        auto permute    = layers[permute_index]->Copy();
+        auto layer_info = layers[layer_index]->Copy();
+        if (layer_info->inputs.size() != 1 || layer_info->outputs.size() != 1) {
+            return false;
+        }
+        if (layer_info->type == LAYER_SOFTMAX) {
+            auto param = dynamic_cast<SoftmaxLayerParam *>(layer_info->param.get());
+            // the rank of a negative axis is not known before reshape
+            if (!param || param->axis < 0) {
+                return false;
+            }
+            std::vector<int> orders;
+            if (!NormalizeOrders(GetPermuteParam(permute)->orders, param->axis + 1, orders)) {
+                return false;
+            }
+            param->axis = orders[param->axis];
+        }
+
+        const auto input_name  = permute->inputs[0];
+        const auto middle_name = permute->outputs[0];
+        layer_info->inputs     = {input_name};
+        permute->inputs        = {middle_name};
+        permute->outputs       = layer_info->outputs;
+        layer_info->outputs    = {middle_name};
+
+        layers[layer_index] = layer_info;
+        layers.erase(layers.begin() + permute_index);
+        layers.insert(layers.begin() + layer_index, permute);
+        return true;
+    }
+
+    // a permute swapping the last two dims is a transposed operand of MatMul
+    static bool FoldPermuteIntoMatMul(NetStructure *structure, NetResource *resource, int permute_index,
+                                      int matmul_index) {
+        auto &layers = structure->layers;
+        auto permute = layers[permute_index];
+        auto orders  = GetPermuteParam(permute)->orders;
+        // the orders must cover all the dims of an input of known rank, or the last two of them are not known
+        // before reshape
+        const auto &input_name = permute->inputs[0];
+        DimsVector input_dims;
+        if (structure->inputs_shape_map.find(input_name) != structure->inputs_shape_map.end()) {
+            input_dims = structure->inputs_shape_map[input_name];
+        } else if (resource->blob_shapes_map.find(input_name) != resource->blob_shapes_map.end()) {
+            input_dims = resource->blob_shapes_map[input_name];
+        } else {
+            return false;
+        }
+        const int rank = orders.size();
+        std::vector<int> normalized_orders;
+        if (rank < 2 || (int)input_dims.size() != rank || !NormalizeOrders(orders, rank, normalized_orders) ||
+            (int)normalized_orders.size() != rank || orders[rank - 1] != rank - 2 || orders[rank - 2] != rank - 1) {
+            return false;
+        }
+        for (int i = 0; i < rank - 2; i++) {
+            if (orders[i] != i) {
+                return false;
+            }
+        }
+
+        auto matmul = layers[matmul_index]->Copy();
+        auto param  = dynamic_cast<MatMulLayerParam *>(matmul->param.get());
+        if (!param || param->weight_quant_bits > 0 || matmul->outputs.size() != 1) {
+            return false;
+        }
+        int input_index = std::find(matmul->inputs.begin(), matmul->inputs.end(), permute->outputs[0]) -
+                          matmul->inputs.begin();
+        bool is_matrix_a = false;
+        if (matmul->inputs.size() == 2) {
+            is_matrix_a = input_index == 0;
+        } else if (matmul->inputs.size() == 1 && (param->weight_position == 0 || param->weight_position == 1)) {
+            is_matrix_a = param->weight_position == 1;
+        } else {
+            return false;
+        }
+
+        if (is_matrix_a) {
+            param->transpose_a = !param->transpose_a;
+        } else {
+            param->transpose_b = !param->transpose_b;
+        }
+        matmul->inputs[input_index] = permute->inputs[0];
+        layers[matmul_index]        = matmul;
+        layers.erase(layers.begin() + permute_index);
+        return true;
+    }
+
+    Status NetOptimizerFusePermute::Optimize(NetStructure *structure, NetResource *resource) {
+        if (!structure) {
+            LOGE("Error: empty NetStructure\n");
+            return Status(TNNERR_NET_ERR, "Error: empty NetStructure");
+        }
+
+        // every rewrite removes a permute or moves one further down the net, so the loop ends
+        bool changed = true;
+        while (changed) {
+            changed      = false;
+            auto &layers = structure->layers;
+            for (int index = 0; index < (int)layers.size() && !changed; index++) {
+                auto layer_info = layers[index];
+                auto permute_param = GetPermuteParam(layer_info);
+                std::vector<int> orders;
+                if (!permute_param || !NormalizeOrders(permute_param->orders, 0, orders)) {
+                    continue;
+                }
+                // blobs folded by the const folder keep their names in the constant map
+                const auto &input_name  = layer_info->inputs[0];
+                const auto &output_name = layer_info->outputs[0];
+                if (resource->constant_map.find(input_name) != resource->constant_map.end() ||
+                    resource->constant_map.find(output_name) != resource->constant_map.end()) {
+                    continue;
+                }
+                int consumer_index = GetOnlyConsumer(structure, output_name);
+                if (consumer_index < 0 || layers[consumer_index]->param->quantized) {
+                    continue;
+                }
+
+                auto consumer = layers[consumer_index];
+                if (GetPermuteParam(consumer)) {
+                    changed = MergePermutes(structure, index, consumer_index);
+                } else if (kPermuteSinkLayers.find(consumer->type) != kPermuteSinkLayers.end()) {
+                    changed = SinkPermute(structure, index, consumer_index);
+                } else if (consumer->type == LAYER_MATMUL) {
+                    changed = FoldPermuteIntoMatMul(structure, resource, index, consumer_index);
+                }
+            }
+        }
+
+        return TNN_OK;
+    }
+
+}  // namespace optimizer
+
+}  // namespace TNN_NS
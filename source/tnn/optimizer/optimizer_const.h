@@ -25,6 +25,9 @@ static const std::string kNetOptimizerFuseConvPost =
 static const std::string kNetOptimizerFuseConvAdd =
     "net_optimizer_fuse_conv_add";
 
+static const std::string kNetOptimizerFuseNorm =
+    "net_optimizer_fuse_norm";
+
 static const std::string kNetOptimizerCbamFusedReduce =
     "net_optimizer_cbam_fused_reduce";
 
@@ -46,6 +49,15 @@ static const std::string kNetOptimizerRemoveLayers =
 static const std::string kNetOptimizerConvertInt8Layers =
     "net_optimizer_convert_int8_layers";
 
+static const std::string kNetOptimizerDequantWeightOnly =
+    "net_optimizer_dequant_weight_only";
+
+static const std::string kNetOptimizerFusePermute =
+    "net_optimizer_fuse_permute";
+
+static const std::string kNetOptimizerFuseDwPw =
+    "net_optimizer_fuse_dw_pw";
+
 }
 
 #endif // TNN_SOURCE_TNN_OPTIMIZER_OPTIMIZER_CONST_H_
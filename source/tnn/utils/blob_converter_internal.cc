@@ -78,6 +78,94 @@ Status BlobConverter::ConvertFromMatAsync(Mat& image, MatConvertParam param, voi
     return impl_->ConvertFromMatAsync(image, param, command_queue);
 }
 
+Status BlobConverter::ConvertFromMatWithPreprocess(Mat& image, MatPreprocessParam preprocess, MatConvertParam param,
+                                                   void* command_queue) {
+    if (!impl_) {
+        return Status(TNNERR_INIT_LAYER, "image converter is nil, check device type");
+    }
+    auto mat_type = image.GetMatType();
+    if (mat_type != N8UC3 && mat_type != N8UC4 && mat_type != NGRAY && mat_type != NNV12 && mat_type != NNV21) {
+        LOGE("ConvertFromMatWithPreprocess does not support mat type %d\n", mat_type);
+        return Status(TNNERR_PARAM_ERR, "ConvertFromMatWithPreprocess only supports image mats");
+    }
+    CHECK_PARAM_NULL(blob_);
+    const auto& dims = blob_->GetBlobDesc().dims;
+    if (dims.size() != 4 || image.GetBatch() != dims[0]) {
+        return Status(TNNERR_PARAM_ERR, "ConvertFromMatWithPreprocess needs a 4-dim blob with the batch of the mat");
+    }
+    if (param.scale.size() < dims[1] || param.bias.size() < dims[1]) {
+        return Status(TNNERR_PARAM_ERR, "blob converter param is invalid, scale bias not match blob channel");
+    }
+
+    auto& crop = preprocess.crop;
+    if (crop.width <= 0) {
+        crop.width = image.GetWidth() - crop.top_left_x;
+    }
+    if (crop.height <= 0) {
+        crop.height = image.GetHeight() - crop.top_left_y;
+    }
+    if (!preprocess.warp_affine &&
+        (crop.top_left_x < 0 || crop.top_left_y < 0 || crop.width <= 0 || crop.height <= 0 ||
+         crop.top_left_x + crop.width > image.GetWidth() || crop.top_left_y + crop.height > image.GetHeight())) {
+        return Status(TNNERR_PARAM_ERR, "crop region is out of the image");
+    }
+
+    return impl_->ConvertFromMatWithPreprocess(image, preprocess, param, command_queue);
+}
+
+Status BlobConverterAcc::ConvertFromMatWithPreprocess(Mat& image, MatPreprocessParam preprocess,
+                                                      MatConvertParam param, void* command_queue) {
+    const auto dims   = blob_->GetBlobDesc().dims;
+    const int batch   = dims[0];
+    const int channel = dims[1];
+    const int height  = dims[2];
+    const int width   = dims[3];
+    Mat src           = image;
+
+    if (src.GetMatType() == NNV12 || src.GetMatType() == NNV21) {
+        Mat bgr(src.GetDeviceType(), N8UC3, {batch, 3, src.GetHeight(), src.GetWidth()});
+        auto type = src.GetMatType() == NNV12 ? COLOR_CONVERT_NV12TOBGR : COLOR_CONVERT_NV21TOBGR;
+        RETURN_ON_NEQ(MatUtils::CvtColor(src, bgr, type, command_queue), TNN_OK);
+        src = bgr;
+    }
+
+    if (preprocess.warp_affine) {
+        Mat warped(src.GetDeviceType(), src.GetMatType(), {batch, src.GetChannel(), height, width});
+        RETURN_ON_NEQ(MatUtils::WarpAffine(src, warped, preprocess.warp_affine_param, command_queue), TNN_OK);
+        src = warped;
+    } else {
+        const auto& crop = preprocess.crop;
+        if (crop.top_left_x != 0 || crop.top_left_y != 0 || crop.width != src.GetWidth() ||
+            crop.height != src.GetHeight()) {
+            Mat cropped(src.GetDeviceType(), src.GetMatType(), {batch, src.GetChannel(), crop.height, crop.width});
+            RETURN_ON_NEQ(MatUtils::Crop(src, cropped, crop, command_queue), TNN_OK);
+            src = cropped;
+        }
+        if (src.GetHeight() != height || src.GetWidth() != width) {
+            Mat resized(src.GetDeviceType(), src.GetMatType(), {batch, src.GetChannel(), height, width});
+            ResizeParam resize_param;
+            resize_param.type = preprocess.interp_type;
+            RETURN_ON_NEQ(MatUtils::Resize(src, resized, resize_param, command_queue), TNN_OK);
+            src = resized;
+        }
+    }
+
+    if (channel == 1 && src.GetMatType() != NGRAY) {
+        Mat gray(src.GetDeviceType(), NGRAY, {batch, 1, height, width});
+        ColorConversionType type;
+        if (src.GetMatType() == N8UC3) {
+            type = param.reverse_channel ? COLOR_CONVERT_RGBTOGRAY : COLOR_CONVERT_BGRTOGRAY;
+        } else {
+            type = param.reverse_channel ? COLOR_CONVERT_RGBATOGRAY : COLOR_CONVERT_BGRATOGRAY;
+        }
+        RETURN_ON_NEQ(MatUtils::CvtColor(src, gray, type, command_queue), TNN_OK);
+        src                   = gray;
+        param.reverse_channel = false;
+    }
+
+    return ConvertFromMat(src, param, command_queue);
+}
+
 Status BlobConverter::CheckScaleBiasInParam(Mat& image, MatConvertParam& param, bool convert_to_mat) {
     int channel = 0;
     if (convert_to_mat) {
@@ -34,6 +34,10 @@ public:
     virtual Status ConvertFromMat(Mat& image, MatConvertParam param, void* command_queue = NULL)      = 0;
     virtual Status ConvertFromMatAsync(Mat& image, MatConvertParam param, void* command_queue = NULL) = 0;
 
+    // runs the steps with MatUtils on intermediate mats, devices override it with fused kernels
+    virtual Status ConvertFromMatWithPreprocess(Mat& image, MatPreprocessParam preprocess, MatConvertParam param,
+                                                void* command_queue = NULL);
+
 protected:
     Blob* blob_;
 };
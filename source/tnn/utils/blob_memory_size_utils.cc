@@ -14,6 +14,9 @@
 
 #include "tnn/utils/blob_memory_size_utils.h"
 
+#include <functional>
+#include <numeric>
+
 #include "tnn/core/common.h"
 #include "tnn/core/macro.h"
 #include "tnn/utils/dims_utils.h"
@@ -21,18 +24,16 @@
 namespace TNN_NS {
 
 BlobMemorySizeInfo Calculate1DMemorySize(BlobDesc& desc) {
-    BlobMemorySizeInfo info;
-    info.data_type = desc.data_type;
-    int count      = 0;
+    // counted in int64_t, Get1DBlobMemorySizeInfo refuses the counts out of the int range
+    int64_t count = 0;
     if (desc.data_format == DATA_FORMAT_NC4HW4) {
-        count = desc.dims[0] * ROUND_UP(desc.dims[1], 4) * desc.dims[2] * desc.dims[3];
+        count = (int64_t)desc.dims[0] * ROUND_UP(desc.dims[1], 4) * desc.dims[2] * desc.dims[3];
     } else if (desc.data_format == DATA_FORMAT_NHWC4) {
-        count = desc.dims[0] * ROUND_UP(desc.dims[1], 4) * ROUND_UP(desc.dims[2] * desc.dims[3], 4);
+        count = (int64_t)desc.dims[0] * ROUND_UP(desc.dims[1], 4) * ROUND_UP((int64_t)desc.dims[2] * desc.dims[3], 4);
     } else {
-        count = DimsVectorUtils::Count(desc.dims);
+        count = std::accumulate(desc.dims.begin(), desc.dims.end(), (int64_t)1, std::multiplies<int64_t>());
     }
-    info.dims.push_back(count);
-    return info;
+    return Get1DBlobMemorySizeInfo(desc.data_type, count);
 }
 
 BlobMemorySizeInfo Calculate2DCLImageMemorySize(BlobDesc& desc) {
@@ -133,4 +133,20 @@ Status RawBuffer2Blob(RawBuffer *buffer, std::shared_ptr<Blob> &blob) {
     return TNN_OK;
 }
 
+Status RawBuffer2SharedBlob(RawBuffer *buffer, std::shared_ptr<Blob> &blob) {
+    if (!buffer) {
+        LOGE("RawBuffer2SharedBlob:: buffer is null \n");
+        return Status(TNNERR_PARAM_ERR, "RawBuffer2SharedBlob:: buffer is null");
+    }
+
+    BlobDesc desc;
+    desc.device_type = DEVICE_NAIVE;
+    desc.data_type   = buffer->GetDataType();
+    desc.dims        = buffer->GetBufferDims();
+    BlobHandle handle;
+    handle.base = buffer->GetBytesSize() > 0 ? buffer->force_to<void *>() : nullptr;
+    blob        = std::make_shared<Blob>(desc, handle);
+    return TNN_OK;
+}
+
 }  // namespace TNN_NS
@@ -30,6 +30,9 @@ Status CopyFromDevice(Blob *blob, Blob *src, void *command_queue);
 Status Blob2RawBuffer(Blob *blob, std::shared_ptr<RawBuffer> &buffer);
 // @brief transfer rawbuffer to blob. The device of blob will be DEVICE_NAIVE
 Status RawBuffer2Blob(RawBuffer *buffer, std::shared_ptr<Blob> &blob);
+// @brief wrap the data of rawbuffer in a blob of DEVICE_NAIVE without copy, the blob must not outlive the
+// buffer and must not be written
+Status RawBuffer2SharedBlob(RawBuffer *buffer, std::shared_ptr<Blob> &blob);
 }  // namespace TNN_NS
 
 #endif  // TNN_INCLUDE_TNN_UTILS_BLOB_TRANSFER_UTILS_H
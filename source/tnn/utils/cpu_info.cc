@@ -18,6 +18,8 @@
 
 #include <alloca.h>
 #include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 
@@ -657,4 +659,46 @@ struct cpuinfo_arm_chipset cpuinfo_arm_android_decode_chipset(const struct cpuin
     return chipset;
 }
 
+static bool read_sysfs_line(const char *path, char *buffer, size_t buffer_size) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        return false;
+    }
+    bool ok = fgets(buffer, (int)buffer_size, file) != NULL;
+    fclose(file);
+    return ok;
+}
+
+uint32_t cpuinfo_linux_get_cache_size(uint32_t level) {
+    char path[128];
+    char value[64];
+    for (int index = 0; index < 16; index++) {
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/level", index);
+        if (!read_sysfs_line(path, value, sizeof(value))) {
+            break;
+        }
+        if ((uint32_t)atoi(value) != level) {
+            continue;
+        }
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/type", index);
+        /* Skip the instruction cache of the level */
+        if (read_sysfs_line(path, value, sizeof(value)) && strncmp(value, "Instruction", 11) == 0) {
+            continue;
+        }
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/size", index);
+        if (!read_sysfs_line(path, value, sizeof(value))) {
+            continue;
+        }
+        char *end     = NULL;
+        uint32_t size = (uint32_t)strtoul(value, &end, 10);
+        if (end != NULL && (*end == 'K' || *end == 'k')) {
+            size *= 1024;
+        } else if (end != NULL && (*end == 'M' || *end == 'm')) {
+            size *= 1024 * 1024;
+        }
+        return size;
+    }
+    return 0;
+}
+
 #endif  // __ANDROID__ || __linux__
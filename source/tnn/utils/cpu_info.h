@@ -75,6 +75,9 @@ void cpuinfo_arm_android_parse_properties(struct cpuinfo_android_properties *pro
 #endif
 struct cpuinfo_arm_chipset cpuinfo_arm_android_decode_chipset(const struct cpuinfo_android_properties *properties);
 
+/* Size in bytes of the data or unified cache of the given level seen by cpu0, 0 if it is not reported. */
+uint32_t cpuinfo_linux_get_cache_size(uint32_t level);
+
 #endif  // __ANDROID__ || __linux__
 
 #endif  // TNN_SOURCE_TNN_UTILS_CPU_INFO_H_
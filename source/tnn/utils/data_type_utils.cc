@@ -31,6 +31,8 @@ int DataTypeUtils::GetBytesSize(DataType data_type) {
         return 4;
     } else if (data_type == DATA_TYPE_UINT32) {
         return 4;
+    } else if (data_type == DATA_TYPE_INT64) {
+        return 8;
     } else {
         LOGE("GetBytes Undefined \n");
         return -1;
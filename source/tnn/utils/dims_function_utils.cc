@@ -49,6 +49,27 @@ DimsVector DimsFunctionUtils::Expand(DimsVector dims0, DimsVector dims1, Status
     return output_dims;
 }
 
+DimsVector DimsFunctionUtils::Broadcast(DimsVector dims0, DimsVector dims1, Status *status) {
+    while (dims0.size() < dims1.size()) {
+        dims0.insert(dims0.begin(), 1);
+    }
+    while (dims1.size() < dims0.size()) {
+        dims1.insert(dims1.begin(), 1);
+    }
+
+    auto output_dims = dims0;
+    for (int i = 0; i < dims0.size(); ++i) {
+        if (dims0[i] == 1) {
+            output_dims[i] = dims1[i];
+        } else if (dims1[i] != 1 && dims1[i] != dims0[i]) {
+            if (status) {
+                *status = Status(TNNERR_PARAM_ERR, "broadcast param dims error");
+            }
+        }
+    }
+    return output_dims;
+}
+
 DimsVector DimsFunctionUtils::Upsample(const DimsVector input_dims,
                                      std::vector<float> scales, std::vector<int> sizes, int mode, Status *status) {
     int num          = input_dims[0];
@@ -47,6 +47,9 @@ public:
     //       [ 5.  6.  7.  8.]
     //       [ 9. 10. 11. 12.]]]]
     static DimsVector Expand(DimsVector dims0, DimsVector dims1, Status *status);
+
+    // @brief numpy broadcast of two dims in both directions, dims are right aligned
+    static DimsVector Broadcast(DimsVector dims0, DimsVector dims1, Status *status);
     
     // @brief reshape op to reshape input dims
     static DimsVector Reshape(const DimsVector input_dims, const DimsVector shape,
@@ -0,0 +1,132 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/utils/hash_utils.h"
+
+#include <cstring>
+#include <vector>
+
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+static const uint64_t kPrime64_1 = 11400714785074694791ULL;
+static const uint64_t kPrime64_2 = 14029467366897019727ULL;
+static const uint64_t kPrime64_3 = 1609587929392839161ULL;
+static const uint64_t kPrime64_4 = 9650029242287828579ULL;
+static const uint64_t kPrime64_5 = 2870177450012600261ULL;
+
+// contents larger than one chunk are hashed in parallel
+static const size_t kDigestChunkSize = 4 << 20;
+
+static inline uint64_t Rotl64(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t Read64(const uint8_t *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint32_t Read32(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint64_t Round64(uint64_t acc, uint64_t input) {
+    acc += input * kPrime64_2;
+    acc = Rotl64(acc, 31);
+    return acc * kPrime64_1;
+}
+
+static inline uint64_t MergeRound64(uint64_t acc, uint64_t val) {
+    acc ^= Round64(0, val);
+    return acc * kPrime64_1 + kPrime64_4;
+}
+
+uint64_t Hash64(const void *data, size_t length, uint64_t seed) {
+    const uint8_t *p   = static_cast<const uint8_t *>(data);
+    const uint8_t *end = p + length;
+    uint64_t h64;
+
+    if (length >= 32) {
+        const uint8_t *limit = end - 32;
+        uint64_t v1          = seed + kPrime64_1 + kPrime64_2;
+        uint64_t v2          = seed + kPrime64_2;
+        uint64_t v3          = seed;
+        uint64_t v4          = seed - kPrime64_1;
+        do {
+            v1 = Round64(v1, Read64(p));
+            v2 = Round64(v2, Read64(p + 8));
+            v3 = Round64(v3, Read64(p + 16));
+            v4 = Round64(v4, Read64(p + 24));
+            p += 32;
+        } while (p <= limit);
+
+        h64 = Rotl64(v1, 1) + Rotl64(v2, 7) + Rotl64(v3, 12) + Rotl64(v4, 18);
+        h64 = MergeRound64(h64, v1);
+        h64 = MergeRound64(h64, v2);
+        h64 = MergeRound64(h64, v3);
+        h64 = MergeRound64(h64, v4);
+    } else {
+        h64 = seed + kPrime64_5;
+    }
+    h64 += static_cast<uint64_t>(length);
+
+    for (; p + 8 <= end; p += 8) {
+        h64 ^= Round64(0, Read64(p));
+        h64 = Rotl64(h64, 27) * kPrime64_1 + kPrime64_4;
+    }
+    if (p + 4 <= end) {
+        h64 ^= static_cast<uint64_t>(Read32(p)) * kPrime64_1;
+        h64 = Rotl64(h64, 23) * kPrime64_2 + kPrime64_3;
+        p += 4;
+    }
+    for (; p < end; p++) {
+        h64 ^= (*p) * kPrime64_5;
+        h64 = Rotl64(h64, 11) * kPrime64_1;
+    }
+
+    h64 ^= h64 >> 33;
+    h64 *= kPrime64_2;
+    h64 ^= h64 >> 29;
+    h64 *= kPrime64_3;
+    h64 ^= h64 >> 32;
+    return h64;
+}
+
+std::string ContentDigest(const std::string &content) {
+    const size_t length = content.length();
+    uint64_t digest     = 0;
+    if (length <= kDigestChunkSize) {
+        digest = Hash64(content.data(), length);
+    } else {
+        const long chunk_count = static_cast<long>((length + kDigestChunkSize - 1) / kDigestChunkSize);
+        std::vector<uint64_t> chunk_hash(chunk_count);
+        OMP_PARALLEL_FOR_
+        for (long i = 0; i < chunk_count; i++) {
+            size_t offset = i * kDigestChunkSize;
+            chunk_hash[i] = Hash64(content.data() + offset, std::min(kDigestChunkSize, length - offset));
+        }
+        digest = Hash64(chunk_hash.data(), chunk_hash.size() * sizeof(uint64_t), length);
+    }
+
+    char hex[17];
+    snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(digest));
+    return std::string(hex);
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,34 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_UTILS_HASH_UTILS_H_
+#define TNN_SOURCE_TNN_UTILS_HASH_UTILS_H_
+
+#include <cstdint>
+#include <string>
+
+#include "tnn/core/macro.h"
+
+namespace TNN_NS {
+
+// @brief 64-bit non-cryptographic hash of data, xxHash64 algorithm
+uint64_t Hash64(const void *data, size_t length, uint64_t seed = 0);
+
+// @brief hex digest of content to identify model files, not for security purposes.
+//        large contents are hashed in chunks by multiple threads, and the chunk hashes are hashed again.
+std::string ContentDigest(const std::string &content);
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_UTILS_HASH_UTILS_H_
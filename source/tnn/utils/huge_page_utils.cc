@@ -0,0 +1,57 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/utils/huge_page_utils.h"
+
+#include <stdlib.h>
+
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <sys/mman.h>
+#if defined(MADV_HUGEPAGE)
+#define TNN_HUGE_PAGE_SUPPORT 1
+#endif
+#endif
+
+namespace TNN_NS {
+
+static thread_local bool t_huge_page_enabled = false;
+
+bool HugePageEnabled() {
+    return t_huge_page_enabled;
+}
+
+void *HugePageMalloc(size_t bytes) {
+#ifdef TNN_HUGE_PAGE_SUPPORT
+    if (t_huge_page_enabled && bytes >= kHugePageSize) {
+        void *ptr = nullptr;
+        if (posix_memalign(&ptr, kHugePageSize, bytes) == 0) {
+            // advice only, the kernel keeps normal pages if transparent huge pages are disabled
+            madvise(ptr, bytes, MADV_HUGEPAGE);
+            return ptr;
+        }
+    }
+#endif
+    return malloc(bytes);
+}
+
+HugePageScope::HugePageScope(bool enable) {
+    previous_           = t_huge_page_enabled;
+    t_huge_page_enabled = enable;
+}
+
+HugePageScope::~HugePageScope() {
+    t_huge_page_enabled = previous_;
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,47 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_UTILS_HUGE_PAGE_UTILS_H_
+#define TNN_SOURCE_TNN_UTILS_HUGE_PAGE_UTILS_H_
+
+#include <cstddef>
+
+#include "tnn/core/macro.h"
+
+namespace TNN_NS {
+
+// allocations smaller than one huge page stay on normal pages
+static const size_t kHugePageSize = 2 * 1024 * 1024;
+
+// @brief whether large allocations of the calling thread are backed by huge pages
+bool HugePageEnabled();
+
+// @brief allocate memory which can be released with free(). if huge pages are enabled for the
+// calling thread and the allocation is large, the memory is aligned to huge pages and advised to be
+// backed by them. without transparent huge page support it falls back to normal pages.
+void *HugePageMalloc(size_t bytes);
+
+// @brief large allocations of the calling thread in the scope are backed by huge pages
+class HugePageScope {
+public:
+    explicit HugePageScope(bool enable);
+    ~HugePageScope();
+
+private:
+    bool previous_;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_UTILS_HUGE_PAGE_UTILS_H_
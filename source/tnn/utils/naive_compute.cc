@@ -358,6 +358,8 @@ void FloatActivate(Tacc &result, const int activation_type) {
         }
     } else if(activation_type == ActivationType_SIGMOID_MUL) {
         result = 1.0f / (1.0f + exp(-result)) * result;
+    } else if (activation_type == ActivationType_GELU) {
+        result = 0.5f * result * (erf(result * 0.707106793288165f) + 1.0f);
     }
 }
 
@@ -0,0 +1,218 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/utils/numa_utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <cerrno>
+
+#include "tnn/utils/cpu_utils.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#if defined(SYS_set_mempolicy) && defined(SYS_get_mempolicy)
+#define TNN_NUMA_SUPPORT 1
+#endif
+#endif
+
+namespace TNN_NS {
+
+#ifdef TNN_NUMA_SUPPORT
+
+// from linux/mempolicy.h
+static const int kMpolDefault   = 0;
+static const int kMpolPreferred = 1;
+
+// parse cpu list like "0-15,32-47"
+static std::vector<int> ParseCpuList(const char *list) {
+    std::vector<int> cpus;
+    const char *p = list;
+    while (*p) {
+        char *end;
+        long first = strtol(p, &end, 10);
+        if (end == p) {
+            break;
+        }
+        long last = first;
+        p         = end;
+        if (*p == '-') {
+            last = strtol(p + 1, &end, 10);
+            p    = end;
+        }
+        for (long cpu = first; cpu <= last; cpu++) {
+            cpus.push_back(static_cast<int>(cpu));
+        }
+        if (*p == ',') {
+            p++;
+        } else {
+            break;
+        }
+    }
+    return cpus;
+}
+
+static std::vector<std::vector<int>> LoadNodeCpus() {
+    std::vector<std::vector<int>> node_cpus;
+    for (int node = 0;; node++) {
+        char path[128];
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+        FILE *fp = fopen(path, "r");
+        if (!fp) {
+            break;
+        }
+        char list[4096] = {0};
+        if (!fgets(list, sizeof(list), fp)) {
+            list[0] = '\0';
+        }
+        fclose(fp);
+        node_cpus.push_back(ParseCpuList(list));
+    }
+    return node_cpus;
+}
+
+static const std::vector<std::vector<int>> &GetNodeCpus() {
+    static std::vector<std::vector<int>> node_cpus = LoadNodeCpus();
+    return node_cpus;
+}
+
+int NumaNodeCount() {
+    return std::max(static_cast<int>(GetNodeCpus().size()), 1);
+}
+
+Status NumaNodeCpus(int node, std::vector<int> &cpus) {
+    const auto &node_cpus = GetNodeCpus();
+    if (node < 0 || node >= node_cpus.size() || node_cpus[node].empty()) {
+        return Status(TNNERR_PARAM_ERR, "invalid numa node");
+    }
+    cpus = node_cpus[node];
+    return TNN_OK;
+}
+
+// node the thread is bound to, avoid setting the affinity again
+static thread_local int t_bound_node = -1;
+
+static int BindCurrentThread(int node, const std::vector<int> &cpus) {
+    if (t_bound_node == node) {
+        return 0;
+    }
+    if (CpuUtils::SetCpuAffinity(cpus) != TNN_OK) {
+        return 1;
+    }
+    t_bound_node = node;
+    return 0;
+}
+
+Status NumaBindThreads(int node, int num_threads) {
+    const auto &node_cpus = GetNodeCpus();
+    if (node < 0 || node >= node_cpus.size() || node_cpus[node].empty()) {
+        return Status(TNNERR_PARAM_ERR, "invalid numa node");
+    }
+    const auto &cpus = node_cpus[node];
+
+    int failed = 0;
+#ifdef _OPENMP
+#pragma omp parallel num_threads(std::max(num_threads, 1)) reduction(+ : failed)
+    { failed += BindCurrentThread(node, cpus); }
+#else
+    failed = BindCurrentThread(node, cpus);
+#endif
+    if (failed > 0) {
+        return Status(TNNERR_SET_CPU_AFFINITY, "bind threads to numa node failed");
+    }
+    return TNN_OK;
+}
+
+Status NumaSetPreferredNode(int node) {
+    long ret = 0;
+    if (node < 0) {
+        ret = syscall(SYS_set_mempolicy, kMpolDefault, NULL, 0);
+    } else {
+        const int bits_per_mask = 8 * sizeof(unsigned long);
+        std::vector<unsigned long> node_mask(node / bits_per_mask + 1, 0);
+        node_mask[node / bits_per_mask] |= 1UL << (node % bits_per_mask);
+        ret = syscall(SYS_set_mempolicy, kMpolPreferred, node_mask.data(), node_mask.size() * bits_per_mask + 1);
+    }
+    if (ret != 0) {
+        return Status(TNNERR_PARAM_ERR, "set numa memory policy failed");
+    }
+    return TNN_OK;
+}
+
+Status NumaGetMemoryPolicy(NumaMemoryPolicy &policy) {
+    // the mask must cover all the nodes the kernel supports, grow it until the kernel accepts it
+    const int bits_per_mask = 8 * sizeof(unsigned long);
+    for (int max_nodes = 1024; max_nodes <= 65536; max_nodes *= 2) {
+        int mode = 0;
+        std::vector<unsigned long> node_mask(max_nodes / bits_per_mask, 0);
+        long ret = syscall(SYS_get_mempolicy, &mode, node_mask.data(), (unsigned long)max_nodes, NULL, 0);
+        if (ret == 0) {
+            policy.mode      = mode;
+            policy.node_mask = node_mask;
+            return TNN_OK;
+        }
+        if (errno != EINVAL) {
+            break;
+        }
+    }
+    return Status(TNNERR_PARAM_ERR, "get numa memory policy failed");
+}
+
+Status NumaSetMemoryPolicy(const NumaMemoryPolicy &policy) {
+    const int bits_per_mask = 8 * sizeof(unsigned long);
+    const unsigned long *node_mask = policy.node_mask.empty() ? NULL : policy.node_mask.data();
+    long ret = syscall(SYS_set_mempolicy, policy.mode, node_mask, policy.node_mask.size() * bits_per_mask + 1);
+    if (ret != 0) {
+        return Status(TNNERR_PARAM_ERR, "set numa memory policy failed");
+    }
+    return TNN_OK;
+}
+
+#else
+
+// the host is regarded as a single numa node, binding to it does nothing
+int NumaNodeCount() {
+    return 1;
+}
+
+Status NumaNodeCpus(int node, std::vector<int> &cpus) {
+    return Status(TNNERR_PARAM_ERR, "numa is not supported");
+}
+
+Status NumaBindThreads(int node, int num_threads) {
+    return TNN_OK;
+}
+
+Status NumaSetPreferredNode(int node) {
+    return TNN_OK;
+}
+
+Status NumaGetMemoryPolicy(NumaMemoryPolicy &policy) {
+    policy = NumaMemoryPolicy();
+    return TNN_OK;
+}
+
+Status NumaSetMemoryPolicy(const NumaMemoryPolicy &policy) {
+    return TNN_OK;
+}
+
+#endif  // TNN_NUMA_SUPPORT
+
+}  // namespace TNN_NS
@@ -0,0 +1,80 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_UTILS_NUMA_UTILS_H_
+#define TNN_SOURCE_TNN_UTILS_NUMA_UTILS_H_
+
+#include <vector>
+
+#include "tnn/core/macro.h"
+#include "tnn/core/status.h"
+
+namespace TNN_NS {
+
+// @brief number of numa nodes of the host, 1 if numa is not available
+int NumaNodeCount();
+
+// @brief cpus of the numa node
+Status NumaNodeCpus(int node, std::vector<int> &cpus);
+
+// @brief bind the calling thread and the omp threads of its parallel regions to the cpus of the node.
+// threads already bound to the node are skipped, calling it before every forward is cheap.
+Status NumaBindThreads(int node, int num_threads);
+
+// @brief memory first touched by the calling thread is preferably allocated on the node,
+// node -1 restores the default policy (allocate on the node of the running cpu)
+Status NumaSetPreferredNode(int node);
+
+// @brief memory policy of a thread, mode and node mask as in set_mempolicy
+struct NumaMemoryPolicy {
+    int mode = 0;
+    std::vector<unsigned long> node_mask;
+};
+
+// @brief get the memory policy of the calling thread
+Status NumaGetMemoryPolicy(NumaMemoryPolicy &policy);
+
+// @brief set the memory policy of the calling thread
+Status NumaSetMemoryPolicy(const NumaMemoryPolicy &policy);
+
+// @brief memory first touched by the calling thread in the scope is allocated on the node,
+// the policy of the thread before the scope is restored on leaving it
+class NumaMemoryScope {
+public:
+    explicit NumaMemoryScope(int node) : node_(node) {
+        if (node_ >= 0) {
+            saved_ = NumaGetMemoryPolicy(prior_policy_) == TNN_OK;
+            NumaSetPreferredNode(node_);
+        }
+    }
+
+    ~NumaMemoryScope() {
+        if (node_ >= 0) {
+            if (saved_) {
+                NumaSetMemoryPolicy(prior_policy_);
+            } else {
+                NumaSetPreferredNode(-1);
+            }
+        }
+    }
+
+private:
+    int node_;
+    bool saved_ = false;
+    NumaMemoryPolicy prior_policy_;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_UTILS_NUMA_UTILS_H_
@@ -0,0 +1,115 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/utils/weight_quant_utils.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace TNN_NS {
+
+int WeightQuantGroupSize(int ic, int group) {
+    if (group <= 0 || group >= ic) {
+        return ic;
+    }
+    return group;
+}
+
+int WeightQuantGroupCount(int ic, int group) {
+    return UP_DIV(ic, WeightQuantGroupSize(ic, group));
+}
+
+int WeightQuantRowBytes(int ic, int bits) {
+    return bits == 4 ? UP_DIV(ic, 2) : ic;
+}
+
+Status QuantizeWeightOnly(const float *src, int oc, int ic, int bits, int group, int8_t *dst, float *scale) {
+    if (bits != 8 && bits != 4) {
+        return Status(TNNERR_PARAM_ERR, "weight quant bits must be 8 or 4");
+    }
+    const int q_max       = bits == 8 ? 127 : 7;
+    const int group_size  = WeightQuantGroupSize(ic, group);
+    const int group_count = WeightQuantGroupCount(ic, group);
+    const int row_bytes   = WeightQuantRowBytes(ic, bits);
+
+    memset(dst, 0, (size_t)oc * row_bytes);
+    for (int o = 0; o < oc; o++) {
+        const float *src_o = src + (size_t)o * ic;
+        int8_t *dst_o      = dst + (size_t)o * row_bytes;
+        for (int g = 0; g < group_count; g++) {
+            int k_begin   = g * group_size;
+            int k_end     = MIN(k_begin + group_size, ic);
+            float abs_max = 0.f;
+            for (int k = k_begin; k < k_end; k++) {
+                abs_max = MAX(abs_max, std::fabs(src_o[k]));
+            }
+            float s                    = abs_max / q_max;
+            scale[o * group_count + g] = s;
+            float inv_s                = s > 0.f ? 1.f / s : 0.f;
+            for (int k = k_begin; k < k_end; k++) {
+                int q = (int)std::round(src_o[k] * inv_s);
+                q     = MIN(MAX(q, -q_max), q_max);
+                if (bits == 8) {
+                    dst_o[k] = (int8_t)q;
+                } else {
+                    dst_o[k >> 1] |= (k & 1) ? (int8_t)(q << 4) : (int8_t)(q & 0x0f);
+                }
+            }
+        }
+    }
+    return TNN_OK;
+}
+
+Status DequantizeWeightOnly(const int8_t *src, const float *scale, int oc, int ic, int bits, int group, float *dst) {
+    if (bits != 8 && bits != 4) {
+        return Status(TNNERR_PARAM_ERR, "weight quant bits must be 8 or 4");
+    }
+    const int group_size  = WeightQuantGroupSize(ic, group);
+    const int group_count = WeightQuantGroupCount(ic, group);
+    const int row_bytes   = WeightQuantRowBytes(ic, bits);
+
+    for (int o = 0; o < oc; o++) {
+        const int8_t *src_o  = src + (size_t)o * row_bytes;
+        const float *scale_o = scale + o * group_count;
+        float *dst_o         = dst + (size_t)o * ic;
+        for (int k = 0; k < ic; k++) {
+            dst_o[k] = GetWeightQuantValue(src_o, k, bits) * scale_o[k / group_size];
+        }
+    }
+    return TNN_OK;
+}
+
+Status DequantizeWeightOnly(RawBuffer &weight, RawBuffer &scale, int oc, int ic, int bits, int group,
+                            RawBuffer &dst) {
+    if (weight.GetDataType() != DATA_TYPE_INT8) {
+        return Status(TNNERR_PARAM_ERR, "weight only quantized weight must be int8");
+    }
+    if (weight.GetBytesSize() < oc * WeightQuantRowBytes(ic, bits) ||
+        scale.GetDataCount() < oc * WeightQuantGroupCount(ic, group)) {
+        return Status(TNNERR_MODEL_ERR, "weight only quantized weight size is invalid");
+    }
+
+    RawBuffer scale_f32 = scale.GetDataType() == DATA_TYPE_HALF ? ConvertHalfHandle(scale) : scale;
+    RawBuffer temp(oc * ic * sizeof(float));
+    auto status = DequantizeWeightOnly(weight.force_to<int8_t *>(), scale_f32.force_to<float *>(), oc, ic, bits,
+                                       group, temp.force_to<float *>());
+    RETURN_ON_NEQ(status, TNN_OK);
+
+    temp.SetDataType(DATA_TYPE_FLOAT);
+    temp.SetBufferDims(weight.GetBufferDims());
+    dst = temp;
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
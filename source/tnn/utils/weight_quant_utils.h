@@ -0,0 +1,63 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_UTILS_WEIGHT_QUANT_UTILS_H_
+#define TNN_SOURCE_TNN_UTILS_WEIGHT_QUANT_UTILS_H_
+
+#include <stdint.h>
+
+#include "tnn/core/common.h"
+#include "tnn/core/macro.h"
+#include "tnn/core/status.h"
+#include "tnn/interpreter/raw_buffer.h"
+
+namespace TNN_NS {
+
+// Weight-only quantization layout:
+//   weights: [oc][ic] rows, int8 for bits = 8, two int4 values per byte for bits = 4
+//            (low nibble holds the even ic index), each row padded to a whole byte
+//   scales : float [oc][group_count], symmetric, group = 0 means one scale per oc
+
+// @brief number of input channels sharing one scale
+int WeightQuantGroupSize(int ic, int group);
+
+// @brief number of scales per output channel
+int WeightQuantGroupCount(int ic, int group);
+
+// @brief bytes of one quantized weight row
+int WeightQuantRowBytes(int ic, int bits);
+
+// @brief get the k-th quantized value of one weight row
+static inline int GetWeightQuantValue(const int8_t *row, int k, int bits) {
+    if (bits == 4) {
+        int8_t packed = row[k >> 1];
+        // sign extend the nibble
+        return (k & 1) ? (packed >> 4) : (int8_t)(packed << 4) >> 4;
+    }
+    return row[k];
+}
+
+// @brief quantize fp32 weights [oc][ic] into dst [oc][row_bytes] and scale [oc][group_count]
+Status QuantizeWeightOnly(const float *src, int oc, int ic, int bits, int group, int8_t *dst, float *scale);
+
+// @brief dequantize weights [oc][row_bytes] with scale [oc][group_count] into fp32 dst [oc][ic]
+Status DequantizeWeightOnly(const int8_t *src, const float *scale, int oc, int ic, int bits, int group, float *dst);
+
+// @brief dequantize a weight-only quantized RawBuffer, the dims of weight are kept
+Status DequantizeWeightOnly(RawBuffer &weight, RawBuffer &scale, int oc, int ic, int bits, int group,
+                            RawBuffer &dst);
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_UTILS_WEIGHT_QUANT_UTILS_H_
@@ -58,4 +58,8 @@ DEFINE_string(sc, "", scale_message);
 
 DEFINE_string(bi, "", bias_message);
 
+DEFINE_int32(numa, -1, numa_node_message);
+
+DEFINE_bool(hp, false, enable_huge_page_message);
+
 }  // namespace TNN_NS
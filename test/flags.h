@@ -67,6 +67,10 @@ static const char scale_message[] = "input scale: s0,s1,s2,...)";
 
 static const char bias_message[] = "input bias: b0,b1,b2,...)";
 
+static const char numa_node_message[] = "numa node to run x86 instance on(default -1, no binding)";
+
+static const char enable_huge_page_message[] = "back large memory with huge pages on linux(default false)";
+
 DECLARE_bool(h);
 
 DECLARE_string(mt);
@@ -109,6 +113,10 @@ DECLARE_string(sc);
 
 DECLARE_string(bi);
 
+DECLARE_int32(numa);
+
+DECLARE_bool(hp);
+
 }  // namespace TNN_NS
 
 #endif  // TNN_TEST_FLAGS_H_
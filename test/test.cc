@@ -78,6 +78,9 @@ namespace test {
                 return ret;
             }
             instance->SetCpuNumThreads(std::max(FLAGS_th, 1));
+            if (network_config.enable_huge_page) {
+                PrintHugePageUsage();
+            }
 
             //get blob
             BlobMap input_blob_map;
@@ -209,6 +212,8 @@ namespace test {
         printf("    -et \"<enable tune>\t%s \n", enable_tune_message);
         printf("    -sc \"<input scale>\t%s \n", scale_message);
         printf("    -bi \"<input bias>\t%s \n", bias_message);
+        printf("    -numa \"<numa node>\t%s \n", numa_node_message);
+        printf("    -hp \"<enable huge page>\t%s \n", enable_huge_page_message);
     }
 
     void SetCpuAffinity() {
@@ -231,6 +236,26 @@ namespace test {
         }
     }
 
+    void PrintHugePageUsage() {
+        // anonymous memory of the process backed by transparent huge pages
+#if defined(__linux__) && !defined(__ANDROID__)
+        std::ifstream smaps("/proc/self/smaps_rollup");
+        if (!smaps.is_open()) {
+            smaps.open("/proc/self/smaps");
+        }
+        long huge_page_kb = 0;
+        std::string line;
+        while (std::getline(smaps, line)) {
+            if (line.find("AnonHugePages:") == 0) {
+                huge_page_kb += atol(line.c_str() + strlen("AnonHugePages:"));
+            }
+        }
+        printf("huge page backed memory: %ld kB\n", huge_page_kb);
+#else
+        printf("huge page is not supported on this platform\n");
+#endif
+    }
+
     InputShapesMap GetInputShapesMap() {
         InputShapesMap input_shape;
         if(!FLAGS_is.empty()) {
@@ -310,6 +335,10 @@ namespace test {
         config.precision = ConvertPrecision(FLAGS_pr);
 
         config.enable_tune_kernel = FLAGS_et;
+
+        config.numa_node = FLAGS_numa;
+
+        config.enable_huge_page = FLAGS_hp;
 #if defined(__ANDROID__)
         config.cache_path = "/data/local/tmp/";
 #else
@@ -34,6 +34,8 @@ namespace test {
 
     void SetCpuAffinity();
 
+    void PrintHugePageUsage();
+
     InputShapesMap GetInputShapesMap();
 
     ModelConfig GetModelConfig();
@@ -0,0 +1,71 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <climits>
+
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/core/abstract_device.h"
+#include "tnn/core/instance.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/memory_manager/blob_memory_size_info.h"
+#include "tnn/utils/blob_memory_size_utils.h"
+
+namespace TNN_NS {
+
+// 64 * 128 * 512 * 512 elements are one more than INT_MAX, the size must not wrap to a small allocation
+static const DimsVector kOversizedDims = {64, 128, 512, 512};
+
+TEST(BlobMemorySizeTest, RefusesCountOutOfIntRange) {
+    BlobDesc desc;
+    desc.dims      = kOversizedDims;
+    desc.data_type = DATA_TYPE_FLOAT;
+    for (auto data_format : {DATA_FORMAT_NCHW, DATA_FORMAT_NC4HW4, DATA_FORMAT_NHWC4}) {
+        desc.data_format = data_format;
+        auto info        = Calculate1DMemorySize(desc);
+        EXPECT_LT(GetBlobMemoryBytesSize(info), 0);
+    }
+
+    // one element less is in range
+    desc.data_format = DATA_FORMAT_NCHW;
+    desc.dims        = {1, 1, 1, INT_MAX};
+    auto info        = Calculate1DMemorySize(desc);
+    EXPECT_EQ(GetBlobMemoryBytesSize(info), (int64_t)INT_MAX * sizeof(float));
+
+    desc.dims        = kOversizedDims;
+    desc.device_type = DEVICE_NAIVE;
+    auto device      = GetDevice(DEVICE_NAIVE);
+    ASSERT_NE(device, nullptr);
+    auto device_info = device->Calculate(desc);
+    void* handle     = nullptr;
+    EXPECT_NE((int)device->Allocate(&handle, device_info), TNN_OK);
+}
+
+// a net with such a blob fails to init instead of running on the wrapped size
+TEST(BlobMemorySizeTest, InstanceRefusesBlobOutOfIntRange) {
+    if (CheckDeviceSkip({DEVICE_X86, DEVICE_NAIVE})) {
+        GTEST_SKIP();
+    }
+
+    auto interpreter = GenerateEmptyInterpreter({kOversizedDims});
+    AddLayer(interpreter, "ReLU", "output0", {"input0"});
+    dynamic_cast<DefaultModelInterpreter*>(interpreter.get())->GetNetStructure()->outputs.insert("output0");
+
+    std::shared_ptr<Instance> instance;
+    EXPECT_NE((int)CreateInstance(instance, interpreter, {{"input0", kOversizedDims}}), TNN_OK);
+    EXPECT_EQ(instance, nullptr);
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,225 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "test/timer.h"
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/core/abstract_device.h"
+#include "tnn/core/blob_int8.h"
+#include "tnn/core/context.h"
+#include "tnn/utils/blob_converter.h"
+#include "tnn/utils/dims_utils.h"
+#include "tnn/utils/string_format.h"
+#include "utils/network_helpers.h"
+
+namespace TNN_NS {
+
+// the naive blob runs the staged MatUtils fallback, the device blob runs the fused preprocess of the device
+class BlobPreprocessTest
+    : public ::testing::TestWithParam<std::tuple<int, int, int, int, bool, bool, MatType, DataType>> {
+public:
+    static void SetUpTestCase() {
+        SetUpEnvironment(&cpu_, &device_, &cpu_context_, &device_context_);
+    }
+    static void TearDownTestCase() {
+        delete cpu_context_;
+        delete device_context_;
+    }
+
+protected:
+    static AbstractDevice* cpu_;
+    static AbstractDevice* device_;
+    static Context* cpu_context_;
+    static Context* device_context_;
+};
+
+AbstractDevice* BlobPreprocessTest::cpu_;
+AbstractDevice* BlobPreprocessTest::device_;
+Context* BlobPreprocessTest::cpu_context_;
+Context* BlobPreprocessTest::device_context_;
+
+INSTANTIATE_TEST_SUITE_P(BlobPreprocessTest, BlobPreprocessTest,
+                         ::testing::Combine(
+                             // batch
+                             testing::Values(1, 2),
+                             // blob channel
+                             testing::Values(1, 3),
+                             // image size
+                             testing::Values(17, 64),
+                             // blob size
+                             testing::Values(16, 23),
+                             // warp affine
+                             testing::Values(false, true),
+                             // reverse channel
+                             testing::Values(false, true),
+                             // mat type
+                             testing::Values(N8UC3, N8UC4, NGRAY),
+                             // blob data type
+                             testing::Values(DATA_TYPE_FLOAT, DATA_TYPE_INT8)));
+
+TEST_P(BlobPreprocessTest, BlobPreprocessTest) {
+    int batch               = std::get<0>(GetParam());
+    int channel             = std::get<1>(GetParam());
+    int image_size          = std::get<2>(GetParam());
+    int blob_size           = std::get<3>(GetParam());
+    bool warp_affine        = std::get<4>(GetParam());
+    bool reverse_channel    = std::get<5>(GetParam());
+    MatType mat_type        = std::get<6>(GetParam());
+    DataType blob_data_type = std::get<7>(GetParam());
+
+    DeviceType dev = ConvertDeviceType(FLAGS_dt);
+    if (blob_data_type == DATA_TYPE_INT8 && DEVICE_ARM != dev && DEVICE_X86 != dev) {
+        GTEST_SKIP();
+    }
+    if (mat_type == NGRAY && (channel != 1 || reverse_channel)) {
+        GTEST_SKIP();
+    }
+
+    int mat_channel = mat_type == N8UC4 ? 4 : (mat_type == NGRAY ? 1 : 3);
+    DimsVector mat_dims = {batch, mat_channel, image_size, image_size};
+    DimsVector blob_dims = {batch, channel, blob_size, blob_size};
+    int in_size          = DimsVectorUtils::Count(mat_dims);
+    int out_size         = DimsVectorUtils::Count(blob_dims);
+
+    std::vector<uint8_t> mat_in_data(in_size);
+    InitRandom(mat_in_data.data(), in_size, static_cast<uint8_t>(0), static_cast<uint8_t>(255));
+    std::vector<float> out_ref_data(out_size);
+    std::vector<float> out_dev_data(out_size);
+
+    BlobDesc cpu_blob_desc, device_blob_desc;
+    cpu_blob_desc.dims        = blob_dims;
+    cpu_blob_desc.device_type = DEVICE_NAIVE;
+    cpu_blob_desc.data_type   = blob_data_type;
+    cpu_blob_desc.data_format = GetDefaultDataFormat(DEVICE_NAIVE);
+
+    device_blob_desc             = cpu_blob_desc;
+    DeviceType device_type       = device_->GetDeviceType();
+    device_blob_desc.device_type = device_type;
+    device_blob_desc.data_format = GetDefaultDataFormat(device_type);
+
+    Blob* cpu_blob    = nullptr;
+    Blob* device_blob = nullptr;
+    float max_i8_diff = 0;
+    if (blob_data_type == DATA_TYPE_FLOAT) {
+        cpu_blob    = new Blob(cpu_blob_desc);
+        device_blob = new Blob(device_blob_desc);
+    } else {
+        auto int_scale = CreateIntScale(channel);
+        auto scaleptr  = int_scale->scale_handle.force_to<float*>();
+        for (int i = 0; i < channel; i++) {
+            auto s = fabs(scaleptr[i]);
+            if (s != 0 && 1.0 / s > max_i8_diff)
+                max_i8_diff = 1.0 / s;
+        }
+        auto tmp = new BlobInt8(cpu_blob_desc);
+        tmp->SetIntResource(int_scale);
+        cpu_blob = tmp;
+
+        tmp = new BlobInt8(device_blob_desc);
+        tmp->SetIntResource(int_scale);
+        device_blob = tmp;
+    }
+    BlobHandleAllocate(cpu_blob, cpu_);
+    BlobHandleAllocate(device_blob, device_);
+    void* device_command_queue;
+    device_context_->GetCommandQueue(&device_command_queue);
+
+    BlobConverter cpu_converter(cpu_blob);
+    BlobConverter device_converter(device_blob);
+
+    MatConvertParam from_mat_param;
+    from_mat_param.reverse_channel = reverse_channel;
+    from_mat_param.scale           = {};
+    from_mat_param.bias            = {};
+    float max_scale                = 0;
+    for (int i = 0; i < mat_channel; i++) {
+        from_mat_param.scale.push_back(0.017f * (i + 1));
+        from_mat_param.bias.push_back(-0.5f * i);
+        max_scale = std::max(max_scale, 0.017f * (i + 1));
+    }
+
+    MatPreprocessParam preprocess;
+    if (warp_affine) {
+        // rotate by 30 degrees around the image center and scale to the blob size
+        const float angle = 3.14159265f / 6;
+        const float ratio = (float)blob_size / image_size;
+        const float c     = image_size / 2.f;
+        float cos_a = std::cos(angle) * ratio, sin_a = std::sin(angle) * ratio;
+        float* t                                 = &preprocess.warp_affine_param.transform[0][0];
+        t[0]                                     = cos_a;
+        t[1]                                     = sin_a;
+        t[2]                                     = blob_size / 2.f - cos_a * c - sin_a * c;
+        t[3]                                     = -sin_a;
+        t[4]                                     = cos_a;
+        t[5]                                     = blob_size / 2.f + sin_a * c - cos_a * c;
+        preprocess.warp_affine                   = true;
+        preprocess.warp_affine_param.interp_type = INTERP_TYPE_LINEAR;
+        preprocess.warp_affine_param.border_type = BORDER_TYPE_CONSTANT;
+        preprocess.warp_affine_param.border_val  = 0;
+    } else {
+        preprocess.crop.top_left_x = image_size / 8;
+        preprocess.crop.top_left_y = image_size / 4;
+    }
+
+    Mat mat_in(DEVICE_NAIVE, mat_type, mat_dims, mat_in_data.data());
+
+    Status ret = cpu_converter.ConvertFromMatWithPreprocess(mat_in, preprocess, from_mat_param, NULL);
+    ASSERT_EQ((int)ret, TNN_OK) << ret.description();
+
+    test::Timer timer("");
+    int loop_cnt = FLAGS_ub ? 10 : 1;
+    for (int i = 0; i < loop_cnt; ++i) {
+        timer.Start();
+        ret = device_converter.ConvertFromMatWithPreprocess(mat_in, preprocess, from_mat_param,
+                                                            device_command_queue);
+        timer.Stop();
+        ASSERT_EQ((int)ret, TNN_OK) << ret.description();
+    }
+    if (FLAGS_ub) {
+        LOGI("ConvertFromMatWithPreprocess (device: %s  mat type: %s  dims: %s)\n", FLAGS_dt.c_str(),
+             MatTypeToString(mat_type).c_str(), DimsToString(blob_dims).c_str());
+        timer.Print();
+    }
+
+    MatConvertParam to_mat_param;
+    Mat mat_out_ref(DEVICE_NAIVE, NCHW_FLOAT, blob_dims, out_ref_data.data());
+    Mat mat_out_dev(DEVICE_NAIVE, NCHW_FLOAT, blob_dims, out_dev_data.data());
+    ASSERT_EQ((int)cpu_converter.ConvertToMat(mat_out_ref, to_mat_param, NULL), TNN_OK);
+    ASSERT_EQ((int)device_converter.ConvertToMat(mat_out_dev, to_mat_param, device_command_queue), TNN_OK);
+
+    // the staged path rounds the resized and gray images to uint8
+    float compare_eps = 2 * max_scale + 0.01f + (blob_data_type == DATA_TYPE_INT8 ? max_i8_diff : 0.f);
+    int mismatch      = 0;
+    for (int i = 0; i < out_size; i++) {
+        if (std::fabs(out_ref_data[i] - out_dev_data[i]) > compare_eps) {
+            if (mismatch == 0) {
+                printf("ERROR AT %d result %.6f ref %.6f\n", i, out_dev_data[i], out_ref_data[i]);
+            }
+            mismatch++;
+        }
+    }
+    EXPECT_EQ(mismatch, 0);
+
+    BlobHandleFree(cpu_blob, cpu_);
+    BlobHandleFree(device_blob, device_);
+    delete cpu_blob;
+    delete device_blob;
+}
+
+}  // namespace TNN_NS
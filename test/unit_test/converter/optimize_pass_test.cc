@@ -0,0 +1,297 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <set>
+
+#include "optimizer/tnn_optimize_pass.h"
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/interpreter/layer_resource.h"
+#include "tnn/interpreter/net_resource.h"
+#include "tnn/interpreter/net_structure.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+// the graphs are built by hand with AddLayer, the passes run on the net of the interpreter
+static NetStructure& GetNetStructure(std::shared_ptr<AbstractModelInterpreter> interpreter) {
+    return *dynamic_cast<DefaultModelInterpreter*>(interpreter.get())->GetNetStructure();
+}
+
+static NetResource& GetNetResource(std::shared_ptr<AbstractModelInterpreter> interpreter) {
+    return *dynamic_cast<DefaultModelInterpreter*>(interpreter.get())->GetNetResource();
+}
+
+static std::shared_ptr<RawBuffer> CreateConstant(DimsVector dims, float value) {
+    const int count = DimsVectorUtils::Count(dims);
+    auto buffer     = std::make_shared<RawBuffer>(count * sizeof(float), dims);
+    std::fill(buffer->force_to<float*>(), buffer->force_to<float*>() + count, value);
+    return buffer;
+}
+
+static void AddConstant(std::shared_ptr<AbstractModelInterpreter> interpreter, std::string name, DimsVector dims,
+                        float value) {
+    GetNetResource(interpreter).constant_map[name] = CreateConstant(dims, value);
+    GetNetStructure(interpreter).blobs.insert(name);
+}
+
+static Status RunPass(const std::string& pass_name, NetStructure& net_structure, NetResource& net_resource) {
+    auto pass = TNN_CONVERTER::TnnOptimizePassManager::get()->search(pass_name);
+    if (pass == nullptr) {
+        return Status(TNNERR_CONVERT_UNSUPPORT_PASS, "optimize pass not found");
+    }
+    return pass->exec(net_structure, net_resource);
+}
+
+static std::vector<std::string> GetLayerNames(const NetStructure& net_structure) {
+    std::vector<std::string> names;
+    for (const auto& layer : net_structure.layers) {
+        names.push_back(layer->name);
+    }
+    return names;
+}
+
+static std::shared_ptr<LayerInfo> GetLayer(const NetStructure& net_structure, const std::string& name) {
+    for (const auto& layer : net_structure.layers) {
+        if (layer->name == name) {
+            return layer;
+        }
+    }
+    return nullptr;
+}
+
+static std::shared_ptr<ReshapeLayerParam> CreateReshapeParam(std::vector<int> shape) {
+    auto param      = std::make_shared<ReshapeLayerParam>();
+    param->shape    = shape;
+    param->num_axes = (int)shape.size();
+    return param;
+}
+
+static std::shared_ptr<StrideSliceV2LayerParam> CreateSliceParam(std::vector<int> axes, std::vector<int> begins,
+                                                                 std::vector<int> ends, std::vector<int> strides) {
+    auto param     = std::make_shared<StrideSliceV2LayerParam>();
+    param->axes    = axes;
+    param->begins  = begins;
+    param->ends    = ends;
+    param->strides = strides;
+    return param;
+}
+
+TEST(ConverterOptimizePassTest, PropagateShapeConstant) {
+    auto interpreter    = GenerateEmptyInterpreter({{1, 4, 2, 2}});
+    auto& net_structure = GetNetStructure(interpreter);
+    auto& net_resource  = GetNetResource(interpreter);
+    AddConstant(interpreter, "shape", {2}, 0);
+
+    // the shape input is a constant the runtime has filled the param with
+    auto filled      = CreateReshapeParam({1, 16});
+    filled->num_axes = 4;
+    AddLayer(interpreter, "Reshape", "reshape1", {"input0", "shape"}, filled);
+    // the shape is computed at runtime
+    AddLayer(interpreter, "Shape", "dynamic_shape", {"input0"});
+    AddLayer(interpreter, "Reshape", "reshape2", {"input0", "dynamic_shape"}, CreateReshapeParam({1, 16}));
+    // the param is not filled
+    AddLayer(interpreter, "Reshape", "reshape3", {"input0", "shape"}, CreateReshapeParam({}));
+
+    ASSERT_EQ((int)RunPass("PropagateShapeConstant", net_structure, net_resource), TNN_CONVERT_OK);
+    auto reshape1 = GetLayer(net_structure, "reshape1");
+    EXPECT_EQ(reshape1->inputs, std::vector<std::string>({"input0"}));
+    EXPECT_EQ(dynamic_cast<ReshapeLayerParam*>(reshape1->param.get())->num_axes, 2);
+    EXPECT_EQ(GetLayer(net_structure, "reshape2")->inputs, std::vector<std::string>({"input0", "dynamic_shape"}));
+    EXPECT_EQ(GetLayer(net_structure, "reshape3")->inputs, std::vector<std::string>({"input0", "shape"}));
+}
+
+TEST(ConverterOptimizePassTest, AlgebraicSimplifyIdentity) {
+    DimsVector dims = {1, 3, 4, 4}, broadcast_dims = {1, 1, 4, 4};
+    auto interpreter    = GenerateEmptyInterpreter({dims, broadcast_dims});
+    auto& net_structure = GetNetStructure(interpreter);
+    auto& net_resource  = GetNetResource(interpreter);
+    net_structure.outputs = {"output0"};
+    AddConstant(interpreter, "one", {1}, 1.0f);
+    AddConstant(interpreter, "ones", dims, 1.0f);
+    AddConstant(interpreter, "zero", {1}, 0.0f);
+    for (auto name : {"input0", "mul1", "mul2", "sub1", "output0", "neg1", "neg2"}) {
+        net_resource.blob_shapes_map[name] = dims;
+    }
+    net_resource.blob_shapes_map["input1"] = broadcast_dims;
+
+    // x * 1 is x
+    AddLayer(interpreter, "Mul", "mul1", {"input0", "one"}, std::make_shared<MultidirBroadcastLayerParam>());
+    AddLayer(interpreter, "ReLU", "relu1", {"mul1"});
+    // the ones broadcast x to a larger shape
+    AddLayer(interpreter, "Mul", "mul2", {"input1", "ones"}, std::make_shared<MultidirBroadcastLayerParam>());
+    AddLayer(interpreter, "ReLU", "relu2", {"mul2"});
+    // 0 - x is not x
+    AddLayer(interpreter, "Sub", "sub1", {"zero", "input0"}, std::make_shared<MultidirBroadcastLayerParam>());
+    AddLayer(interpreter, "ReLU", "relu3", {"sub1"});
+    // the net output keeps its name
+    AddLayer(interpreter, "Mul", "output0", {"input0", "one"}, std::make_shared<MultidirBroadcastLayerParam>());
+    // neg(neg(x)) is x, the first neg is left to EliminateDeadOutput
+    AddLayer(interpreter, "Neg", "neg1", {"input0"});
+    AddLayer(interpreter, "Neg", "neg2", {"neg1"});
+    AddLayer(interpreter, "ReLU", "relu4", {"neg2"});
+
+    ASSERT_EQ((int)RunPass("AlgebraicSimplify", net_structure, net_resource), TNN_CONVERT_OK);
+    EXPECT_EQ(GetLayerNames(net_structure), std::vector<std::string>({"relu1", "mul2", "relu2", "sub1", "relu3",
+                                                                      "output0", "neg1", "relu4"}));
+    EXPECT_EQ(GetLayer(net_structure, "relu1")->inputs, std::vector<std::string>({"input0"}));
+    EXPECT_EQ(GetLayer(net_structure, "relu2")->inputs, std::vector<std::string>({"mul2"}));
+    EXPECT_EQ(GetLayer(net_structure, "relu3")->inputs, std::vector<std::string>({"sub1"}));
+    EXPECT_EQ(GetLayer(net_structure, "relu4")->inputs, std::vector<std::string>({"input0"}));
+}
+
+TEST(ConverterOptimizePassTest, AlgebraicSimplifyMerge) {
+    auto interpreter    = GenerateEmptyInterpreter({{1, 3, 4, 4}});
+    auto& net_structure = GetNetStructure(interpreter);
+    auto& net_resource  = GetNetResource(interpreter);
+
+    AddLayer(interpreter, "Reshape", "reshape1", {"input0"}, CreateReshapeParam({1, 48}));
+    AddLayer(interpreter, "Reshape", "reshape2", {"reshape1"}, CreateReshapeParam({3, 16}));
+    // 0 copies a dim of the first reshape
+    AddLayer(interpreter, "Reshape", "reshape3", {"reshape1"}, CreateReshapeParam({0, 48}));
+
+    AddLayer(interpreter, "StridedSliceV2", "slice1", {"input0"}, CreateSliceParam({2}, {1}, {4}, {1}));
+    AddLayer(interpreter, "StridedSliceV2", "slice2", {"slice1"}, CreateSliceParam({2, 3}, {1, 0}, {2, 2}, {1, 1}));
+    // a step other than 1 on an axis sliced twice
+    AddLayer(interpreter, "StridedSliceV2", "slice3", {"slice1"}, CreateSliceParam({2}, {0}, {3}, {2}));
+
+    ASSERT_EQ((int)RunPass("AlgebraicSimplify", net_structure, net_resource), TNN_CONVERT_OK);
+    EXPECT_EQ(net_structure.layers.size(), 6u);
+    EXPECT_EQ(GetLayer(net_structure, "reshape2")->inputs, std::vector<std::string>({"input0"}));
+    EXPECT_EQ(GetLayer(net_structure, "reshape3")->inputs, std::vector<std::string>({"reshape1"}));
+
+    auto slice2 = GetLayer(net_structure, "slice2");
+    auto param  = dynamic_cast<StrideSliceV2LayerParam*>(slice2->param.get());
+    EXPECT_EQ(slice2->inputs, std::vector<std::string>({"input0"}));
+    EXPECT_EQ(param->axes, std::vector<int>({2, 3}));
+    EXPECT_EQ(param->begins, std::vector<int>({2, 0}));
+    EXPECT_EQ(param->ends, std::vector<int>({3, 2}));
+    EXPECT_EQ(GetLayer(net_structure, "slice3")->inputs, std::vector<std::string>({"slice1"}));
+}
+
+TEST(ConverterOptimizePassTest, EliminateCommonSubexpression) {
+    auto interpreter    = GenerateEmptyInterpreter({{1, 4, 8, 8}});
+    auto& net_structure = GetNetStructure(interpreter);
+    auto& net_resource  = GetNetResource(interpreter);
+    net_structure.outputs = {"output0"};
+
+    AddLayer(interpreter, "Sigmoid", "sigmoid1", {"input0"});
+    AddLayer(interpreter, "Sigmoid", "sigmoid2", {"input0"});
+    AddLayer(interpreter, "Add", "add1", {"sigmoid1", "sigmoid2"}, std::make_shared<MultidirBroadcastLayerParam>());
+
+    // convs of the same param are equal only with the same weights
+    auto conv_param = CreateConvParam(4, 4, 3);
+    auto conv1_res  = CreateConvResource(conv_param);
+    AddLayer(interpreter, "Convolution", "conv1", {"input0"}, conv_param->Copy());
+    AddLayer(interpreter, "Convolution", "conv2", {"input0"}, conv_param->Copy());
+    AddLayer(interpreter, "Convolution", "conv3", {"input0"}, conv_param->Copy());
+    net_resource.resource_map["conv1"] = conv1_res;
+    net_resource.resource_map["conv2"] = CreateConvResource(conv_param);
+    net_resource.resource_map["conv3"] = std::make_shared<ConvLayerResource>(*conv1_res);
+    AddLayer(interpreter, "Add", "add2", {"conv2", "conv3"}, std::make_shared<MultidirBroadcastLayerParam>());
+
+    // the net output keeps its name
+    AddLayer(interpreter, "Sigmoid", "output0", {"input0"});
+
+    ASSERT_EQ((int)RunPass("EliminateCommonSubexpression", net_structure, net_resource), TNN_CONVERT_OK);
+    EXPECT_EQ(GetLayerNames(net_structure),
+              std::vector<std::string>({"sigmoid1", "add1", "conv1", "conv2", "add2", "output0"}));
+    EXPECT_EQ(GetLayer(net_structure, "add1")->inputs, std::vector<std::string>({"sigmoid1", "sigmoid1"}));
+    EXPECT_EQ(GetLayer(net_structure, "add2")->inputs, std::vector<std::string>({"conv2", "conv1"}));
+    EXPECT_EQ(net_resource.resource_map.count("conv3"), 0u);
+}
+
+static std::shared_ptr<InnerProductLayerParam> CreateInnerProductParam(int num_output, int has_bias,
+                                                                       int transpose = 0) {
+    auto param        = std::make_shared<InnerProductLayerParam>();
+    param->num_output = num_output;
+    param->has_bias   = has_bias;
+    param->transpose  = transpose;
+    param->axis       = 1;
+    return param;
+}
+
+static std::shared_ptr<InnerProductLayerResource> CreateInnerProductResource(int num_output, int input_size,
+                                                                             float value) {
+    auto resource           = std::make_shared<InnerProductLayerResource>();
+    resource->weight_handle = *CreateConstant({num_output, input_size}, value);
+    resource->bias_handle   = *CreateConstant({num_output}, value);
+    return resource;
+}
+
+TEST(ConverterOptimizePassTest, MergeParallelGemm) {
+    const int input_size = 8;
+    auto interpreter    = GenerateEmptyInterpreter({{1, input_size}, {1, input_size}});
+    auto& net_structure = GetNetStructure(interpreter);
+    auto& net_resource  = GetNetResource(interpreter);
+
+    AddLayer(interpreter, "InnerProduct", "ip1", {"input0"}, CreateInnerProductParam(4, 1));
+    AddLayer(interpreter, "InnerProduct", "ip2", {"input0"}, CreateInnerProductParam(2, 0));
+    // another input
+    AddLayer(interpreter, "InnerProduct", "ip3", {"input1"}, CreateInnerProductParam(4, 1));
+    // transposed weights
+    AddLayer(interpreter, "InnerProduct", "ip4", {"input0"}, CreateInnerProductParam(4, 1, 1));
+    net_resource.resource_map["ip1"] = CreateInnerProductResource(4, input_size, 1.0f);
+    net_resource.resource_map["ip2"] = CreateInnerProductResource(2, input_size, 2.0f);
+    net_resource.resource_map["ip3"] = CreateInnerProductResource(4, input_size, 3.0f);
+    net_resource.resource_map["ip4"] = CreateInnerProductResource(4, input_size, 4.0f);
+
+    ASSERT_EQ((int)RunPass("MergeParallelGemm", net_structure, net_resource), TNN_CONVERT_OK);
+    EXPECT_EQ(GetLayerNames(net_structure), std::vector<std::string>({"ip1", "ip1_split", "ip3", "ip4"}));
+    auto merged = GetLayer(net_structure, "ip1");
+    EXPECT_EQ(merged->outputs, std::vector<std::string>({"ip1_merged"}));
+    EXPECT_EQ(dynamic_cast<InnerProductLayerParam*>(merged->param.get())->num_output, 6);
+    auto split = GetLayer(net_structure, "ip1_split");
+    EXPECT_EQ(split->inputs, std::vector<std::string>({"ip1_merged"}));
+    EXPECT_EQ(split->outputs, std::vector<std::string>({"ip1", "ip2"}));
+    EXPECT_EQ(dynamic_cast<SplitVLayerParam*>(split->param.get())->slices, std::vector<int>({4, 2}));
+
+    // the weights are concatenated, the layer without bias adds zeros
+    auto resource = dynamic_cast<InnerProductLayerResource*>(net_resource.resource_map["ip1"].get());
+    ASSERT_EQ(resource->weight_handle.GetDataCount(), 6 * input_size);
+    const float* weight = resource->weight_handle.force_to<float*>();
+    EXPECT_EQ(weight[4 * input_size - 1], 1.0f);
+    EXPECT_EQ(weight[4 * input_size], 2.0f);
+    const float* bias = resource->bias_handle.force_to<float*>();
+    EXPECT_EQ(std::vector<float>(bias, bias + 6), std::vector<float>({1, 1, 1, 1, 0, 0}));
+    EXPECT_EQ(net_resource.resource_map.count("ip2"), 0u);
+}
+
+TEST(ConverterOptimizePassTest, EliminateDeadOutput) {
+    auto interpreter    = GenerateEmptyInterpreter({{1, 4}});
+    auto& net_structure = GetNetStructure(interpreter);
+    auto& net_resource  = GetNetResource(interpreter);
+    net_structure.outputs = {"output0", "output1"};
+    AddConstant(interpreter, "dead_bias", {4}, 1.0f);
+    AddConstant(interpreter, "bias", {4}, 1.0f);
+
+    AddLayer(interpreter, "ReLU", "relu1", {"input0"});
+    AddLayer(interpreter, "ReLU", "dead1", {"input0"});
+    AddLayer(interpreter, "Add", "dead2", {"dead1", "dead_bias"}, std::make_shared<MultidirBroadcastLayerParam>());
+    AddLayer(interpreter, "Add", "output0", {"relu1", "bias"}, std::make_shared<MultidirBroadcastLayerParam>());
+    // read by no layer, but a net output
+    AddLayer(interpreter, "ReLU", "output1", {"input0"});
+
+    ASSERT_EQ((int)RunPass("EliminateDeadOutput", net_structure, net_resource), TNN_CONVERT_OK);
+    EXPECT_EQ(GetLayerNames(net_structure), std::vector<std::string>({"relu1", "output0", "output1"}));
+    EXPECT_EQ(net_resource.constant_map.count("dead_bias"), 0u);
+    EXPECT_EQ(net_resource.constant_map.count("bias"), 1u);
+    EXPECT_EQ(net_structure.blobs, std::set<std::string>({"input0", "relu1", "bias", "output0", "output1"}));
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,104 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/core/instance.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+// output0 = conv1x1(relu6(dwconv3x3(input0))), x86 runs the two convs as one fused layer
+TEST(DwPwFusionTest, FuseDepthwisePointwise) {
+    if (CheckDeviceSkip({DEVICE_X86})) {
+        GTEST_SKIP();
+    }
+
+    // channel, output channel, input size, stride
+    std::vector<std::vector<int>> cases = {{13, 21, 17, 1}, {32, 16, 9, 2}, {8, 40, 30, 1}, {5, 3, 4, 2}};
+    for (auto& c : cases) {
+        const int batch = 2, channel = c[0], oc = c[1], size = c[2], stride = c[3];
+        const int out_size = (size + 2 - 3) / stride + 1;
+        DimsVector input_dims = {batch, channel, size, size};
+
+        auto interpreter = GenerateEmptyInterpreter({input_dims});
+        auto dw_param    = CreateConvParam(channel, channel, 3, stride, channel, ActivationType_ReLU6);
+        auto dw_resource = CreateConvResource(dw_param, 1.0f);
+        auto pw_param    = CreateConvParam(channel, oc, 1, 1, 1, ActivationType_ReLU);
+        auto pw_resource = CreateConvResource(pw_param, 1.0f);
+        AddLayer(interpreter, "Convolution", "dw", {"input0"}, dw_param, dw_resource);
+        AddLayer(interpreter, "Convolution", "output0", {"dw"}, pw_param, pw_resource);
+        auto net_structure = dynamic_cast<DefaultModelInterpreter*>(interpreter.get())->GetNetStructure();
+        net_structure->outputs.insert("output0");
+
+        std::shared_ptr<Instance> instance;
+        Status status = CreateInstance(instance, interpreter, {{"input0", input_dims}});
+        ASSERT_EQ((int)status, TNN_OK) << status.description();
+
+        auto structure = dynamic_cast<DefaultModelInterpreter*>(instance->GetInterpreter().get())->GetNetStructure();
+        ASSERT_EQ(structure->layers.size(), 1);
+        EXPECT_EQ(structure->layers[0]->type, LAYER_CONV_DW_PW_FUSED);
+
+        std::vector<float> input(DimsVectorUtils::Count(input_dims)), output;
+        InitRandom(input.data(), input.size(), -1.0f, 1.0f);
+        status = RunInstance(instance, input, input_dims, output);
+        ASSERT_EQ((int)status, TNN_OK) << status.description();
+        ASSERT_EQ(output.size(), (size_t)batch * oc * out_size * out_size);
+
+        float* dw_filter = dw_resource->filter_handle.force_to<float*>();
+        float* dw_bias   = dw_resource->bias_handle.force_to<float*>();
+        float* pw_filter = pw_resource->filter_handle.force_to<float*>();
+        float* pw_bias   = pw_resource->bias_handle.force_to<float*>();
+        std::vector<float> dw(channel * out_size * out_size);
+        for (int b = 0; b < batch; b++) {
+            for (int ch = 0; ch < channel; ch++) {
+                for (int oy = 0; oy < out_size; oy++) {
+                    for (int ox = 0; ox < out_size; ox++) {
+                        float sum = dw_bias[ch];
+                        for (int ky = 0; ky < 3; ky++) {
+                            for (int kx = 0; kx < 3; kx++) {
+                                int iy = oy * stride - 1 + ky, ix = ox * stride - 1 + kx;
+                                if (iy >= 0 && iy < size && ix >= 0 && ix < size) {
+                                    sum += input[((b * channel + ch) * size + iy) * size + ix] *
+                                           dw_filter[ch * 9 + ky * 3 + kx];
+                                }
+                            }
+                        }
+                        dw[(ch * out_size + oy) * out_size + ox] = std::min(std::max(sum, 0.0f), 6.0f);
+                    }
+                }
+            }
+            for (int o = 0; o < oc; o++) {
+                for (int p = 0; p < out_size * out_size; p++) {
+                    float sum = pw_bias[o];
+                    for (int ch = 0; ch < channel; ch++) {
+                        sum += dw[ch * out_size * out_size + p] * pw_filter[o * channel + ch];
+                    }
+                    EXPECT_NEAR(output[(b * oc + o) * out_size * out_size + p], std::max(sum, 0.0f), 1e-4)
+                        << "case " << channel << " " << oc << " " << size << " " << stride << " at " << b << " " << o
+                        << " " << p;
+                }
+            }
+        }
+    }
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,96 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <gtest/gtest.h>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/core/instance.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+// output0 = relu(conv(input0))
+static std::shared_ptr<AbstractModelInterpreter> GenerateConvReluInterpreter(DimsVector dims) {
+    const int channel = dims[1];
+    auto interpreter  = GenerateEmptyInterpreter({dims});
+    auto conv_param   = CreateConvParam(channel, channel, 3);
+    AddLayer(interpreter, "Convolution", "conv", {"input0"}, conv_param, CreateConvResource(conv_param));
+    AddLayer(interpreter, "ReLU", "output0", {"conv"}, std::make_shared<LayerParam>());
+    dynamic_cast<DefaultModelInterpreter*>(interpreter.get())->GetNetStructure()->outputs.insert("output0");
+    return interpreter;
+}
+
+TEST(InstanceCloneTest, MatchesTemplate) {
+    if (CheckDeviceSkip({DEVICE_X86, DEVICE_NAIVE})) {
+        GTEST_SKIP();
+    }
+
+    DimsVector dims  = {1, 8, 32, 32};
+    auto interpreter = GenerateConvReluInterpreter(dims);
+    std::shared_ptr<Instance> instance;
+    Status status = CreateInstance(instance, interpreter, {{"input0", dims}});
+    ASSERT_EQ((int)status, TNN_OK) << status.description();
+
+    // the source model gets other weights, a clone initialized from it again would not match the template
+    auto source     = dynamic_cast<DefaultModelInterpreter*>(interpreter.get());
+    auto conv_param = std::dynamic_pointer_cast<ConvLayerParam>(source->GetNetStructure()->layers[0]->param);
+    source->GetNetResource()->resource_map["conv"] = CreateConvResource(conv_param);
+
+    auto clone = instance->Clone(status);
+    ASSERT_EQ((int)status, TNN_OK) << status.description();
+    ASSERT_TRUE(clone != nullptr);
+
+    // the clone takes the optimized model of the template and shares its weights
+    auto resource       = dynamic_cast<DefaultModelInterpreter*>(instance->GetInterpreter().get())->GetNetResource();
+    auto clone_resource = dynamic_cast<DefaultModelInterpreter*>(clone->GetInterpreter().get())->GetNetResource();
+    ASSERT_EQ(clone_resource->resource_map.size(), resource->resource_map.size());
+    for (const auto& iter : resource->resource_map) {
+        EXPECT_EQ(clone_resource->resource_map[iter.first], iter.second) << iter.first;
+    }
+
+    // the clone has blobs of its own
+    int64_t memory_size = 0, clone_memory_size = 0;
+    ASSERT_EQ((int)instance->GetForwardMemorySize(memory_size), TNN_OK);
+    ASSERT_EQ((int)clone->GetForwardMemorySize(clone_memory_size), TNN_OK);
+    EXPECT_EQ(memory_size, clone_memory_size);
+
+    std::vector<float> input(DimsVectorUtils::Count(dims)), other_input(DimsVectorUtils::Count(dims));
+    InitRandom(input.data(), input.size(), -1.0f, 1.0f);
+    InitRandom(other_input.data(), other_input.size(), -1.0f, 1.0f);
+
+    std::vector<float> expect, output, other_output, output_after;
+    ASSERT_EQ((int)RunInstance(instance, input, dims, expect), TNN_OK);
+    ASSERT_EQ((int)RunInstance(clone, input, dims, output), TNN_OK);
+    EXPECT_EQ(output, expect);
+
+    // running the clone does not touch the outputs of the template
+    ASSERT_EQ((int)RunInstance(clone, other_input, dims, other_output), TNN_OK);
+    EXPECT_NE(other_output, expect);
+    std::shared_ptr<Mat> output_mat;
+    ASSERT_EQ((int)instance->GetOutputMat(output_mat, MatConvertParam(), "output0", DEVICE_NAIVE), TNN_OK);
+    const float* data = static_cast<float*>(output_mat->GetData());
+    output_after.assign(data, data + DimsVectorUtils::Count(output_mat->GetDims()));
+    EXPECT_EQ(output_after, expect);
+
+    // the clone outlives the template
+    instance.reset();
+    ASSERT_EQ((int)RunInstance(clone, input, dims, output), TNN_OK);
+    EXPECT_EQ(output, expect);
+}
+
+}  // namespace TNN_NS
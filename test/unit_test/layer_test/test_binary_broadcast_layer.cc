@@ -0,0 +1,76 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "test/unit_test/layer_test/layer_test.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+// element, scalar, channel, row, both sides broadcast and short rows, large enough to be split across threads
+static const std::vector<std::pair<DimsVector, DimsVector>> kBroadcastShapes = {
+    {{2, 8, 64, 64}, {2, 8, 64, 64}}, {{2, 8, 64, 64}, {1, 1, 1, 1}}, {{2, 8, 64, 64}, {1, 8, 1, 1}},
+    {{1, 8, 1, 1}, {2, 8, 64, 64}},   {{2, 8, 64, 64}, {1, 1, 64, 64}}, {{2, 8, 1, 64}, {2, 1, 64, 1}},
+    {{2, 8, 64, 3}, {1, 8, 1, 3}},    {{3, 1, 5, 1}, {1, 4, 1, 6}},
+};
+
+class BinaryBroadcastLayerTest : public LayerTest,
+                                 public ::testing::WithParamInterface<std::tuple<int, std::string, bool>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, BinaryBroadcastLayerTest,
+                         ::testing::Combine(testing::Range(0, (int)kBroadcastShapes.size()),
+                                            testing::Values("Add", "Sub", "Mul", "Div", "Maximum", "Minimum"),
+                                            // inputs computed by another layer, the output may reuse their memory
+                                            testing::Values(false, true)));
+
+TEST_P(BinaryBroadcastLayerTest, BinaryLayer) {
+    auto shapes            = kBroadcastShapes[std::get<0>(GetParam())];
+    std::string layer_type = std::get<1>(GetParam());
+    bool inplace           = std::get<2>(GetParam());
+    DeviceType dev         = ConvertDeviceType(FLAGS_dt);
+
+    if (DEVICE_HUAWEI_NPU == dev || DEVICE_APPLE_NPU == dev) {
+        GTEST_SKIP();
+    }
+
+    std::shared_ptr<MultidirBroadcastLayerParam> param(new MultidirBroadcastLayerParam());
+    param->name               = "Binary";
+    param->weight_input_index = -1;
+
+    auto interpreter = GenerateInterpreter(layer_type, {shapes.first, shapes.second}, param);
+    if (inplace) {
+        auto default_interpreter = dynamic_cast<DefaultModelInterpreter *>(interpreter.get());
+        auto net_structure       = default_interpreter->GetNetStructure();
+        auto binary_layer        = net_structure->layers[0];
+        for (int i = 0; i < 2; i++) {
+            std::shared_ptr<LayerInfo> abs_layer = std::make_shared<LayerInfo>();
+            abs_layer->type                      = LAYER_ABS;
+            abs_layer->type_str                  = "Abs";
+            abs_layer->name                      = "abs" + std::to_string(i);
+            abs_layer->param                     = std::make_shared<LayerParam>();
+            abs_layer->param->name               = abs_layer->name;
+            abs_layer->inputs                    = {binary_layer->inputs[i]};
+            abs_layer->outputs                   = {abs_layer->name};
+            binary_layer->inputs[i]              = abs_layer->name;
+            net_structure->blobs.insert(abs_layer->name);
+            net_structure->layers.insert(net_structure->layers.begin() + i, abs_layer);
+        }
+    }
+    Run(interpreter);
+}
+
+}  // namespace TNN_NS
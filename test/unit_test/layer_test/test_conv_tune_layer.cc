@@ -0,0 +1,194 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <dirent.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "test/flags.h"
+#include "test/unit_test/layer_test/layer_test.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/interpreter/tnn/model_packer.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+// the device instance tunes the kernel and the picked candidate must match the naive result, then every
+// candidate is forced through the tune cache and checked on random inputs as well
+class ConvTuneLayerTest : public LayerTest,
+                          public ::testing::WithParamInterface<std::tuple<int, int, int, int, int, int>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, ConvTuneLayerTest,
+                         ::testing::Combine(  // batch
+                             testing::Values(1, 2),
+                             // input channel
+                             testing::Values(4, 24),
+                             // output channel
+                             testing::Values(8, 37),
+                             // hw
+                             testing::Values(7, 20),
+                             // kernel
+                             testing::Values(1, 3),
+                             // stride
+                             testing::Values(1, 2)));
+
+TEST_P(ConvTuneLayerTest, ConvLayer) {
+    int batch          = std::get<0>(GetParam());
+    int input_channel  = std::get<1>(GetParam());
+    int output_channel = std::get<2>(GetParam());
+    int input_size     = std::get<3>(GetParam());
+    int kernel         = std::get<4>(GetParam());
+    int stride         = std::get<5>(GetParam());
+    DeviceType dev     = ConvertDeviceType(FLAGS_dt);
+
+    if (DEVICE_X86 != dev) {
+        GTEST_SKIP();
+    }
+
+    std::shared_ptr<ConvLayerParam> param(new ConvLayerParam());
+    param->name            = "Conv";
+    param->input_channel   = input_channel;
+    param->output_channel  = output_channel;
+    param->group           = 1;
+    param->kernels         = {kernel, kernel};
+    param->dialations      = {1, 1};
+    param->strides         = {stride, stride};
+    param->pads            = {kernel / 2, kernel / 2, kernel / 2, kernel / 2};
+    param->bias            = 1;
+    param->activation_type = ActivationType_ReLU;
+
+    std::vector<int> input_dims = {batch, input_channel, input_size, input_size};
+    auto interpreter            = GenerateInterpreter("Convolution", {input_dims}, param);
+
+    bool enable_tune = FLAGS_et;
+    FLAGS_et         = true;
+    Run(interpreter);
+    FLAGS_et = enable_tune;
+
+    // candidates are {X86ConvImpType, M_c, K_c} as saved in the tune cache, the gemm based impls are common
+    // and 1x1, the winograd one has no block sizes
+    std::vector<std::vector<int>> candidates;
+    std::vector<int> gemm_imps = {0};
+    if (kernel == 1 && stride == 1) {
+        gemm_imps.push_back(2);
+    }
+    for (auto imp : gemm_imps) {
+        for (int m_c : {32, 64, 128}) {
+            for (int k_c : {128, 256, 512}) {
+                candidates.push_back({imp, m_c, k_c});
+            }
+        }
+    }
+    if (kernel == 3 && stride == 1) {
+        candidates.push_back({3, 0, 0});
+    }
+
+    char cache_path[] = "conv_tune_test_XXXXXX";
+    ASSERT_TRUE(mkdtemp(cache_path) != nullptr);
+    ModelConfig model_config;
+    model_config.params = {"", ""};
+    NetworkConfig config_cpu;
+    config_cpu.device_type = DEVICE_NAIVE;
+    auto instance_cpu      = std::make_shared<Instance>(config_cpu, model_config);
+    ASSERT_EQ((int)instance_cpu->Init(interpreter, InputShapesMap()), TNN_OK);
+
+    // the cache path needs the md5 of the model params, pack the net with its random weights and load it again
+    auto default_interpreter = dynamic_cast<DefaultModelInterpreter *>(instance_cpu->GetInterpreter().get());
+    ModelPacker packer(default_interpreter->GetNetStructure(), default_interpreter->GetNetResource());
+    std::vector<std::string> param_paths = {std::string(cache_path) + "/conv.tnnproto",
+                                            std::string(cache_path) + "/conv.tnnmodel"};
+    ASSERT_EQ((int)packer.Pack(param_paths[0], param_paths[1]), TNN_OK);
+    for (int i = 0; i < 2; i++) {
+        std::ifstream param_stream(param_paths[i], std::ios::binary);
+        std::ostringstream param_content;
+        param_content << param_stream.rdbuf();
+        param_stream.close();
+        model_config.params[i] = param_content.str();
+        std::remove(param_paths[i].c_str());
+    }
+    std::shared_ptr<AbstractModelInterpreter> model_interpreter(CreateModelInterpreter(MODEL_TYPE_TNN));
+    ASSERT_EQ((int)model_interpreter->Interpret(model_config.params), TNN_OK);
+
+    NetworkConfig config;
+    config.device_type        = dev;
+    config.enable_tune_kernel = true;
+    config.cache_path         = cache_path;
+    auto instance_tune        = std::make_shared<Instance>(config, model_config);
+    ASSERT_EQ((int)instance_tune->Init(model_interpreter, InputShapesMap()), TNN_OK);
+
+    // the cache holds the only conv of the net
+    std::string cache_file;
+    DIR *dir = opendir(cache_path);
+    ASSERT_TRUE(dir != nullptr);
+    for (struct dirent *entry = readdir(dir); entry != nullptr; entry = readdir(dir)) {
+        if (std::string(entry->d_name).find("tnn_x86_tune_") == 0) {
+            cache_file = std::string(cache_path) + "/" + entry->d_name;
+        }
+    }
+    closedir(dir);
+    ASSERT_FALSE(cache_file.empty());
+    std::string key;
+    {
+        std::ifstream cache_stream(cache_file);
+        int map_size = 0;
+        cache_stream >> map_size >> key;
+        ASSERT_EQ(map_size, 1);
+    }
+
+    BlobMap input_blobs, output_blobs;
+    instance_cpu->GetAllInputBlobs(input_blobs);
+    instance_cpu->GetAllOutputBlobs(output_blobs);
+    const std::string input_name  = input_blobs.begin()->first;
+    const std::string output_name = output_blobs.begin()->first;
+    const int input_count         = DimsVectorUtils::Count(input_dims);
+    std::vector<float> input_data(input_count);
+    auto input_mat = std::make_shared<Mat>(DEVICE_NAIVE, NCHW_FLOAT, input_dims, input_data.data());
+
+    for (const auto &candidate : candidates) {
+        {
+            std::ofstream cache_stream(cache_file);
+            cache_stream << 1 << std::endl << key << " " << candidate.size();
+            for (auto value : candidate) {
+                cache_stream << " " << value;
+            }
+            cache_stream << std::endl;
+        }
+        auto instance = std::make_shared<Instance>(config, model_config);
+        ASSERT_EQ((int)instance->Init(model_interpreter, InputShapesMap()), TNN_OK);
+
+        InitRandom(input_data.data(), input_count, 1.0f);
+        std::shared_ptr<Mat> ref_mat, output_mat;
+        ASSERT_EQ((int)instance_cpu->SetInputMat(input_mat, MatConvertParam(), input_name), TNN_OK);
+        ASSERT_EQ((int)instance_cpu->Forward(), TNN_OK);
+        ASSERT_EQ((int)instance_cpu->GetOutputMat(ref_mat, MatConvertParam(), output_name, DEVICE_NAIVE), TNN_OK);
+        ASSERT_EQ((int)instance->SetInputMat(input_mat, MatConvertParam(), input_name), TNN_OK);
+        ASSERT_EQ((int)instance->Forward(), TNN_OK);
+        ASSERT_EQ((int)instance->GetOutputMat(output_mat, MatConvertParam(), output_name, DEVICE_NAIVE), TNN_OK);
+        EXPECT_EQ(0, CompareData(static_cast<float *>(ref_mat->GetData()), static_cast<float *>(output_mat->GetData()),
+                                 DimsVectorUtils::Count(ref_mat->GetDims()), 0.001f))
+            << "candidate " << candidate[0] << " " << candidate[1] << " " << candidate[2];
+    }
+
+    std::remove(cache_file.c_str());
+    rmdir(cache_path);
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,64 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "test/unit_test/layer_test/layer_test.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+// residual and activation are the fusion of net_optimizer_fuse_norm
+class GroupNormLayerTest : public LayerTest,
+                           public ::testing::WithParamInterface<std::tuple<int, int, int, int, bool, int>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, GroupNormLayerTest,
+                         ::testing::Combine(testing::Values(1, 2),          // batch
+                                            testing::Values(4, 32),         // channel
+                                            testing::Values(1, 2, 4),       // group
+                                            testing::Values(5, 16, 33),     // input_size
+                                            testing::Values(false, true),   // residual
+                                            testing::Values(ActivationType_None, ActivationType_ReLU6,
+                                                            ActivationType_SIGMOID_MUL)));
+
+TEST_P(GroupNormLayerTest, GroupNormLayer) {
+    int batch           = std::get<0>(GetParam());
+    int channel         = std::get<1>(GetParam());
+    int group           = std::get<2>(GetParam());
+    int input_size      = std::get<3>(GetParam());
+    bool residual       = std::get<4>(GetParam());
+    int activation_type = std::get<5>(GetParam());
+    DeviceType dev      = ConvertDeviceType(FLAGS_dt);
+
+    if (DEVICE_NAIVE != dev && DEVICE_X86 != dev) {
+        GTEST_SKIP();
+    }
+
+    std::shared_ptr<GroupNormLayerParam> param(new GroupNormLayerParam());
+    param->name            = "GroupNorm";
+    param->group           = group;
+    param->activation_type = activation_type;
+
+    std::vector<int> input_dims = {batch, channel, input_size, input_size};
+    std::vector<int> scale_dims = {channel};
+    std::vector<std::vector<int>> inputs_dims = {input_dims, scale_dims, scale_dims};
+    if (residual) {
+        inputs_dims.push_back(input_dims);
+    }
+
+    auto interpreter = GenerateInterpreter("GroupNorm", inputs_dims, param, nullptr, residual ? 2 : 1);
+    Run(interpreter);
+}
+
+}  // namespace TNN_NS
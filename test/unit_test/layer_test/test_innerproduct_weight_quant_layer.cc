@@ -0,0 +1,72 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "test/unit_test/layer_test/layer_test.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+class InnerProductWeightQuantLayerTest : public LayerTest,
+                                         public ::testing::WithParamInterface<std::tuple<int, int, int, int, int, int, int>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, InnerProductWeightQuantLayerTest,
+                         ::testing::Combine(testing::Values(1, 2, 9), testing::Values(3, 16, 33),
+                                            // output channel
+                                            testing::Values(1, 8, 21),
+                                            testing::Values(0, 1),
+                                            // weight quant bits
+                                            testing::Values(8, 4),
+                                            // weight quant group, 0 for per output channel
+                                            testing::Values(0, 16, 7),
+                                            // dynamic quant of the input, int8 weights with group 0 only
+                                            testing::Values(0, 1, 2)));
+
+TEST_P(InnerProductWeightQuantLayerTest, InnerProductLayer) {
+    // get param
+    int batch          = std::get<0>(GetParam());
+    int input_channel  = std::get<1>(GetParam());
+    int output_channel = std::get<2>(GetParam());
+    int has_bias       = std::get<3>(GetParam());
+    int bits           = std::get<4>(GetParam());
+    int group          = std::get<5>(GetParam());
+    int dynamic_quant  = std::get<6>(GetParam());
+    DeviceType dev     = ConvertDeviceType(FLAGS_dt);
+
+    // other devices get dequantized weights from the optimizer, which runs before random resources are generated
+    if (DEVICE_X86 != dev && DEVICE_NAIVE != dev) {
+        GTEST_SKIP();
+    }
+    if (dynamic_quant > 0 && (bits != 8 || group != 0)) {
+        GTEST_SKIP();
+    }
+
+    // param
+    std::shared_ptr<InnerProductLayerParam> param(new InnerProductLayerParam());
+    param->name               = "InnerProduct";
+    param->num_output         = output_channel;
+    param->has_bias           = has_bias;
+    param->axis               = 1;
+    param->weight_quant_bits  = bits;
+    param->weight_quant_group = group;
+    param->dynamic_quant      = dynamic_quant;
+
+    // generate interpreter
+    std::vector<int> input_dims = {batch, input_channel, 3, 3};
+    auto interpreter            = GenerateInterpreter("InnerProduct", {input_dims}, param);
+    Run(interpreter);
+}
+
+}  // namespace TNN_NS
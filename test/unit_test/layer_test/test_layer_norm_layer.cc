@@ -85,4 +85,44 @@ TEST_P(LayerNormLayerTest, LayerNormLayer) {
     Run(interpreter, precision);
 }
 
+// LayerNorm as left by net_optimizer_fuse_norm: residual input, sum output and activation
+class FusedLayerNormLayerTest : public LayerTest,
+                                public ::testing::WithParamInterface<std::tuple<int, int, int, bool, bool, int>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, FusedLayerNormLayerTest,
+                         ::testing::Combine(testing::Values(1, 2),          // batch
+                                            testing::Values(3, 16),         // seq len
+                                            testing::Values(7, 64, 768),    // hidden size
+                                            testing::Values(false, true),   // broadcast residual
+                                            testing::Values(false, true),   // sum output
+                                            testing::Values(ActivationType_None, ActivationType_ReLU,
+                                                            ActivationType_SIGMOID_MUL, ActivationType_GELU)));
+
+TEST_P(FusedLayerNormLayerTest, LayerNormLayer) {
+    int batch           = std::get<0>(GetParam());
+    int seq_len         = std::get<1>(GetParam());
+    int hidden_size     = std::get<2>(GetParam());
+    bool broadcast      = std::get<3>(GetParam());
+    bool sum_output     = std::get<4>(GetParam());
+    int activation_type = std::get<5>(GetParam());
+    DeviceType dev      = ConvertDeviceType(FLAGS_dt);
+
+    if (DEVICE_NAIVE != dev && DEVICE_X86 != dev) {
+        GTEST_SKIP();
+    }
+
+    std::shared_ptr<LayerNormLayerParam> param(new LayerNormLayerParam());
+    param->name             = "LayerNorm";
+    param->reduce_dims_size = 1;
+    param->activation_type  = activation_type;
+
+    std::vector<int> input_dims    = {batch, seq_len, hidden_size};
+    std::vector<int> residual_dims = broadcast ? std::vector<int>({seq_len, hidden_size}) : input_dims;
+    std::vector<int> scale_dims    = {hidden_size};
+
+    auto interpreter = GenerateInterpreter("LayerNorm", {input_dims, scale_dims, scale_dims, residual_dims}, param,
+                                           nullptr, sum_output ? 2 : 1);
+    Run(interpreter);
+}
+
 }  // namespace TNN_NS
@@ -15,6 +15,7 @@
 #include "test/unit_test/layer_test/layer_test.h"
 #include "test/unit_test/unit_test_common.h"
 #include "test/unit_test/utils/network_helpers.h"
+#include "tnn/interpreter/default_model_interpreter.h"
 #include "tnn/utils/dims_vector_utils.h"
 
 namespace TNN_NS {
@@ -82,4 +83,117 @@ TEST_P(LSTMLayerTest, LSTMONNXLayer) {
     Run(interpreter, precision, format, device_format);
 }
 
+static float *LSTMBlobData(BlobMap &blobs, const std::string &name) {
+    auto handle = blobs[name]->GetHandle();
+    return reinterpret_cast<float *>(static_cast<char *>(handle.base) + handle.bytes_offset);
+}
+
+// chunks of one step with NetworkConfig.enable_recurrent_state against the whole sequence in one forward
+class LSTMStreamLayerTest : public ::testing::TestWithParam<std::tuple<int, int, int>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, LSTMStreamLayerTest,
+                         ::testing::Combine(testing::Values(1, 2),      // batch_size
+                                            testing::Values(3, 16),     // input_size
+                                            testing::Values(7, 32)));   // hidden_size
+
+TEST_P(LSTMStreamLayerTest, LSTMONNXStream) {
+    int batch       = std::get<0>(GetParam());
+    int input_size  = std::get<1>(GetParam());
+    int hidden_size = std::get<2>(GetParam());
+    int seq_len     = 4;
+    DeviceType dev  = ConvertDeviceType(FLAGS_dt);
+    if (dev != DEVICE_X86) {
+        GTEST_SKIP();
+    }
+
+    std::shared_ptr<LSTMONNXLayerParam> param(new LSTMONNXLayerParam());
+    param->name        = "LSTMONNX";
+    param->hidden_size = hidden_size;
+    param->direction   = 0;
+
+    std::vector<int> input_dims = {seq_len, batch, input_size};
+    std::vector<int> wi_dims    = {1, 4 * hidden_size, input_size};
+    std::vector<int> wh_dims    = {1, 4 * hidden_size, hidden_size};
+    std::vector<int> bias_dims  = {1, 8 * hidden_size};
+    auto interpreter = GenerateInterpreter("LSTMONNX", {input_dims, wi_dims, wh_dims, bias_dims}, param, nullptr, 3);
+
+    // weights are constants of the model
+    auto default_interpreter = dynamic_cast<DefaultModelInterpreter *>(interpreter.get());
+    auto net_structure       = default_interpreter->GetNetStructure();
+    auto net_resource        = default_interpreter->GetNetResource();
+    std::vector<std::vector<int>> weight_dims = {wi_dims, wh_dims, bias_dims};
+    for (int i = 0; i < 3; i++) {
+        auto name  = net_structure->layers[0]->inputs[i + 1];
+        int count  = DimsVectorUtils::Count(weight_dims[i]);
+        std::shared_ptr<RawBuffer> buffer(new RawBuffer(count * sizeof(float), weight_dims[i]));
+        InitRandom(buffer->force_to<float *>(), count, 0.5f);
+        net_resource->constant_map[name] = buffer;
+        net_structure->inputs_shape_map.erase(name);
+    }
+    auto input_name = net_structure->layers[0]->inputs[0];
+
+    ModelConfig model_config;
+    model_config.params = {"", ""};
+    NetworkConfig config;
+    config.device_type = dev;
+    config.precision   = PRECISION_HIGH;
+
+    auto instance_seq = std::make_shared<Instance>(config, model_config);
+    ASSERT_EQ((int)instance_seq->Init(interpreter, InputShapesMap()), TNN_OK);
+    config.enable_recurrent_state = true;
+    auto instance_step = std::make_shared<Instance>(config, model_config);
+    InputShapesMap step_shape;
+    step_shape[input_name] = {1, batch, input_size};
+    ASSERT_EQ((int)instance_step->Init(instance_seq->GetInterpreter(), step_shape), TNN_OK);
+
+    BlobMap seq_inputs, seq_outputs, step_inputs, step_outputs;
+    instance_seq->GetAllInputBlobs(seq_inputs);
+    instance_seq->GetAllOutputBlobs(seq_outputs);
+    instance_step->GetAllInputBlobs(step_inputs);
+    instance_step->GetAllOutputBlobs(step_outputs);
+
+    const int step_size  = batch * input_size;
+    const int state_size = batch * hidden_size;
+    float *x             = LSTMBlobData(seq_inputs, input_name);
+    InitRandom(x, seq_len * step_size, 1.0f);
+    ASSERT_EQ((int)instance_seq->Forward(), TNN_OK);
+    float *y_seq = LSTMBlobData(seq_outputs, "output0");
+    float *h_seq = LSTMBlobData(seq_outputs, "output1");
+    float *c_seq = LSTMBlobData(seq_outputs, "output2");
+
+    float *x_step = LSTMBlobData(step_inputs, input_name);
+    float *y_step = LSTMBlobData(step_outputs, "output0");
+    MatMap snapshot;
+    for (int t = 0; t < seq_len; t++) {
+        memcpy(x_step, x + t * step_size, step_size * sizeof(float));
+        ASSERT_EQ((int)instance_step->Forward(), TNN_OK);
+        EXPECT_EQ(0, CompareData(y_seq + t * state_size, y_step, state_size, 0.001f));
+        if (t == 0) {
+            ASSERT_EQ((int)instance_step->GetRecurrentState(snapshot), TNN_OK);
+            ASSERT_EQ(snapshot.size(), 2u);
+        }
+    }
+    EXPECT_EQ(0, CompareData(h_seq, LSTMBlobData(step_outputs, "output1"), state_size, 0.001f));
+    EXPECT_EQ(0, CompareData(c_seq, LSTMBlobData(step_outputs, "output2"), state_size, 0.001f));
+
+    // a state of another batch is refused, the saved one is kept
+    MatMap other_batch = snapshot;
+    auto other_dims    = snapshot.begin()->second->GetDims();
+    other_dims[1] += 1;
+    other_batch[snapshot.begin()->first] = std::make_shared<Mat>(DEVICE_NAIVE, NCHW_FLOAT, other_dims);
+    EXPECT_EQ((int)instance_step->SetRecurrentState(other_batch), TNNERR_PARAM_ERR);
+
+    // restore the state after the first step and replay the second step
+    ASSERT_EQ((int)instance_step->SetRecurrentState(snapshot), TNN_OK);
+    memcpy(x_step, x + step_size, step_size * sizeof(float));
+    ASSERT_EQ((int)instance_step->Forward(), TNN_OK);
+    EXPECT_EQ(0, CompareData(y_seq + state_size, y_step, state_size, 0.001f));
+
+    // a new stream starts from zero state
+    ASSERT_EQ((int)instance_step->ResetRecurrentState(), TNN_OK);
+    memcpy(x_step, x, step_size * sizeof(float));
+    ASSERT_EQ((int)instance_step->Forward(), TNN_OK);
+    EXPECT_EQ(0, CompareData(y_seq, y_step, state_size, 0.001f));
+}
+
 }  // namespace TNN_NS
@@ -0,0 +1,148 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/core/instance.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+// MatMul with dynamic quant of the input against a float reference computed here. LayerTest is not used, the
+// naive instance dequantizes the weight in the interpreter it hands to the device instance.
+// weight_position 1 holds int8 weight-only B[K, M], weight_position 0 a float A[N, K], the quantization tool only
+// quantizes B and the flag must leave the float weight alone.
+class MatMulWeightQuantLayerTest : public ::testing::TestWithParam<std::tuple<int, int, int, int, int>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, MatMulWeightQuantLayerTest,
+                         ::testing::Combine(  // rows of A
+                             testing::Values(1, 2, 9),
+                             // K
+                             testing::Values(3, 16, 33),
+                             // columns of B
+                             testing::Values(1, 8, 21),
+                             // weight position
+                             testing::Values(0, 1),
+                             // dynamic quant, 1 per tensor, 2 per row
+                             testing::Values(1, 2)));
+
+TEST_P(MatMulWeightQuantLayerTest, MatMulLayer) {
+    const int batch         = 2;
+    const int N             = std::get<0>(GetParam());
+    const int K             = std::get<1>(GetParam());
+    const int M             = std::get<2>(GetParam());
+    const int weight_pos    = std::get<3>(GetParam());
+    const int dynamic_quant = std::get<4>(GetParam());
+    DeviceType dev          = ConvertDeviceType(FLAGS_dt);
+
+    // other devices get dequantized weights from the optimizer, the flag is only read by x86
+    if (DEVICE_X86 != dev && DEVICE_NAIVE != dev) {
+        GTEST_SKIP();
+    }
+
+    std::shared_ptr<MatMulLayerParam> param(new MatMulLayerParam());
+    param->name            = "MatMul";
+    param->weight_position = weight_pos;
+    param->dynamic_quant   = dynamic_quant;
+
+    // a[batch][N][K] * b[batch][K][M], one of them is the broadcast weight
+    std::vector<float> a_data(batch * N * K), b_data(batch * K * M);
+    std::shared_ptr<MatMulLayerResource> resource(new MatMulLayerResource());
+    DimsVector input_dims;
+    if (weight_pos == 1) {
+        param->weight_quant_bits  = 8;
+        param->weight_quant_group = 0;
+        // int8 weight stored as rows of B^T[M][K], one scale per column of B
+        RawBuffer weight(M * K, {K, M});
+        RawBuffer scale(M * sizeof(float));
+        weight.SetDataType(DATA_TYPE_INT8);
+        scale.SetDataType(DATA_TYPE_FLOAT);
+        auto weight_data = weight.force_to<int8_t *>();
+        auto scale_data  = scale.force_to<float *>();
+        InitRandom(weight_data, M * K, (int8_t)127);
+        InitRandom(scale_data, M, 0.001f, 0.01f);
+        for (int b = 0; b < batch; b++) {
+            for (int k = 0; k < K; k++) {
+                for (int m = 0; m < M; m++) {
+                    b_data[(b * K + k) * M + m] = weight_data[m * K + k] * scale_data[m];
+                }
+            }
+        }
+        resource->weight       = weight;
+        resource->scale_handle = scale;
+        InitRandom(a_data.data(), a_data.size(), 1.0f);
+        input_dims = {batch, N, K};
+    } else {
+        RawBuffer weight(N * K * sizeof(float), {N, K});
+        InitRandom(weight.force_to<float *>(), N * K, 1.0f);
+        for (int b = 0; b < batch; b++) {
+            std::copy(weight.force_to<float *>(), weight.force_to<float *>() + N * K, a_data.begin() + b * N * K);
+        }
+        resource->weight = weight;
+        InitRandom(b_data.data(), b_data.size(), 1.0f);
+        input_dims = {batch, K, M};
+    }
+    auto interpreter = GenerateInterpreter("MatMul", {input_dims}, param, resource);
+
+    ModelConfig model_config;
+    model_config.params = {"", ""};
+    NetworkConfig config;
+    config.device_type = dev;
+    config.precision   = PRECISION_HIGH;
+    auto instance      = std::make_shared<Instance>(config, model_config);
+    Status status      = instance->Init(interpreter, InputShapesMap());
+    ASSERT_EQ((int)status, TNN_OK) << status.description();
+
+    BlobMap input_blobs, output_blobs;
+    instance->GetAllInputBlobs(input_blobs);
+    instance->GetAllOutputBlobs(output_blobs);
+    auto &input_data = weight_pos == 1 ? a_data : b_data;
+    auto input_mat   = std::make_shared<Mat>(DEVICE_NAIVE, NCHW_FLOAT, input_dims, input_data.data());
+    ASSERT_EQ((int)instance->SetInputMat(input_mat, MatConvertParam(), input_blobs.begin()->first), TNN_OK);
+    status = instance->Forward();
+    ASSERT_EQ((int)status, TNN_OK) << status.description();
+    std::shared_ptr<Mat> output_mat;
+    status = instance->GetOutputMat(output_mat, MatConvertParam(), output_blobs.begin()->first, DEVICE_NAIVE);
+    ASSERT_EQ((int)status, TNN_OK) << status.description();
+    ASSERT_TRUE(DimsVectorUtils::Equal(output_mat->GetDims(), {batch, N, M}));
+    auto output = static_cast<float *>(output_mat->GetData());
+
+    // the input is quantized with a step of at most max|input| / 127, the rounding error of each product is bounded
+    // by half of it
+    const float input_max = 1.0f;
+    float weight_max      = 0;
+    for (auto value : weight_pos == 1 ? b_data : a_data) {
+        weight_max = std::max(weight_max, std::fabs(value));
+    }
+    const float bound = weight_pos == 1 ? K * weight_max * input_max / 254 + 1e-4f : 1e-4f;
+    for (int b = 0; b < batch; b++) {
+        for (int n = 0; n < N; n++) {
+            for (int m = 0; m < M; m++) {
+                float ref = 0;
+                for (int k = 0; k < K; k++) {
+                    ref += a_data[(b * N + n) * K + k] * b_data[(b * K + k) * M + m];
+                }
+                EXPECT_NEAR(output[(b * N + n) * M + m], ref, bound) << "at " << b << " " << n << " " << m;
+            }
+        }
+    }
+}
+
+}  // namespace TNN_NS
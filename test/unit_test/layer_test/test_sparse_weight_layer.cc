@@ -0,0 +1,146 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <random>
+
+#include "test/unit_test/layer_test/layer_test.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/utils/dims_utils.h"
+#include "tnn/utils/random_data_utils.h"
+
+namespace TNN_NS {
+
+// random weights with the given ratio of zeros, as left by magnitude pruning
+static RawBuffer GeneratePrunedWeight(int count, float sparsity) {
+    RawBuffer weight(count * sizeof(float));
+    float *data = weight.force_to<float *>();
+    InitRandom(data, count, 1.0f);
+
+    std::mt19937 gen(count);
+    std::uniform_real_distribution<float> dis(0.f, 1.f);
+    for (int i = 0; i < count; i++) {
+        if (dis(gen) < sparsity) {
+            data[i] = 0.f;
+        }
+    }
+    return weight;
+}
+
+// sparsity 0 runs the dense kernels of the same shape, compare the time of both with -ub
+class SparseConvLayerTest : public LayerTest,
+                            public ::testing::WithParamInterface<std::tuple<int, int, int, int, float, int>> {};
+
+#ifdef TNN_UNIT_TEST_BENCHMARK
+INSTANTIATE_TEST_SUITE_P(LayerTest, SparseConvLayerTest,
+                         ::testing::Combine(testing::Values(1), testing::Values(128, 256), testing::Values(256),
+                                            testing::Values(28, 56), testing::Values(0.f, 0.5f, 0.7f, 0.9f),
+                                            testing::Values(ActivationType_None)));
+#else
+INSTANTIATE_TEST_SUITE_P(LayerTest, SparseConvLayerTest,
+                         ::testing::Combine(testing::Values(1, 2),
+                                            // input channel
+                                            testing::Values(3, 16, 33),
+                                            // output channel
+                                            testing::Values(1, 8, 21),
+                                            // hw
+                                            testing::Values(5, 16, 19),
+                                            // sparsity
+                                            testing::Values(0.f, 0.7f, 1.f),
+                                            testing::Values(ActivationType_None, ActivationType_ReLU,
+                                                            ActivationType_SIGMOID_MUL)));
+#endif
+
+TEST_P(SparseConvLayerTest, ConvLayer) {
+    int batch          = std::get<0>(GetParam());
+    int input_channel  = std::get<1>(GetParam());
+    int output_channel = std::get<2>(GetParam());
+    int input_size     = std::get<3>(GetParam());
+    float sparsity     = std::get<4>(GetParam());
+    int activation     = std::get<5>(GetParam());
+    DeviceType dev     = ConvertDeviceType(FLAGS_dt);
+
+    if (activation == ActivationType_SIGMOID_MUL && (DEVICE_APPLE_NPU == dev || DEVICE_CUDA == dev)) {
+        GTEST_SKIP();
+    }
+
+    // param
+    std::shared_ptr<ConvLayerParam> param(new ConvLayerParam());
+    param->name            = "Conv";
+    param->input_channel   = input_channel;
+    param->output_channel  = output_channel;
+    param->group           = 1;
+    param->kernels         = {1, 1};
+    param->dialations      = {1, 1};
+    param->strides         = {1, 1};
+    param->pads            = {0, 0, 0, 0};
+    param->bias            = 1;
+    param->activation_type = activation;
+
+    // resource
+    std::shared_ptr<ConvLayerResource> resource(new ConvLayerResource());
+    resource->filter_handle = GeneratePrunedWeight(output_channel * input_channel, sparsity);
+    resource->bias_handle   = RawBuffer(output_channel * sizeof(float));
+    InitRandom(resource->bias_handle.force_to<float *>(), output_channel, 1.0f);
+
+    // generate interpreter
+    std::vector<int> input_dims = {batch, input_channel, input_size, input_size};
+    auto interpreter            = GenerateInterpreter("Convolution", {input_dims}, param, resource);
+    Run(interpreter);
+}
+
+class SparseInnerProductLayerTest : public LayerTest,
+                                    public ::testing::WithParamInterface<std::tuple<int, int, int, float>> {};
+
+#ifdef TNN_UNIT_TEST_BENCHMARK
+INSTANTIATE_TEST_SUITE_P(LayerTest, SparseInnerProductLayerTest,
+                         ::testing::Combine(testing::Values(1), testing::Values(1024, 4096), testing::Values(1024),
+                                            testing::Values(0.f, 0.5f, 0.7f, 0.9f)));
+#else
+INSTANTIATE_TEST_SUITE_P(LayerTest, SparseInnerProductLayerTest,
+                         ::testing::Combine(testing::Values(1, 2),
+                                            // input channel
+                                            testing::Values(3, 16, 67),
+                                            // output channel
+                                            testing::Values(1, 8, 21),
+                                            // sparsity
+                                            testing::Values(0.f, 0.8f, 1.f)));
+#endif
+
+TEST_P(SparseInnerProductLayerTest, InnerProductLayer) {
+    int batch          = std::get<0>(GetParam());
+    int input_channel  = std::get<1>(GetParam());
+    int output_channel = std::get<2>(GetParam());
+    float sparsity     = std::get<3>(GetParam());
+
+    // param
+    std::shared_ptr<InnerProductLayerParam> param(new InnerProductLayerParam());
+    param->name       = "InnerProduct";
+    param->num_output = output_channel;
+    param->has_bias   = 1;
+    param->axis       = 1;
+
+    // resource
+    std::shared_ptr<InnerProductLayerResource> resource(new InnerProductLayerResource());
+    resource->weight_handle = GeneratePrunedWeight(output_channel * input_channel, sparsity);
+    resource->bias_handle   = RawBuffer(output_channel * sizeof(float));
+    InitRandom(resource->bias_handle.force_to<float *>(), output_channel, 1.0f);
+
+    // generate interpreter
+    std::vector<int> input_dims = {batch, input_channel, 1, 1};
+    auto interpreter            = GenerateInterpreter("InnerProduct", {input_dims}, param, resource);
+    Run(interpreter);
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,221 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/core/default_network.h"
+#include "tnn/core/instance.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/interpreter/tnn/model_packer.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+// output0 = conv(relu(conv(input0))), a new set of random weights for each call
+static std::shared_ptr<AbstractModelInterpreter> GenerateConvInterpreter(DimsVector dims, int filter_channel) {
+    const int channel = dims[1];
+    auto interpreter  = GenerateEmptyInterpreter({dims});
+    // a filter_channel other than the input channel makes a model of another layout
+    auto conv1_param    = CreateConvParam(channel, channel, 3);
+    auto conv1_resource = CreateConvResource(CreateConvParam(filter_channel, channel, 3));
+    auto conv2_param    = CreateConvParam(channel, channel, 3);
+    AddLayer(interpreter, "Convolution", "conv1", {"input0"}, conv1_param, conv1_resource);
+    AddLayer(interpreter, "ReLU", "relu1", {"conv1"}, std::make_shared<LayerParam>());
+    AddLayer(interpreter, "Convolution", "output0", {"relu1"}, conv2_param, CreateConvResource(conv2_param));
+    dynamic_cast<DefaultModelInterpreter*>(interpreter.get())->GetNetStructure()->outputs.insert("output0");
+    return interpreter;
+}
+
+static Status GetModelContent(std::shared_ptr<AbstractModelInterpreter> interpreter, std::string& content) {
+    auto default_interpreter = dynamic_cast<DefaultModelInterpreter*>(interpreter.get());
+    ModelPacker packer(default_interpreter->GetNetStructure(), default_interpreter->GetNetResource());
+    const std::string proto_path = "model_update_test.tnnproto";
+    const std::string model_path = "model_update_test.tnnmodel";
+    RETURN_ON_NEQ(packer.Pack(proto_path, model_path), TNN_OK);
+
+    std::ifstream model_stream(model_path, std::ios::binary);
+    std::ostringstream os;
+    os << model_stream.rdbuf();
+    content = os.str();
+    model_stream.close();
+    remove(proto_path.c_str());
+    remove(model_path.c_str());
+    return content.empty() ? Status(TNNERR_PACK_MODEL, "model content is empty") : TNN_OK;
+}
+
+static int CountMismatch(const std::vector<float>& result, const std::vector<float>& expect) {
+    if (result.size() != expect.size()) {
+        return -1;
+    }
+    int mismatch = 0;
+    for (size_t i = 0; i < result.size(); i++) {
+        if (std::fabs(result[i] - expect[i]) > 1e-4 * std::max(1.0f, std::fabs(expect[i]))) {
+            mismatch++;
+        }
+    }
+    return mismatch;
+}
+
+TEST(ModelUpdateTest, MatchesNewInstance) {
+    if (CheckDeviceSkip({DEVICE_X86, DEVICE_NAIVE})) {
+        GTEST_SKIP();
+    }
+
+    DimsVector dims = {1, 8, 32, 32};
+    std::vector<float> input(DimsVectorUtils::Count(dims));
+    InitRandom(input.data(), input.size(), -1.0f, 1.0f);
+
+    std::shared_ptr<Instance> instance;
+    ASSERT_EQ((int)CreateInstance(instance, GenerateConvInterpreter(dims, dims[1]), {{"input0", dims}}), TNN_OK);
+    std::vector<float> old_output;
+    ASSERT_EQ((int)RunInstance(instance, input, dims, old_output), TNN_OK);
+
+    // consecutive updates, each one releases the weights of the previous one
+    for (int i = 0; i < 2; i++) {
+        auto interpreter = GenerateConvInterpreter(dims, dims[1]);
+        std::string model_content;
+        ASSERT_EQ((int)GetModelContent(interpreter, model_content), TNN_OK);
+        Status status = instance->UpdateModel(model_content);
+        ASSERT_EQ((int)status, TNN_OK) << status.description();
+
+        std::shared_ptr<Instance> reference;
+        ASSERT_EQ((int)CreateInstance(reference, interpreter, {{"input0", dims}}), TNN_OK);
+        std::vector<float> output, expect;
+        ASSERT_EQ((int)RunInstance(instance, input, dims, output), TNN_OK);
+        ASSERT_EQ((int)RunInstance(reference, input, dims, expect), TNN_OK);
+        EXPECT_EQ(CountMismatch(output, expect), 0);
+        EXPECT_NE(CountMismatch(output, old_output), 0);
+        old_output = output;
+    }
+
+    // weights of another layout are rejected and the instance keeps its weights
+    std::string model_content;
+    ASSERT_EQ((int)GetModelContent(GenerateConvInterpreter(dims, dims[1] / 2), model_content), TNN_OK);
+    EXPECT_NE((int)instance->UpdateModel(model_content), TNN_OK);
+    std::vector<float> output;
+    ASSERT_EQ((int)RunInstance(instance, input, dims, output), TNN_OK);
+    EXPECT_EQ(CountMismatch(output, old_output), 0);
+}
+
+// forward runs on the old weights while the new ones are packed, each output is the one of either weights
+TEST(ModelUpdateTest, ForwardDuringUpdate) {
+    if (CheckDeviceSkip({DEVICE_X86, DEVICE_NAIVE})) {
+        GTEST_SKIP();
+    }
+
+    DimsVector dims = {1, 8, 32, 32};
+    std::vector<float> input(DimsVectorUtils::Count(dims));
+    InitRandom(input.data(), input.size(), -1.0f, 1.0f);
+
+    std::shared_ptr<Instance> instance, reference;
+    ASSERT_EQ((int)CreateInstance(instance, GenerateConvInterpreter(dims, dims[1]), {{"input0", dims}}), TNN_OK);
+    std::vector<float> old_output, new_output;
+    ASSERT_EQ((int)RunInstance(instance, input, dims, old_output), TNN_OK);
+    auto interpreter = GenerateConvInterpreter(dims, dims[1]);
+    ASSERT_EQ((int)CreateInstance(reference, interpreter, {{"input0", dims}}), TNN_OK);
+    ASSERT_EQ((int)RunInstance(reference, input, dims, new_output), TNN_OK);
+    std::string model_content;
+    ASSERT_EQ((int)GetModelContent(interpreter, model_content), TNN_OK);
+
+    std::vector<std::vector<float>> outputs;
+    Status forward_status = TNN_OK;
+    bool updated          = false;
+    std::mutex updated_mtx;
+    std::thread forward_thread([&]() {
+        // a few more forward calls once the update is done
+        for (int after_update = 0; after_update < 3 && forward_status == TNN_OK;) {
+            {
+                std::lock_guard<std::mutex> guard(updated_mtx);
+                after_update += updated;
+            }
+            std::vector<float> output;
+            forward_status = RunInstance(instance, input, dims, output);
+            outputs.push_back(output);
+        }
+    });
+    Status status = instance->UpdateModel(model_content);
+    {
+        std::lock_guard<std::mutex> guard(updated_mtx);
+        updated = true;
+    }
+    forward_thread.join();
+    ASSERT_EQ((int)status, TNN_OK) << status.description();
+    ASSERT_EQ((int)forward_status, TNN_OK) << forward_status.description();
+
+    for (const auto& output : outputs) {
+        EXPECT_TRUE(CountMismatch(output, old_output) == 0 || CountMismatch(output, new_output) == 0);
+    }
+    EXPECT_EQ(CountMismatch(outputs.back(), new_output), 0);
+}
+
+static Status RunNetwork(DefaultNetwork& network, std::vector<float>& input, std::vector<float>& output) {
+    BlobMap input_blobs, output_blobs;
+    RETURN_ON_NEQ(network.GetAllInputBlobs(input_blobs), TNN_OK);
+    RETURN_ON_NEQ(network.GetAllOutputBlobs(output_blobs), TNN_OK);
+    auto input_handle = input_blobs["input0"]->GetHandle();
+    memcpy((char*)input_handle.base + input_handle.bytes_offset, input.data(), input.size() * sizeof(float));
+    RETURN_ON_NEQ(network.Forward(), TNN_OK);
+    auto output_blob   = output_blobs["output0"];
+    auto output_handle = output_blob->GetHandle();
+    const float* data  = (const float*)((char*)output_handle.base + output_handle.bytes_offset);
+    output.assign(data, data + DimsVectorUtils::Count(output_blob->GetBlobDesc().dims));
+    return TNN_OK;
+}
+
+// the first conv takes its new weights before the last one fails, none of them may be switched
+TEST(ModelUpdateTest, KeepsWeightsOnFailure) {
+    if (CheckDeviceSkip({DEVICE_X86, DEVICE_NAIVE})) {
+        GTEST_SKIP();
+    }
+
+    DimsVector dims = {1, 8, 16, 16};
+    std::vector<float> input(DimsVectorUtils::Count(dims));
+    InitRandom(input.data(), input.size(), -1.0f, 1.0f);
+
+    NetworkConfig config;
+    config.device_type = ConvertDeviceType(FLAGS_dt);
+    ModelConfig model_config;
+    model_config.params = {"", ""};
+    auto interpreter    = GenerateConvInterpreter(dims, dims[1]);
+    DefaultNetwork network;
+    InputShapesMap shapes = {{"input0", dims}};
+    ASSERT_EQ((int)network.Init(config, model_config, interpreter.get(), shapes, shapes, false), TNN_OK);
+    std::vector<float> old_output;
+    ASSERT_EQ((int)RunNetwork(network, input, old_output), TNN_OK);
+
+    // the conv acc of the last layer fails to init without its resource
+    auto update_interpreter = GenerateConvInterpreter(dims, dims[1]);
+    auto default_update     = dynamic_cast<DefaultModelInterpreter*>(update_interpreter.get());
+    default_update->GetNetResource()->resource_map.erase("output0");
+    EXPECT_NE((int)network.UpdateModelResource(default_update->GetNetStructure(), default_update->GetNetResource()),
+              TNN_OK);
+
+    std::vector<float> output;
+    ASSERT_EQ((int)RunNetwork(network, input, output), TNN_OK);
+    EXPECT_EQ(CountMismatch(output, old_output), 0);
+}
+
+}  // namespace TNN_NS
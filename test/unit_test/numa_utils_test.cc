@@ -0,0 +1,41 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "tnn/utils/numa_utils.h"
+
+namespace TNN_NS {
+
+// a memory scope nested in a thread with its own policy must give the policy back, not the default one
+TEST(NumaUtilsTest, MemoryScopeRestoresPolicy) {
+    NumaMemoryPolicy prior_policy;
+    if (NumaGetMemoryPolicy(prior_policy) != TNN_OK) {
+        GTEST_SKIP();
+    }
+    ASSERT_EQ((int)NumaSetPreferredNode(0), TNN_OK);
+
+    NumaMemoryPolicy outer_policy;
+    ASSERT_EQ((int)NumaGetMemoryPolicy(outer_policy), TNN_OK);
+    { NumaMemoryScope scope(0); }
+    NumaMemoryPolicy restored_policy;
+    ASSERT_EQ((int)NumaGetMemoryPolicy(restored_policy), TNN_OK);
+
+    EXPECT_EQ(restored_policy.mode, outer_policy.mode);
+    EXPECT_EQ(restored_policy.node_mask, outer_policy.node_mask);
+
+    ASSERT_EQ((int)NumaSetMemoryPolicy(prior_policy), TNN_OK);
+}
+
+}  // namespace TNN_NS
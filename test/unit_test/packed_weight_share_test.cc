@@ -0,0 +1,87 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/core/instance.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+// output0 = conv(conv(input0)), two convs of the same shape and different weights
+static std::shared_ptr<AbstractModelInterpreter> GenerateConvConvInterpreter(DimsVector dims,
+                                                                             std::shared_ptr<LayerResource> res1,
+                                                                             std::shared_ptr<LayerResource> res2) {
+    const int channel = dims[1];
+    auto interpreter  = GenerateEmptyInterpreter({dims});
+    AddLayer(interpreter, "Convolution", "conv1", {"input0"}, CreateConvParam(channel, channel, 1), res1);
+    AddLayer(interpreter, "Convolution", "output0", {"conv1"}, CreateConvParam(channel, channel, 1), res2);
+    dynamic_cast<DefaultModelInterpreter*>(interpreter.get())->GetNetStructure()->outputs.insert("output0");
+    return interpreter;
+}
+
+// half weights are packed from fp32 copies freed after init, the copy of the second conv may get the address
+// of the first one and must not be taken for it
+TEST(PackedWeightShareTest, HalfConvsOfSameShape) {
+    if (CheckDeviceSkip({DEVICE_X86, DEVICE_NAIVE})) {
+        GTEST_SKIP();
+    }
+
+    DimsVector dims = {1, 16, 8, 8};
+    std::shared_ptr<LayerResource> half_res[2], float_res[2];
+    for (int i = 0; i < 2; i++) {
+        auto resource       = CreateConvResource(CreateConvParam(dims[1], dims[1], 1));
+        auto half           = std::make_shared<ConvLayerResource>(*resource);
+        half->filter_handle = ConvertFloatToFP16(resource->filter_handle);
+        half->filter_handle.SetDataType(DATA_TYPE_HALF);
+        // the float reference has the weights rounded to half
+        resource->filter_handle = ConvertHalfHandle(half->filter_handle);
+        half_res[i]             = half;
+        float_res[i]            = resource;
+    }
+
+    std::vector<float> input(DimsVectorUtils::Count(dims));
+    InitRandom(input.data(), input.size(), -1.0f, 1.0f);
+    std::shared_ptr<Instance> half_instance, float_instance;
+    Status status = CreateInstance(half_instance, GenerateConvConvInterpreter(dims, half_res[0], half_res[1]),
+                                   {{"input0", dims}});
+    ASSERT_EQ((int)status, TNN_OK) << status.description();
+    status = CreateInstance(float_instance, GenerateConvConvInterpreter(dims, float_res[0], float_res[1]),
+                            {{"input0", dims}});
+    ASSERT_EQ((int)status, TNN_OK) << status.description();
+
+    std::vector<float> output, expect;
+    status = RunInstance(half_instance, input, dims, output);
+    ASSERT_EQ((int)status, TNN_OK) << status.description();
+    status = RunInstance(float_instance, input, dims, expect);
+    ASSERT_EQ((int)status, TNN_OK) << status.description();
+
+    ASSERT_EQ(output.size(), expect.size());
+    int mismatch = 0;
+    for (size_t i = 0; i < output.size(); i++) {
+        if (std::fabs(output[i] - expect[i]) > 1e-4 * std::max(1.0f, std::fabs(expect[i]))) {
+            mismatch++;
+        }
+    }
+    EXPECT_EQ(mismatch, 0);
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,198 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/core/instance.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/interpreter/tnn/layer_interpreter/abstract_layer_interpreter.h"
+#include "tnn/interpreter/tnn/model_interpreter.h"
+#include "tnn/optimizer/net_optimizer_manager.h"
+#include "tnn/optimizer/optimizer_const.h"
+#include "tnn/utils/dims_utils.h"
+#include "tnn/utils/split_utils.h"
+
+namespace TNN_NS {
+
+static std::shared_ptr<PermuteLayerParam> PermuteParam(std::vector<int> orders) {
+    std::shared_ptr<PermuteLayerParam> param(new PermuteLayerParam());
+    param->orders = orders;
+    return param;
+}
+
+// output0 = Permute(Softmax(MatMul(Permute(Relu(Permute(input0))), Permute(input1)), axis 2)), the two permutes
+// around relu cancel, the permute of input1 becomes the transposed operand b of MatMul and the permute before
+// softmax sinks below it
+static std::shared_ptr<AbstractModelInterpreter> GeneratePermuteInterpreter(DimsVector a_dims, DimsVector b_dims) {
+    auto interpreter = GenerateEmptyInterpreter({a_dims, b_dims});
+    AddLayer(interpreter, "Permute", "a_t", {"input0"}, PermuteParam({0, 2, 1, 3}));
+    AddLayer(interpreter, "ReLU", "a_relu", {"a_t"}, std::make_shared<LayerParam>());
+    AddLayer(interpreter, "Permute", "a", {"a_relu"}, PermuteParam({0, 2, 1, 3}));
+    AddLayer(interpreter, "Permute", "b", {"input1"}, PermuteParam({0, 1, 3, 2}));
+
+    std::shared_ptr<MatMulLayerParam> matmul_param(new MatMulLayerParam());
+    AddLayer(interpreter, "MatMul", "c", {"a", "b"}, matmul_param);
+    AddLayer(interpreter, "Permute", "c_t", {"c"}, PermuteParam({0, 1, 3, 2}));
+
+    std::shared_ptr<SoftmaxLayerParam> softmax_param(new SoftmaxLayerParam());
+    softmax_param->axis = 2;
+    AddLayer(interpreter, "Softmax", "output0", {"c_t"}, softmax_param);
+    auto net_structure = dynamic_cast<DefaultModelInterpreter*>(interpreter.get())->GetNetStructure();
+    net_structure->outputs.insert("output0");
+
+    return interpreter;
+}
+
+TEST(PermuteFusionTest, FoldAndSinkPermutes) {
+    if (CheckDeviceSkip({DEVICE_X86, DEVICE_NAIVE})) {
+        GTEST_SKIP();
+    }
+
+    const int batch = 2, channel = 3, m = 5, k = 7, n = 6;
+    DimsVector a_dims = {batch, channel, m, k};
+    DimsVector b_dims = {batch, channel, n, k};
+    auto interpreter  = GeneratePermuteInterpreter(a_dims, b_dims);
+
+    std::shared_ptr<Instance> instance;
+    Status status = CreateInstance(instance, interpreter, {{"input0", a_dims}, {"input1", b_dims}});
+    ASSERT_EQ((int)status, TNN_OK) << status.description();
+
+    // only the permute producing the net output is left on x86, the naive device runs the net as it is
+    DeviceType dev     = ConvertDeviceType(FLAGS_dt);
+    auto net_structure = dynamic_cast<DefaultModelInterpreter*>(instance->GetInterpreter().get())->GetNetStructure();
+    int permute_count  = 0;
+    for (auto layer_info : net_structure->layers) {
+        permute_count += layer_info->type == LAYER_PERMUTE;
+    }
+    EXPECT_EQ(permute_count, DEVICE_X86 == dev ? 1 : 4);
+    EXPECT_EQ(net_structure->layers.back()->type, DEVICE_X86 == dev ? LAYER_PERMUTE : LAYER_SOFTMAX);
+
+    std::vector<float> a_data(DimsVectorUtils::Count(a_dims));
+    std::vector<float> b_data(DimsVectorUtils::Count(b_dims));
+    InitRandom(a_data.data(), a_data.size(), -1.0f, 1.0f);
+    InitRandom(b_data.data(), b_data.size(), -1.0f, 1.0f);
+    auto a_mat = std::make_shared<Mat>(DEVICE_NAIVE, NCHW_FLOAT, a_dims, a_data.data());
+    auto b_mat = std::make_shared<Mat>(DEVICE_NAIVE, NCHW_FLOAT, b_dims, b_data.data());
+    ASSERT_EQ((int)instance->SetInputMat(a_mat, MatConvertParam(), "input0"), TNN_OK);
+    ASSERT_EQ((int)instance->SetInputMat(b_mat, MatConvertParam(), "input1"), TNN_OK);
+    status = instance->Forward();
+    ASSERT_EQ((int)status, TNN_OK) << status.description();
+
+    std::shared_ptr<Mat> output_mat;
+    status = instance->GetOutputMat(output_mat, MatConvertParam(), "output0", DEVICE_NAIVE);
+    ASSERT_EQ((int)status, TNN_OK) << status.description();
+    ASSERT_TRUE(DimsVectorUtils::Equal(output_mat->GetDims(), {batch, channel, n, m}));
+    float* output = static_cast<float*>(output_mat->GetData());
+
+    // output[b][c][j][i] = softmax over j of sum(relu(a[b][c][i][:]) * b[b][c][j][:])
+    std::vector<float> row(n);
+    for (int bc = 0; bc < batch * channel; bc++) {
+        for (int i = 0; i < m; i++) {
+            float max_value = -INFINITY, sum = 0;
+            for (int j = 0; j < n; j++) {
+                row[j] = 0;
+                for (int l = 0; l < k; l++) {
+                    row[j] += std::max(a_data[(bc * m + i) * k + l], 0.0f) * b_data[(bc * n + j) * k + l];
+                }
+                max_value = std::max(max_value, row[j]);
+            }
+            for (int j = 0; j < n; j++) {
+                row[j] = std::exp(row[j] - max_value);
+                sum += row[j];
+            }
+            for (int j = 0; j < n; j++) {
+                EXPECT_NEAR(output[(bc * n + j) * m + i], row[j] / sum, 1e-4) << "at " << bc << " " << i << " " << j;
+            }
+        }
+    }
+}
+
+// permutes of invalid orders are left as they are, as are the ones of an input of unknown rank before MatMul
+TEST(PermuteFusionTest, KeepInvalidPermutes) {
+    auto interpreter = GenerateEmptyInterpreter({{2, 3, 5, 7}, {2, 3, 7, 6}});
+    AddLayer(interpreter, "Permute", "a_t", {"input0"}, PermuteParam({0, 0, 1, 2}));
+    AddLayer(interpreter, "Permute", "a", {"a_t"}, PermuteParam({0, 2, 1, 3}));
+    AddLayer(interpreter, "ReLU", "b_relu", {"input1"}, std::make_shared<LayerParam>());
+    AddLayer(interpreter, "Permute", "b", {"b_relu"}, PermuteParam({0, 1, 3, 2}));
+    AddLayer(interpreter, "MatMul", "c", {"a", "b"}, std::make_shared<MatMulLayerParam>());
+    AddLayer(interpreter, "Permute", "c_t", {"c"}, PermuteParam({1, 1, 3, 2}));
+    std::shared_ptr<SoftmaxLayerParam> softmax_param(new SoftmaxLayerParam());
+    softmax_param->axis = 2;
+    AddLayer(interpreter, "Softmax", "output0", {"c_t"}, softmax_param);
+
+    auto default_interpreter = dynamic_cast<DefaultModelInterpreter*>(interpreter.get());
+    auto net_structure       = default_interpreter->GetNetStructure();
+    net_structure->outputs.insert("output0");
+    std::vector<std::string> layer_names;
+    for (auto layer_info : net_structure->layers) {
+        layer_names.push_back(layer_info->name);
+    }
+
+    auto optimizer = optimizer::NetOptimizerManager::GetNetOptimizerByName(kNetOptimizerFusePermute);
+    ASSERT_TRUE(optimizer != nullptr);
+    Status status = optimizer->Optimize(net_structure, default_interpreter->GetNetResource());
+    ASSERT_EQ((int)status, TNN_OK) << status.description();
+
+    ASSERT_EQ(net_structure->layers.size(), layer_names.size());
+    for (int i = 0; i < (int)layer_names.size(); i++) {
+        EXPECT_EQ(net_structure->layers[i]->name, layer_names[i]);
+    }
+    auto matmul_param = dynamic_cast<MatMulLayerParam*>(net_structure->layers[4]->param.get());
+    ASSERT_TRUE(matmul_param != nullptr);
+    EXPECT_FALSE(matmul_param->transpose_a);
+    EXPECT_FALSE(matmul_param->transpose_b);
+    EXPECT_EQ(dynamic_cast<SoftmaxLayerParam*>(net_structure->layers[6]->param.get())->axis, 2);
+}
+
+// the transpose flags set by the fusion are saved with the model
+TEST(PermuteFusionTest, SaveMatMulTranspose) {
+    auto layer_interpreter = ModelInterpreter::GetLayerInterpreterMap()[LAYER_MATMUL];
+    ASSERT_TRUE(layer_interpreter != nullptr);
+
+    MatMulLayerParam param;
+    param.transpose_b      = true;
+    const std::string path = "permute_fusion_test.tnnproto";
+    std::ofstream output_stream(path);
+    ASSERT_EQ((int)layer_interpreter->SaveProto(output_stream, &param), TNN_OK);
+    output_stream.close();
+
+    std::ifstream input_stream(path);
+    std::stringstream proto;
+    proto << input_stream.rdbuf();
+    input_stream.close();
+    std::remove(path.c_str());
+
+    str_arr layer_cfg_arr;
+    ASSERT_EQ((int)SplitUtils::SplitStr(proto.str().c_str(), layer_cfg_arr, " ", true, false), TNN_OK);
+    LayerParam* loaded = nullptr;
+    ASSERT_EQ((int)layer_interpreter->InterpretProto(layer_cfg_arr, 0, &loaded), TNN_OK);
+    std::shared_ptr<LayerParam> loaded_holder(loaded);
+    auto loaded_param = dynamic_cast<MatMulLayerParam*>(loaded);
+    ASSERT_TRUE(loaded_param != nullptr);
+    EXPECT_EQ(loaded_param->weight_quant_bits, 0);
+    EXPECT_EQ(loaded_param->dynamic_quant, 0);
+    EXPECT_FALSE(loaded_param->transpose_a);
+    EXPECT_TRUE(loaded_param->transpose_b);
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,95 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/core/instance.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/utils/dims_utils.h"
+#include "tnn/utils/string_format.h"
+
+namespace TNN_NS {
+
+static std::shared_ptr<GatherLayerResource> GatherIndices(std::vector<int> indices) {
+    std::shared_ptr<GatherLayerResource> resource(new GatherLayerResource());
+    resource->indices = RawBuffer(indices.size() * sizeof(int), DimsVector({(int)indices.size()}));
+    resource->indices.SetDataType(DATA_TYPE_INT32);
+    memcpy(resource->indices.force_to<int*>(), indices.data(), indices.size() * sizeof(int));
+    return resource;
+}
+
+// reshape input0 of dims [n, c, h, w] to [n, c * h, w] with the shape computed by
+// Shape -> Gather -> Mul -> Concat, Instance::Reshape must refresh the shape for each input dims
+static std::shared_ptr<AbstractModelInterpreter> GenerateShapeSubgraphInterpreter(DimsVector max_dims) {
+    auto interpreter = GenerateEmptyInterpreter({max_dims});
+    AddLayer(interpreter, "Shape", "shape", {"input0"}, std::make_shared<LayerParam>());
+    for (int i = 0; i < 4; i++) {
+        std::shared_ptr<GatherLayerParam> gather_param(new GatherLayerParam());
+        gather_param->axis                = 0;
+        gather_param->indices_in_resource = true;
+        auto name                         = "dim" + std::to_string(i);
+        AddLayer(interpreter, "Gather", name, {"shape"}, gather_param, GatherIndices({i}));
+    }
+
+    std::shared_ptr<MultidirBroadcastLayerParam> mul_param(new MultidirBroadcastLayerParam());
+    mul_param->weight_input_index = -1;
+    AddLayer(interpreter, "Mul", "ch", {"dim1", "dim2"}, mul_param);
+
+    std::shared_ptr<ConcatLayerParam> concat_param(new ConcatLayerParam());
+    concat_param->axis = 0;
+    AddLayer(interpreter, "Concat", "target", {"dim0", "ch", "dim3"}, concat_param);
+
+    std::shared_ptr<ReshapeLayerParam> reshape_param(new ReshapeLayerParam());
+    reshape_param->axis     = 0;
+    reshape_param->num_axes = -1;
+    AddLayer(interpreter, "Reshape", "output0", {"input0", "target"}, reshape_param);
+    auto net_structure = dynamic_cast<DefaultModelInterpreter*>(interpreter.get())->GetNetStructure();
+    net_structure->outputs.insert("output0");
+
+    return interpreter;
+}
+
+TEST(ShapeProgramTest, ReshapeWithShapeSubgraph) {
+    DeviceType dev = ConvertDeviceType(FLAGS_dt);
+    if (DEVICE_CUDA == dev || DEVICE_APPLE_NPU == dev || DEVICE_HUAWEI_NPU == dev) {
+        GTEST_SKIP();
+    }
+
+    DimsVector min_dims = {1, 3, 2, 2};
+    DimsVector max_dims = {2, 3, 16, 16};
+    auto interpreter    = GenerateShapeSubgraphInterpreter(max_dims);
+
+    std::shared_ptr<Instance> instance;
+    Status status = CreateInstance(instance, interpreter, {{"input0", min_dims}}, {{"input0", max_dims}});
+    ASSERT_EQ((int)status, TNN_OK) << status.description();
+
+    std::vector<DimsVector> reshape_dims = {{2, 3, 16, 16}, {1, 3, 2, 2}, {2, 3, 5, 9}, {1, 3, 16, 3}, {2, 3, 5, 9}};
+    for (const auto& dims : reshape_dims) {
+        status = instance->Reshape({{"input0", dims}});
+        ASSERT_EQ((int)status, TNN_OK) << status.description();
+        status = instance->Forward();
+        ASSERT_EQ((int)status, TNN_OK) << status.description();
+
+        BlobMap output_blobs;
+        instance->GetAllOutputBlobs(output_blobs);
+        DimsVector expected = {dims[0], dims[1] * dims[2], dims[3]};
+        EXPECT_TRUE(DimsVectorUtils::Equal(output_blobs["output0"]->GetBlobDesc().dims, expected))
+            << "input dims " << DimsToString(dims);
+    }
+}
+
+}  // namespace TNN_NS
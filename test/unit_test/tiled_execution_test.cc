@@ -0,0 +1,107 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/core/instance.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/utils/dims_utils.h"
+#include "tnn/utils/string_format.h"
+
+namespace TNN_NS {
+
+// output0 = sigmoid(conv(avgpool(relu(conv(input0))))), a chain of layers on a high resolution input
+static std::shared_ptr<AbstractModelInterpreter> GenerateChainInterpreter(DimsVector dims) {
+    auto interpreter  = GenerateEmptyInterpreter({dims});
+    const int channel = dims[1];
+    auto conv1_param  = CreateConvParam(channel, channel, 3);
+    AddLayer(interpreter, "Convolution", "conv1", {"input0"}, conv1_param, CreateConvResource(conv1_param, 0.2f));
+    AddLayer(interpreter, "ReLU", "relu1", {"conv1"}, std::make_shared<LayerParam>());
+
+    std::shared_ptr<PoolingLayerParam> pool_param(new PoolingLayerParam());
+    pool_param->pool_type      = 1;
+    pool_param->ceil_mode      = 1;
+    pool_param->kernels_params = {3, 3};
+    pool_param->kernels        = {3, 3};
+    pool_param->kernel_indexs  = {-1, -1};
+    pool_param->strides        = {2, 2};
+    pool_param->pads           = {1, 1, 1, 1};
+    AddLayer(interpreter, "Pooling", "pool1", {"relu1"}, pool_param);
+
+    auto conv2_param        = CreateConvParam(channel, channel, 3, 2);
+    conv2_param->dialations = {2, 2};
+    conv2_param->pad_type   = 0;
+    conv2_param->pads       = {0, 0, 0, 0};
+    AddLayer(interpreter, "Convolution", "conv2", {"pool1"}, conv2_param, CreateConvResource(conv2_param, 0.2f));
+    AddLayer(interpreter, "Sigmoid", "output0", {"conv2"}, std::make_shared<LayerParam>());
+    dynamic_cast<DefaultModelInterpreter*>(interpreter.get())->GetNetStructure()->outputs.insert("output0");
+    return interpreter;
+}
+
+TEST(TiledExecutionTest, MatchesLayerByLayer) {
+    if (CheckDeviceSkip({DEVICE_X86, DEVICE_NAIVE})) {
+        GTEST_SKIP();
+    }
+
+    // the input of the chain is larger than the L2 cache
+    DimsVector max_dims = {1, 16, 256, 256};
+    auto interpreter    = GenerateChainInterpreter(max_dims);
+    NetworkConfig config;
+    config.enable_tiled_execution = true;
+    std::shared_ptr<Instance> tiled, reference;
+    Status status = CreateInstance(tiled, interpreter, {{"input0", max_dims}}, {}, config);
+    ASSERT_EQ((int)status, TNN_OK) << status.description();
+    status = CreateInstance(reference, interpreter, {{"input0", max_dims}});
+    ASSERT_EQ((int)status, TNN_OK) << status.description();
+
+    // the blobs inside the chain are not allocated
+    int64_t tiled_memory = 0, reference_memory = 0;
+    ASSERT_EQ((int)tiled->GetForwardMemorySize(tiled_memory), TNN_OK);
+    ASSERT_EQ((int)reference->GetForwardMemorySize(reference_memory), TNN_OK);
+    EXPECT_LT(tiled_memory, reference_memory);
+
+    std::vector<DimsVector> dims_list = {max_dims, {1, 16, 201, 233}, {1, 16, 97, 256}};
+    for (const auto& dims : dims_list) {
+        std::vector<float> input(DimsVectorUtils::Count(dims));
+        InitRandom(input.data(), input.size(), -1.0f, 1.0f);
+
+        std::vector<float> result, expect;
+        ASSERT_EQ((int)tiled->Reshape({{"input0", dims}}), TNN_OK);
+        status = RunInstance(tiled, input, dims, result);
+        ASSERT_EQ((int)status, TNN_OK) << status.description();
+        ASSERT_EQ((int)reference->Reshape({{"input0", dims}}), TNN_OK);
+        status = RunInstance(reference, input, dims, expect);
+        ASSERT_EQ((int)status, TNN_OK) << status.description();
+
+        ASSERT_EQ(result.size(), expect.size());
+        int mismatch = 0;
+        for (size_t i = 0; i < result.size(); i++) {
+            if (std::fabs(result[i] - expect[i]) > 1e-5) {
+                if (mismatch == 0) {
+                    printf("ERROR AT %zu result %.6f ref %.6f dims %s\n", i, result[i], expect[i],
+                           DimsToString(dims).c_str());
+                }
+                mismatch++;
+            }
+        }
+        EXPECT_EQ(mismatch, 0);
+    }
+}
+
+}  // namespace TNN_NS
@@ -14,6 +14,7 @@
 
 #include "test/unit_test/unit_test_common.h"
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 
@@ -22,6 +23,7 @@
 #include "tnn/core/macro.h"
 #include "tnn/interpreter/default_model_interpreter.h"
 #include "tnn/utils/bfp16.h"
+#include "tnn/utils/dims_utils.h"
 
 namespace TNN_NS {
 
@@ -151,4 +153,108 @@ std::shared_ptr<AbstractModelInterpreter> GenerateInterpreter(std::string layer_
     return std::shared_ptr<AbstractModelInterpreter>(interpreter);
 }
 
+std::shared_ptr<AbstractModelInterpreter> GenerateEmptyInterpreter(std::vector<std::vector<int>> input_vec,
+                                                                   std::vector<DataType> input_dtype) {
+    auto interpreter = CreateModelInterpreter(MODEL_TYPE_TNN);
+    if (!interpreter) {
+        return nullptr;
+    }
+    DefaultModelInterpreter* default_interpreter = dynamic_cast<DefaultModelInterpreter*>(interpreter);
+    if (!default_interpreter) {
+        delete interpreter;
+        return nullptr;
+    }
+
+    NetStructure* net_structure        = default_interpreter->GetNetStructure();
+    net_structure->inputs_shape_map    = GenerateInputShapeMap(input_vec);
+    net_structure->input_data_type_map = GenerateInputDataTypeMap(input_dtype);
+    for (auto item : net_structure->inputs_shape_map) {
+        net_structure->blobs.insert(item.first);
+    }
+    return std::shared_ptr<AbstractModelInterpreter>(interpreter);
+}
+
+std::shared_ptr<LayerInfo> AddLayer(std::shared_ptr<AbstractModelInterpreter> interpreter, std::string type_str,
+                                    std::string name, std::vector<std::string> inputs,
+                                    std::shared_ptr<LayerParam> param, std::shared_ptr<LayerResource> resource) {
+    auto default_interpreter    = dynamic_cast<DefaultModelInterpreter*>(interpreter.get());
+    NetStructure* net_structure = default_interpreter->GetNetStructure();
+
+    std::shared_ptr<LayerInfo> layer_info = std::make_shared<LayerInfo>();
+    layer_info->type                      = GlobalConvertLayerType(type_str);
+    layer_info->type_str                  = type_str;
+    layer_info->name                      = name;
+    layer_info->inputs                    = inputs;
+    layer_info->outputs                   = {name};
+    layer_info->param                     = param;
+    layer_info->param->type               = type_str;
+    layer_info->param->name               = name;
+    net_structure->layers.push_back(layer_info);
+    net_structure->blobs.insert(name);
+
+    if (nullptr != resource) {
+        default_interpreter->GetNetResource()->resource_map[name] = resource;
+    }
+    return layer_info;
+}
+
+std::shared_ptr<ConvLayerParam> CreateConvParam(int input_channel, int output_channel, int kernel, int stride,
+                                                int group, int activation_type) {
+    std::shared_ptr<ConvLayerParam> param(new ConvLayerParam());
+    param->input_channel   = input_channel;
+    param->output_channel  = output_channel;
+    param->group           = group;
+    param->kernels         = {kernel, kernel};
+    param->strides         = {stride, stride};
+    param->dialations      = {1, 1};
+    param->pad_type        = -1;
+    param->pads            = {kernel / 2, kernel / 2, kernel / 2, kernel / 2};
+    param->bias            = 1;
+    param->activation_type = activation_type;
+    return param;
+}
+
+std::shared_ptr<ConvLayerResource> CreateConvResource(std::shared_ptr<ConvLayerParam> param, float filter_range) {
+    const int filter_count = param->output_channel * param->input_channel / param->group *
+                             DimsVectorUtils::Count(param->kernels);
+    std::shared_ptr<ConvLayerResource> resource(new ConvLayerResource());
+    resource->filter_handle = RawBuffer(filter_count * sizeof(float));
+    resource->bias_handle   = RawBuffer(param->output_channel * sizeof(float));
+    InitRandom(resource->filter_handle.force_to<float*>(), filter_count, -filter_range, filter_range);
+    InitRandom(resource->bias_handle.force_to<float*>(), param->output_channel, -1.0f, 1.0f);
+    return resource;
+}
+
+bool CheckDeviceSkip(std::vector<DeviceType> device_types) {
+    DeviceType dev = ConvertDeviceType(FLAGS_dt);
+    return std::find(device_types.begin(), device_types.end(), dev) == device_types.end();
+}
+
+Status CreateInstance(std::shared_ptr<Instance>& instance, std::shared_ptr<AbstractModelInterpreter> interpreter,
+                      InputShapesMap min_inputs_shape, InputShapesMap max_inputs_shape, NetworkConfig config) {
+    config.device_type = ConvertDeviceType(FLAGS_dt);
+    ModelConfig model_config;
+    // the net and its weights come from interpreter
+    model_config.params = {"", ""};
+    instance            = std::make_shared<Instance>(config, model_config);
+    Status status       = instance->Init(interpreter, min_inputs_shape,
+                                         max_inputs_shape.empty() ? min_inputs_shape : max_inputs_shape);
+    if (status != TNN_OK) {
+        instance = nullptr;
+    }
+    return status;
+}
+
+Status RunInstance(std::shared_ptr<Instance> instance, std::vector<float>& input, DimsVector dims,
+                   std::vector<float>& output) {
+    auto input_mat = std::make_shared<Mat>(DEVICE_NAIVE, NCHW_FLOAT, dims, input.data());
+    RETURN_ON_NEQ(instance->SetInputMat(input_mat, MatConvertParam(), "input0"), TNN_OK);
+    RETURN_ON_NEQ(instance->Forward(), TNN_OK);
+    std::shared_ptr<Mat> output_mat;
+    RETURN_ON_NEQ(instance->GetOutputMat(output_mat, MatConvertParam(), "output0", DEVICE_NAIVE), TNN_OK);
+    const float* data = static_cast<float*>(output_mat->GetData());
+    output.assign(data, data + DimsVectorUtils::Count(output_mat->GetDims()));
+    return TNN_OK;
+}
+
 }  // namespace TNN_NS
@@ -22,10 +22,12 @@
 
 #include "tnn/core/abstract_device.h"
 #include "tnn/core/context.h"
+#include "tnn/core/instance.h"
 #include "tnn/core/macro.h"
 #include "tnn/interpreter/abstract_model_interpreter.h"
 #include "tnn/interpreter/layer_param.h"
 #include "tnn/interpreter/layer_resource.h"
+#include "tnn/interpreter/net_structure.h"
 #include "tnn/utils/random_data_utils.h"
 
 namespace TNN_NS {
@@ -40,6 +42,37 @@ std::shared_ptr<AbstractModelInterpreter> GenerateInterpreter(std::string layer_
                                                               int output_count                        = 1,
                                                               std::vector<DataType> input_dtype       = {});
 
+// @brief interpreter of a net with the inputs input0, input1, ... of input_vec and no layers, see AddLayer
+std::shared_ptr<AbstractModelInterpreter> GenerateEmptyInterpreter(std::vector<std::vector<int>> input_vec,
+                                                                   std::vector<DataType> input_dtype = {});
+
+// @brief append a layer with the single output blob name to the net of interpreter, resource is set if not null
+std::shared_ptr<LayerInfo> AddLayer(std::shared_ptr<AbstractModelInterpreter> interpreter, std::string type_str,
+                                    std::string name, std::vector<std::string> inputs,
+                                    std::shared_ptr<LayerParam> param       = std::make_shared<LayerParam>(),
+                                    std::shared_ptr<LayerResource> resource = nullptr);
+
+// @brief conv of a square kernel, the pads keep the size at stride 1
+std::shared_ptr<ConvLayerParam> CreateConvParam(int input_channel, int output_channel, int kernel, int stride = 1,
+                                                int group = 1, int activation_type = ActivationType_None);
+
+// @brief random filter in [-filter_range, filter_range] and bias in [-1, 1] of the conv
+std::shared_ptr<ConvLayerResource> CreateConvResource(std::shared_ptr<ConvLayerParam> param,
+                                                      float filter_range = 0.5f);
+
+// @brief true if the device of -dt is none of device_types, the test is to be skipped
+bool CheckDeviceSkip(std::vector<DeviceType> device_types);
+
+// @brief init an instance of the net of interpreter on the device of -dt with the other options of config, the model
+// params are left empty. max_inputs_shape defaults to min_inputs_shape
+Status CreateInstance(std::shared_ptr<Instance>& instance, std::shared_ptr<AbstractModelInterpreter> interpreter,
+                      InputShapesMap min_inputs_shape, InputShapesMap max_inputs_shape = InputShapesMap(),
+                      NetworkConfig config = NetworkConfig());
+
+// @brief forward instance with input of dims as input0 and copy output0 to output
+Status RunInstance(std::shared_ptr<Instance> instance, std::vector<float>& input, DimsVector dims,
+                   std::vector<float>& output);
+
 }  // namespace TNN_NS
 
 #endif  // TNN_TEST_UNIT_TEST_COMMON_H_
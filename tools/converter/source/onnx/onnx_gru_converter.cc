@@ -0,0 +1,129 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "onnx_base_converter.h"
+#include "onnx_utils.h"
+
+namespace TNN_CONVERTER {
+DECLARE_OP_CONVERTER(GRU);
+
+std::string OnnxGRUConverter::TNNOpType(const onnx::NodeProto &node, bool quantized_model) {
+    return "GRUONNX";
+}
+
+TNN_NS::ActivationType OnnxGRUConverter::ActivationType(const onnx::NodeProto &node) {
+    return TNN_NS::ActivationType_None;
+}
+
+TNN_NS::Status OnnxGRUConverter::exec(TNN_NS::NetStructure &net_structure, TNN_NS::NetResource &net_resource,
+                                      const onnx::NodeProto &node,
+                                      std::map<std::string, const onnx::TensorProto *> &proxy_initializers_map,
+                                      std::map<std::string, std::shared_ptr<OnnxProxyNode>> &proxy_nodes,
+                                      bool &quantized_model) {
+    auto param       = new TNN_NS::GRUONNXLayerParam;
+    auto cur_layer   = net_structure.layers.back();
+    cur_layer->param = std::shared_ptr<TNN_NS::LayerParam>(param);
+    param->type      = cur_layer->type_str;
+    param->name      = cur_layer->name;
+    param->quantized = false;
+
+    param->hidden_size         = GetAttributeInt(node, "hidden_size", 0);
+    param->linear_before_reset = GetAttributeInt(node, "linear_before_reset", 0);
+    const auto direction       = GetAttributeString(node, "direction", "forward");
+    if (direction == "reverse") {
+        param->direction = 1;
+    } else if (direction == "bidirectional") {
+        param->direction = 2;
+    } else {
+        param->direction = 0;
+    }
+    const int num_directions = param->direction == 2 ? 2 : 1;
+
+    // X, W, R, B, sequence_lens, initial_h
+    const int input_size = node.input_size();
+    if (input_size > 4 && !node.input(4).empty()) {
+        LOGE("TNN Converter does not support sequence_lens of GRU\n");
+        return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
+    }
+    if (input_size > 5 && !node.input(5).empty() && node.input(3).empty()) {
+        LOGE("TNN Converter does not support initial_h of GRU without B\n");
+        return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
+    }
+    cur_layer->inputs.clear();
+    for (int i = 0; i < input_size; i++) {
+        const auto &input = node.input(i);
+        if (input.empty() || i == 4) {
+            continue;
+        }
+        cur_layer->inputs.push_back(input);
+        if (proxy_initializers_map.find(input) != proxy_initializers_map.end()) {
+            TNN_NS::RawBuffer *const_raw_buffer = nullptr;
+            CreateRawBufferFromTensor(*proxy_initializers_map[input], &const_raw_buffer);
+            net_resource.constant_map[input] = std::shared_ptr<TNN_NS::RawBuffer>(const_raw_buffer);
+        }
+    }
+
+    // GRUONNX writes Y as [seq_length, batch_size, num_directions * hidden_size],
+    // reshape and permute it back to [seq_length, num_directions, batch_size, hidden_size] of onnx
+    const std::string y_name     = node.output(0);
+    const std::string gru_output = cur_layer->name + "_gru_output";
+    const std::string reshape_output = cur_layer->name + "_gru_reshape";
+    cur_layer->outputs.clear();
+    cur_layer->outputs.push_back(gru_output);
+    if (node.output_size() > 1 && !node.output(1).empty()) {
+        cur_layer->outputs.push_back(node.output(1));
+    }
+    InsertBlobs(net_structure);
+    if (y_name.empty()) {
+        return TNN_NS::TNN_CONVERT_OK;
+    }
+
+    auto reshape_layer      = std::make_shared<TNN_NS::LayerInfo>();
+    reshape_layer->type     = TNN_NS::LAYER_RESHAPE;
+    reshape_layer->type_str = "Reshape";
+    reshape_layer->name     = cur_layer->name + "_reshape";
+    reshape_layer->inputs.push_back(gru_output);
+    reshape_layer->outputs.push_back(reshape_output);
+    auto reshape_param          = new TNN_NS::ReshapeLayerParam;
+    reshape_layer->param        = std::shared_ptr<TNN_NS::LayerParam>(reshape_param);
+    reshape_param->type         = reshape_layer->type_str;
+    reshape_param->name         = reshape_layer->name;
+    reshape_param->quantized    = false;
+    reshape_param->axis         = 0;
+    reshape_param->num_axes     = 4;
+    reshape_param->shape        = {0, 0, num_directions, param->hidden_size};
+    reshape_param->reshape_type = 0;
+    net_structure.layers.push_back(reshape_layer);
+    InsertBlobs(net_structure);
+
+    auto permute_layer      = std::make_shared<TNN_NS::LayerInfo>();
+    permute_layer->type     = TNN_NS::LAYER_PERMUTE;
+    permute_layer->type_str = "Permute";
+    permute_layer->name     = cur_layer->name + "_permute";
+    permute_layer->inputs.push_back(reshape_output);
+    permute_layer->outputs.push_back(y_name);
+    auto permute_param       = new TNN_NS::PermuteLayerParam;
+    permute_layer->param     = std::shared_ptr<TNN_NS::LayerParam>(permute_param);
+    permute_param->type      = permute_layer->type_str;
+    permute_param->name      = permute_layer->name;
+    permute_param->quantized = false;
+    permute_param->orders    = {0, 2, 1, 3};
+    net_structure.layers.push_back(permute_layer);
+
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+REGISTER_CONVERTER(GRU, GRU);
+
+}  // namespace TNN_CONVERTER
@@ -0,0 +1,224 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+#include "tnn/interpreter/tnn/objseri.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn_optimize_pass.h"
+#include "tnn_optimize_utils.h"
+
+namespace TNN_CONVERTER {
+
+DECLARE_OPTIMIZE_PASS(AlgebraicSimplify);
+
+std::string TnnOptimizeAlgebraicSimplifyPass::PassName() {
+    return "AlgebraicSimplify";
+}
+
+// whether every element of the buffer equals value
+static bool IsFilledWith(TNN_NS::RawBuffer& buffer, float value) {
+    const int count = buffer.GetDataCount();
+    if (count <= 0) {
+        return false;
+    }
+    if (buffer.GetDataType() == TNN_NS::DATA_TYPE_INT32) {
+        auto data = buffer.force_to<int*>();
+        return std::all_of(data, data + count, [&](int v) { return v == value; });
+    }
+    if (buffer.GetDataType() != TNN_NS::DATA_TYPE_FLOAT && buffer.GetDataType() != TNN_NS::DATA_TYPE_HALF) {
+        return false;
+    }
+    auto data = TNN_NS::GetFloatFromRawBuffer(buffer);
+    return data && std::all_of(data.get(), data.get() + count, [&](float v) { return v == value; });
+}
+
+// x * 1, x / 1, x + 0 and x - 0 return x when the constant does not broadcast x to a larger shape
+static bool GetIdentityBinaryInput(std::shared_ptr<TNN_NS::LayerInfo> layer, TNN_NS::NetResource& net_resource,
+                                   std::string& input_name) {
+    const auto type = layer->type;
+    if ((type != TNN_NS::LAYER_MUL && type != TNN_NS::LAYER_DIV && type != TNN_NS::LAYER_ADD &&
+         type != TNN_NS::LAYER_SUB) ||
+        layer->param->quantized || layer->outputs.size() != 1) {
+        return false;
+    }
+    const float neutral = (type == TNN_NS::LAYER_MUL || type == TNN_NS::LAYER_DIV) ? 1.0f : 0.0f;
+    // the constant must be the second operand of div and sub
+    const bool commutative = type == TNN_NS::LAYER_MUL || type == TNN_NS::LAYER_ADD;
+
+    TNN_NS::RawBuffer* constant = nullptr;
+    if (layer->inputs.size() == 1) {
+        auto param         = dynamic_cast<TNN_NS::MultidirBroadcastLayerParam*>(layer->param.get());
+        auto resource_iter = net_resource.resource_map.find(layer->name);
+        if (!param || resource_iter == net_resource.resource_map.end() ||
+            (!commutative && param->weight_input_index != 1)) {
+            return false;
+        }
+        auto resource = dynamic_cast<TNN_NS::EltwiseLayerResource*>(resource_iter->second.get());
+        if (!resource) {
+            return false;
+        }
+        constant   = &resource->element_handle;
+        input_name = layer->inputs[0];
+    } else if (layer->inputs.size() == 2) {
+        auto& constant_map = net_resource.constant_map;
+        for (int i = 1; i >= (commutative ? 0 : 1); i--) {
+            auto iter = constant_map.find(layer->inputs[i]);
+            if (iter != constant_map.end() && iter->second) {
+                constant   = iter->second.get();
+                input_name = layer->inputs[1 - i];
+                break;
+            }
+        }
+    }
+    if (!constant || !IsFilledWith(*constant, neutral)) {
+        return false;
+    }
+
+    auto& shapes_map = net_resource.blob_shapes_map;
+    auto input_iter  = shapes_map.find(input_name);
+    auto output_iter = shapes_map.find(layer->outputs[0]);
+    if (input_iter == shapes_map.end() || output_iter == shapes_map.end() ||
+        !TNN_NS::DimsVectorUtils::Equal(input_iter->second, output_iter->second)) {
+        return false;
+    }
+    auto& datatype_map = net_resource.blob_datatype_map;
+    auto input_type    = datatype_map.find(input_name);
+    auto output_type   = datatype_map.find(layer->outputs[0]);
+    return input_type == datatype_map.end() || output_type == datatype_map.end() ||
+           input_type->second == output_type->second;
+}
+
+// neg(neg(x)) is x
+static bool GetDoubleNegationInput(TNN_NS::NetStructure& net_structure, std::shared_ptr<TNN_NS::LayerInfo> layer,
+                                   std::string& input_name) {
+    if (layer->type != TNN_NS::LAYER_NEG || layer->inputs.size() != 1 || layer->outputs.size() != 1 ||
+        layer->param->quantized) {
+        return false;
+    }
+    auto producer = FindProducer(net_structure, layer->inputs[0]);
+    if (!producer || producer->type != TNN_NS::LAYER_NEG || producer->inputs.size() != 1 ||
+        producer->param->quantized) {
+        return false;
+    }
+    input_name = producer->inputs[0];
+    return true;
+}
+
+// reshape(reshape(x)) is a single reshape to the second shape, unless the second shape copies the dims of
+// its input with 0
+static bool MergeReshape(TNN_NS::NetStructure& net_structure, std::shared_ptr<TNN_NS::LayerInfo> layer) {
+    if (layer->type != TNN_NS::LAYER_RESHAPE || layer->inputs.size() != 1) {
+        return false;
+    }
+    auto producer = FindProducer(net_structure, layer->inputs[0]);
+    if (!producer || producer->type != TNN_NS::LAYER_RESHAPE || producer->inputs.size() != 1) {
+        return false;
+    }
+    auto param          = dynamic_cast<TNN_NS::ReshapeLayerParam*>(layer->param.get());
+    auto producer_param = dynamic_cast<TNN_NS::ReshapeLayerParam*>(producer->param.get());
+    if (!param || !producer_param || param->reshape_type != 0 || producer_param->reshape_type != 0 ||
+        param->axis != 0 || (param->num_axes != -1 && param->num_axes != (int)param->shape.size()) ||
+        std::find(param->shape.begin(), param->shape.end(), 0) != param->shape.end()) {
+        return false;
+    }
+    layer->inputs[0] = producer->inputs[0];
+    return true;
+}
+
+// slice(slice(x)) is a single slice, the axes must be distinct or sliced with step 1 from non negative positions
+static bool MergeStrideSlice(TNN_NS::NetStructure& net_structure, std::shared_ptr<TNN_NS::LayerInfo> layer) {
+    if (layer->type != TNN_NS::LAYER_STRIDED_SLICE_V2 || layer->inputs.size() != 1) {
+        return false;
+    }
+    auto producer = FindProducer(net_structure, layer->inputs[0]);
+    if (!producer || producer->type != TNN_NS::LAYER_STRIDED_SLICE_V2 || producer->inputs.size() != 1 ||
+        producer->outputs.size() != 1) {
+        return false;
+    }
+    auto param          = dynamic_cast<TNN_NS::StrideSliceV2LayerParam*>(layer->param.get());
+    auto producer_param = dynamic_cast<TNN_NS::StrideSliceV2LayerParam*>(producer->param.get());
+    if (!param || !producer_param) {
+        return false;
+    }
+    auto is_valid = [](TNN_NS::StrideSliceV2LayerParam* p) {
+        const int size = p->axes.size();
+        return (int)p->begins.size() == size && (int)p->ends.size() == size && (int)p->strides.size() == size &&
+               std::all_of(p->axes.begin(), p->axes.end(), [](int axis) { return axis >= 0; });
+    };
+    if (!is_valid(param) || !is_valid(producer_param)) {
+        return false;
+    }
+
+    auto merged = *producer_param;
+    for (int i = 0; i < (int)param->axes.size(); i++) {
+        auto iter = std::find(merged.axes.begin(), merged.axes.end(), param->axes[i]);
+        if (iter == merged.axes.end()) {
+            merged.axes.push_back(param->axes[i]);
+            merged.begins.push_back(param->begins[i]);
+            merged.ends.push_back(param->ends[i]);
+            merged.strides.push_back(param->strides[i]);
+            continue;
+        }
+        const int j = iter - merged.axes.begin();
+        if (merged.strides[j] != 1 || param->strides[i] != 1 || merged.begins[j] < 0 || merged.ends[j] < 0 ||
+            param->begins[i] < 0 || param->ends[i] < 0) {
+            return false;
+        }
+        const int64_t begin = (int64_t)merged.begins[j] + param->begins[i];
+        const int64_t end   = std::min((int64_t)merged.begins[j] + param->ends[i], (int64_t)merged.ends[j]);
+        merged.begins[j]    = std::min(begin, (int64_t)INT_MAX);
+        merged.ends[j]      = std::min(end, (int64_t)INT_MAX);
+    }
+
+    param->axes      = merged.axes;
+    param->begins    = merged.begins;
+    param->ends      = merged.ends;
+    param->strides   = merged.strides;
+    layer->inputs[0] = producer->inputs[0];
+    return true;
+}
+
+TNN_NS::Status TnnOptimizeAlgebraicSimplifyPass::exec(TNN_NS::NetStructure& net_structure,
+                                                      TNN_NS::NetResource& net_resource) {
+    // the merged reshapes and slices read the input of the first layer, which is left to EliminateDeadOutput
+    auto& layers = net_structure.layers;
+    for (int index = 0; index < (int)layers.size();) {
+        auto layer = layers[index];
+        std::string input_name;
+        if (MergeReshape(net_structure, layer) || MergeStrideSlice(net_structure, layer)) {
+            index++;
+            continue;
+        }
+        if (!GetIdentityBinaryInput(layer, net_resource, input_name) &&
+            !GetDoubleNegationInput(net_structure, layer, input_name)) {
+            index++;
+            continue;
+        }
+        // the name of a net output must be kept
+        if (IsNetOutput(net_structure, layer->outputs[0])) {
+            index++;
+            continue;
+        }
+        ReplaceBlobUses(net_structure, layer->outputs[0], input_name);
+        RemoveLayer(net_structure, net_resource, index);
+    }
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+REGISTER_OPTIMIZE_PASS(AlgebraicSimplify);
+}  // namespace TNN_CONVERTER
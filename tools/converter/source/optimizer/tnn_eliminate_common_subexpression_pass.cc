@@ -0,0 +1,105 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <map>
+#include <vector>
+
+#include "tnn/interpreter/tnn/objseri.h"
+#include "tnn_optimize_pass.h"
+#include "tnn_optimize_utils.h"
+
+namespace TNN_CONVERTER {
+
+DECLARE_OPTIMIZE_PASS(EliminateCommonSubexpression);
+
+std::string TnnOptimizeEliminateCommonSubexpressionPass::PassName() {
+    return "EliminateCommonSubexpression";
+}
+
+static TNN_NS::Status GetLayerSignature(std::shared_ptr<TNN_NS::LayerInfo> layer, TNN_NS::NetResource& net_resource,
+                                        std::string& signature) {
+    std::string param_signature, resource_signature;
+    auto status = GetParamSignature(layer->type, layer->param, param_signature);
+    if (status != TNN_NS::TNN_OK) {
+        return status;
+    }
+    status = GetResourceSignature(layer, net_resource, resource_signature);
+    if (status != TNN_NS::TNN_OK) {
+        return status;
+    }
+    signature = param_signature + "|" + resource_signature;
+    return TNN_NS::TNN_OK;
+}
+
+TNN_NS::Status TnnOptimizeEliminateCommonSubexpressionPass::exec(TNN_NS::NetStructure& net_structure,
+                                                                 TNN_NS::NetResource& net_resource) {
+    // layers of the same type reading the same blobs are compared by the param and resource they save to the
+    // model, the signatures are only computed for such candidates as they hold a copy of the weights
+    std::map<std::string, std::vector<std::shared_ptr<TNN_NS::LayerInfo>>> candidates;
+    std::map<TNN_NS::LayerInfo*, std::string> signatures;
+    auto get_signature = [&](std::shared_ptr<TNN_NS::LayerInfo> layer) -> const std::string& {
+        auto iter = signatures.find(layer.get());
+        if (iter == signatures.end()) {
+            std::string signature;
+            if (GetLayerSignature(layer, net_resource, signature) != TNN_NS::TNN_OK) {
+                // a layer which can not be saved is never equal to another
+                signature = "#" + layer->name;
+            }
+            iter = signatures.insert(std::make_pair(layer.get(), signature)).first;
+        }
+        return iter->second;
+    };
+
+    auto& layers = net_structure.layers;
+    for (int index = 0; index < (int)layers.size();) {
+        auto layer = layers[index];
+        if (layer->outputs.empty()) {
+            index++;
+            continue;
+        }
+        std::string key = layer->type_str + ":";
+        for (const auto& input : layer->inputs) {
+            key += input + ",";
+        }
+
+        std::shared_ptr<TNN_NS::LayerInfo> equal_layer = nullptr;
+        bool removable = std::none_of(layer->outputs.begin(), layer->outputs.end(),
+                                      [&](const std::string& name) { return IsNetOutput(net_structure, name); });
+        if (removable) {
+            for (auto candidate : candidates[key]) {
+                if (candidate->outputs.size() == layer->outputs.size() &&
+                    get_signature(candidate) == get_signature(layer)) {
+                    equal_layer = candidate;
+                    break;
+                }
+            }
+        }
+        if (!equal_layer) {
+            candidates[key].push_back(layer);
+            index++;
+            continue;
+        }
+
+        for (int i = 0; i < (int)layer->outputs.size(); i++) {
+            ReplaceBlobUses(net_structure, layer->outputs[i], equal_layer->outputs[i]);
+        }
+        signatures.erase(layer.get());
+        RemoveLayer(net_structure, net_resource, index);
+    }
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+REGISTER_OPTIMIZE_PASS(EliminateCommonSubexpression);
+}  // namespace TNN_CONVERTER
@@ -0,0 +1,72 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <algorithm>
+#include <set>
+
+#include "tnn/interpreter/tnn/objseri.h"
+#include "tnn_optimize_pass.h"
+#include "tnn_optimize_utils.h"
+
+namespace TNN_CONVERTER {
+
+DECLARE_OPTIMIZE_PASS(EliminateDeadOutput);
+
+std::string TnnOptimizeEliminateDeadOutputPass::PassName() {
+    return "EliminateDeadOutput";
+}
+
+TNN_NS::Status TnnOptimizeEliminateDeadOutputPass::exec(TNN_NS::NetStructure& net_structure,
+                                                        TNN_NS::NetResource& net_resource) {
+    // walk the layers backward, a layer none of whose outputs is read later or by the user is dead
+    std::set<std::string> used_blobs(net_structure.outputs.begin(), net_structure.outputs.end());
+    auto& layers = net_structure.layers;
+    for (int index = (int)layers.size() - 1; index >= 0; index--) {
+        auto layer = layers[index];
+        bool alive = std::any_of(layer->outputs.begin(), layer->outputs.end(),
+                                 [&](const std::string& name) { return used_blobs.count(name) > 0; });
+        if (!alive) {
+            RemoveLayer(net_structure, net_resource, index);
+            continue;
+        }
+        used_blobs.insert(layer->inputs.begin(), layer->inputs.end());
+    }
+
+    // constants only read by the removed layers need not be saved to the model
+    auto& constant_map = net_resource.constant_map;
+    for (auto iter = constant_map.begin(); iter != constant_map.end();) {
+        if (used_blobs.find(iter->first) == used_blobs.end()) {
+            net_resource.constant_blob_flags.erase(iter->first);
+            iter = constant_map.erase(iter);
+        } else {
+            iter++;
+        }
+    }
+
+    std::set<std::string> blobs;
+    for (const auto& iter : net_structure.inputs_shape_map) {
+        blobs.insert(iter.first);
+    }
+    for (const auto& layer : layers) {
+        blobs.insert(layer->inputs.begin(), layer->inputs.end());
+        blobs.insert(layer->outputs.begin(), layer->outputs.end());
+    }
+    net_structure.blobs = blobs;
+
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+REGISTER_OPTIMIZE_PASS(EliminateDeadOutput);
+}  // namespace TNN_CONVERTER
@@ -0,0 +1,234 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <vector>
+
+#include "tnn/interpreter/tnn/objseri.h"
+#include "tnn/utils/data_type_utils.h"
+#include "tnn_optimize_pass.h"
+#include "tnn_optimize_utils.h"
+
+namespace TNN_CONVERTER {
+
+DECLARE_OPTIMIZE_PASS(MergeParallelGemm);
+
+std::string TnnOptimizeMergeParallelGemmPass::PassName() {
+    return "MergeParallelGemm";
+}
+
+struct GemmLayer {
+    int index;
+    std::shared_ptr<TNN_NS::LayerInfo> layer;
+    // output channels of conv or num_output of inner product
+    int output_channel;
+    bool has_bias;
+    TNN_NS::RawBuffer* weight;
+    TNN_NS::RawBuffer* bias;
+};
+
+// the key of a convolution or inner product without quantization, the layers with equal keys only differ in the
+// number of output channels and the bias, so their weights can be concatenated into one gemm
+static bool GetGemmLayer(std::shared_ptr<TNN_NS::LayerInfo> layer, TNN_NS::NetResource& net_resource, int index,
+                         GemmLayer& gemm, std::string& key) {
+    if ((layer->type != TNN_NS::LAYER_CONVOLUTION && layer->type != TNN_NS::LAYER_INNER_PRODUCT) ||
+        layer->inputs.size() != 1 || layer->outputs.size() != 1 || layer->param->quantized) {
+        return false;
+    }
+    auto resource_iter = net_resource.resource_map.find(layer->name);
+    if (resource_iter == net_resource.resource_map.end()) {
+        return false;
+    }
+
+    auto param = layer->param->Copy();
+    gemm.index = index;
+    gemm.layer = layer;
+    if (layer->type == TNN_NS::LAYER_CONVOLUTION) {
+        auto conv_param = dynamic_cast<TNN_NS::ConvLayerParam*>(param.get());
+        auto resource   = dynamic_cast<TNN_NS::ConvLayerResource*>(resource_iter->second.get());
+        if (!conv_param || !resource || conv_param->group != 1 || conv_param->fusion_type != TNN_NS::FusionType_None ||
+            resource->filter_format != TNN_NS::OIHW || resource->scale_handle.GetBytesSize() > 0) {
+            return false;
+        }
+        gemm.output_channel        = conv_param->output_channel;
+        gemm.has_bias              = conv_param->bias != 0;
+        gemm.weight                = &resource->filter_handle;
+        gemm.bias                  = &resource->bias_handle;
+        conv_param->output_channel = 0;
+        conv_param->bias           = 0;
+    } else {
+        auto ip_param = dynamic_cast<TNN_NS::InnerProductLayerParam*>(param.get());
+        auto resource = dynamic_cast<TNN_NS::InnerProductLayerResource*>(resource_iter->second.get());
+        if (!ip_param || !resource || ip_param->transpose != 0 || ip_param->weight_quant_bits > 0 ||
+            resource->scale_handle.GetBytesSize() > 0) {
+            return false;
+        }
+        gemm.output_channel  = ip_param->num_output;
+        gemm.has_bias        = ip_param->has_bias != 0;
+        gemm.weight          = &resource->weight_handle;
+        gemm.bias            = &resource->bias_handle;
+        ip_param->num_output = 0;
+        ip_param->has_bias   = 0;
+    }
+    if (gemm.output_channel <= 0 || gemm.weight->GetDataCount() % gemm.output_channel != 0 ||
+        (gemm.has_bias && gemm.bias->GetDataCount() != gemm.output_channel)) {
+        return false;
+    }
+
+    std::string param_signature;
+    if (GetParamSignature(layer->type, param, param_signature) != TNN_NS::TNN_OK) {
+        return false;
+    }
+    key = layer->type_str + ":" + layer->inputs[0] + ":" + std::to_string(gemm.weight->GetDataType()) + ":" +
+          std::to_string(gemm.weight->GetDataCount() / gemm.output_channel) + ":" + param_signature;
+    return true;
+}
+
+// concatenate the per output channel data of the layers, layers without bias contribute zeros
+static TNN_NS::RawBuffer ConcatBuffers(const std::vector<GemmLayer>& gemms, bool is_bias, TNN_NS::DataType data_type,
+                                       int total_channel) {
+    const int element_size = TNN_NS::DataTypeUtils::GetBytesSize(data_type);
+    int64_t total_bytes    = 0;
+    for (const auto& gemm : gemms) {
+        total_bytes += is_bias ? (int64_t)gemm.output_channel * element_size : gemm.weight->GetBytesSize64();
+    }
+    TNN_NS::RawBuffer buffer(total_bytes);
+    memset(buffer.force_to<char*>(), 0, total_bytes);
+    int64_t offset = 0;
+    for (const auto& gemm : gemms) {
+        auto src = is_bias ? gemm.bias : gemm.weight;
+        if (!is_bias || gemm.has_bias) {
+            memcpy(buffer.force_to<char*>() + offset, src->force_to<char*>(), src->GetBytesSize64());
+        }
+        offset += is_bias ? (int64_t)gemm.output_channel * element_size : src->GetBytesSize64();
+    }
+    buffer.SetDataType(data_type);
+
+    auto dims = gemms[0].weight->GetBufferDims();
+    if (is_bias) {
+        buffer.SetBufferDims({total_channel});
+    } else if (!dims.empty()) {
+        dims[0] = total_channel;
+        buffer.SetBufferDims(dims);
+    }
+    return buffer;
+}
+
+static bool MergeGemmLayers(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource,
+                            const std::vector<GemmLayer>& gemms) {
+    const auto& first = gemms[0];
+    int total_channel = 0;
+    bool has_bias     = false;
+    // the bias of the merged layer takes the data type of the layers having one
+    auto bias_type = first.weight->GetDataType();
+    std::vector<int> slices;
+    for (const auto& gemm : gemms) {
+        total_channel += gemm.output_channel;
+        slices.push_back(gemm.output_channel);
+        if (gemm.has_bias) {
+            has_bias  = true;
+            bias_type = gemm.bias->GetDataType();
+        }
+    }
+    for (const auto& gemm : gemms) {
+        if (gemm.has_bias && gemm.bias->GetDataType() != bias_type) {
+            return false;
+        }
+    }
+
+    auto merged       = first.layer->Copy();
+    merged->outputs   = {first.layer->name + "_merged"};
+    int split_axis    = 1;
+    auto weight       = ConcatBuffers(gemms, false, first.weight->GetDataType(), total_channel);
+    auto bias         = has_bias ? ConcatBuffers(gemms, true, bias_type, total_channel) : TNN_NS::RawBuffer();
+    auto old_resource = net_resource.resource_map[first.layer->name];
+    if (merged->type == TNN_NS::LAYER_CONVOLUTION) {
+        auto param            = dynamic_cast<TNN_NS::ConvLayerParam*>(merged->param.get());
+        param->output_channel = total_channel;
+        param->bias           = has_bias ? 1 : 0;
+        auto resource         = std::make_shared<TNN_NS::ConvLayerResource>();
+        resource->filter_format = dynamic_cast<TNN_NS::ConvLayerResource*>(old_resource.get())->filter_format;
+        resource->filter_handle = weight;
+        resource->bias_handle   = bias;
+        net_resource.resource_map[merged->name] = resource;
+    } else {
+        auto param        = dynamic_cast<TNN_NS::InnerProductLayerParam*>(merged->param.get());
+        param->num_output = total_channel;
+        param->has_bias   = has_bias ? 1 : 0;
+        split_axis        = param->axis;
+        auto resource     = std::make_shared<TNN_NS::InnerProductLayerResource>();
+        resource->weight_handle = weight;
+        resource->bias_handle   = bias;
+        net_resource.resource_map[merged->name] = resource;
+    }
+
+    auto split_param                = std::make_shared<TNN_NS::SplitVLayerParam>();
+    split_param->name               = first.layer->name + "_split";
+    split_param->axis               = split_axis;
+    split_param->slices             = slices;
+    split_param->is_split_specified = true;
+    auto split                      = std::make_shared<TNN_NS::LayerInfo>();
+    split->type                     = TNN_NS::LAYER_SPLITV;
+    split->type_str                 = "SplitV";
+    split->name                     = split_param->name;
+    split->param                    = split_param;
+    split->inputs                   = merged->outputs;
+    for (const auto& gemm : gemms) {
+        split->outputs.push_back(gemm.layer->outputs[0]);
+    }
+    net_structure.blobs.insert(merged->outputs[0]);
+
+    // the other layers come later in the net, so all of their consumers follow the split
+    auto& layers = net_structure.layers;
+    for (int i = gemms.size() - 1; i > 0; i--) {
+        RemoveLayer(net_structure, net_resource, gemms[i].index);
+    }
+    layers[first.index] = merged;
+    layers.insert(layers.begin() + first.index + 1, split);
+    return true;
+}
+
+TNN_NS::Status TnnOptimizeMergeParallelGemmPass::exec(TNN_NS::NetStructure& net_structure,
+                                                      TNN_NS::NetResource& net_resource) {
+    // merge one group at a time, the indices of the layers change after each merge
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        std::map<std::string, std::vector<GemmLayer>> groups;
+        auto& layers = net_structure.layers;
+        for (int index = 0; index < (int)layers.size(); index++) {
+            GemmLayer gemm;
+            std::string key;
+            if (GetGemmLayer(layers[index], net_resource, index, gemm, key)) {
+                groups[key].push_back(gemm);
+            }
+        }
+        for (const auto& iter : groups) {
+            if (iter.second.size() < 2) {
+                continue;
+            }
+            if (MergeGemmLayers(net_structure, net_resource, iter.second)) {
+                changed = true;
+                break;
+            }
+        }
+    }
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+REGISTER_OPTIMIZE_PASS(MergeParallelGemm);
+}  // namespace TNN_CONVERTER
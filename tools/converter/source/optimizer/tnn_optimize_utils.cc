@@ -0,0 +1,105 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn_optimize_utils.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "tnn/interpreter/tnn/layer_interpreter/abstract_layer_interpreter.h"
+#include "tnn/interpreter/tnn/model_interpreter.h"
+#include "tnn/interpreter/tnn/objseri.h"
+
+namespace TNN_CONVERTER {
+
+bool IsNetOutput(const TNN_NS::NetStructure& net_structure, const std::string& blob_name) {
+    return net_structure.outputs.find(blob_name) != net_structure.outputs.end();
+}
+
+int CountBlobUses(const TNN_NS::NetStructure& net_structure, const std::string& blob_name) {
+    int count = 0;
+    for (const auto& layer : net_structure.layers) {
+        count += std::count(layer->inputs.begin(), layer->inputs.end(), blob_name);
+    }
+    return count;
+}
+
+std::shared_ptr<TNN_NS::LayerInfo> FindProducer(const TNN_NS::NetStructure& net_structure,
+                                                const std::string& blob_name) {
+    for (const auto& layer : net_structure.layers) {
+        if (std::find(layer->outputs.begin(), layer->outputs.end(), blob_name) != layer->outputs.end()) {
+            return layer;
+        }
+    }
+    return nullptr;
+}
+
+void ReplaceBlobUses(TNN_NS::NetStructure& net_structure, const std::string& blob_name, const std::string& new_name) {
+    for (auto& layer : net_structure.layers) {
+        std::replace(layer->inputs.begin(), layer->inputs.end(), blob_name, new_name);
+    }
+}
+
+void RemoveLayer(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource, int index) {
+    auto& layers = net_structure.layers;
+    net_resource.resource_map.erase(layers[index]->name);
+    layers.erase(layers.begin() + index);
+}
+
+TNN_NS::Status GetParamSignature(TNN_NS::LayerType layer_type, std::shared_ptr<TNN_NS::LayerParam> param,
+                                 std::string& signature) {
+    auto& layer_interpreter_map = TNN_NS::ModelInterpreter::GetLayerInterpreterMap();
+    auto iter                   = layer_interpreter_map.find(layer_type);
+    if (iter == layer_interpreter_map.end() || param == nullptr) {
+        return TNN_NS::Status(TNN_NS::TNNERR_CONVERT_OPTIMIZE_ERROR, "layer has no interpreter");
+    }
+    auto param_copy  = param->Copy();
+    param_copy->name = "";
+
+    std::ostringstream stream;
+    auto status = iter->second->SaveProto(stream, param_copy.get());
+    if (status != TNN_NS::TNN_OK) {
+        return status;
+    }
+    signature = std::to_string(param->quantized) + " " + stream.str();
+    return TNN_NS::TNN_OK;
+}
+
+TNN_NS::Status GetResourceSignature(std::shared_ptr<TNN_NS::LayerInfo> layer, TNN_NS::NetResource& net_resource,
+                                    std::string& signature) {
+    signature          = "";
+    auto resource_iter = net_resource.resource_map.find(layer->name);
+    if (resource_iter == net_resource.resource_map.end() || resource_iter->second == nullptr) {
+        return TNN_NS::TNN_OK;
+    }
+    auto& layer_interpreter_map = TNN_NS::ModelInterpreter::GetLayerInterpreterMap();
+    auto iter                   = layer_interpreter_map.find(layer->type);
+    if (iter == layer_interpreter_map.end()) {
+        return TNN_NS::Status(TNN_NS::TNNERR_CONVERT_OPTIMIZE_ERROR, "layer has no interpreter");
+    }
+    auto param_copy  = layer->param->Copy();
+    param_copy->name = "";
+
+    std::ostringstream stream;
+    TNN_NS::Serializer serializer(stream);
+    auto status = iter->second->SaveResource(serializer, param_copy.get(), resource_iter->second.get());
+    if (status != TNN_NS::TNN_OK) {
+        return status;
+    }
+    signature = stream.str();
+    return TNN_NS::TNN_OK;
+}
+
+}  // namespace TNN_CONVERTER
@@ -0,0 +1,52 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef TNN_TOOLS_CONVERTER_SOURCE_OPTIMIZER_TNN_OPTIMIZE_UTILS_H_
+#define TNN_TOOLS_CONVERTER_SOURCE_OPTIMIZER_TNN_OPTIMIZE_UTILS_H_
+#include <memory>
+#include <string>
+
+#include "tnn/core/status.h"
+#include "tnn/interpreter/net_resource.h"
+#include "tnn/interpreter/net_structure.h"
+
+namespace TNN_CONVERTER {
+
+bool IsNetOutput(const TNN_NS::NetStructure& net_structure, const std::string& blob_name);
+
+// the number of layer inputs reading the blob
+int CountBlobUses(const TNN_NS::NetStructure& net_structure, const std::string& blob_name);
+
+// the layer writing the blob, nullptr for the inputs of the net
+std::shared_ptr<TNN_NS::LayerInfo> FindProducer(const TNN_NS::NetStructure& net_structure,
+                                                const std::string& blob_name);
+
+// let every layer read new_name instead of blob_name
+void ReplaceBlobUses(TNN_NS::NetStructure& net_structure, const std::string& blob_name, const std::string& new_name);
+
+// remove the layer and its resource from the net
+void RemoveLayer(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource, int index);
+
+// the param as written to the proto, without the layer name
+TNN_NS::Status GetParamSignature(TNN_NS::LayerType layer_type, std::shared_ptr<TNN_NS::LayerParam> param,
+                                 std::string& signature);
+
+// the resource as written to the model, without the layer name, empty if the layer has no resource
+TNN_NS::Status GetResourceSignature(std::shared_ptr<TNN_NS::LayerInfo> layer, TNN_NS::NetResource& net_resource,
+                                    std::string& signature);
+
+}  // namespace TNN_CONVERTER
+
+#endif  // TNN_TOOLS_CONVERTER_SOURCE_OPTIMIZER_TNN_OPTIMIZE_UTILS_H_
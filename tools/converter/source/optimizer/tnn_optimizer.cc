@@ -43,8 +43,17 @@ TNN_NS::Status TnnOptimizer::PreOptimize(TNN_NS::NetStructure& net_structure, TN
 
 TNN_NS::Status TnnOptimizer::PostOptimize(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource) {
     // pre optimize
-    std::vector<std::string> pre_optimize_pass = {"ConstantFolding", "AdjustLayerInputs", "EliminateReformatNode",
+    // PropagateShapeConstant must run before ConstantFolding rewires the inputs of the folded layers
+    std::vector<std::string> pre_optimize_pass = {"PropagateShapeConstant",
+                                                  "ConstantFolding",
+                                                  "AdjustLayerInputs",
+                                                  "AlgebraicSimplify",
+                                                  "EliminateCommonSubexpression",
+                                                  "MergeParallelGemm",
+                                                  "EliminateDeadOutput",
+                                                  "EliminateReformatNode",
                                                   "TransformDequantized"};
+    const int origin_layer_count = net_structure.layers.size();
     for (const auto& pass_name : pre_optimize_pass) {
         auto pass = TnnOptimizePassManager::get()->search(pass_name);
         if (pass == nullptr) {
@@ -56,7 +65,9 @@ TNN_NS::Status TnnOptimizer::PostOptimize(TNN_NS::NetStructure& net_structure, T
             LOGE("Converter: pre optimize failed. the failed pass is %s\n", pass_name.c_str());
             return TNN_NS::TNNERR_CONVERT_OPTIMIZE_ERROR;
         }
+        LOGD("Converter: optimize pass %s, %d layers left\n", pass_name.c_str(), (int)net_structure.layers.size());
     }
+    printf("TNN Converter optimize layer count %d -> %d\n", origin_layer_count, (int)net_structure.layers.size());
 
     return TNN_NS::TNN_CONVERT_OK;
 }
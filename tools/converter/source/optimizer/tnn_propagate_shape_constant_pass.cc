@@ -0,0 +1,84 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <algorithm>
+
+#include "tnn/interpreter/tnn/objseri.h"
+#include "tnn_optimize_pass.h"
+
+namespace TNN_CONVERTER {
+
+DECLARE_OPTIMIZE_PASS(PropagateShapeConstant);
+
+std::string TnnOptimizePropagateShapeConstantPass::PassName() {
+    return "PropagateShapeConstant";
+}
+
+// the runtime has filled the param of these layers with their constant inputs (see
+// FillLayerParamWithConstantResource), so the inputs and the shape layers computing them can be dropped
+static bool IsParamFilled(std::shared_ptr<TNN_NS::LayerInfo> layer) {
+    const int input_count = layer->inputs.size();
+    switch (layer->type) {
+        case TNN_NS::LAYER_RESHAPE: {
+            auto param = dynamic_cast<TNN_NS::ReshapeLayerParam*>(layer->param.get());
+            return param && input_count == 2 && !param->shape.empty();
+        }
+        case TNN_NS::LAYER_STRIDED_SLICE_V2: {
+            auto param = dynamic_cast<TNN_NS::StrideSliceV2LayerParam*>(layer->param.get());
+            return param && input_count <= 3 && !param->begins.empty() && !param->ends.empty();
+        }
+        case TNN_NS::LAYER_UPSAMPLE: {
+            auto param = dynamic_cast<TNN_NS::UpsampleLayerParam*>(layer->param.get());
+            return param && input_count <= 4 && (!param->scales.empty() || !param->dims.empty());
+        }
+        case TNN_NS::LAYER_REPEAT: {
+            auto param = dynamic_cast<TNN_NS::TileLayerParam*>(layer->param.get());
+            return param && input_count == 2 && !param->reps.empty();
+        }
+        case TNN_NS::LAYER_PADV2: {
+            auto param = dynamic_cast<TNN_NS::PadLayerParam*>(layer->param.get());
+            return param && input_count == 2 && !param->pads.empty();
+        }
+        default:
+            return false;
+    }
+}
+
+TNN_NS::Status TnnOptimizePropagateShapeConstantPass::exec(TNN_NS::NetStructure& net_structure,
+                                                           TNN_NS::NetResource& net_resource) {
+    // the converter runs the net for the input shapes it is given, the values of the shape subgraph are
+    // folded for these shapes the same way ConstantFolding removes the shape layers
+    auto& constant_map = net_resource.constant_map;
+    for (auto& layer : net_structure.layers) {
+        if (layer->inputs.size() < 2 || !IsParamFilled(layer)) {
+            continue;
+        }
+        bool all_constant = std::all_of(layer->inputs.begin() + 1, layer->inputs.end(), [&](const std::string& name) {
+            return constant_map.find(name) != constant_map.end();
+        });
+        if (!all_constant) {
+            continue;
+        }
+        if (layer->type == TNN_NS::LAYER_RESHAPE) {
+            auto param      = dynamic_cast<TNN_NS::ReshapeLayerParam*>(layer->param.get());
+            param->num_axes = param->shape.size();
+        }
+        layer->inputs.resize(1);
+    }
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+REGISTER_OPTIMIZE_PASS(PropagateShapeConstant);
+}  // namespace TNN_CONVERTER
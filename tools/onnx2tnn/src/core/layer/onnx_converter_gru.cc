@@ -0,0 +1,79 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the 
+// specific language governing permissions and limitations under the License.
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "onnx_op_converter.h"
+#include "onnx_utility.h"
+
+DECLARE_OP_CONVERTER_WITH_FUNC(GRU,
+                               std::vector<std::string> GetInputNames(NodeProto &node, OnnxNetInfo &net_info););
+
+string OnnxOpConverterGRU::TNNOpType(NodeProto& node,
+                                     OnnxNetInfo &net_info) {
+    return "GRUONNX";
+}
+
+std::vector<std::string> OnnxOpConverterGRU::GetInputNames(NodeProto &node, OnnxNetInfo &net_info) {
+    std::vector<std::string> input_names;
+    for (int j = 0; j < (int)node.input_size(); j++) {
+        const auto input_name = node.input(j);
+        if (input_name.length() <= 0) {
+            continue;
+        }
+        input_names.push_back(input_name);
+    }
+    return input_names;
+}
+
+string OnnxOpConverterGRU::TNNLayerParam(NodeProto& node,
+                                         OnnxNetInfo& net_info) {
+    if (node.input_size() > 4 && node.input(4).length() > 0) {
+        DLog("Note: sequence_lens is not supported\n");
+        assert(0);
+    }
+    if (node.input_size() > 5 && node.input(5).length() > 0 && node.input(3).length() <= 0) {
+        DLog("Note: initial_h without B is not supported\n");
+        assert(0);
+    }
+
+    int hidden_size = (int)get_node_attr_i(node, "hidden_size", 0);
+    int linear_before_reset = (int)get_node_attr_i(node, "linear_before_reset", 0);
+    auto direction_s = get_node_attr_s(node, "direction", "forward");
+    int direction = 0;
+    if (direction_s == "reverse") {
+        direction = 1;
+    } else if (direction_s == "bidirectional") {
+        direction = 2;
+    }
+
+    ostringstream layer_param;
+    layer_param << hidden_size << " " << direction << " " << linear_before_reset << " ";
+
+    return layer_param.str();
+}
+
+bool OnnxOpConverterGRU::HasLayerResource(NodeProto &node, OnnxNetInfo &net_info) {
+    return false;
+};
+
+int OnnxOpConverterGRU::WriteTNNModel(Serializer* net_writer,
+                                      NodeProto& node,
+                                      OnnxNetInfo& net_info) {
+    // W, R and B are written in constant resource
+    return 0;
+}
+
+REGISTER_OP_CONVERTER(GRU, GRU);
@@ -556,6 +556,7 @@ int Onnx2TNN::OnnxExtractBlobWeights() {
     FuseRelu6(mutable_graph, index_nodes, weights, node_reference, blob_names);
     FuseSpaceToDepth(mutable_graph, index_nodes, weights, node_reference, blob_names);
     FuseLSTM(mutable_graph, index_nodes, weights, node_reference, blob_names);
+    FuseGRU(mutable_graph, index_nodes, weights, node_reference, blob_names);
     FuseArgMaxOrMin(mutable_graph, index_nodes, weights, node_reference, blob_names);
     FuseHistogram(mutable_graph, index_nodes, weights, node_reference, blob_names);
     FuseClip(mutable_graph, index_nodes, weights, node_reference, blob_names);
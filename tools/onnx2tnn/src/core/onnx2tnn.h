@@ -223,6 +223,11 @@ protected:
                   std::map<std::string, onnx::TensorProto>& weights,
                   std::map<std::string, int>& node_reference,
                   std::set<std::string>& blob_names);
+    int FuseGRU(onnx::GraphProto* mutable_graph,
+                std::vector<IndexNode> & index_nodes,
+                std::map<std::string, onnx::TensorProto>& weights,
+                std::map<std::string, int>& node_reference,
+                std::set<std::string>& blob_names);
     int FuseArgMaxOrMin(onnx::GraphProto* mutable_graph,
                   std::vector<IndexNode> & index_nodes,
                   std::map<std::string, onnx::TensorProto>& weights,
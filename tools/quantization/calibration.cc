@@ -14,14 +14,16 @@
 
 #include "calibration.h"
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <random>
+#include <thread>
 #include "file_reader.h"
 #include "tnn/core/macro.h"
-#include "tnn/core/tnn.h"
 #include "tnn/interpreter/tnn/model_packer.h"
 #include "tnn/interpreter/tnn/objseri.h"
 #include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/weight_quant_utils.h"
 
 namespace TNN_NS {
 
@@ -98,13 +100,14 @@ Calibration::Calibration() {}
 Calibration::~Calibration() {}
 
 Status Calibration::Init(NetworkConfig& net_config, ModelConfig& model_config, InputShapesMap inputs_shape) {
-    TNN tnn;
-    Status status = tnn.Init(model_config);
+    // keep tnn_ to create the instances of calibration workers
+    Status status = tnn_.Init(model_config);
     if (status != TNN_OK) {
         LOGE("tnn init failed!\n");
         return TNNERR_INVALID_MODEL;
     }
-    instance_ = tnn.CreateInst(net_config, status);
+    net_config_ = net_config;
+    instance_   = tnn_.CreateInst(net_config, status);
     if (status != TNN_OK) {
         LOGE("tnn create instance failed!\n");
         return TNNERR_INST_ERR;
@@ -139,6 +142,16 @@ int Calibration::SetCalibrationParams(CalibrationParam params) {
 }
 
 Status Calibration::RunCalibration(DataSet& dataset) {
+    // weight-only quantization needs no calibration data
+    if (cali_params_.weight_only_bits > 0) {
+        int ret = QuantizeWeightOnlyParams();
+        if (ret != 0) {
+            LOGE("weight-only quantize params failed!\n");
+            return TNNERR_QUANTIZE_ERROR;
+        }
+        return TNN_OK;
+    }
+
     // Compute Feature Scale
     int ret = CalBlobScale(dataset);
     if (ret != 0) {
@@ -200,21 +213,13 @@ int Calibration::CalBlobScale(DataSet& dataset) {
     }
     printf("\tInit Feature Map done!\n");
 
-    // Collect the Range of Feature map
-    ret = UpdateBlobRange(dataset);
-    if (ret != 0) {
-        LOGE("collect feautre map range failed!\n");
-        return ret;
-    }
-    printf("\tCollect Blob Range done!\n");
-
-    // Calculate Distribute of Feature map
-    ret = UpdateBlobDistribute(dataset);
+    // Collect the Range and Distribute of Feature map in one pass
+    ret = UpdateBlobStatistics(dataset);
     if (ret != 0) {
-        LOGE("update feautre map distribute failed!\n");
+        LOGE("collect feautre map statistics failed!\n");
         return ret;
     }
-    printf("\tCollect Blob Distribution done!\n");
+    printf("\tCollect Blob Statistics done!\n");
 
     // Compute Scale of Feature map and save to resource map
     for (auto& item : feature_map_) {
@@ -280,79 +285,116 @@ int Calibration::InitFeatureMap() {
     return 0;
 }
 
-int Calibration::UpdateBlobRange(DataSet& dataset) {
-    BlobMap input_blobs;
-    Status status = instance_->GetAllInputBlobs(input_blobs);
-    if (status != TNN_OK) {
-        LOGE("instance get input blobs failed!\n");
-        return -1;
-    }
-    Blob* input_blob = input_blobs.begin()->second;
-
-    BlobStatisticCallback func = [&](std::vector<Blob*>& blobs, LayerInfo* info) {
-        for (auto blob : blobs) {
-            if (feature_map_.find(blob) != feature_map_.end()) {
-                feature_map_[blob]->UpdateRange();
-            }
-        }
-    };
-
-    FileReader file_reader;
-    file_reader.SetBiasValue(cali_params_.input_bias);
-    file_reader.SetScaleValue(cali_params_.input_scale);
-    file_reader.SetReverseChannel(cali_params_.reverse_channel);
-    for (auto file_pack : dataset.file_list) {
-        for (auto item : feature_map_) {
-            item.second->ClearRangeFlag();
-        }
-
-        status = file_reader.Read(input_blob, file_pack.first, file_pack.second);
-        if (status != TNN_OK) {
-            LOGE("read input file (%s) failed!\n", file_pack.first.c_str());
-            continue;
+int Calibration::UpdateBlobStatistics(DataSet& dataset) {
+    int num_files   = dataset.file_list.size();
+    int num_workers = cali_params_.num_threads;
+    if (num_workers <= 0) {
+        num_workers = std::max((int)std::thread::hardware_concurrency(), 1);
+    }
+    num_workers = std::max(std::min(num_workers, num_files), 1);
+
+    // instance_ is the first worker, the others run instances of the same model
+    std::vector<std::shared_ptr<Instance>> instances = {instance_};
+    for (int i = 1; i < num_workers; ++i) {
+        Status status;
+        auto instance = tnn_.CreateInst(net_config_, status, dataset.input_shape);
+        if (status != TNN_OK || instance == nullptr) {
+            LOGE("tnn create instance for calibration worker failed!\n");
+            return -1;
         }
-        instance_->ForwardWithCallback(func, func);
+        instances.push_back(instance);
     }
+    printf("\tCollect Blob Statistics with %d workers ...\n", num_workers);
 
-    return 0;
-}
-
-int Calibration::UpdateBlobDistribute(DataSet& dataset) {
+    std::map<std::string, std::shared_ptr<ScaleCalculator>> name_feature_map;
     for (auto& item : feature_map_) {
-        item.second->ResetDistribute();
-    }
+        name_feature_map[item.first->GetBlobDesc().name] = item.second;
+    }
+
+    // every worker decodes its own files and updates its own copy of the calculators,
+    // the copies are merged after all files are done
+    typedef std::map<std::string, std::shared_ptr<ScaleCalculator>> CalculatorMap;
+    std::vector<CalculatorMap> worker_feature_maps(num_workers);
+    std::vector<int> worker_rets(num_workers, 0);
+    std::atomic<int> next_file(0);
+    std::atomic<int> done_files(0);
+
+    auto worker = [&](int worker_id) {
+        auto instance        = instances[worker_id];
+        auto& calculator_map = worker_feature_maps[worker_id];
+
+        BlobMap input_blobs;
+        Status status = instance->GetAllInputBlobs(input_blobs);
+        if (status != TNN_OK || input_blobs.empty()) {
+            LOGE("instance get input blobs failed!\n");
+            worker_rets[worker_id] = -1;
+            return;
+        }
+        Blob* input_blob = input_blobs.begin()->second;
 
-    BlobMap input_blobs;
-    Status status = instance_->GetAllInputBlobs(input_blobs);
-    if (status != TNN_OK) {
-        LOGE("instance get input blobs failed!\n");
-        return -1;
-    }
-    Blob* input_blob = input_blobs.begin()->second;
+        BlobStatisticCallback func = [&](std::vector<Blob*>& blobs, LayerInfo* info) {
+            for (auto blob : blobs) {
+                auto name = blob->GetBlobDesc().name;
+                auto iter = name_feature_map.find(name);
+                if (iter == name_feature_map.end()) {
+                    continue;
+                }
+                auto& calculator = calculator_map[name];
+                if (calculator == nullptr) {
+                    calculator = std::make_shared<ScaleCalculator>(*iter->second);
+                    calculator->SetBlob(blob);
+                }
+                if (calculator->Update() != 0) {
+                    worker_rets[worker_id] = -1;
+                }
+            }
+        };
+
+        FileReader file_reader;
+        file_reader.SetBiasValue(cali_params_.input_bias);
+        file_reader.SetScaleValue(cali_params_.input_scale);
+        file_reader.SetReverseChannel(cali_params_.reverse_channel);
+        for (int index = next_file++; index < num_files && worker_rets[worker_id] == 0; index = next_file++) {
+            auto& file_pack = dataset.file_list[index];
+            for (auto& item : calculator_map) {
+                item.second->ClearUpdateFlag();
+            }
 
-    BlobStatisticCallback func = [&](std::vector<Blob*>& blobs, LayerInfo* info) {
-        for (auto blob : blobs) {
-            if (feature_map_.find(blob) != feature_map_.end()) {
-                feature_map_[blob]->UpdateDistribute();
+            status = file_reader.Read(input_blob, file_pack.first, file_pack.second);
+            if (status != TNN_OK) {
+                LOGE("read input file (%s) failed!\n", file_pack.first.c_str());
+                continue;
+            }
+            instance->ForwardWithCallback(func, func);
+
+            int done = ++done_files;
+            if (done % 100 == 0 || done == num_files) {
+                printf("\t\t%d / %d files done\n", done, num_files);
             }
         }
     };
 
-    FileReader file_reader;
-    file_reader.SetBiasValue(cali_params_.input_bias);
-    file_reader.SetScaleValue(cali_params_.input_scale);
-    file_reader.SetReverseChannel(cali_params_.reverse_channel);
-    for (auto file_pack : dataset.file_list) {
-        for (auto& item : feature_map_) {
-            item.second->ClearDistributeFlag();
-        }
+    std::vector<std::thread> threads;
+    for (int i = 1; i < num_workers; ++i) {
+        threads.emplace_back(worker, i);
+    }
+    worker(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
 
-        status = file_reader.Read(input_blob, file_pack.first, file_pack.second);
-        if (status != TNN_OK) {
-            LOGE("read input file (%s) failed!\n", file_pack.first.c_str());
-            continue;
+    for (int i = 0; i < num_workers; ++i) {
+        if (worker_rets[i] != 0) {
+            LOGE("calibration worker %d failed!\n", i);
+            return worker_rets[i];
+        }
+        for (auto& item : worker_feature_maps[i]) {
+            int ret = name_feature_map[item.first]->Merge(*item.second);
+            if (ret != 0) {
+                LOGE("merge statistics of blob (%s) failed!\n", item.first.c_str());
+                return ret;
+            }
         }
-        instance_->ForwardWithCallback(func, func);
     }
 
     return 0;
@@ -674,6 +716,143 @@ int Calibration::QuantizeFcParams(InnerProductLayerResource* resource, InnerProd
     return 0;
 }
 
+int Calibration::QuantizeWeightOnlyParams() {
+    printf("Start to Quantize Parameters (weight-only, %d bits) ...\n", cali_params_.weight_only_bits);
+    NetStructure* net_struct  = interpreter_->GetNetStructure();
+    NetResource* net_resource = interpreter_->GetNetResource();
+    const int bits            = cali_params_.weight_only_bits;
+    const int group           = cali_params_.weight_only_group;
+
+    for (auto& item : net_struct->layers) {
+        auto const_layers = net_resource->constant_layers;
+        if (const_layers.find(item->name) != const_layers.end()) {
+            continue;
+        }
+
+        if (item->type == LAYER_INNER_PRODUCT) {
+            auto fc_param = dynamic_cast<InnerProductLayerParam*>(item->param.get());
+            auto fc_res   = dynamic_cast<InnerProductLayerResource*>(net_resource->resource_map[item->name].get());
+            if (!fc_param || !fc_res || fc_param->quantized) {
+                continue;
+            }
+            printf("\tQuantize InnerProduct weights (weight-only)...\n");
+            int oc = fc_param->num_output;
+            int ic = fc_res->weight_handle.GetDataCount() / oc;
+            RawBuffer weight, scale;
+            if (QuantizeWeightOnly(fc_res->weight_handle, oc, ic, false, weight, scale) != 0) {
+                LOGE("Quantize InnerProduct weights failed! (layer name: %s)\n", item->name.c_str());
+                return -1;
+            }
+            RawBuffer zero_point(scale.GetDataCount() * sizeof(int8_t));
+            zero_point.SetDataType(DATA_TYPE_INT8);
+            fc_res->weight_handle        = weight;
+            fc_res->scale_handle         = scale;
+            fc_res->zero_point_handle    = zero_point;
+            fc_res->bias_handle          = ConvertHalfHandle(fc_res->bias_handle);
+            fc_param->weight_quant_bits  = bits;
+            fc_param->weight_quant_group = group;
+            fc_param->dynamic_quant      = cali_params_.dynamic_quant;
+            printf("\t====> done!\n");
+        } else if (item->type == LAYER_MATMUL) {
+            auto mm_param = dynamic_cast<MatMulLayerParam*>(item->param.get());
+            auto mm_res   = dynamic_cast<MatMulLayerResource*>(net_resource->resource_map[item->name].get());
+            // only the constant B[K, M] of A * B is supported
+            if (!mm_param || !mm_res || mm_param->weight_position != 1 || mm_res->weight.GetBufferDims().size() != 2) {
+                continue;
+            }
+            printf("\tQuantize MatMul weights (weight-only)...\n");
+            auto dims = mm_res->weight.GetBufferDims();
+            RawBuffer weight, scale;
+            if (QuantizeWeightOnly(mm_res->weight, dims[1], dims[0], true, weight, scale) != 0) {
+                LOGE("Quantize MatMul weights failed! (layer name: %s)\n", item->name.c_str());
+                return -1;
+            }
+            weight.SetBufferDims(dims);
+            mm_res->weight               = weight;
+            mm_res->scale_handle         = scale;
+            mm_param->weight_quant_bits  = bits;
+            mm_param->weight_quant_group = group;
+            mm_param->dynamic_quant      = cali_params_.dynamic_quant;
+            printf("\t====> done!\n");
+        } else if (item->type == LAYER_LSTMONNX) {
+            auto lstm_param = dynamic_cast<LSTMONNXLayerParam*>(item->param.get());
+            if (!lstm_param || item->inputs.size() < 3) {
+                continue;
+            }
+            // W and R, [num_directions, 4 * hidden_size, K]
+            bool all_const = true;
+            for (int i = 1; i <= 2; i++) {
+                auto iter = net_resource->constant_map.find(item->inputs[i]);
+                all_const = all_const && iter != net_resource->constant_map.end() &&
+                            iter->second->GetBufferDims().size() == 3;
+            }
+            if (!all_const) {
+                continue;
+            }
+            printf("\tQuantize LSTM weights (weight-only)...\n");
+            for (int i = 1; i <= 2; i++) {
+                auto& buffer = net_resource->constant_map[item->inputs[i]];
+                auto dims    = buffer->GetBufferDims();
+                auto weight  = std::make_shared<RawBuffer>();
+                auto scale   = std::make_shared<RawBuffer>();
+                if (QuantizeWeightOnly(*buffer, dims[0] * dims[1], dims[2], false, *weight, *scale) != 0) {
+                    LOGE("Quantize LSTM weights failed! (layer name: %s)\n", item->name.c_str());
+                    return -1;
+                }
+                weight->SetBufferDims(dims);
+                scale->SetBufferDims({dims[0] * dims[1], scale->GetDataCount() / (dims[0] * dims[1])});
+                net_resource->constant_map[item->inputs[i] + WEIGHT_QUANT_SCALE_SUFFIX] = scale;
+                buffer = weight;
+            }
+            lstm_param->weight_quant_bits  = bits;
+            lstm_param->weight_quant_group = group;
+            printf("\t====> done!\n");
+        }
+    }
+
+    return 0;
+}
+
+int Calibration::QuantizeWeightOnly(RawBuffer& weight, int oc, int ic, bool transpose, RawBuffer& quantized_weight,
+                                    RawBuffer& scale) {
+    const int bits  = cali_params_.weight_only_bits;
+    const int group = cali_params_.weight_only_group;
+    if (weight.GetDataType() != DATA_TYPE_FLOAT && weight.GetDataType() != DATA_TYPE_HALF) {
+        LOGE("weight-only quantization needs float weights!\n");
+        return -1;
+    }
+    if (oc <= 0 || ic <= 0 || weight.GetDataCount() != oc * ic) {
+        LOGE("invalid weight size!\n");
+        return -1;
+    }
+
+    RawBuffer weight_f32 = ConvertHalfHandle(weight);
+    float* weight_data   = weight_f32.force_to<float*>();
+    // weights are quantized along rows of [oc, ic]
+    std::vector<float> weight_t;
+    if (transpose) {
+        weight_t.resize(oc * ic);
+        for (int k = 0; k < ic; k++) {
+            for (int o = 0; o < oc; o++) {
+                weight_t[o * ic + k] = weight_data[k * oc + o];
+            }
+        }
+        weight_data = weight_t.data();
+    }
+
+    quantized_weight = RawBuffer(oc * WeightQuantRowBytes(ic, bits), {oc, ic});
+    quantized_weight.SetDataType(DATA_TYPE_INT8);
+    scale = RawBuffer(oc * WeightQuantGroupCount(ic, group) * sizeof(float));
+    scale.SetDataType(DATA_TYPE_FLOAT);
+    Status status = TNN_NS::QuantizeWeightOnly(weight_data, oc, ic, bits, group,
+                                               quantized_weight.force_to<int8_t*>(), scale.force_to<float*>());
+    if (status != TNN_OK) {
+        LOGE("%s\n", status.description().c_str());
+        return -1;
+    }
+    return 0;
+}
+
 int Calibration::CalQuantizedWeights(const float* weights, const int size, const int output_channel, bool merge_channel,
                                      int8_t* quantized_weights, float* weight_scale, int8_t* weight_zero_point) {
     ASSERT(size % output_channel == 0);
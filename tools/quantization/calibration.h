@@ -20,6 +20,7 @@
 #include "tnn/core/instance.h"
 #include "tnn/core/layer_type.h"
 #include "tnn/core/status.h"
+#include "tnn/core/tnn.h"
 #include "tnn/interpreter/default_model_interpreter.h"
 
 #include "calibration_common.h"
@@ -58,8 +59,7 @@ public:
 private:
     int CalBlobScale(DataSet& dataset);
     int InitFeatureMap();
-    int UpdateBlobRange(DataSet& dataset);
-    int UpdateBlobDistribute(DataSet& dataset);
+    int UpdateBlobStatistics(DataSet& dataset);
     IntScaleResource* CreateIntScale(std::vector<float> scale_vec);
     IntScaleResource* CreateIntScale(std::vector<float> scale_vec, std::vector<int8_t> zero_point_vec);
 
@@ -72,10 +72,16 @@ private:
     int CalQuantizedWeights(const float* weights, const int size, const int output_channel, bool merge_channel,
                             int8_t* quantized_weight, float* weight_scale,  int8_t* weight_zero_point);
 
+    int QuantizeWeightOnlyParams();
+    int QuantizeWeightOnly(RawBuffer& weight, int oc, int ic, bool transpose, RawBuffer& quantized_weight,
+                           RawBuffer& scale);
+
     int MergeBlobScale();
     void MergeBlobScaleRecursion(LayerInfo* layer_info, NetStructure* net_struct, NetResource* net_resource);
     LayerInfo* GetLayerInfoFromOutpubBlobName(std::string blob_name, NetStructure* net_struct);
 
+    TNN tnn_;
+    NetworkConfig net_config_;
     std::shared_ptr<DefaultModelInterpreter> interpreter_;
     std::shared_ptr<Instance> instance_;
     std::map<Blob*, std::shared_ptr<ScaleCalculator>> feature_map_;
@@ -54,6 +54,14 @@ struct CalibrationParam {
     std::vector<float> input_bias             = {0, 0, 0, 0};
     std::vector<float> input_scale            = {1.0f, 1.0f, 1.0f, 1.0f};
     bool reverse_channel                      = false;
+    /* calibration workers, each runs its own instance, 0: one per hardware thread */
+    int num_threads                           = 0;
+    /* weight-only quantization of InnerProduct, MatMul and LSTM, 0: disabled, 8: int8, 4: int4 */
+    int weight_only_bits                      = 0;
+    /* input channels per weight-only scale, 0: one scale per output channel */
+    int weight_only_group                     = 0;
+    /* int8 weight-only layers quantize their input at runtime, 0: disabled, 1: per tensor, 2: per row */
+    int dynamic_quant                         = 0;
 };
 
 }  // namespace TNN_NS
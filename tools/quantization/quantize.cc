@@ -178,11 +178,11 @@ bool CheckFileName(std::string name) {
 void PrintConfig() {
     printf(
         "usage:\n./quantization_cmd [-h] [-p] <proto file> [-m] <model file> [-i] <input folder> [-b] <val> [-w] <val> "
-        "[-n] <val> [-s] <val> [-t] <val> [-o] <output_name>\n"
+        "[-n] <val> [-s] <val> [-t] <val> [-q] <val> [-g] <val> [-j] <val> [-o] <output_name>\n"
         "\t-h, --help        \t show this message\n"
         "\t-p, --proto       \t(require) tnn proto file name\n"
         "\t-m, --model       \t(require) tnn model file name\n"
-        "\t-i, --input_path  \t(require) the folder of input files\n"
+        "\t-i, --input_path  \t(require) the folder of input files, not needed by weight-only mode\n"
         "\t-b, --blob_method \t(optional) the method to quantize blob\n"
         "\t\t0: MIN_MAX  (default)\n"
         "\t\t2: KL_DIVERGENCE\n"
@@ -207,6 +207,20 @@ void PrintConfig() {
         "\t\t0: per-channel mode  (default)\n"
         "\t\t1: mix mode          weight: per-channel  blob: per-tensor\n"
         "\t\t2: per-tersor mode\n"
+        "\t-q, --weight_only_bits\t(optional) only quantize weights of InnerProduct, MatMul and LSTM, "
+        "activations stay float\n"
+        "\t\t0: disabled  (default)\n"
+        "\t\t8: int8 weights\n"
+        "\t\t4: int4 weights\n"
+        "\t-g, --weight_only_group\t(optional) input channels per scale of weight-only mode, "
+        "0: per output channel (default)\n"
+        "\t-d, --dynamic_quant\t(optional) quantize the input of weight-only layers to int8 at runtime, "
+        "needs -q 8 and -g 0\n"
+        "\t\t0: disabled  (default)\n"
+        "\t\t1: one scale per tensor\n"
+        "\t\t2: one scale per row\n"
+        "\t-j, --threads      \t(optional) calibration workers, each decodes inputs and runs its own instance, "
+        "0: one per hardware thread (default)\n"
         "\t-o, --output       \t(optional) specify the name of output\n");
 }
 
@@ -228,11 +242,15 @@ int main(int argc, char* argv[]) {
                                     {"bias", required_argument, 0, 'n'},
                                     {"scale", required_argument, 0, 's'},
                                     {"merge_type", required_argument, 0, 't'},
+                                    {"weight_only_bits", required_argument, 0, 'q'},
+                                    {"weight_only_group", required_argument, 0, 'g'},
+                                    {"dynamic_quant", required_argument, 0, 'd'},
+                                    {"threads", required_argument, 0, 'j'},
                                     {"output", required_argument, 0, 'o'},
                                     {"help", no_argument, 0, 'h'},
                                     {0, 0, 0, 0}};
 
-    const char* optstring = "p:m:i:b:w:r:n:s:t:o:h";
+    const char* optstring = "p:m:i:b:w:r:n:s:t:q:g:d:j:o:h";
 
     if (argc == 1) {
         PrintConfig();
@@ -317,6 +335,32 @@ int main(int argc, char* argv[]) {
                     cali_params.merge_weights_channel = false;
                 }
             } break;
+            case 'q': {
+                printf("weight only bits: %s\n", optarg);
+                int bits = atoi(optarg);
+                if (bits != 0 && bits != 8 && bits != 4) {
+                    printf("invalid weight only bits: %s\n", optarg);
+                    return -1;
+                }
+                cali_params.weight_only_bits = bits;
+            } break;
+            case 'g':
+                printf("weight only group: %s\n", optarg);
+                cali_params.weight_only_group = atoi(optarg);
+                break;
+            case 'd': {
+                printf("dynamic quant: %s\n", optarg);
+                int mode = atoi(optarg);
+                if (mode < 0 || mode > 2) {
+                    printf("invalid dynamic quant: %s\n", optarg);
+                    return -1;
+                }
+                cali_params.dynamic_quant = mode;
+            } break;
+            case 'j':
+                printf("calibration threads: %s\n", optarg);
+                cali_params.num_threads = atoi(optarg);
+                break;
             case 'o':
                 printf("output name: %s\n", optarg);
                 output_name = optarg;
@@ -335,6 +379,12 @@ int main(int argc, char* argv[]) {
         }
     }
 
+    if (cali_params.dynamic_quant > 0 &&
+        (cali_params.weight_only_bits != 8 || cali_params.weight_only_group != 0)) {
+        printf("dynamic quant needs int8 weight-only mode with group 0 (-q 8 -g 0)!\n");
+        return -1;
+    }
+
     ModelConfig model_config;
     int ret = InitModelConfig(model_config, proto_file_name, model_file_name);
     if (CheckResult("init model config", ret) != true)
@@ -343,9 +393,11 @@ int main(int argc, char* argv[]) {
     NetworkConfig net_config;
     net_config.device_type = DEVICE_NAIVE;    
     DataSet dataset;
-    ret = ImportDataSet(dataset, input_path);
-    if (CheckResult("import data set", ret) != true)
-        return -1;
+    if (cali_params.weight_only_bits == 0) {
+        ret = ImportDataSet(dataset, input_path);
+        if (CheckResult("import data set", ret) != true)
+            return -1;
+    }
 
     Calibration calibration;
     Status status = calibration.Init(net_config, model_config);
@@ -41,11 +41,36 @@ static float KlDivergence(const std::vector<float>& dis_ref, const std::vector<f
     return result;
 }
 
+// the smallest power of two greater than val
+static float PowerOfTwoCeil(float val) {
+    int exp = 0;
+    std::frexp(val, &exp);
+    return std::ldexp(1.0f, exp);
+}
+
+// grow the range of a histogram sketch to new_max by folding bins, both ranges are powers of two
+static void GrowSketch(std::vector<double>& sketch, float& sketch_max, float new_max) {
+    if (new_max <= sketch_max) {
+        return;
+    }
+    if (sketch_max > 0) {
+        const int factor = static_cast<int>(std::lround(new_max / sketch_max));
+        const int size   = sketch.size();
+        for (int i = 0; i < size; ++i) {
+            double val = sketch[i];
+            sketch[i]  = 0;
+            sketch[i / factor] += val;
+        }
+    }
+    sketch_max = new_max;
+}
+
 ScaleCalculator::ScaleCalculator() {
-    origin_blob_          = nullptr;
-    range_done_flag_      = false;
-    distribute_done_flag_ = false;
-    bin_nums_             = 2048;
+    origin_blob_      = nullptr;
+    update_done_flag_ = false;
+    bin_nums_         = 2048;
+    // the sketch range is at most twice the max abs value, keep at least bin_nums_ bins in use
+    sketch_bin_nums_  = 2 * bin_nums_;
 }
 
 ScaleCalculator::~ScaleCalculator() {}
@@ -74,12 +99,9 @@ int ScaleCalculator::Init(Blob* blob, bool merge_channel, CalibrationMethod meth
         }
         mean_per_channel_.resize(channel);
         mean_abs_per_channel_.resize(channel);
-        interval_per_channel_.resize(channel);
         valid_channel_.resize(channel);
-        distribute_per_channel_.resize(channel);
-        for (auto& item : distribute_per_channel_) {
-            item.resize(bin_nums_);
-        }
+        sketch_max_per_channel_.resize(channel);
+        sketch_per_channel_.resize(channel);
 
         if (height * width < 100 && cali_method_ != ASY_MIN_MAX) {
             // the data num is too small, use minmax
@@ -108,16 +130,16 @@ void ScaleCalculator::SetMergeChannel(bool merge) {
     merge_channel_ = merge;
 }
 
-void ScaleCalculator::ClearRangeFlag() {
-    range_done_flag_ = false;
+void ScaleCalculator::SetBlob(Blob* blob) {
+    origin_blob_ = blob;
 }
 
-void ScaleCalculator::ClearDistributeFlag() {
-    distribute_done_flag_ = false;
+void ScaleCalculator::ClearUpdateFlag() {
+    update_done_flag_ = false;
 }
 
-int ScaleCalculator::UpdateRange() {
-    if (range_done_flag_) {
+int ScaleCalculator::Update() {
+    if (update_done_flag_) {
         return 0;
     }
 
@@ -126,6 +148,11 @@ int ScaleCalculator::UpdateRange() {
     int hxw         = DimsVectorUtils::Count(origin_blob_->GetBlobDesc().dims, 2);
     float* data_ptr = reinterpret_cast<float*>(static_cast<char*>(origin_blob_->GetHandle().base) +
                                                origin_blob_->GetHandle().bytes_offset);
+    if (channel != (int)range_per_channel_.size()) {
+        LOGE("blob channel (%d) mismatch with the calculator!\n", channel);
+        return -1;
+    }
+    const bool need_sketch = cali_method_ == KL_DIVERGENCE;
 
     for (int b = 0; b < batch; ++b) {
         for (int c = 0; c < channel; ++c) {
@@ -151,85 +178,131 @@ int ScaleCalculator::UpdateRange() {
                 index_image_per_channel_[channel_idx] = index + 1;
             }
 
+            float min_val = range_per_channel_[channel_idx].first;
+            float max_val = range_per_channel_[channel_idx].second;
             for (int i = 0; i < hxw; ++i) {
-                float val = p[i];
+                min_val = std::min(min_val, p[i]);
+                max_val = std::max(max_val, p[i]);
+            }
+            range_per_channel_[channel_idx].first  = min_val;
+            range_per_channel_[channel_idx].second = max_val;
 
-                if (val < range_per_channel_[channel_idx].first) {
-                    range_per_channel_[channel_idx].first = val;
-                }
-                if (val > range_per_channel_[channel_idx].second) {
-                    range_per_channel_[channel_idx].second = val;
+            if (!need_sketch) {
+                continue;
+            }
+            auto& sketch      = sketch_per_channel_[channel_idx];
+            float& sketch_max = sketch_max_per_channel_[channel_idx];
+            if (sketch.empty()) {
+                sketch.resize(sketch_bin_nums_, 0);
+            }
+            float abs_max = std::max(std::abs(min_val), std::abs(max_val));
+            if (abs_max > sketch_max) {
+                GrowSketch(sketch, sketch_max, PowerOfTwoCeil(abs_max));
+            }
+            if (sketch_max <= 0) {
+                continue;
+            }
+
+            const float interval = (float)sketch_bin_nums_ / sketch_max;
+            double* sketch_data  = sketch.data();
+            for (int i = 0; i < hxw; ++i) {
+                float val = p[i];
+                if (val == 0) {
+                    continue;
                 }
+
+                int index = static_cast<int>(std::abs(val) * interval);
+                index     = std::min(index, sketch_bin_nums_ - 1);
+                sketch_data[index] += 1.0;
             }
         }
     }
-    
-    range_done_flag_ = true;
+
+    update_done_flag_ = true;
     return 0;
 }
 
-int ScaleCalculator::ResetDistribute() {
-    for (unsigned int i = 0; i < interval_per_channel_.size(); ++i) {
-        float max_val     = std::max(std::abs(range_per_channel_[i].first), std::abs(range_per_channel_[i].second));
-        valid_channel_[i] = max_val > 0.00001;
-        if (valid_channel_[i]) {
-            interval_per_channel_[i] = (float)bin_nums_ / max_val;
-        }
-
-        if (merge_channel_)
-            break;
+int ScaleCalculator::Merge(const ScaleCalculator& other) {
+    if (other.range_per_channel_.size() != range_per_channel_.size()) {
+        LOGE("merge calculators of different blobs!\n");
+        return -1;
     }
 
-    for (auto& item : distribute_per_channel_) {
-        std::fill(item.begin(), item.end(), 1.0e-7);
+    for (unsigned int c = 0; c < range_per_channel_.size(); ++c) {
+        range_per_channel_[c].first  = std::min(range_per_channel_[c].first, other.range_per_channel_[c].first);
+        range_per_channel_[c].second = std::max(range_per_channel_[c].second, other.range_per_channel_[c].second);
+
+        int index       = index_image_per_channel_[c];
+        int other_index = other.index_image_per_channel_[c];
+        if (other_index > 0) {
+            mean_per_channel_[c] =
+                (mean_per_channel_[c] * index + other.mean_per_channel_[c] * other_index) / (index + other_index);
+            mean_abs_per_channel_[c] = (mean_abs_per_channel_[c] * index + other.mean_abs_per_channel_[c] * other_index) /
+                                       (index + other_index);
+            index_image_per_channel_[c] = index + other_index;
+        }
+
+        if (other.sketch_per_channel_[c].empty() || other.sketch_max_per_channel_[c] <= 0) {
+            continue;
+        }
+        auto& sketch = sketch_per_channel_[c];
+        if (sketch.empty()) {
+            sketch.resize(sketch_bin_nums_, 0);
+        }
+        GrowSketch(sketch, sketch_max_per_channel_[c], other.sketch_max_per_channel_[c]);
+        const int factor = static_cast<int>(std::lround(sketch_max_per_channel_[c] / other.sketch_max_per_channel_[c]));
+        const auto& other_sketch = other.sketch_per_channel_[c];
+        for (int i = 0; i < sketch_bin_nums_; ++i) {
+            sketch[i / factor] += other_sketch[i];
+        }
     }
 
     return 0;
 }
 
-int ScaleCalculator::UpdateDistribute() {
-    if (distribute_done_flag_) {
-        return 0;
-    }
-
-    int batch       = origin_blob_->GetBlobDesc().dims[0];
-    int channel     = origin_blob_->GetBlobDesc().dims[1];
-    int hxw         = DimsVectorUtils::Count(origin_blob_->GetBlobDesc().dims, 2);
-    float* data_ptr = reinterpret_cast<float*>(static_cast<char*>(origin_blob_->GetHandle().base) +
-                                               origin_blob_->GetHandle().bytes_offset);
-
-    for (int b = 0; b < batch; ++b) {
-        for (int c = 0; c < channel; ++c) {
-            int channel_idx = c;
-            if (merge_channel_) {
-                channel_idx = 0;
-            }
-            if (!valid_channel_[channel_idx]) {
-                continue;
-            }
+void ScaleCalculator::GetDistribute(int channel_index, std::vector<float>& distribute, float& interval) {
+    float max_val = std::max(std::abs(range_per_channel_[channel_index].first),
+                             std::abs(range_per_channel_[channel_index].second));
+    interval      = (float)bin_nums_ / max_val;
 
-            float* p               = data_ptr + b * channel * hxw + c * hxw;
-            float* distribute_data = distribute_per_channel_[channel_idx].data();
-            for (int i = 0; i < hxw; ++i) {
-                float val = p[i];
-                if (val == 0) {
-                    continue;
-                }
+    distribute.resize(bin_nums_);
+    std::fill(distribute.begin(), distribute.end(), 1.0e-7);
 
-                int index = static_cast<int>(std::abs(val) * interval_per_channel_[channel_idx]);
-                index     = std::min(index, bin_nums_ - 1);
-                distribute_data[index] += 1.0;
-            }
+    const auto& sketch = sketch_per_channel_[channel_index];
+    if (sketch.empty()) {
+        return;
+    }
+    // a sketch bin is narrower than a target bin, so it overlaps at most two target bins
+    const double sketch_width = sketch_max_per_channel_[channel_index] / sketch_bin_nums_;
+    const double target_width = max_val / bin_nums_;
+    for (int i = 0; i < sketch_bin_nums_; ++i) {
+        if (sketch[i] == 0) {
+            continue;
+        }
+        double start = i * sketch_width;
+        double end   = start + sketch_width;
+        int index    = std::min(static_cast<int>(start / target_width), bin_nums_ - 1);
+        double split = std::min((index + 1) * target_width, end);
+        if (index == bin_nums_ - 1 || split >= end) {
+            distribute[index] += sketch[i];
+        } else {
+            double ratio = (split - start) / sketch_width;
+            distribute[index] += sketch[i] * ratio;
+            distribute[index + 1] += sketch[i] * (1.0 - ratio);
         }
     }
-
-    distribute_done_flag_ = true;
-    return 0;
 }
 
 int ScaleCalculator::CalculateScale(std::vector<float>& val, std::vector<int8_t>& bias) {
+    for (unsigned int i = 0; i < valid_channel_.size(); ++i) {
+        float max_val     = std::max(std::abs(range_per_channel_[i].first), std::abs(range_per_channel_[i].second));
+        valid_channel_[i] = max_val > 0.00001;
+    }
+
     val.clear();
     bias.clear();
+    std::vector<float> distribute;
+    float interval = 0;
     if (merge_channel_) {
         val.push_back(0.0f);
         bias.push_back(0);
@@ -240,7 +313,8 @@ int ScaleCalculator::CalculateScale(std::vector<float>& val, std::vector<int8_t>
         if (cali_method_ == ASY_MIN_MAX || cali_method_ == ACIQ_GAUS || cali_method_ == ACIQ_LAPLACE) {
             ret = CalculateScaleAnalysis(0, val[0], bias[0]);
         } else {
-            ret = CalculateScalePerDis(distribute_per_channel_[0], interval_per_channel_[0], val[0]);
+            GetDistribute(0, distribute, interval);
+            ret = CalculateScalePerDis(distribute, interval, val[0]);
         }
         if (ret != 0)
             return -1;
@@ -258,7 +332,8 @@ int ScaleCalculator::CalculateScale(std::vector<float>& val, std::vector<int8_t>
             if (cali_method_ == ASY_MIN_MAX || cali_method_ == ACIQ_GAUS || cali_method_ == ACIQ_LAPLACE) {
                 ret = CalculateScaleAnalysis(c, val[c], bias[c]);
             } else{
-                ret = CalculateScalePerDis(distribute_per_channel_[c], interval_per_channel_[c], val[c]);
+                GetDistribute(c, distribute, interval);
+                ret = CalculateScalePerDis(distribute, interval, val[c]);
             }
             if (ret != 0)
                 return -1;
@@ -49,20 +49,18 @@ public:
     // param 0 : method, the method to set
     void SetMergeChannel(bool merge);
 
-    // @brief: clear range_done_flag_.
-    void ClearRangeFlag();
+    // @brief: bind the calculator to a blob of the same shape, used to copy the
+    //         calculator to the instances of calibration workers
+    void SetBlob(Blob* blob);
 
-    // @brief: clear distribute_done_flag_.
-    void ClearDistributeFlag();
+    // @brief: clear update_done_flag_, call it before every forward.
+    void ClearUpdateFlag();
 
-    // @brief: update the blob data.
-    int UpdateRange();
+    // @brief: update range, mean and distribute with the blob data in one pass.
+    int Update();
 
-    // @brief: reset distribute according range.
-    int ResetDistribute();
-
-    // @brief: update distribute.
-    int UpdateDistribute();
+    // @brief: merge the statistics collected by another calculator of the same blob.
+    int Merge(const ScaleCalculator& other);
 
     // @brief: get the per-channel scale of the given blob
     int CalculateScale(std::vector<float>& val);
@@ -73,20 +71,24 @@ private:
     int CalculateScalePerDis(std::vector<float>& distribute, float interval, float& output);
     // @brief: analytical-based methods
     int CalculateScaleAnalysis(int channel_index, float& blob_scale, int8_t& bias);
+    // @brief: resample the histogram sketch of a channel to bin_nums_ bins in [0, max abs]
+    void GetDistribute(int channel_index, std::vector<float>& distribute, float& interval);
 
     Blob* origin_blob_;
     bool merge_channel_;
     CalibrationMethod cali_method_;
     int bin_nums_;
-    bool range_done_flag_;
-    bool distribute_done_flag_;
+    int sketch_bin_nums_;
+    bool update_done_flag_;
     std::vector<std::pair<float, float>> range_per_channel_;
-    std::vector<float> interval_per_channel_;
     std::vector<float> mean_per_channel_;
     std::vector<float> mean_abs_per_channel_;
     std::vector<int> index_image_per_channel_;
     std::vector<bool> valid_channel_;
-    std::vector<std::vector<float>> distribute_per_channel_;
+    // histogram of abs values in [0, sketch_max_per_channel_), the range is always a power of two,
+    // so histograms of different ranges are merged by folding bins, only kept by KL_DIVERGENCE
+    std::vector<float> sketch_max_per_channel_;
+    std::vector<std::vector<double>> sketch_per_channel_;
 };
 
 }  // namespace TNN_NS